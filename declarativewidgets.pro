@@ -4,5 +4,6 @@ CONFIG += ordered
 
 SUBDIRS = lib runner.pro examples \
     extensionplugin \
-    tests \
-    ui2dw
+    ui2dw \
+    qml2cpp \
+    tests
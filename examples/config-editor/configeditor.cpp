@@ -30,18 +30,25 @@
 
 #include "settingsadaptor.h"
 
+#include "declarativetextdocumentloader.h"
+#include "declarativetextdocumentsaver.h"
+
 #include <QDebug>
 #include <QDir>
-#include <QFile>
 #include <QFileInfo>
 #include <QStandardPaths>
-#include <QTextStream>
 
 ConfigEditor::ConfigEditor(QObject *parent)
   : QObject(parent)
   , m_textDocument(new QTextDocument(this))
+  , m_textLoader(new DeclarativeTextDocumentLoader(this))
+  , m_textSaver(new DeclarativeTextDocumentSaver(this))
   , m_settings(new SettingsAdaptor(this))
 {
+  m_textLoader->setDocument(m_textDocument);
+
+  m_textSaver->setDocument(m_textDocument);
+  connect(m_textSaver, SIGNAL(failed(QString)), SLOT(saveTextFailed(QString)));
 }
 
 QString ConfigEditor::fileName() const
@@ -83,14 +90,17 @@ void ConfigEditor::openFile(const QString &fileName)
 
 void ConfigEditor::saveText()
 {
-  QFile file(m_fileName);
-  if (!file.open(QIODevice::WriteOnly)) {
-    qWarning() << "Failed to open" << m_fileName << "for writing";
+  if (m_textLoader->isLoading()) {
+    qWarning() << m_fileName << "is still being loaded";
     return;
   }
 
-  QTextStream stream(&file);
-  stream << m_textDocument->toPlainText();
+  m_textSaver->save(m_fileName);
+}
+
+void ConfigEditor::saveTextFailed(const QString &errorString)
+{
+  qWarning() << "Failed to save" << m_fileName << ":" << errorString;
 }
 
 void ConfigEditor::saveSettings()
@@ -130,15 +140,10 @@ void ConfigEditor::setEditorQml(const QUrl &qmlUrl)
 
 void ConfigEditor::loadAsText()
 {
-  QFile file(m_fileName);
-  if (!file.open(QIODevice::ReadOnly)) {
+  if (!m_textLoader->load(m_fileName)) {
     qWarning() << "Failed to open" << m_fileName << "for reading";
     m_textDocument->clear();
-    return;
   }
-
-  QTextStream stream(&file);
-  m_textDocument->setPlainText(stream.readAll());
 }
 
 void ConfigEditor::loadAsSettings(const QUrl &customEditorQml)
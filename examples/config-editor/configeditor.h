@@ -33,6 +33,8 @@
 #include <QTextDocument>
 #include <QUrl>
 
+class DeclarativeTextDocumentLoader;
+class DeclarativeTextDocumentSaver;
 class SettingsAdaptor;
 
 QT_BEGIN_NAMESPACE
@@ -69,10 +71,15 @@ class ConfigEditor : public QObject
     void editorQmlChanged();
     void requestUpdateOnSave();
 
+  private Q_SLOTS:
+    void saveTextFailed(const QString &errorString);
+
   private:
     QString m_fileName;
     QUrl m_editorQml;
     QTextDocument *m_textDocument;
+    DeclarativeTextDocumentLoader *m_textLoader;
+    DeclarativeTextDocumentSaver *m_textSaver;
     SettingsAdaptor *m_settings;
 
   private:
@@ -96,6 +96,30 @@ MainWindow {
             document: _editor.textDocument;
         }
 
+        SyntaxHighlighter {
+            document: _editor.textDocument
+
+            HighlightRule {
+                pattern: "^\\s*\\[[^\\]]*\\]"
+                color: "darkblue"
+                bold: true
+            }
+            HighlightRule {
+                pattern: "^\\s*[;#].*$"
+                color: "gray"
+                italic: true
+            }
+            HighlightRule {
+                pattern: "^[^=]+(?==)"
+                color: "darkmagenta"
+            }
+            HighlightRule {
+                pattern: "\\b(true|false|yes|no|on|off)\\b"
+                caseSensitive: false
+                color: "darkgreen"
+            }
+        }
+
         LoaderWidget {
             id: customEditorLoader
 
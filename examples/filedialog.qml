@@ -76,5 +76,13 @@ Widget {
         console.log("FileDialog.getSaveFileName returned " + file)
       }
     }
+    PushButton {
+      text: "FileDialog::getOpenFileNameAsync"
+      onClicked: {
+        FileDialog.getOpenFileNameAsync(function(file, accepted) {
+          console.log("FileDialog.getOpenFileNameAsync returned " + file + ", accepted " + accepted)
+        })
+      }
+    }
   }
 }
@@ -27,22 +27,33 @@
 
 #include "editor.h"
 
-#include <QFile>
+#include "declarativetextdocumentloader.h"
+#include "declarativetextdocumentsaver.h"
+
 #include <QTextDocument>
-#include <QTextStream>
 
 Editor::Editor(QObject *parent)
   : QObject(parent)
   , m_document(new QTextDocument)
+  , m_loader(new DeclarativeTextDocumentLoader(this))
+  , m_saver(new DeclarativeTextDocumentSaver(this))
   , m_undoAvailable(false)
   , m_redoAvailable(false)
 {
   connect(m_document, SIGNAL(undoAvailable(bool)), SLOT(undoAvailable(bool)));
   connect(m_document, SIGNAL(redoAvailable(bool)), SLOT(redoAvailable(bool)));
+
+  m_loader->setDocument(m_document);
+  connect(m_loader, SIGNAL(failed(QString)), SLOT(loadFailed()));
+
+  m_saver->setDocument(m_document);
+  connect(m_saver, SIGNAL(saved(QString)), SLOT(saveDone(QString)));
+  connect(m_saver, SIGNAL(failed(QString)), SIGNAL(requestSaveFileName()));
 }
 
 Editor::~Editor()
 {
+  m_loader->cancel();
   delete m_document;
 }
 
@@ -77,6 +88,8 @@ QString Editor::fileName() const
 
 void Editor::newDocument()
 {
+  m_loader->cancel();
+
   m_fileName = QString();
   m_document->clear();
   m_document->setModified(false);
@@ -87,15 +100,9 @@ void Editor::open(const QString &fileName)
   if (fileName.isEmpty())
     return;
 
-  QFile file(fileName);
-  if (!file.open(QIODevice::ReadOnly)) {
-    emit critical(tr("File %1 can not be read").arg(fileName));
+  // the loader fills the document in chunks while the UI stays responsive
+  if (!m_loader->load(fileName))
     return;
-  }
-
-  QTextStream stream(&file);
-  m_document->setPlainText(stream.readAll());
-  m_document->setModified(false);
 
   setFileName(fileName);
 }
@@ -107,18 +114,13 @@ void Editor::save()
     return;
   }
 
-  QFile file(m_fileName);
-  if (!file.open(QIODevice::WriteOnly)) {
-    emit requestSaveFileName();
+  if (m_loader->isLoading()) {
+    emit information(tr("File %1 is still being loaded").arg(m_fileName));
     return;
   }
 
-  QTextStream stream(&file);
-  stream << m_document->toPlainText();
-  file.close();
-
-  m_document->setModified(false);
-  emit information(tr("File %1 successfully saved").arg(m_fileName));
+  // written on a worker thread, the document is marked as saved once the file has been replaced
+  m_saver->save(m_fileName);
 }
 
 void Editor::undoAvailable(bool available)
@@ -138,3 +140,13 @@ void Editor::redoAvailable(bool available)
   m_redoAvailable = available;
   emit redoAvailableChanged();
 }
+
+void Editor::loadFailed()
+{
+  emit critical(tr("File %1 can not be read").arg(m_loader->fileName()));
+}
+
+void Editor::saveDone(const QString &fileName)
+{
+  emit information(tr("File %1 successfully saved").arg(fileName));
+}
@@ -30,6 +30,9 @@
 
 #include <QObject>
 
+class DeclarativeTextDocumentLoader;
+class DeclarativeTextDocumentSaver;
+
 QT_BEGIN_NAMESPACE
 class QTextDocument;
 QT_END_NAMESPACE
@@ -72,9 +75,13 @@ class Editor : public QObject
   private Q_SLOTS:
     void undoAvailable(bool);
     void redoAvailable(bool);
+    void loadFailed();
+    void saveDone(const QString &fileName);
 
   private:
     QTextDocument *m_document;
+    DeclarativeTextDocumentLoader *m_loader;
+    DeclarativeTextDocumentSaver *m_saver;
     QString m_fileName;
     bool m_undoAvailable;
     bool m_redoAvailable;
@@ -43,16 +43,23 @@
 #include "declarativeicon_p.h"
 #include "declarativeinputdialog_p.h"
 #include "declarativeitemviewextension_p.h"
+#include "declarativelazytreemodel_p.h"
 #include "declarativemessagebox_p.h"
+#include "declarativepreloader_p.h"
 #include "declarativeqmlcontext_p.h"
 #include "declarativequickwidgetextension_p.h"
+#include "declarativerepeater_p.h"
 #include "declarativeseparator_p.h"
 #include "declarativestackedlayout_p.h"
 #include "declarativestatusbar_p.h"
 #include "declarativestringlistmodelextension_p.h"
+#include "declarativesyntaxhighlighter_p.h"
 #include "declarativetableviewextension_p.h"
 #include "declarativetabstops_p.h"
 #include "declarativetabwidget_p.h"
+#include "declarativetextdocumentbuilder_p.h"
+#include "declarativetextdocumentloader.h"
+#include "declarativetextdocumentsaver.h"
 #include "declarativetexteditextension_p.h"
 #include "declarativetreeviewextension_p.h"
 #include "declarativevboxlayout_p.h"
@@ -125,12 +132,20 @@ void ExtensionpluginPlugin::registerTypes(const char *uri)
   qmlRegisterExtendedType<DeclarativeAction, DeclarativeObjectExtension>(uri, 1, 0, "Action");
   qmlRegisterExtendedType<DeclarativeActionItem, DeclarativeObjectExtension>(uri, 1, 0, "ActionItem");
   qmlRegisterExtendedType<QButtonGroup, DeclarativeButtonGroupExtension>(uri, 1, 0, "ButtonGroup");
+  qmlRegisterType<DeclarativeHighlightRule>(uri, 1, 0, "HighlightRule");
   qmlRegisterType<DeclarativeQmlContextProperty>(uri, 1, 0, "QmlContextProperty");
   qmlRegisterType<DeclarativeQmlContext>(uri, 1, 0, "QmlContext");
   qmlRegisterExtendedType<QFileSystemModel, DeclarativeFileSystemModelExtension>(uri, 1, 0, "FileSystemModel");
   qmlRegisterType<DeclarativeIcon>(uri, 1, 0, "Icon");
+  qmlRegisterType<DeclarativeLazyTreeModel>(uri, 1, 0, "LazyTreeModel");
+  qmlRegisterType<DeclarativePreloader>(uri, 1, 0, "Preloader");
+  qmlRegisterType<DeclarativeRepeater>(uri, 1, 0, "Repeater");
   qmlRegisterExtendedType<DeclarativeSeparator, DeclarativeObjectExtension>(uri, 1, 0, "Separator");
+  qmlRegisterType<DeclarativeSyntaxHighlighter>(uri, 1, 0, "SyntaxHighlighter");
   qmlRegisterType<DeclarativeTabStops>("QtWidgets", 1, 0, "TabStops");
+  qmlRegisterType<DeclarativeTextDocumentBuilder>(uri, 1, 0, "TextDocumentBuilder");
+  qmlRegisterType<DeclarativeTextDocumentLoader>(uri, 1, 0, "TextDocumentLoader");
+  qmlRegisterType<DeclarativeTextDocumentSaver>(uri, 1, 0, "TextDocumentSaver");
 
   // layouts
   qmlRegisterExtendedType<DeclarativeFormLayout, DeclarativeFormLayoutExtension>(uri, 1, 0, "FormLayout");
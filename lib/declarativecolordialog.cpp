@@ -94,6 +94,26 @@ QColor DeclarativeColorDialogAttached::getColor(const QColor &initialColor)
     return QColorDialog::getColor(initialColor, parent);
 }
 
+void DeclarativeColorDialogAttached::getColorAsync(const QJSValue &callback)
+{
+  getColorAsync(Qt::white, callback);
+}
+
+void DeclarativeColorDialogAttached::getColorAsync(const QColor &initialColor, const QJSValue &callback)
+{
+  QColorDialog *dialog = new QColorDialog(initialColor, bestParentWindow());
+  if (!d->title.isEmpty())
+    dialog->setWindowTitle(d->title);
+  dialog->setOptions(d->options);
+
+  openDialog(dialog, callback);
+}
+
+QVariant DeclarativeColorDialogAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  return *accepted ? static_cast<QColorDialog*>(dialog)->selectedColor() : QColor();
+}
+
 Q_DECLARE_METATYPE(Qt::WindowFlags)
 
 DeclarativeColorDialog::DeclarativeColorDialog(QWidget *parent) : QColorDialog(parent)
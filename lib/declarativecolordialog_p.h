@@ -54,10 +54,17 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeColorDialogAttached : public StaticDi
     Q_INVOKABLE QColor getColor();
     Q_INVOKABLE QColor getColor(const QColor &initialColor);
 
+    // non-blocking variants, the callback gets the color, invalid if canceled, and whether the dialog was accepted
+    Q_INVOKABLE void getColorAsync(const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void getColorAsync(const QColor &initialColor, const QJSValue &callback);
+
   Q_SIGNALS:
     void titleChanged(const QString &title);
     void optionsChanged(int options);
 
+  protected:
+    QVariant dialogResult(QDialog *dialog, bool *accepted);
+
   private:
     class Private;
     Private *const d;
@@ -27,13 +27,226 @@
 
 #include "declarativecomboboxextension_p.h"
 
+#include <QAbstractProxyModel>
 #include <QComboBox>
+#include <QCompleter>
+#include <QFutureWatcher>
+#include <QLineEdit>
+#include <QListView>
+#include <QPointer>
+#include <QtConcurrent>
+
+#include <algorithm>
+#include <numeric>
+
+// changes to more rows than this are answered with a full rebuild of the index
+static const int s_incrementalUpdateLimit = 64;
+
+static QVector<int> sortedRows(const QStringList &texts)
+{
+  QVector<int> rows(texts.count());
+  std::iota(rows.begin(), rows.end(), 0);
+
+  std::stable_sort(rows.begin(), rows.end(), [&texts](int left, int right) {
+    return QString::compare(texts.at(left), texts.at(right), Qt::CaseInsensitive) < 0;
+  });
+
+  return rows;
+}
+
+// Presents the rows of the combobox model sorted case insensitively, so that
+// QCompleter can use a binary search instead of scanning all of them.
+// Being a proxy of the combobox model lets QComboBox map completions back to its rows.
+class ComboBoxPrefixIndexModel : public QAbstractProxyModel
+{
+  public:
+    explicit ComboBoxPrefixIndexModel(QObject *parent)
+      : QAbstractProxyModel(parent)
+      , column(0)
+    {}
+
+    QString textAt(int sourceRow) const
+    {
+      return sourceModel()->index(sourceRow, column, root).data(Qt::DisplayRole).toString();
+    }
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const
+    {
+      if (!sourceModel() || !proxyIndex.isValid() || proxyIndex.row() >= sourceRows.count())
+        return QModelIndex();
+
+      return sourceModel()->index(sourceRows.at(proxyIndex.row()), column, root);
+    }
+
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const
+    {
+      if (!sourceIndex.isValid() || sourceIndex.parent() != root)
+        return QModelIndex();
+
+      const int row = proxyRows.value(sourceIndex.row(), -1);
+      return row < 0 ? QModelIndex() : createIndex(row, 0);
+    }
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const
+    {
+      if (parent.isValid() || column != 0 || row < 0 || row >= sourceRows.count())
+        return QModelIndex();
+
+      return createIndex(row, column);
+    }
+
+    QModelIndex parent(const QModelIndex &child) const
+    {
+      Q_UNUSED(child);
+      return QModelIndex();
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const
+    {
+      return parent.isValid() ? 0 : sourceRows.count();
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const
+    {
+      return parent.isValid() ? 0 : 1;
+    }
+
+    // rows is a permutation of the source rows, or empty while the index is being built
+    void setSourceRows(const QVector<int> &rows)
+    {
+      beginResetModel();
+      sourceRows = rows;
+      proxyRows.fill(-1, rows.count());
+      updateProxyRows(0);
+      endResetModel();
+    }
+
+    void insertSourceRows(int first, int last)
+    {
+      const int count = last - first + 1;
+      for (int i = 0; i < sourceRows.count(); ++i) {
+        if (sourceRows.at(i) >= first)
+          sourceRows[i] += count;
+      }
+
+      if (proxyRows.count() < first)
+        growProxyRows(first);
+      proxyRows.insert(first, count, -1);
+
+      for (int row = first; row <= last; ++row)
+        insertSourceRow(row);
+    }
+
+    void removeSourceRows(int first, int last)
+    {
+      for (int row = first; row <= last; ++row)
+        removeSourceRow(row);
+
+      const int count = last - first + 1;
+      for (int i = 0; i < sourceRows.count(); ++i) {
+        if (sourceRows.at(i) > last)
+          sourceRows[i] -= count;
+      }
+
+      if (first < proxyRows.count())
+        proxyRows.remove(first, qMin(count, proxyRows.count() - first));
+    }
+
+    void updateSourceRows(int first, int last)
+    {
+      for (int row = first; row <= last; ++row) {
+        removeSourceRow(row);
+        insertSourceRow(row);
+      }
+    }
+
+    int column;
+    QPersistentModelIndex root;
+    QVector<int> sourceRows;
+    // position of each source row in sourceRows, -1 for rows that are not indexed
+    QVector<int> proxyRows;
+
+  private:
+    void growProxyRows(int count)
+    {
+      const int oldCount = proxyRows.count();
+      proxyRows.resize(count);
+      std::fill(proxyRows.begin() + oldCount, proxyRows.end(), -1);
+    }
+
+    void updateProxyRows(int first)
+    {
+      for (int i = first; i < sourceRows.count(); ++i)
+        proxyRows[sourceRows.at(i)] = i;
+    }
+
+    void removeSourceRow(int row)
+    {
+      const int i = proxyRows.value(row, -1);
+      if (i < 0)
+        return;
+
+      beginRemoveRows(QModelIndex(), i, i);
+      sourceRows.remove(i);
+      proxyRows[row] = -1;
+      updateProxyRows(i);
+      endRemoveRows();
+    }
+
+    void insertSourceRow(int row)
+    {
+      const QString text = textAt(row);
+
+      const QVector<int>::iterator it = std::upper_bound(sourceRows.begin(), sourceRows.end(), text,
+                                                         [this](const QString &text, int sourceRow) {
+        return QString::compare(text, textAt(sourceRow), Qt::CaseInsensitive) < 0;
+      });
+      const int position = it - sourceRows.begin();
+
+      if (proxyRows.count() <= row)
+        growProxyRows(row + 1);
+
+      beginInsertRows(QModelIndex(), position, position);
+      sourceRows.insert(position, row);
+      updateProxyRows(position);
+      endInsertRows();
+    }
+};
+
+class DeclarativeComboBoxExtension::Private
+{
+  public:
+    Private()
+      : largeModel(false)
+      , indexing(false)
+      , prefixIndex(0)
+      , completer(0)
+      , indexWatcher(0)
+      , sizeAdjustPolicy(QComboBox::AdjustToContentsOnFirstShow)
+    {}
+
+    bool largeModel;
+    bool indexing;
+
+    ComboBoxPrefixIndexModel *prefixIndex;
+    QCompleter *completer;
+    QFutureWatcher<QVector<int> > *indexWatcher;
+    QPointer<QAbstractItemModel> indexedModel;
+
+    QComboBox::SizeAdjustPolicy sizeAdjustPolicy;
+};
 
 DeclarativeComboBoxExtension::DeclarativeComboBoxExtension(QObject *parent)
   : DeclarativeWidgetExtension(parent)
+  , d(new Private)
 {
 }
 
+DeclarativeComboBoxExtension::~DeclarativeComboBoxExtension()
+{
+  delete d;
+}
+
 QComboBox *DeclarativeComboBoxExtension::extendedComboBox() const
 {
   QComboBox *comboBox = qobject_cast<QComboBox*>(extendedWidget());
@@ -41,7 +254,6 @@ QComboBox *DeclarativeComboBoxExtension::extendedComboBox() const
 
   return comboBox;
 }
-#include <QDebug>
 void DeclarativeComboBoxExtension::setModel(QAbstractItemModel *model)
 {
   QComboBox *comboBox = extendedComboBox();
@@ -51,6 +263,16 @@ void DeclarativeComboBoxExtension::setModel(QAbstractItemModel *model)
 
   comboBox->setModel(model);
 
+  if (d->largeModel) {
+    // QComboBox::setModel() may point the completer of its line edit at the new model,
+    // which is not sorted the way the completer has been told
+    if (d->completer->model() != d->prefixIndex)
+      d->completer->setModel(d->prefixIndex);
+
+    rebuildIndex();
+    installCompleter();
+  }
+
   emit modelChanged();
 }
 
@@ -58,3 +280,208 @@ QAbstractItemModel *DeclarativeComboBoxExtension::model() const
 {
   return extendedComboBox()->model();
 }
+
+void DeclarativeComboBoxExtension::setLargeModel(bool enable)
+{
+  if (d->largeModel == enable)
+    return;
+
+  d->largeModel = enable;
+
+  QComboBox *comboBox = extendedComboBox();
+  QListView *listView = qobject_cast<QListView*>(comboBox->view());
+
+  if (enable) {
+    // neither the size hint nor the popup should look at every row
+    d->sizeAdjustPolicy = comboBox->sizeAdjustPolicy();
+    comboBox->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
+
+    if (listView) {
+      listView->setUniformItemSizes(true);
+      listView->setLayoutMode(QListView::Batched);
+    }
+
+    if (!d->prefixIndex) {
+      d->prefixIndex = new ComboBoxPrefixIndexModel(this);
+
+      d->completer = new QCompleter(this);
+      d->completer->setModel(d->prefixIndex);
+      d->completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
+      d->completer->setCaseSensitivity(Qt::CaseInsensitive);
+      d->completer->setCompletionMode(QCompleter::InlineCompletion);
+      d->completer->setCompletionRole(Qt::DisplayRole);
+
+      d->indexWatcher = new QFutureWatcher<QVector<int> >(this);
+      connect(d->indexWatcher, SIGNAL(finished()), this, SLOT(onIndexBuilt()));
+    }
+
+    rebuildIndex();
+    installCompleter();
+  } else {
+    comboBox->setSizeAdjustPolicy(d->sizeAdjustPolicy);
+
+    if (listView) {
+      listView->setUniformItemSizes(false);
+      listView->setLayoutMode(QListView::SinglePass);
+    }
+
+    if (d->indexedModel)
+      disconnect(d->indexedModel, 0, this, 0);
+    d->indexedModel = 0;
+
+    d->indexWatcher->cancel();
+    d->prefixIndex->setSourceModel(0);
+
+    if (comboBox->lineEdit() && comboBox->completer() == d->completer) {
+      // what QComboBox sets up for an editable combobox
+      QCompleter *completer = new QCompleter(comboBox->model(), comboBox->lineEdit());
+      completer->setCaseSensitivity(Qt::CaseInsensitive);
+      completer->setCompletionMode(QCompleter::InlineCompletion);
+      completer->setCompletionColumn(comboBox->modelColumn());
+      comboBox->setCompleter(completer);
+    }
+
+    if (d->indexing) {
+      d->indexing = false;
+      emit indexingChanged(false);
+    }
+  }
+
+  emit largeModelChanged(enable);
+}
+
+bool DeclarativeComboBoxExtension::largeModel() const
+{
+  return d->largeModel;
+}
+
+bool DeclarativeComboBoxExtension::isIndexing() const
+{
+  return d->indexing;
+}
+
+bool DeclarativeComboBoxExtension::eventFilter(QObject *watched, QEvent *event)
+{
+  // setEditable() creates a line edit together with a default completer
+  if (d->largeModel && event->type() == QEvent::ChildAdded &&
+      qobject_cast<QLineEdit*>(static_cast<QChildEvent*>(event)->child())) {
+    QMetaObject::invokeMethod(this, "installCompleter", Qt::QueuedConnection);
+  }
+
+  return DeclarativeWidgetExtension::eventFilter(watched, event);
+}
+
+void DeclarativeComboBoxExtension::rebuildIndex()
+{
+  if (!d->largeModel)
+    return;
+
+  QComboBox *comboBox = extendedComboBox();
+  QAbstractItemModel *model = comboBox->model();
+
+  d->prefixIndex->setSourceRows(QVector<int>());
+
+  if (d->indexedModel != model) {
+    if (d->indexedModel)
+      disconnect(d->indexedModel, 0, this, 0);
+
+    d->indexedModel = model;
+    d->prefixIndex->setSourceModel(model);
+
+    if (model) {
+      connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(onRowsInserted(QModelIndex,int,int)));
+      connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), this, SLOT(onRowsAboutToBeRemoved(QModelIndex,int,int)));
+      connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(onDataChanged(QModelIndex,QModelIndex)));
+      connect(model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(rebuildIndex()));
+      connect(model, SIGNAL(layoutChanged()), this, SLOT(rebuildIndex()));
+      connect(model, SIGNAL(modelReset()), this, SLOT(rebuildIndex()));
+    }
+  }
+
+  d->prefixIndex->column = comboBox->modelColumn();
+  d->prefixIndex->root = comboBox->rootModelIndex();
+
+  if (!model)
+    return;
+
+  // models are not thread safe, only the texts travel to the worker
+  QStringList texts;
+  const int rowCount = model->rowCount(comboBox->rootModelIndex());
+  texts.reserve(rowCount);
+  for (int row = 0; row < rowCount; ++row)
+    texts << d->prefixIndex->textAt(row);
+
+  d->indexWatcher->setFuture(QtConcurrent::run(sortedRows, texts));
+
+  if (!d->indexing) {
+    d->indexing = true;
+    emit indexingChanged(true);
+  }
+}
+
+void DeclarativeComboBoxExtension::onIndexBuilt()
+{
+  if (d->indexWatcher->isCanceled())
+    return;
+
+  d->prefixIndex->setSourceRows(d->indexWatcher->result());
+
+  d->indexing = false;
+  emit indexingChanged(false);
+}
+
+void DeclarativeComboBoxExtension::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+  if (parent != extendedComboBox()->rootModelIndex())
+    return;
+
+  if (d->indexing || last - first >= s_incrementalUpdateLimit)
+    rebuildIndex();
+  else
+    d->prefixIndex->insertSourceRows(first, last);
+}
+
+void DeclarativeComboBoxExtension::onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+{
+  if (parent != extendedComboBox()->rootModelIndex())
+    return;
+
+  if (d->indexing || last - first >= s_incrementalUpdateLimit) {
+    // the rows are still there, index what remains once they are gone
+    d->indexWatcher->cancel();
+    d->prefixIndex->setSourceRows(QVector<int>());
+    QMetaObject::invokeMethod(this, "rebuildIndex", Qt::QueuedConnection);
+
+    // changes until then are covered by that rebuild
+    if (!d->indexing) {
+      d->indexing = true;
+      emit indexingChanged(true);
+    }
+  } else {
+    d->prefixIndex->removeSourceRows(first, last);
+  }
+}
+
+void DeclarativeComboBoxExtension::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+  if (topLeft.parent() != extendedComboBox()->rootModelIndex())
+    return;
+
+  const int column = d->prefixIndex->column;
+  if (column < topLeft.column() || column > bottomRight.column())
+    return;
+
+  if (d->indexing || bottomRight.row() - topLeft.row() >= s_incrementalUpdateLimit)
+    rebuildIndex();
+  else
+    d->prefixIndex->updateSourceRows(topLeft.row(), bottomRight.row());
+}
+
+void DeclarativeComboBoxExtension::installCompleter()
+{
+  QComboBox *comboBox = extendedComboBox();
+  if (!d->largeModel || !comboBox->lineEdit() || comboBox->completer() == d->completer)
+    return;
+
+  comboBox->setCompleter(d->completer);
+}
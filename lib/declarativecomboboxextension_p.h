@@ -32,6 +32,8 @@
 #include "declarativewidgets_export.h"
 #include "declarativewidgetextension.h"
 
+#include <QModelIndex>
+
 QT_BEGIN_NAMESPACE
 class QComboBox;
 class QAbstractItemModel;
@@ -42,6 +44,8 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeComboBoxExtension : public Declarativ
   Q_OBJECT
 
   Q_PROPERTY(QAbstractItemModel* model READ model WRITE setModel NOTIFY modelChanged)
+  Q_PROPERTY(bool largeModel READ largeModel WRITE setLargeModel NOTIFY largeModelChanged)
+  Q_PROPERTY(bool indexing READ isIndexing NOTIFY indexingChanged)
 
   // repeat property declarations, qmlRegisterExtendedType doesn't see the ones from base class
   Q_PROPERTY(QQmlListProperty<QObject> data READ data DESIGNABLE false)
@@ -50,14 +54,38 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeComboBoxExtension : public Declarativ
 
   public:
     explicit DeclarativeComboBoxExtension(QObject *parent = 0);
+    ~DeclarativeComboBoxExtension();
 
     QComboBox *extendedComboBox() const;
 
     void setModel(QAbstractItemModel *model);
     QAbstractItemModel *model() const;
 
+    // popup rows are assumed to share one height and completion searches
+    // a sorted index that is built on a worker thread
+    void setLargeModel(bool enable);
+    bool largeModel() const;
+
+    bool isIndexing() const;
+
+    bool eventFilter(QObject *watched, QEvent *event);
+
   Q_SIGNALS:
     void modelChanged();
+    void largeModelChanged(bool enable);
+    void indexingChanged(bool indexing);
+
+  private Q_SLOTS:
+    void rebuildIndex();
+    void onIndexBuilt();
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void installCompleter();
+
+  private:
+    class Private;
+    Private *const d;
 };
 
 #endif
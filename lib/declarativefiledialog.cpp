@@ -155,6 +155,55 @@ QString DeclarativeFileDialogAttached::getSaveFileName()
   return retVal;
 }
 
+void DeclarativeFileDialogAttached::getExistingDirectoryAsync(const QJSValue &callback)
+{
+  openDialog(createDialog(QFileDialog::Directory, QFileDialog::ShowDirsOnly), callback);
+}
+
+void DeclarativeFileDialogAttached::getOpenFileNameAsync(const QJSValue &callback)
+{
+  openDialog(createDialog(QFileDialog::ExistingFile), callback);
+}
+
+void DeclarativeFileDialogAttached::getOpenFileNamesAsync(const QJSValue &callback)
+{
+  openDialog(createDialog(QFileDialog::ExistingFiles), callback);
+}
+
+void DeclarativeFileDialogAttached::getSaveFileNameAsync(const QJSValue &callback)
+{
+  QFileDialog *dialog = createDialog(QFileDialog::AnyFile);
+  dialog->setAcceptMode(QFileDialog::AcceptSave);
+
+  openDialog(dialog, callback);
+}
+
+QVariant DeclarativeFileDialogAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  QFileDialog *fileDialog = static_cast<QFileDialog*>(dialog);
+
+  if (*accepted && fileDialog->fileMode() != QFileDialog::Directory)
+    setSelectedFilter(fileDialog->selectedNameFilter());
+
+  if (fileDialog->fileMode() == QFileDialog::ExistingFiles)
+    return *accepted ? fileDialog->selectedFiles() : QStringList();
+
+  return *accepted ? fileDialog->selectedFiles().value(0) : QString();
+}
+
+QFileDialog *DeclarativeFileDialogAttached::createDialog(QFileDialog::FileMode fileMode, QFileDialog::Options defaultOptions) const
+{
+  const QFileDialog::Options options = (d->options < 0 ? defaultOptions : static_cast<QFileDialog::Options>(d->options));
+
+  QFileDialog *dialog = new QFileDialog(bestParentWindow(), d->caption, d->dir);
+  dialog->setFileMode(fileMode);
+  dialog->setOptions(options);
+  if (fileMode != QFileDialog::Directory)
+    dialog->setNameFilters(d->nameFilters);
+
+  return dialog;
+}
+
 void DeclarativeFileDialogAttached::setSelectedFilter(const QString &filter)
 {
   if (filter == d->selectedFilter)
@@ -70,6 +70,15 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeFileDialogAttached : public StaticDia
 
     Q_INVOKABLE QString getSaveFileName();
 
+    // non-blocking variants, the callback gets the selection and whether the dialog was accepted
+    Q_INVOKABLE void getExistingDirectoryAsync(const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getOpenFileNameAsync(const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getOpenFileNamesAsync(const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getSaveFileNameAsync(const QJSValue &callback = QJSValue());
+
   Q_SIGNALS:
     void captionChanged(const QString &caption);
     void dirChanged(const QString &dir);
@@ -77,8 +86,12 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeFileDialogAttached : public StaticDia
     void optionsChanged(int options);
     void selectedFilterChanged(const QString &filter);
 
+  protected:
+    QVariant dialogResult(QDialog *dialog, bool *accepted);
+
   private:
     void setSelectedFilter(const QString &filter);
+    QFileDialog *createDialog(QFileDialog::FileMode fileMode, QFileDialog::Options defaultOptions = 0) const;
 
     class Private;
     Private *const d;
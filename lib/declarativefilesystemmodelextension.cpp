@@ -27,12 +27,71 @@
 
 #include "declarativefilesystemmodelextension_p.h"
 
+#include "filesystempopulationproxymodel_p.h"
+
 #include <QFileSystemModel>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QQmlInfo>
+#include <QSet>
+#include <QTimer>
+
+// directoryLoaded() reports clean absolute paths, whatever form the root path had
+static QString loadingKey(const QString &path)
+{
+  return QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+}
+
+class DeclarativeFileSystemModelExtension::Private
+{
+  public:
+    Private()
+      : proxyModel(0)
+      , populationTimer(0)
+      , rootPathPending(false)
+      , watchForChanges(true)
+      , batchSize(0)
+      , loading(false)
+      , loadedCount(0)
+      , totalCount(0)
+    {}
+
+    FileSystemPopulationProxyModel *proxyModel;
+    QTimer *populationTimer;
+
+    QString pendingRootPath;
+    bool rootPathPending;
+    bool watchForChanges;
+    int batchSize;
+
+    bool loading;
+    QSet<QString> loadingPaths;
+    QSet<QString> loadedPaths;
+    int loadedCount;
+    int totalCount;
+};
 
 DeclarativeFileSystemModelExtension::DeclarativeFileSystemModelExtension(QObject *parent)
   : DeclarativeObjectExtension(parent)
+  , d(new Private)
+{
+  QFileSystemModel *model = extendedModel();
+
+  d->proxyModel = new FileSystemPopulationProxyModel(model, this);
+
+  d->populationTimer = new QTimer(this);
+  d->populationTimer->setInterval(50);
+  connect(d->populationTimer, SIGNAL(timeout()), this, SLOT(releaseBatch()));
+
+  connect(model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)), this, SLOT(onRowsAboutToBeInserted(QModelIndex)));
+  connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(onRowsInserted(QModelIndex,int,int)));
+  connect(model, SIGNAL(directoryLoaded(QString)), this, SLOT(onDirectoryLoaded(QString)));
+}
+
+DeclarativeFileSystemModelExtension::~DeclarativeFileSystemModelExtension()
 {
+  delete d;
 }
 
 QFileSystemModel *DeclarativeFileSystemModelExtension::extendedModel() const
@@ -46,16 +105,216 @@ QFileSystemModel *DeclarativeFileSystemModelExtension::extendedModel() const
 void DeclarativeFileSystemModelExtension::setRootPath(const QString &path)
 {
   // TODO: for whatever reason QFileSystemModel does not emit its rootPathChanged() signal
-  QFileSystemModel *model = extendedModel();
-  if (model->rootPath() == path)
+  if (rootPath() == path)
     return;
 
-  model->setRootPath(path);
+  // applied delayed so that filters and options set in the same declaration are
+  // in effect before the directory gets populated the first time
+  if (!d->rootPathPending)
+    QMetaObject::invokeMethod(this, "applyRootPath", Qt::QueuedConnection);
+
+  d->pendingRootPath = path;
+  d->rootPathPending = true;
 
   emit rootPathChanged(path);
 }
 
 QString DeclarativeFileSystemModelExtension::rootPath() const
 {
+  if (d->rootPathPending)
+    return d->pendingRootPath;
+
   return extendedModel()->rootPath();
 }
+
+void DeclarativeFileSystemModelExtension::setNameFilters(const QStringList &filters)
+{
+  QFileSystemModel *model = extendedModel();
+  if (model->nameFilters() == filters)
+    return;
+
+  model->setNameFilters(filters);
+
+  emit nameFiltersChanged(filters);
+}
+
+QStringList DeclarativeFileSystemModelExtension::nameFilters() const
+{
+  return extendedModel()->nameFilters();
+}
+
+void DeclarativeFileSystemModelExtension::setResolveSymlinks(bool enable)
+{
+  QFileSystemModel *model = extendedModel();
+  if (model->resolveSymlinks() == enable)
+    return;
+
+  model->setResolveSymlinks(enable);
+
+  emit resolveSymlinksChanged(enable);
+}
+
+bool DeclarativeFileSystemModelExtension::resolveSymlinks() const
+{
+  return extendedModel()->resolveSymlinks();
+}
+
+void DeclarativeFileSystemModelExtension::setWatchForChanges(bool enable)
+{
+  if (d->watchForChanges == enable)
+    return;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+  d->watchForChanges = enable;
+  extendedModel()->setOption(QFileSystemModel::DontWatchForChanges, !enable);
+
+  emit watchForChangesChanged(enable);
+#else
+  // older models always watch, so the property stays true
+  qmlInfo(extendedModel()) << "watchForChanges requires Qt 5.14 or newer";
+#endif
+}
+
+bool DeclarativeFileSystemModelExtension::watchForChanges() const
+{
+  return d->watchForChanges;
+}
+
+void DeclarativeFileSystemModelExtension::setPopulationBatchSize(int batchSize)
+{
+  batchSize = qMax(0, batchSize);
+  if (d->batchSize == batchSize)
+    return;
+
+  d->batchSize = batchSize;
+  d->proxyModel->setBatchSize(batchSize);
+
+  if (batchSize == 0) {
+    d->populationTimer->stop();
+    d->loadedCount = d->totalCount;
+    emit progressChanged(d->loadedCount, d->totalCount);
+    updateLoading();
+  }
+
+  emit populationBatchSizeChanged(batchSize);
+}
+
+int DeclarativeFileSystemModelExtension::populationBatchSize() const
+{
+  return d->batchSize;
+}
+
+void DeclarativeFileSystemModelExtension::setPopulationInterval(int interval)
+{
+  if (d->populationTimer->interval() == interval)
+    return;
+
+  d->populationTimer->setInterval(interval);
+
+  emit populationIntervalChanged(interval);
+}
+
+int DeclarativeFileSystemModelExtension::populationInterval() const
+{
+  return d->populationTimer->interval();
+}
+
+QAbstractItemModel *DeclarativeFileSystemModelExtension::throttledModel() const
+{
+  return d->proxyModel;
+}
+
+bool DeclarativeFileSystemModelExtension::isLoading() const
+{
+  return d->loading;
+}
+
+int DeclarativeFileSystemModelExtension::loadedCount() const
+{
+  return d->loadedCount;
+}
+
+int DeclarativeFileSystemModelExtension::totalCount() const
+{
+  return d->totalCount;
+}
+
+void DeclarativeFileSystemModelExtension::applyRootPath()
+{
+  if (!d->rootPathPending)
+    return;
+
+  d->rootPathPending = false;
+
+  d->loadingPaths.clear();
+  d->loadedPaths.clear();
+  d->loadedCount = 0;
+  d->totalCount = 0;
+  emit progressChanged(d->loadedCount, d->totalCount);
+
+  // the model ignores paths that do not exist and loads nothing for the drives list
+  const QFileInfo rootInfo(d->pendingRootPath);
+  if (!d->pendingRootPath.isEmpty() && rootInfo.isDir())
+    d->loadingPaths.insert(loadingKey(d->pendingRootPath));
+  updateLoading();
+
+  extendedModel()->setRootPath(d->pendingRootPath);
+}
+
+void DeclarativeFileSystemModelExtension::onRowsAboutToBeInserted(const QModelIndex &parent)
+{
+  if (parent.isValid()) {
+    const QString path = loadingKey(extendedModel()->filePath(parent));
+    if (!d->loadedPaths.contains(path))
+      d->loadingPaths.insert(path);
+  }
+}
+
+void DeclarativeFileSystemModelExtension::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+  Q_UNUSED(parent);
+
+  d->totalCount += last - first + 1;
+
+  if (d->batchSize > 0) {
+    if (!d->populationTimer->isActive())
+      d->populationTimer->start();
+  } else {
+    d->loadedCount = d->totalCount;
+  }
+
+  emit progressChanged(d->loadedCount, d->totalCount);
+  updateLoading();
+}
+
+void DeclarativeFileSystemModelExtension::onDirectoryLoaded(const QString &path)
+{
+  const QString key = loadingKey(path);
+  d->loadingPaths.remove(key);
+  d->loadedPaths.insert(key);
+
+  updateLoading();
+}
+
+void DeclarativeFileSystemModelExtension::releaseBatch()
+{
+  d->loadedCount = qMin(d->totalCount, d->loadedCount + d->proxyModel->releaseBatch());
+
+  if (!d->proxyModel->hasPendingRows()) {
+    d->populationTimer->stop();
+    d->loadedCount = d->totalCount;
+  }
+
+  emit progressChanged(d->loadedCount, d->totalCount);
+  updateLoading();
+}
+
+void DeclarativeFileSystemModelExtension::updateLoading()
+{
+  const bool loading = !d->loadingPaths.isEmpty() || d->proxyModel->hasPendingRows();
+  if (loading == d->loading)
+    return;
+
+  d->loading = loading;
+  emit loadingChanged(loading);
+}
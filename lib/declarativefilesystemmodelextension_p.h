@@ -31,7 +31,11 @@
 #include "declarativewidgets_export.h"
 #include "declarativeobjectextension.h"
 
+#include <QModelIndex>
+#include <QStringList>
+
 QT_BEGIN_NAMESPACE
+class QAbstractItemModel;
 class QFileSystemModel;
 QT_END_NAMESPACE
 
@@ -42,20 +46,70 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeFileSystemModelExtension : public Dec
   // repeat property declarations, qmlRegisterExtendedType doesn't see the ones from base class
   Q_PROPERTY(QQmlListProperty<QObject> data READ data DESIGNABLE false)
   Q_PROPERTY(QString rootPath READ rootPath WRITE setRootPath NOTIFY rootPathChanged)
+  Q_PROPERTY(QStringList nameFilters READ nameFilters WRITE setNameFilters NOTIFY nameFiltersChanged)
+  Q_PROPERTY(bool resolveSymlinks READ resolveSymlinks WRITE setResolveSymlinks NOTIFY resolveSymlinksChanged)
+  Q_PROPERTY(bool watchForChanges READ watchForChanges WRITE setWatchForChanges NOTIFY watchForChangesChanged)
+  Q_PROPERTY(int populationBatchSize READ populationBatchSize WRITE setPopulationBatchSize NOTIFY populationBatchSizeChanged)
+  Q_PROPERTY(int populationInterval READ populationInterval WRITE setPopulationInterval NOTIFY populationIntervalChanged)
+  Q_PROPERTY(QAbstractItemModel* throttledModel READ throttledModel CONSTANT)
+  Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+  Q_PROPERTY(int loadedCount READ loadedCount NOTIFY progressChanged)
+  Q_PROPERTY(int totalCount READ totalCount NOTIFY progressChanged)
 
   Q_CLASSINFO("DefaultProperty", "data")
 
   public:
     explicit DeclarativeFileSystemModelExtension(QObject *parent = 0);
+    ~DeclarativeFileSystemModelExtension();
 
     QFileSystemModel *extendedModel() const;
 
     void setRootPath(const QString &path);
-
     QString rootPath() const;
 
+    void setNameFilters(const QStringList &filters);
+    QStringList nameFilters() const;
+
+    void setResolveSymlinks(bool enable);
+    bool resolveSymlinks() const;
+
+    void setWatchForChanges(bool enable);
+    bool watchForChanges() const;
+
+    void setPopulationBatchSize(int batchSize);
+    int populationBatchSize() const;
+
+    void setPopulationInterval(int interval);
+    int populationInterval() const;
+
+    QAbstractItemModel *throttledModel() const;
+
+    bool isLoading() const;
+    int loadedCount() const;
+    int totalCount() const;
+
   Q_SIGNALS:
     void rootPathChanged(const QString &rootPath);
+    void nameFiltersChanged(const QStringList &nameFilters);
+    void resolveSymlinksChanged(bool resolveSymlinks);
+    void watchForChangesChanged(bool watchForChanges);
+    void populationBatchSizeChanged(int batchSize);
+    void populationIntervalChanged(int interval);
+    void loadingChanged(bool loading);
+    void progressChanged(int loadedCount, int totalCount);
+
+  private Q_SLOTS:
+    void applyRootPath();
+    void onRowsAboutToBeInserted(const QModelIndex &parent);
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onDirectoryLoaded(const QString &path);
+    void releaseBatch();
+
+  private:
+    void updateLoading();
+
+    class Private;
+    Private *const d;
 };
 
 #endif // DECLARATIVEFILESYSTEMMODELEXTENSION_H
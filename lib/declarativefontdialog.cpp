@@ -108,6 +108,30 @@ QFont DeclarativeFontDialogAttached::getFont(const QString &fontFamily)
   return getFont();
 }
 
+void DeclarativeFontDialogAttached::getFontAsync(const QJSValue &callback)
+{
+  QFontDialog *dialog = new QFontDialog(d->initial, bestParentWindow());
+  if (!d->title.isEmpty())
+    dialog->setWindowTitle(d->title);
+  dialog->setOptions(d->options);
+
+  openDialog(dialog, callback);
+}
+
+void DeclarativeFontDialogAttached::getFontAsync(const QString &fontFamily, const QJSValue &callback)
+{
+  d->initial = QFont(fontFamily);
+  getFontAsync(callback);
+}
+
+QVariant DeclarativeFontDialogAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  setDialogAccepted(*accepted);
+
+  // like QFontDialog::getFont(), a canceled dialog yields the initial font
+  return *accepted ? static_cast<QFontDialog*>(dialog)->selectedFont() : d->initial;
+}
+
 void DeclarativeFontDialogAttached::setDialogAccepted(bool accepted)
 {
   if (accepted == d->dialogAccepted)
@@ -57,11 +57,18 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeFontDialogAttached : public StaticDia
     Q_INVOKABLE QFont getFont();
     Q_INVOKABLE QFont getFont(const QString &fontFamily);
 
+    // non-blocking variants, the callback gets the font and whether the dialog was accepted
+    Q_INVOKABLE void getFontAsync(const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void getFontAsync(const QString &fontFamily, const QJSValue &callback);
+
   Q_SIGNALS:
     void titleChanged(const QString &title);
     void dialogAcceptedChanged(bool accepted);
     void optionsChanged(int options);
 
+  protected:
+    QVariant dialogResult(QDialog *dialog, bool *accepted);
+
   private:
     void setDialogAccepted(bool accepted);
 
@@ -148,6 +148,8 @@ class FormLayoutContainer : public LayoutContainerInterface
     void addSpacer(DeclarativeSpacerItem *spacerItem);
     void addLayout(QLayout *layout);
     void addWidget(QWidget *widget);
+    void insertWidget(int index, QWidget *widget);
+    void removeWidget(QWidget *widget);
     void setContentsMargins(int left, int top, int right, int bottom);
     void getContentsMargins(int &left, int &top, int &right, int &bottom);
 
@@ -182,6 +184,11 @@ void FormLayoutContainer::addSpacer(DeclarativeSpacerItem *spacerItem)
 }
 
 void FormLayoutContainer::addWidget(QWidget *widget)
+{
+  insertWidget(-1, widget);
+}
+
+void FormLayoutContainer::insertWidget(int index, QWidget *widget)
 {
   QObject *attachedProperties = qmlAttachedPropertiesObject<DeclarativeFormLayout>(widget, false);
   DeclarativeFormLayoutAttached *properties = qobject_cast<DeclarativeFormLayoutAttached*>(attachedProperties);
@@ -189,12 +196,23 @@ void FormLayoutContainer::addWidget(QWidget *widget)
     properties->setParentLayout(m_layout);
 
     if (!properties->label().isEmpty()) {
-      m_layout->addRow(properties->label(), widget);
+      m_layout->insertRow(index, properties->label(), widget);
       return;
     }
   }
 
-  m_layout->addRow(widget);
+  m_layout->insertRow(index, widget);
+}
+
+void FormLayoutContainer::removeWidget(QWidget *widget)
+{
+  // take the whole row, otherwise an empty row and the label would be left behind
+  const QFormLayout::TakeRowResult row = m_layout->takeRow(widget);
+  if (row.labelItem) {
+    delete row.labelItem->widget();
+    delete row.labelItem;
+  }
+  delete row.fieldItem;
 }
 
 void FormLayoutContainer::setContentsMargins(int left, int top, int right, int bottom)
@@ -43,6 +43,8 @@ class DeclarativeGridLayoutAttached::Private
         widget(w), layout(l), spacerItem(s)
     {}
 
+    void relocate();
+
     int row;
     int column;
     int rowSpan;
@@ -55,6 +57,21 @@ class DeclarativeGridLayoutAttached::Private
     QPointer<QGridLayout> parentLayout;
 };
 
+void DeclarativeGridLayoutAttached::Private::relocate()
+{
+  if (!parentLayout)
+    return;
+
+  // QGridLayout cannot move items, so they are taken out and added again at their new cell
+  if (widget) {
+    parentLayout->removeWidget(widget);
+    parentLayout->addWidget(widget, row, column, rowSpan, columnSpan, alignment);
+  } else if (spacerItem) {
+    parentLayout->removeItem(spacerItem->spacer());
+    parentLayout->addItem(spacerItem->spacer(), row, column, rowSpan, columnSpan, alignment);
+  }
+}
+
 DeclarativeGridLayoutAttached::DeclarativeGridLayoutAttached(QWidget *widget, QObject *parent)
   : QObject(parent), d(new Private(widget, 0, 0))
 {
@@ -87,6 +104,8 @@ void DeclarativeGridLayoutAttached::setRow(int row)
 
   d->row = row;
   emit rowChanged(row);
+
+  d->relocate();
 }
 
 int DeclarativeGridLayoutAttached::row() const
@@ -101,6 +120,8 @@ void DeclarativeGridLayoutAttached::setColumn(int column)
 
   d->column = column;
   emit columnChanged(column);
+
+  d->relocate();
 }
 
 int DeclarativeGridLayoutAttached::column() const
@@ -115,6 +136,8 @@ void DeclarativeGridLayoutAttached::setRowSpan(int rowSpan)
 
   d->rowSpan = rowSpan;
   emit rowSpanChanged(rowSpan);
+
+  d->relocate();
 }
 
 int DeclarativeGridLayoutAttached::rowSpan() const
@@ -129,6 +152,8 @@ void DeclarativeGridLayoutAttached::setColumnSpan(int columnSpan)
 
   d->columnSpan = columnSpan;
   emit columnSpanChanged(columnSpan);
+
+  d->relocate();
 }
 
 int DeclarativeGridLayoutAttached::columnSpan() const
@@ -194,6 +219,8 @@ class GridLayoutContainer : public LayoutContainerInterface
     void addSpacer(DeclarativeSpacerItem *spacerItem);
     void addLayout(QLayout *layout);
     void addWidget(QWidget *widget);
+    void insertWidget(int index, QWidget *widget);
+    void removeWidget(QWidget *widget);
     void setContentsMargins(int left, int top, int right, int bottom);
     void getContentsMargins(int &left, int &top, int &right, int &bottom);
 
@@ -275,6 +302,19 @@ void GridLayoutContainer::addWidget(QWidget *widget)
   m_layout->addWidget(widget, row, column, rowSpan, columnSpan, alignment);
 }
 
+void GridLayoutContainer::insertWidget(int index, QWidget *widget)
+{
+  Q_UNUSED(index);
+
+  // grid cells are explicitly addressed through the attached properties
+  addWidget(widget);
+}
+
+void GridLayoutContainer::removeWidget(QWidget *widget)
+{
+  m_layout->removeWidget(widget);
+}
+
 void GridLayoutContainer::setContentsMargins(int left, int top, int right, int bottom)
 {
   m_layout->setContentsMargins(left, top, right, bottom);
@@ -70,6 +70,8 @@ class HBoxLayoutContainer : public LayoutContainerInterface
     void addLayout(QLayout *layout);
     void addSpacer(DeclarativeSpacerItem *spacerItem);
     void addWidget(QWidget *widget);
+    void insertWidget(int index, QWidget *widget);
+    void removeWidget(QWidget *widget);
     void setContentsMargins(int left, int top, int right, int bottom);
     void getContentsMargins(int &left, int &top, int &right, int &bottom);
 
@@ -106,6 +108,11 @@ void HBoxLayoutContainer::addSpacer(DeclarativeSpacerItem *spacerItem)
 }
 
 void HBoxLayoutContainer::addWidget(QWidget *widget)
+{
+  insertWidget(-1, widget);
+}
+
+void HBoxLayoutContainer::insertWidget(int index, QWidget *widget)
 {
   int stretch = 0;
   Qt::Alignment alignment = 0;
@@ -119,7 +126,12 @@ void HBoxLayoutContainer::addWidget(QWidget *widget)
     properties->setParentLayout(m_layout);
   }
 
-  m_layout->addWidget(widget, stretch, alignment);
+  m_layout->insertWidget(index, widget, stretch, alignment);
+}
+
+void HBoxLayoutContainer::removeWidget(QWidget *widget)
+{
+  m_layout->removeWidget(widget);
 }
 
 void HBoxLayoutContainer::setContentsMargins(int left, int top, int right, int bottom)
@@ -27,6 +27,9 @@
 
 #include "declarativeicon_p.h"
 
+#include "iconthemeindex_p.h"
+#include "pixmapcache_p.h"
+
 DeclarativeIconAttached::DeclarativeIconAttached(QObject *parent)
   : QObject(parent)
 {
@@ -43,6 +46,8 @@ void DeclarativeIconAttached::setThemeName(const QString &name)
     return;
 
   QIcon::setThemeName(name);
+  IconThemeIndex::instance()->prepare();
+
   emit themeNameChanged(name);
 }
 
@@ -57,17 +62,24 @@ void DeclarativeIconAttached::setThemeSearchPaths(const QStringList &paths)
     return;
 
   QIcon::setThemeSearchPaths(paths);
+  IconThemeIndex::instance()->prepare();
+
   emit themeSearchPathsChanged(paths);
 }
 
 QIcon DeclarativeIconAttached::fromTheme(const QString &name)
 {
-  return QIcon::fromTheme(name);
+  return IconThemeIndex::instance()->icon(name);
 }
 
-QIcon DeclarativeIconAttached::fromFileName(const QString &fileName)
+QIcon DeclarativeIconAttached::fromFileName(const QString &fileName, const QSize &sourceSize)
 {
-  return QIcon(fileName);
+  // without a size QIcon decodes lazily, at full resolution, for every size it is asked for
+  if (!sourceSize.isValid())
+    return PixmapCache::instance()->icon(fileName);
+
+  const QPixmap pixmap = PixmapCache::instance()->pixmap(fileName, sourceSize, PixmapCache::devicePixelRatio(sourceSize));
+  return pixmap.isNull() ? QIcon() : QIcon(pixmap);
 }
 
 class DeclarativeIcon::Private
@@ -51,7 +51,8 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeIconAttached : public QObject
     void setThemeSearchPaths(const QStringList &paths);
 
     Q_INVOKABLE QIcon fromTheme(const QString &name);
-    Q_INVOKABLE QIcon fromFileName(const QString &fileName);
+    // a valid sourceSize decodes the image once, scaled down to fit into it
+    Q_INVOKABLE QIcon fromFileName(const QString &fileName, const QSize &sourceSize = QSize());
 
   Q_SIGNALS:
     void themeNameChanged(const QString &themeName);
@@ -274,6 +274,84 @@ QString DeclarativeInputDialogAttached::getText()
   return retVal;
 }
 
+void DeclarativeInputDialogAttached::getDoubleAsync(const QJSValue &callback)
+{
+  const double value = d->value.canConvert<double>() ? d->value.value<double>() : 0.0;
+  const double min = d->min.canConvert<double>() ? d->min.value<double>() : -2147483647;
+  const double max = d->max.canConvert<double>() ? d->max.value<double>() : 2147483647;
+
+  QInputDialog *dialog = createDialog(QInputDialog::DoubleInput);
+  dialog->setDoubleDecimals(d->decimals);
+  dialog->setDoubleRange(min, max);
+  dialog->setDoubleValue(value);
+
+  openDialog(dialog, callback);
+}
+
+void DeclarativeInputDialogAttached::getIntAsync(const QJSValue &callback)
+{
+  const int value = d->value.canConvert<int>() ? d->value.value<int>() : 0;
+  const int min = d->min.canConvert<int>() ? d->min.value<int>() : -2147483647;
+  const int max = d->max.canConvert<int>() ? d->max.value<int>() : 2147483647;
+
+  QInputDialog *dialog = createDialog(QInputDialog::IntInput);
+  dialog->setIntRange(min, max);
+  dialog->setIntValue(value);
+  dialog->setIntStep(d->step);
+
+  openDialog(dialog, callback);
+}
+
+void DeclarativeInputDialogAttached::getItemAsync(const QStringList &items, const QJSValue &callback)
+{
+  QInputDialog *dialog = createDialog(QInputDialog::TextInput);
+  dialog->setComboBoxItems(items);
+  dialog->setTextValue(items.value(d->currentItem));
+  dialog->setComboBoxEditable(d->itemsEditable);
+
+  openDialog(dialog, callback);
+}
+
+void DeclarativeInputDialogAttached::getTextAsync(const QJSValue &callback)
+{
+  QInputDialog *dialog = createDialog(QInputDialog::TextInput);
+  dialog->setTextEchoMode(d->echoMode);
+  dialog->setTextValue(d->text);
+
+  openDialog(dialog, callback);
+}
+
+QVariant DeclarativeInputDialogAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  QInputDialog *inputDialog = static_cast<QInputDialog*>(dialog);
+  setDialogAccepted(*accepted);
+
+  // same values as the static QInputDialog functions return when canceled
+  switch (inputDialog->inputMode()) {
+    case QInputDialog::IntInput:
+      return *accepted ? QVariant(inputDialog->intValue()) : QVariant(d->value.canConvert<int>() ? d->value.value<int>() : 0);
+    case QInputDialog::DoubleInput:
+      return *accepted ? QVariant(inputDialog->doubleValue()) : QVariant(d->value.canConvert<double>() ? d->value.value<double>() : 0.0);
+    case QInputDialog::TextInput:
+      break;
+  }
+
+  if (*accepted)
+    return inputDialog->textValue();
+
+  return inputDialog->comboBoxItems().isEmpty() ? QString() : inputDialog->comboBoxItems().value(d->currentItem);
+}
+
+QInputDialog *DeclarativeInputDialogAttached::createDialog(QInputDialog::InputMode inputMode) const
+{
+  QInputDialog *dialog = new QInputDialog(bestParentWindow());
+  dialog->setWindowTitle(d->title);
+  dialog->setLabelText(d->label);
+  dialog->setInputMode(inputMode);
+
+  return dialog;
+}
+
 void DeclarativeInputDialogAttached::setDialogAccepted(bool accepted)
 {
   if (accepted == d->dialogAccepted)
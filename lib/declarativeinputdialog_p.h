@@ -101,6 +101,15 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeInputDialogAttached : public StaticDi
 
     Q_INVOKABLE QString getText();
 
+    // non-blocking variants, the callback gets the value and whether the dialog was accepted
+    Q_INVOKABLE void getDoubleAsync(const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getIntAsync(const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getItemAsync(const QStringList &items, const QJSValue &callback = QJSValue());
+
+    Q_INVOKABLE void getTextAsync(const QJSValue &callback = QJSValue());
+
   Q_SIGNALS:
     void titleChanged(const QString &title);
     void labelChanged(const QString &label);
@@ -118,8 +127,12 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeInputDialogAttached : public StaticDi
     void echoModeChanged(QLineEdit::EchoMode echoMode);
     void textChanged(const QString &text);
 
+  protected:
+    QVariant dialogResult(QDialog *dialog, bool *accepted);
+
   private:
     void setDialogAccepted(bool accepted);
+    QInputDialog *createDialog(QInputDialog::InputMode inputMode) const;
 
     class Private;
     Private *const d;
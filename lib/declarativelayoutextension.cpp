@@ -27,9 +27,11 @@
 
 #include "declarativelayoutextension.h"
 
+#include "declarativerepeater_p.h"
 #include "declarativespaceritem_p.h"
 #include "defaultobjectcontainer_p.h"
 #include "layoutcontainerinterface_p.h"
+#include "repeatercontainerinterface_p.h"
 
 #include <QLayout>
 #include <QWidget>
@@ -122,7 +124,7 @@ void DeclarativeLayoutContentsMargins::changeMargins(int left, int top, int righ
 }
 
 
-class LayoutContainerDelegate : public DefaultObjectContainer
+class LayoutContainerDelegate : public DefaultObjectContainer, public RepeaterContainerInterface
 {
   public:
     explicit LayoutContainerDelegate(LayoutContainerInterface *layoutContainer)
@@ -155,10 +157,48 @@ class LayoutContainerDelegate : public DefaultObjectContainer
           m_layoutContainer->addSpacer(spacer);
           return;
       }
+
+      DeclarativeRepeater *repeater = qobject_cast<DeclarativeRepeater*>(object);
+      if (repeater) {
+        repeater->setRepeaterContainer(this);
+        return;
+      }
+    }
+
+    void insertWidget(DeclarativeRepeater *repeater, int index, QWidget *widget)
+    {
+      m_layoutContainer->insertWidget(layoutIndexOf(repeater) + index, widget);
+    }
+
+    void removeWidget(QWidget *widget)
+    {
+      m_layoutContainer->removeWidget(widget);
     }
 
   private:
     LayoutContainerInterface *m_layoutContainer;
+
+    // the layout position of a repeater's first item depends on the children declared
+    // before it, including the items currently created by preceding repeaters
+    int layoutIndexOf(DeclarativeRepeater *repeater) const
+    {
+      int layoutIndex = 0;
+      for (int i = 0; i < dataCount(); ++i) {
+        QObject *object = dataAt(i);
+        if (object == repeater)
+          break;
+
+        DeclarativeRepeater *precedingRepeater = qobject_cast<DeclarativeRepeater*>(object);
+        if (precedingRepeater) {
+          layoutIndex += precedingRepeater->count();
+        } else if (object->isWidgetType() || qobject_cast<QLayout*>(object) ||
+                   qobject_cast<DeclarativeSpacerItem*>(object)) {
+          ++layoutIndex;
+        }
+      }
+
+      return layoutIndex;
+    }
 };
 
 QLayout *DeclarativeLayoutExtension::extendedLayout() const
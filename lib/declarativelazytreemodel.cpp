@@ -0,0 +1,461 @@
+/*
+  declarativelazytreemodel.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativelazytreemodel_p.h"
+
+#include <QQmlEngine>
+#include <QQmlInfo>
+
+class LazyTreeNode
+{
+  public:
+    enum State {
+      Unfetched,
+      Fetching,
+      Fetched
+    };
+
+    LazyTreeNode(LazyTreeNode *parent, int row, const QVariantMap &item, bool placeholder = false)
+      : parent(parent)
+      , row(row)
+      , item(item)
+      , state(placeholder ? Fetched : Unfetched)
+      , requestId(0)
+      , placeholder(placeholder)
+    {
+      // nodes are assumed to be expandable until their provider says otherwise
+      mayHaveChildren = !placeholder && item.value(QStringLiteral("hasChildren"), true).toBool();
+    }
+
+    ~LazyTreeNode()
+    {
+      qDeleteAll(children);
+    }
+
+    LazyTreeNode *parent;
+    int row;
+    QVariantMap item;
+    QVector<LazyTreeNode*> children;
+
+    State state;
+    int requestId;
+    bool placeholder;
+    bool mayHaveChildren;
+};
+
+class DeclarativeLazyTreeModel::Private
+{
+  public:
+    Private(DeclarativeLazyTreeModel *qq)
+      : q(qq)
+      , root(0)
+      , componentComplete(true)
+      , dispatchScheduled(false)
+      , lastRequestId(0)
+      , loadingText(QObject::tr("Loading..."))
+    {
+      roles << QStringLiteral("display");
+    }
+
+    LazyTreeNode *nodeForIndex(const QModelIndex &index) const;
+    QModelIndex indexForNode(LazyTreeNode *node) const;
+
+    void resetRoot();
+    void removePlaceholder(LazyTreeNode *node);
+    void setPendingRequest(LazyTreeNode *node, int requestId);
+
+    DeclarativeLazyTreeModel *q;
+    LazyTreeNode *root;
+    bool componentComplete;
+    bool dispatchScheduled;
+
+    QJSValue provider;
+    QStringList roles;
+    QString loadingText;
+
+    int lastRequestId;
+    QHash<int, LazyTreeNode*> pendingRequests;
+    QVector<int> queuedRequests;
+};
+
+LazyTreeNode *DeclarativeLazyTreeModel::Private::nodeForIndex(const QModelIndex &index) const
+{
+  if (!index.isValid())
+    return root;
+
+  return static_cast<LazyTreeNode*>(index.internalPointer());
+}
+
+QModelIndex DeclarativeLazyTreeModel::Private::indexForNode(LazyTreeNode *node) const
+{
+  if (node == root)
+    return QModelIndex();
+
+  return q->createIndex(node->row, 0, node);
+}
+
+void DeclarativeLazyTreeModel::Private::resetRoot()
+{
+  delete root;
+  root = new LazyTreeNode(0, 0, QVariantMap());
+
+  pendingRequests.clear();
+  queuedRequests.clear();
+}
+
+void DeclarativeLazyTreeModel::Private::removePlaceholder(LazyTreeNode *node)
+{
+  if (node->children.isEmpty() || !node->children.first()->placeholder)
+    return;
+
+  q->beginRemoveRows(indexForNode(node), 0, 0);
+  delete node->children.takeFirst();
+  q->endRemoveRows();
+}
+
+void DeclarativeLazyTreeModel::Private::setPendingRequest(LazyTreeNode *node, int requestId)
+{
+  if (requestId != 0)
+    pendingRequests.insert(requestId, node);
+  else
+    pendingRequests.remove(node->requestId);
+
+  node->requestId = requestId;
+  emit q->pendingRequestsChanged(pendingRequests.count());
+}
+
+DeclarativeLazyTreeModel::DeclarativeLazyTreeModel(QObject *parent)
+  : QAbstractItemModel(parent)
+  , d(new Private(this))
+{
+  d->resetRoot();
+}
+
+DeclarativeLazyTreeModel::~DeclarativeLazyTreeModel()
+{
+  delete d->root;
+  delete d;
+}
+
+void DeclarativeLazyTreeModel::setProvider(const QJSValue &provider)
+{
+  if (!provider.isUndefined() && !provider.isNull() && !provider.isCallable()) {
+    qmlInfo(this) << "provider must be a function";
+    return;
+  }
+
+  d->provider = provider;
+  emit providerChanged();
+
+  reload();
+}
+
+QJSValue DeclarativeLazyTreeModel::provider() const
+{
+  return d->provider;
+}
+
+void DeclarativeLazyTreeModel::setRoles(const QStringList &roles)
+{
+  if (d->roles == roles)
+    return;
+
+  beginResetModel();
+  d->roles = roles;
+  endResetModel();
+
+  emit rolesChanged(roles);
+}
+
+QStringList DeclarativeLazyTreeModel::roles() const
+{
+  return d->roles;
+}
+
+void DeclarativeLazyTreeModel::setLoadingText(const QString &text)
+{
+  if (d->loadingText == text)
+    return;
+
+  d->loadingText = text;
+  emit loadingTextChanged(text);
+}
+
+QString DeclarativeLazyTreeModel::loadingText() const
+{
+  return d->loadingText;
+}
+
+int DeclarativeLazyTreeModel::pendingRequests() const
+{
+  return d->pendingRequests.count();
+}
+
+bool DeclarativeLazyTreeModel::supply(int requestId, const QVariant &children)
+{
+  LazyTreeNode *node = d->pendingRequests.value(requestId);
+  if (!node)
+    return false; // canceled or already answered
+
+  d->setPendingRequest(node, 0);
+  d->removePlaceholder(node);
+  node->state = LazyTreeNode::Fetched;
+
+  QVariant list = children;
+  if (list.userType() == qMetaTypeId<QJSValue>())
+    list = list.value<QJSValue>().toVariant();
+
+  const QVariantList items = list.toList();
+  if (items.isEmpty()) {
+    // lets views drop the expand indicator
+    const QModelIndex index = d->indexForNode(node);
+    emit dataChanged(index, index);
+    return true;
+  }
+
+  beginInsertRows(d->indexForNode(node), 0, items.count() - 1);
+  node->children.reserve(items.count());
+  for (int row = 0; row < items.count(); ++row) {
+    const QVariant &value = items.at(row);
+
+    QVariantMap item = value.toMap();
+    if (item.isEmpty())
+      item.insert(QStringLiteral("display"), value);
+
+    node->children.append(new LazyTreeNode(node, row, item));
+  }
+  endInsertRows();
+
+  return true;
+}
+
+void DeclarativeLazyTreeModel::cancel(const QModelIndex &index)
+{
+  LazyTreeNode *node = d->nodeForIndex(index);
+  if (!node || node->state != LazyTreeNode::Fetching)
+    return;
+
+  const int requestId = node->requestId;
+
+  d->setPendingRequest(node, 0);
+  d->removePlaceholder(node);
+  node->state = LazyTreeNode::Unfetched;
+
+  emit fetchCanceled(requestId);
+}
+
+QVariant DeclarativeLazyTreeModel::item(const QModelIndex &index) const
+{
+  LazyTreeNode *node = d->nodeForIndex(index);
+  if (!node || node->placeholder)
+    return QVariant();
+
+  return node->item;
+}
+
+void DeclarativeLazyTreeModel::reload()
+{
+  if (!d->componentComplete)
+    return;
+
+  QList<int> canceled = d->pendingRequests.keys();
+
+  beginResetModel();
+  d->resetRoot();
+  endResetModel();
+
+  emit pendingRequestsChanged(0);
+  foreach (int requestId, canceled)
+    emit fetchCanceled(requestId);
+}
+
+QModelIndex DeclarativeLazyTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+  LazyTreeNode *parentNode = d->nodeForIndex(parent);
+  if (!parentNode || column != 0 || row < 0 || row >= parentNode->children.count())
+    return QModelIndex();
+
+  return createIndex(row, column, parentNode->children.at(row));
+}
+
+QModelIndex DeclarativeLazyTreeModel::parent(const QModelIndex &child) const
+{
+  LazyTreeNode *node = d->nodeForIndex(child);
+  if (!node || node == d->root)
+    return QModelIndex();
+
+  return d->indexForNode(node->parent);
+}
+
+int DeclarativeLazyTreeModel::rowCount(const QModelIndex &parent) const
+{
+  if (parent.column() > 0)
+    return 0;
+
+  LazyTreeNode *node = d->nodeForIndex(parent);
+  return node ? node->children.count() : 0;
+}
+
+int DeclarativeLazyTreeModel::columnCount(const QModelIndex &parent) const
+{
+  Q_UNUSED(parent);
+  return 1;
+}
+
+bool DeclarativeLazyTreeModel::hasChildren(const QModelIndex &parent) const
+{
+  LazyTreeNode *node = d->nodeForIndex(parent);
+  if (!node)
+    return false;
+
+  if (node == d->root || !node->children.isEmpty())
+    return true;
+
+  return node->state != LazyTreeNode::Fetched && node->mayHaveChildren;
+}
+
+QVariant DeclarativeLazyTreeModel::data(const QModelIndex &index, int role) const
+{
+  LazyTreeNode *node = d->nodeForIndex(index);
+  if (!node || node == d->root)
+    return QVariant();
+
+  if (role == LoadingRole)
+    return node->placeholder;
+
+  if (node->placeholder)
+    return role == Qt::DisplayRole ? QVariant(d->loadingText) : QVariant();
+
+  if (role == Qt::DisplayRole)
+    return node->item.value(QStringLiteral("display"));
+
+  const int roleIndex = role - LoadingRole - 1;
+  if (roleIndex < 0 || roleIndex >= d->roles.count())
+    return QVariant();
+
+  return node->item.value(d->roles.at(roleIndex));
+}
+
+Qt::ItemFlags DeclarativeLazyTreeModel::flags(const QModelIndex &index) const
+{
+  LazyTreeNode *node = d->nodeForIndex(index);
+  if (!node || node->placeholder)
+    return Qt::NoItemFlags;
+
+  return QAbstractItemModel::flags(index);
+}
+
+QHash<int, QByteArray> DeclarativeLazyTreeModel::roleNames() const
+{
+  QHash<int, QByteArray> names;
+  names.insert(Qt::DisplayRole, QByteArrayLiteral("display"));
+  names.insert(LoadingRole, QByteArrayLiteral("loading"));
+
+  for (int i = 0; i < d->roles.count(); ++i) {
+    if (d->roles.at(i) != QLatin1String("display"))
+      names.insert(LoadingRole + 1 + i, d->roles.at(i).toUtf8());
+  }
+
+  return names;
+}
+
+bool DeclarativeLazyTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+  LazyTreeNode *node = d->nodeForIndex(parent);
+  if (!node || !d->componentComplete)
+    return false;
+
+  return node->state == LazyTreeNode::Unfetched && (node == d->root || node->mayHaveChildren);
+}
+
+void DeclarativeLazyTreeModel::fetchMore(const QModelIndex &parent)
+{
+  if (!canFetchMore(parent))
+    return;
+
+  LazyTreeNode *node = d->nodeForIndex(parent);
+
+  node->state = LazyTreeNode::Fetching;
+  d->setPendingRequest(node, ++d->lastRequestId);
+
+  beginInsertRows(parent, 0, 0);
+  node->children.prepend(new LazyTreeNode(node, 0, QVariantMap(), true));
+  endInsertRows();
+
+  // views call fetchMore() while laying out, so the provider runs from the event loop
+  d->queuedRequests.append(node->requestId);
+  if (!d->dispatchScheduled) {
+    d->dispatchScheduled = true;
+    QMetaObject::invokeMethod(this, "dispatchRequests", Qt::QueuedConnection);
+  }
+}
+
+void DeclarativeLazyTreeModel::classBegin()
+{
+  d->componentComplete = false;
+}
+
+void DeclarativeLazyTreeModel::componentComplete()
+{
+  d->componentComplete = true;
+  reload();
+}
+
+void DeclarativeLazyTreeModel::dispatchRequests()
+{
+  d->dispatchScheduled = false;
+
+  const QVector<int> requests = d->queuedRequests;
+  d->queuedRequests.clear();
+
+  QQmlEngine *engine = qmlEngine(this);
+
+  foreach (int requestId, requests) {
+    LazyTreeNode *node = d->pendingRequests.value(requestId);
+    if (!node)
+      continue;
+
+    emit fetchRequested(requestId, node->item);
+
+    if (!d->provider.isCallable() || !d->pendingRequests.contains(requestId))
+      continue;
+
+    if (!engine) {
+      qmlInfo(this) << "provider can not be called without a QML engine";
+      continue;
+    }
+
+    const QJSValue result = d->provider.call(QJSValueList() << engine->toScriptValue(node->item) << requestId);
+    if (result.isError()) {
+      qmlInfo(this) << "provider failed: " << result.toString();
+      cancel(d->indexForNode(node));
+      continue;
+    }
+
+    if (result.isArray())
+      supply(requestId, result.toVariant());
+  }
+}
@@ -0,0 +1,105 @@
+/*
+  declarativelazytreemodel_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVELAZYTREEMODEL_P_H
+#define DECLARATIVELAZYTREEMODEL_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QAbstractItemModel>
+#include <QJSValue>
+#include <QQmlParserStatus>
+#include <QStringList>
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeLazyTreeModel : public QAbstractItemModel, public QQmlParserStatus
+{
+  Q_OBJECT
+  Q_INTERFACES(QQmlParserStatus)
+
+  Q_PROPERTY(QJSValue provider READ provider WRITE setProvider NOTIFY providerChanged)
+  Q_PROPERTY(QStringList roles READ roles WRITE setRoles NOTIFY rolesChanged)
+  Q_PROPERTY(QString loadingText READ loadingText WRITE setLoadingText NOTIFY loadingTextChanged)
+  Q_PROPERTY(int pendingRequests READ pendingRequests NOTIFY pendingRequestsChanged)
+
+  public:
+    enum Roles {
+      LoadingRole = Qt::UserRole
+    };
+
+    explicit DeclarativeLazyTreeModel(QObject *parent = 0);
+    ~DeclarativeLazyTreeModel();
+
+    // called as provider(parentItem, requestId) whenever a node is expanded for the first time,
+    // returns the children as an array or supplies them later through supply(requestId, children)
+    void setProvider(const QJSValue &provider);
+    QJSValue provider() const;
+
+    void setRoles(const QStringList &roles);
+    QStringList roles() const;
+
+    void setLoadingText(const QString &text);
+    QString loadingText() const;
+
+    int pendingRequests() const;
+
+    Q_INVOKABLE bool supply(int requestId, const QVariant &children);
+    Q_INVOKABLE void cancel(const QModelIndex &index);
+    Q_INVOKABLE QVariant item(const QModelIndex &index) const;
+    Q_INVOKABLE void reload();
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+    QModelIndex parent(const QModelIndex &child) const;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    Qt::ItemFlags flags(const QModelIndex &index) const;
+    QHash<int, QByteArray> roleNames() const;
+
+    bool canFetchMore(const QModelIndex &parent) const;
+    void fetchMore(const QModelIndex &parent);
+
+    void classBegin();
+    void componentComplete();
+
+  Q_SIGNALS:
+    void providerChanged();
+    void rolesChanged(const QStringList &roles);
+    void loadingTextChanged(const QString &text);
+    void pendingRequestsChanged(int pendingRequests);
+
+    void fetchRequested(int requestId, const QVariant &parentItem);
+    void fetchCanceled(int requestId);
+
+  private Q_SLOTS:
+    void dispatchRequests();
+
+  private:
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVELAZYTREEMODEL_P_H
@@ -111,6 +111,46 @@ int DeclarativeMessageBoxAttached::warning(const QString &title, const QString &
   return QMessageBox::warning(bestParentWindow(), title, text, d->buttons, d->defaultButton);
 }
 
+void DeclarativeMessageBoxAttached::criticalAsync(const QString &title, const QString &text, const QJSValue &callback)
+{
+  openMessageBox(QMessageBox::Critical, title, text, callback);
+}
+
+void DeclarativeMessageBoxAttached::informationAsync(const QString &title, const QString &text, const QJSValue &callback)
+{
+  openMessageBox(QMessageBox::Information, title, text, callback);
+}
+
+void DeclarativeMessageBoxAttached::questionAsync(const QString &title, const QString &text, const QJSValue &callback)
+{
+  openMessageBox(QMessageBox::Question, title, text, callback);
+}
+
+void DeclarativeMessageBoxAttached::warningAsync(const QString &title, const QString &text, const QJSValue &callback)
+{
+  openMessageBox(QMessageBox::Warning, title, text, callback);
+}
+
+QVariant DeclarativeMessageBoxAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  QMessageBox *messageBox = static_cast<QMessageBox*>(dialog);
+
+  // the result code of a message box is the clicked standard button, not QDialog::Accepted
+  const QMessageBox::ButtonRole role = messageBox->buttonRole(messageBox->clickedButton());
+  *accepted = (role == QMessageBox::AcceptRole || role == QMessageBox::YesRole);
+
+  return messageBox->standardButton(messageBox->clickedButton());
+}
+
+void DeclarativeMessageBoxAttached::openMessageBox(QMessageBox::Icon icon, const QString &title, const QString &text, const QJSValue &callback)
+{
+  QMessageBox *messageBox = new QMessageBox(icon, title, text, d->buttons, bestParentWindow());
+  if (d->defaultButton != QMessageBox::NoButton)
+    messageBox->setDefaultButton(d->defaultButton);
+
+  openDialog(messageBox, callback);
+}
+
 Q_DECLARE_METATYPE(Qt::WindowFlags)
 
 DeclarativeMessageBox::DeclarativeMessageBox(QWidget *parent) : QMessageBox(parent)
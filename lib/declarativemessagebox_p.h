@@ -59,11 +59,22 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeMessageBoxAttached : public StaticDia
     Q_INVOKABLE int question(const QString &title, const QString &text);
     Q_INVOKABLE int warning(const QString &title, const QString &text);
 
+    // non-blocking variants, the callback gets the clicked standard button and whether it accepts
+    Q_INVOKABLE void criticalAsync(const QString &title, const QString &text, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void informationAsync(const QString &title, const QString &text, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void questionAsync(const QString &title, const QString &text, const QJSValue &callback = QJSValue());
+    Q_INVOKABLE void warningAsync(const QString &title, const QString &text, const QJSValue &callback = QJSValue());
+
   Q_SIGNALS:
     void buttonsChanged(int buttons);
     void defaultButtonChanged(int defaultButton);
 
+  protected:
+    QVariant dialogResult(QDialog *dialog, bool *accepted);
+
   private:
+    void openMessageBox(QMessageBox::Icon icon, const QString &title, const QString &text, const QJSValue &callback);
+
     class Private;
     Private *const d;
 };
@@ -27,25 +27,132 @@
 
 #include "declarativepixmap_p.h"
 
+#include "pixmapcache_p.h"
+
 DeclarativePixmapAttached::DeclarativePixmapAttached(QObject *parent)
   : QObject(parent)
 {
 }
 
-QPixmap DeclarativePixmapAttached::fromFileName(const QString &fileName)
+int DeclarativePixmapAttached::cacheLimit() const
+{
+  return PixmapCache::instance()->cacheLimit();
+}
+
+void DeclarativePixmapAttached::setCacheLimit(int kilobytes)
 {
-  return QPixmap(fileName);
+  if (kilobytes == cacheLimit())
+    return;
+
+  PixmapCache::instance()->setCacheLimit(kilobytes);
+  emit cacheLimitChanged(cacheLimit());
+}
+
+QPixmap DeclarativePixmapAttached::fromFileName(const QString &fileName, const QSize &sourceSize)
+{
+  return PixmapCache::instance()->pixmap(fileName, sourceSize, PixmapCache::devicePixelRatio(sourceSize));
+}
+
+QVariantMap DeclarativePixmapAttached::cacheStatistics() const
+{
+  const PixmapCache *cache = PixmapCache::instance();
+
+  QVariantMap statistics;
+  statistics.insert(QStringLiteral("hits"), cache->hits());
+  statistics.insert(QStringLiteral("misses"), cache->misses());
+  statistics.insert(QStringLiteral("hitRate"), cache->hitRate());
+  statistics.insert(QStringLiteral("count"), cache->count());
+  statistics.insert(QStringLiteral("deduplicated"), cache->deduplicated());
+  statistics.insert(QStringLiteral("bytes"), cache->totalBytes());
+  statistics.insert(QStringLiteral("limit"), cache->cacheLimit());
+
+  return statistics;
+}
+
+void DeclarativePixmapAttached::clearCache()
+{
+  PixmapCache::instance()->clear();
 }
 
 class DeclarativePixmap::Private
 {
   public:
+    Private(DeclarativePixmap *qq)
+      : asynchronous(false)
+      , loading(false)
+      , complete(true)
+      , q(qq)
+    {
+    }
+
+    void load();
+    void setLoading(bool loading);
+
     QPixmap pixmap;
+    QString source;
+    QSize sourceSize;
+    QString pendingKey;
+    bool asynchronous;
+    bool loading;
+    bool complete;
+
+  private:
+    DeclarativePixmap *q;
 };
 
+void DeclarativePixmap::Private::load()
+{
+  if (!complete)
+    return;
+
+  PixmapCache *cache = PixmapCache::instance();
+  const qreal devicePixelRatio = PixmapCache::devicePixelRatio(sourceSize);
+
+  if (source.isEmpty()) {
+    pendingKey.clear();
+    setLoading(false);
+    q->setPixmap(QPixmap());
+    return;
+  }
+
+  if (!asynchronous) {
+    pendingKey.clear();
+    setLoading(false);
+    q->setPixmap(cache->pixmap(source, sourceSize, devicePixelRatio));
+    return;
+  }
+
+  const QPixmap cached = cache->load(source, sourceSize, devicePixelRatio);
+  if (!cached.isNull()) {
+    pendingKey.clear();
+    setLoading(false);
+    q->setPixmap(cached);
+    return;
+  }
+
+  pendingKey = PixmapCache::cacheKey(source, sourceSize, devicePixelRatio);
+  setLoading(true);
+}
+
+void DeclarativePixmap::Private::setLoading(bool newLoading)
+{
+  if (newLoading == loading)
+    return;
+
+  loading = newLoading;
+
+  // only listen while waiting, otherwise every Pixmap would be notified about every finished load
+  if (loading)
+    QObject::connect(PixmapCache::instance(), SIGNAL(pixmapLoaded(QString,QPixmap)), q, SLOT(onPixmapLoaded(QString,QPixmap)));
+  else
+    QObject::disconnect(PixmapCache::instance(), SIGNAL(pixmapLoaded(QString,QPixmap)), q, SLOT(onPixmapLoaded(QString,QPixmap)));
+
+  emit q->loadingChanged(loading);
+}
+
 DeclarativePixmap::DeclarativePixmap(QObject *parent)
   : QObject(parent)
-  , d(new Private)
+  , d(new Private(this))
 {
 }
 
@@ -81,6 +188,62 @@ void DeclarativePixmap::setPixmap(const QPixmap &pixmap)
     emit isNullChanged(d->pixmap.isNull());
 }
 
+QString DeclarativePixmap::source() const
+{
+  return d->source;
+}
+
+void DeclarativePixmap::setSource(const QString &source)
+{
+  if (source == d->source)
+    return;
+
+  d->source = source;
+  emit sourceChanged(source);
+
+  d->load();
+}
+
+QSize DeclarativePixmap::sourceSize() const
+{
+  return d->sourceSize;
+}
+
+void DeclarativePixmap::setSourceSize(const QSize &sourceSize)
+{
+  if (sourceSize == d->sourceSize)
+    return;
+
+  d->sourceSize = sourceSize;
+  emit sourceSizeChanged(sourceSize);
+
+  if (!d->source.isEmpty())
+    d->load();
+}
+
+bool DeclarativePixmap::asynchronous() const
+{
+  return d->asynchronous;
+}
+
+void DeclarativePixmap::setAsynchronous(bool asynchronous)
+{
+  if (asynchronous == d->asynchronous)
+    return;
+
+  d->asynchronous = asynchronous;
+  emit asynchronousChanged(asynchronous);
+
+  // switching to synchronous loading finishes a pending load right away
+  if (!asynchronous && d->loading)
+    d->load();
+}
+
+bool DeclarativePixmap::loading() const
+{
+  return d->loading;
+}
+
 int DeclarativePixmap::height() const
 {
   return d->pixmap.height();
@@ -100,3 +263,27 @@ DeclarativePixmapAttached *DeclarativePixmap::qmlAttachedProperties(QObject *par
 {
   return new DeclarativePixmapAttached(parent);
 }
+
+void DeclarativePixmap::classBegin()
+{
+  d->complete = false;
+}
+
+void DeclarativePixmap::componentComplete()
+{
+  d->complete = true;
+
+  if (!d->source.isEmpty())
+    d->load();
+}
+
+void DeclarativePixmap::onPixmapLoaded(const QString &key, const QPixmap &pixmap)
+{
+  if (key != d->pendingKey)
+    return;
+
+  d->pendingKey.clear();
+  d->setLoading(false);
+
+  setPixmap(pixmap);
+}
@@ -32,23 +32,42 @@
 
 #include <QObject>
 #include <QPixmap>
+#include <QQmlParserStatus>
 #include <qqml.h>
 #include <QStringList>
+#include <QVariantMap>
 
 class DECLARATIVEWIDGETS_EXPORT DeclarativePixmapAttached : public QObject
 {
   Q_OBJECT
+  Q_PROPERTY(int cacheLimit READ cacheLimit WRITE setCacheLimit NOTIFY cacheLimitChanged)
 
   public:
     explicit DeclarativePixmapAttached(QObject *parent = 0);
 
-    Q_INVOKABLE QPixmap fromFileName(const QString &fileName);
+    int cacheLimit() const;
+    void setCacheLimit(int kilobytes);
+
+    // a valid sourceSize decodes the image scaled down to fit into it
+    Q_INVOKABLE QPixmap fromFileName(const QString &fileName, const QSize &sourceSize = QSize());
+
+    Q_INVOKABLE QVariantMap cacheStatistics() const;
+    Q_INVOKABLE void clearCache();
+
+  Q_SIGNALS:
+    void cacheLimitChanged(int cacheLimit);
 };
 
-class DECLARATIVEWIDGETS_EXPORT DeclarativePixmap : public QObject
+class DECLARATIVEWIDGETS_EXPORT DeclarativePixmap : public QObject, public QQmlParserStatus
 {
   Q_OBJECT
+  Q_INTERFACES(QQmlParserStatus)
+
   Q_PROPERTY(QPixmap Pixmap READ pixmap WRITE setPixmap NOTIFY pixmapChanged)
+  Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged)
+  Q_PROPERTY(QSize sourceSize READ sourceSize WRITE setSourceSize NOTIFY sourceSizeChanged)
+  Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged)
+  Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
   Q_PROPERTY(int width READ width NOTIFY widthChanged)
   Q_PROPERTY(int height READ height NOTIFY heightChanged)
   Q_PROPERTY(bool isNull READ isNull NOTIFY isNullChanged)
@@ -60,6 +79,17 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativePixmap : public QObject
     QPixmap pixmap() const;
     void setPixmap(const QPixmap &pixmap);
 
+    QString source() const;
+    void setSource(const QString &source);
+
+    QSize sourceSize() const;
+    void setSourceSize(const QSize &sourceSize);
+
+    bool asynchronous() const;
+    void setAsynchronous(bool asynchronous);
+
+    bool loading() const;
+
     int height() const;
     int width() const;
 
@@ -67,15 +97,25 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativePixmap : public QObject
 
     static DeclarativePixmapAttached *qmlAttachedProperties(QObject *parent);
 
+    void classBegin();
+    void componentComplete();
+
   Q_SIGNALS:
     void pixmapChanged(const QPixmap &Pixmap);
     void heightChanged(int height);
     void widthChanged(int width);
     void isNullChanged(bool isNull);
+    void sourceChanged(const QString &source);
+    void sourceSizeChanged(const QSize &sourceSize);
+    void asynchronousChanged(bool asynchronous);
+    void loadingChanged(bool loading);
 
   private:
     class Private;
     Private *const d;
+
+  private Q_SLOTS:
+    void onPixmapLoaded(const QString &key, const QPixmap &pixmap);
 };
 
 QML_DECLARE_TYPEINFO(DeclarativePixmap, QML_HAS_ATTACHED_PROPERTIES)
@@ -0,0 +1,181 @@
+/*
+  declarativepreloader.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativepreloader_p.h"
+
+#include "pixmapcache_p.h"
+
+DeclarativePreloader::DeclarativePreloader(QObject *parent)
+  : QObject(parent)
+  , m_loaded(0)
+  , m_failed(0)
+  , m_total(0)
+  , m_loading(false)
+  , m_complete(true)
+{
+}
+
+void DeclarativePreloader::setSources(const QStringList &sources)
+{
+  if (sources == m_sources)
+    return;
+
+  m_sources = sources;
+  emit sourcesChanged(sources);
+
+  start();
+}
+
+QStringList DeclarativePreloader::sources() const
+{
+  return m_sources;
+}
+
+void DeclarativePreloader::setSourceSize(const QSize &sourceSize)
+{
+  if (sourceSize == m_sourceSize)
+    return;
+
+  m_sourceSize = sourceSize;
+  emit sourceSizeChanged(sourceSize);
+
+  start();
+}
+
+QSize DeclarativePreloader::sourceSize() const
+{
+  return m_sourceSize;
+}
+
+bool DeclarativePreloader::loading() const
+{
+  return m_loading;
+}
+
+int DeclarativePreloader::loaded() const
+{
+  return m_loaded;
+}
+
+int DeclarativePreloader::failed() const
+{
+  return m_failed;
+}
+
+qreal DeclarativePreloader::progress() const
+{
+  if (m_total == 0)
+    return 1.0;
+
+  return qreal(m_loaded + m_failed) / m_total;
+}
+
+void DeclarativePreloader::classBegin()
+{
+  m_complete = false;
+}
+
+void DeclarativePreloader::componentComplete()
+{
+  m_complete = true;
+
+  start();
+}
+
+void DeclarativePreloader::onPixmapLoaded(const QString &key, const QPixmap &pixmap)
+{
+  if (!m_pendingKeys.remove(key))
+    return;
+
+  if (pixmap.isNull())
+    ++m_failed;
+  else
+    ++m_loaded;
+
+  emit progressChanged();
+
+  if (m_pendingKeys.isEmpty()) {
+    setLoading(false);
+    emit finished();
+  }
+}
+
+void DeclarativePreloader::start()
+{
+  if (!m_complete)
+    return;
+
+  m_pendingKeys.clear();
+  m_loaded = 0;
+  m_failed = 0;
+  m_total = 0;
+
+  PixmapCache *cache = PixmapCache::instance();
+  const qreal devicePixelRatio = PixmapCache::devicePixelRatio(m_sourceSize);
+
+  // the cache decodes every miss on the global thread pool, so all sources load in parallel.
+  // Only the sized pixmap path is warmed, see the class comment for icons
+  QSet<QString> keys;
+  foreach (const QString &source, m_sources) {
+    const QString key = PixmapCache::cacheKey(source, m_sourceSize, devicePixelRatio);
+    if (keys.contains(key))
+      continue;
+
+    keys.insert(key);
+
+    if (cache->load(source, m_sourceSize, devicePixelRatio).isNull())
+      m_pendingKeys.insert(key);
+    else
+      ++m_loaded;
+  }
+
+  m_total = keys.count();
+
+  emit progressChanged();
+
+  if (m_pendingKeys.isEmpty()) {
+    setLoading(false);
+    emit finished();
+  } else {
+    setLoading(true);
+  }
+}
+
+void DeclarativePreloader::setLoading(bool loading)
+{
+  if (loading == m_loading)
+    return;
+
+  m_loading = loading;
+
+  // only listen while waiting, like Pixmap does
+  if (m_loading)
+    connect(PixmapCache::instance(), SIGNAL(pixmapLoaded(QString,QPixmap)), this, SLOT(onPixmapLoaded(QString,QPixmap)));
+  else
+    disconnect(PixmapCache::instance(), SIGNAL(pixmapLoaded(QString,QPixmap)), this, SLOT(onPixmapLoaded(QString,QPixmap)));
+
+  emit loadingChanged(m_loading);
+}
@@ -0,0 +1,96 @@
+/*
+  declarativepreloader_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVEPRELOADER_P_H
+#define DECLARATIVEPRELOADER_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QObject>
+#include <QPixmap>
+#include <QQmlParserStatus>
+#include <QSet>
+#include <QSize>
+#include <QStringList>
+
+// Decodes a list of image files into the pixmap cache ahead of use, at sourceSize.
+// Only warms what Pixmap and Icon.fromFileName(fileName, sourceSize) read with the same
+// sourceSize: Icon.fromFileName without a size decodes lazily per painted size and
+// Icon.fromTheme resolves through the theme index, neither gains anything from preloading.
+class DECLARATIVEWIDGETS_EXPORT DeclarativePreloader : public QObject, public QQmlParserStatus
+{
+  Q_OBJECT
+  Q_INTERFACES(QQmlParserStatus)
+
+  Q_PROPERTY(QStringList sources READ sources WRITE setSources NOTIFY sourcesChanged)
+  Q_PROPERTY(QSize sourceSize READ sourceSize WRITE setSourceSize NOTIFY sourceSizeChanged)
+  Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+  Q_PROPERTY(int loaded READ loaded NOTIFY progressChanged)
+  Q_PROPERTY(int failed READ failed NOTIFY progressChanged)
+  Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+
+  public:
+    explicit DeclarativePreloader(QObject *parent = 0);
+
+    void setSources(const QStringList &sources);
+    QStringList sources() const;
+
+    void setSourceSize(const QSize &sourceSize);
+    QSize sourceSize() const;
+
+    bool loading() const;
+    int loaded() const;
+    int failed() const;
+    qreal progress() const;
+
+    void classBegin();
+    void componentComplete();
+
+  Q_SIGNALS:
+    void sourcesChanged(const QStringList &sources);
+    void sourceSizeChanged(const QSize &sourceSize);
+    void loadingChanged(bool loading);
+    void progressChanged();
+    void finished();
+
+  private Q_SLOTS:
+    void onPixmapLoaded(const QString &key, const QPixmap &pixmap);
+
+  private:
+    void start();
+    void setLoading(bool loading);
+
+    QStringList m_sources;
+    QSize m_sourceSize;
+    QSet<QString> m_pendingKeys;
+    int m_loaded;
+    int m_failed;
+    int m_total;
+    bool m_loading;
+    bool m_complete;
+};
+
+#endif // DECLARATIVEPRELOADER_P_H
@@ -0,0 +1,352 @@
+/*
+  declarativerepeater.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativerepeater_p.h"
+
+#include "repeatercontainerinterface_p.h"
+
+#include <QAbstractItemModel>
+#include <QPointer>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlInfo>
+#include <QWidget>
+
+class DeclarativeRepeater::Private
+{
+  public:
+    struct Item
+    {
+      QPointer<QWidget> widget;
+      QPointer<QQmlContext> context;
+    };
+
+    Private(DeclarativeRepeater *qq)
+      : q(qq), container(0), componentComplete(true)
+    {}
+
+    Item createItem(int row);
+    void destroyItem(const Item &item);
+    void updateRoles(const Item &item, int row, const QVector<int> &roles = QVector<int>());
+    void updateIndices(int from, int to);
+
+    DeclarativeRepeater *q;
+    QPointer<QAbstractItemModel> model;
+    QPointer<QQmlComponent> delegate;
+    RepeaterContainerInterface *container;
+    bool componentComplete;
+
+    QHash<int, QByteArray> roleNames;
+    QList<Item> items;
+};
+
+DeclarativeRepeater::Private::Item DeclarativeRepeater::Private::createItem(int row)
+{
+  Item item;
+
+  QQmlContext *creationContext = delegate->creationContext();
+  if (!creationContext)
+    creationContext = qmlContext(q);
+
+  QQmlContext *context = new QQmlContext(creationContext);
+  item.context = context;
+  updateRoles(item, row);
+
+  QObject *object = delegate->beginCreate(context);
+  if (!object) {
+    delete context;
+    return item;
+  }
+
+  context->setParent(object);
+  delegate->completeCreate();
+
+  item.widget = qobject_cast<QWidget*>(object);
+  if (!item.widget) {
+    qmlInfo(q) << "Repeater delegate has to be a widget";
+    delete object;
+  }
+
+  return item;
+}
+
+void DeclarativeRepeater::Private::destroyItem(const Item &item)
+{
+  if (!item.widget)
+    return;
+
+  container->removeWidget(item.widget);
+
+  // the widget might still be referenced by a binding that is currently being evaluated
+  item.widget->hide();
+  item.widget->deleteLater();
+}
+
+void DeclarativeRepeater::Private::updateRoles(const Item &item, int row, const QVector<int> &roles)
+{
+  if (!item.context)
+    return;
+
+  item.context->setContextProperty(QStringLiteral("index"), row);
+
+  const QModelIndex index = model->index(row, 0);
+
+  QHash<int, QByteArray>::const_iterator it = roleNames.constBegin();
+  for (; it != roleNames.constEnd(); ++it) {
+    if (!roles.isEmpty() && !roles.contains(it.key()))
+      continue;
+
+    item.context->setContextProperty(QString::fromUtf8(it.value()), index.data(it.key()));
+  }
+}
+
+void DeclarativeRepeater::Private::updateIndices(int from, int to)
+{
+  for (int row = from; row <= to && row < items.count(); ++row) {
+    if (items[row].context)
+      items[row].context->setContextProperty(QStringLiteral("index"), row);
+  }
+}
+
+DeclarativeRepeater::DeclarativeRepeater(QObject *parent)
+  : QObject(parent)
+  , d(new Private(this))
+{
+}
+
+DeclarativeRepeater::~DeclarativeRepeater()
+{
+  delete d;
+}
+
+void DeclarativeRepeater::setModel(QAbstractItemModel *model)
+{
+  if (model == d->model)
+    return;
+
+  if (d->model)
+    disconnect(d->model, 0, this, 0);
+
+  d->model = model;
+
+  if (d->model) {
+    connect(d->model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(onRowsInserted(QModelIndex,int,int)));
+    connect(d->model, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(onRowsRemoved(QModelIndex,int,int)));
+    connect(d->model, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)),
+            this, SLOT(onRowsMoved(QModelIndex,int,int,QModelIndex,int)));
+    connect(d->model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)),
+            this, SLOT(onDataChanged(QModelIndex,QModelIndex,QVector<int>)));
+    connect(d->model, SIGNAL(modelReset()), this, SLOT(onModelReset()));
+    connect(d->model, SIGNAL(layoutChanged()), this, SLOT(onModelReset()));
+    connect(d->model, SIGNAL(destroyed()), this, SLOT(onModelReset()));
+  }
+
+  regenerate();
+
+  emit modelChanged();
+}
+
+QAbstractItemModel *DeclarativeRepeater::model() const
+{
+  return d->model;
+}
+
+void DeclarativeRepeater::setDelegate(QQmlComponent *delegate)
+{
+  if (delegate == d->delegate)
+    return;
+
+  d->delegate = delegate;
+
+  regenerate();
+
+  emit delegateChanged();
+}
+
+QQmlComponent *DeclarativeRepeater::delegate() const
+{
+  return d->delegate;
+}
+
+int DeclarativeRepeater::count() const
+{
+  return d->items.count();
+}
+
+QWidget *DeclarativeRepeater::itemAt(int index) const
+{
+  if (index < 0 || index >= d->items.count())
+    return 0;
+
+  return d->items.at(index).widget;
+}
+
+void DeclarativeRepeater::setRepeaterContainer(RepeaterContainerInterface *container)
+{
+  d->container = container;
+
+  regenerate();
+}
+
+void DeclarativeRepeater::classBegin()
+{
+  d->componentComplete = false;
+}
+
+void DeclarativeRepeater::componentComplete()
+{
+  d->componentComplete = true;
+
+  regenerate();
+}
+
+void DeclarativeRepeater::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+  if (parent.isValid() || !d->componentComplete || !d->container || !d->delegate)
+    return;
+
+  for (int row = first; row <= last; ++row) {
+    const Private::Item item = d->createItem(row);
+    d->items.insert(row, item);
+
+    if (item.widget) {
+      d->container->insertWidget(this, row, item.widget);
+      emit itemAdded(row, item.widget);
+    }
+  }
+
+  d->updateIndices(last + 1, d->items.count() - 1);
+
+  emit countChanged();
+}
+
+void DeclarativeRepeater::onRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+  if (parent.isValid() || !d->container)
+    return;
+
+  for (int row = qMin(last, d->items.count() - 1); row >= first; --row) {
+    const Private::Item item = d->items.takeAt(row);
+    if (item.widget)
+      emit itemRemoved(row, item.widget);
+
+    d->destroyItem(item);
+  }
+
+  d->updateIndices(first, d->items.count() - 1);
+
+  emit countChanged();
+}
+
+void DeclarativeRepeater::onRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd,
+                                      const QModelIndex &destinationParent, int destinationRow)
+{
+  if (!d->componentComplete || !d->container || !d->delegate)
+    return;
+
+  if (sourceParent.isValid() || destinationParent.isValid()) {
+    // rows moved into or out of a child level are treated like insertions or removals
+    if (!sourceParent.isValid())
+      onRowsRemoved(sourceParent, sourceStart, sourceEnd);
+    else if (!destinationParent.isValid())
+      onRowsInserted(destinationParent, destinationRow, destinationRow + sourceEnd - sourceStart);
+    return;
+  }
+
+  const int movedCount = sourceEnd - sourceStart + 1;
+  const int targetRow = destinationRow > sourceEnd ? destinationRow - movedCount : destinationRow;
+
+  QList<Private::Item> moved;
+  for (int i = 0; i < movedCount; ++i) {
+    const Private::Item item = d->items.takeAt(sourceStart);
+    if (item.widget)
+      d->container->removeWidget(item.widget);
+    moved.append(item);
+  }
+
+  for (int i = 0; i < movedCount; ++i) {
+    const Private::Item &item = moved.at(i);
+    d->items.insert(targetRow + i, item);
+    if (item.widget)
+      d->container->insertWidget(this, targetRow + i, item.widget);
+  }
+
+  d->updateIndices(qMin(sourceStart, targetRow), qMax(sourceEnd, targetRow + movedCount - 1));
+}
+
+void DeclarativeRepeater::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+  if (topLeft.parent().isValid() || topLeft.column() > 0)
+    return;
+
+  const int last = qMin(bottomRight.row(), d->items.count() - 1);
+  for (int row = topLeft.row(); row <= last; ++row) {
+    d->updateRoles(d->items.at(row), row, roles);
+  }
+}
+
+void DeclarativeRepeater::onModelReset()
+{
+  regenerate();
+}
+
+void DeclarativeRepeater::regenerate()
+{
+  if (!d->componentComplete || !d->container)
+    return;
+
+  const bool hadItems = !d->items.isEmpty();
+
+  while (!d->items.isEmpty()) {
+    const Private::Item item = d->items.takeLast();
+    if (item.widget)
+      emit itemRemoved(d->items.count(), item.widget);
+
+    d->destroyItem(item);
+  }
+
+  if (!d->model || !d->delegate) {
+    if (hadItems)
+      emit countChanged();
+    return;
+  }
+
+  d->roleNames = d->model->roleNames();
+
+  const int rowCount = d->model->rowCount();
+  for (int row = 0; row < rowCount; ++row) {
+    const Private::Item item = d->createItem(row);
+    d->items.append(item);
+
+    if (item.widget) {
+      d->container->insertWidget(this, row, item.widget);
+      emit itemAdded(row, item.widget);
+    }
+  }
+
+  if (hadItems || rowCount > 0)
+    emit countChanged();
+}
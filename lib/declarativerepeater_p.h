@@ -0,0 +1,97 @@
+/*
+  declarativerepeater_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVEREPEATER_P_H
+#define DECLARATIVEREPEATER_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QModelIndex>
+#include <QObject>
+#include <QQmlComponent>
+#include <QQmlParserStatus>
+#include <QVector>
+#include <QWidget>
+
+class RepeaterContainerInterface;
+
+QT_BEGIN_NAMESPACE
+class QAbstractItemModel;
+QT_END_NAMESPACE
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeRepeater : public QObject, public QQmlParserStatus
+{
+  Q_OBJECT
+  Q_INTERFACES(QQmlParserStatus)
+
+  Q_PROPERTY(QAbstractItemModel* model READ model WRITE setModel NOTIFY modelChanged)
+  Q_PROPERTY(QQmlComponent* delegate READ delegate WRITE setDelegate NOTIFY delegateChanged)
+  Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+  Q_CLASSINFO("DefaultProperty", "delegate")
+
+  public:
+    explicit DeclarativeRepeater(QObject *parent = 0);
+    ~DeclarativeRepeater();
+
+    void setModel(QAbstractItemModel *model);
+    QAbstractItemModel *model() const;
+
+    void setDelegate(QQmlComponent *delegate);
+    QQmlComponent *delegate() const;
+
+    int count() const;
+
+    Q_INVOKABLE QWidget *itemAt(int index) const;
+
+    void setRepeaterContainer(RepeaterContainerInterface *container);
+
+    void classBegin();
+    void componentComplete();
+
+  Q_SIGNALS:
+    void modelChanged();
+    void delegateChanged();
+    void countChanged();
+    void itemAdded(int index, QWidget *item);
+    void itemRemoved(int index, QWidget *item);
+
+  private Q_SLOTS:
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onRowsMoved(const QModelIndex &sourceParent, int sourceStart, int sourceEnd,
+                     const QModelIndex &destinationParent, int destinationRow);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void onModelReset();
+
+  private:
+    void regenerate();
+
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVEREPEATER_P_H
@@ -52,6 +52,8 @@ class StackedLayoutContainer : public LayoutContainerInterface
     void addLayout(QLayout *layout);
     void addSpacer(DeclarativeSpacerItem *spacerItem);
     void addWidget(QWidget *widget);
+    void insertWidget(int index, QWidget *widget);
+    void removeWidget(QWidget *widget);
     void setContentsMargins(int left, int top, int right, int bottom);
     void getContentsMargins(int &left, int &top, int &right, int &bottom);
 
@@ -88,6 +90,16 @@ void StackedLayoutContainer::addWidget(QWidget *widget)
   m_layout->addWidget(widget);
 }
 
+void StackedLayoutContainer::insertWidget(int index, QWidget *widget)
+{
+  m_layout->insertWidget(index, widget);
+}
+
+void StackedLayoutContainer::removeWidget(QWidget *widget)
+{
+  m_layout->removeWidget(widget);
+}
+
 void StackedLayoutContainer::setContentsMargins(int left, int top, int right, int bottom)
 {
   m_layout->setContentsMargins(left, top, right, bottom);
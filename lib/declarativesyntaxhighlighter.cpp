@@ -0,0 +1,675 @@
+/*
+  declarativesyntaxhighlighter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativesyntaxhighlighter_p.h"
+
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QQmlInfo>
+#include <QRegularExpression>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextLayout>
+#include <QTimer>
+
+// edits touching more blocks than this are highlighted from the event loop
+static const int s_synchronousBlockLimit = 64;
+
+// time spent highlighting before returning to the event loop
+static const int s_highlightTimeSlice = 10;
+
+// Joining patterns into one expression renumbers their capture groups, so patterns
+// referring to groups by number, or recursing into the whole pattern, keep their own
+// expression. Errs on the side of true, which only costs matching speed
+bool DeclarativeSyntaxHighlighter::hasAbsoluteGroupReference(const QString &pattern)
+{
+  const int length = pattern.length();
+  bool inClass = false;
+
+  for (int i = 0; i < length; ++i) {
+    const QChar c = pattern.at(i);
+
+    if (c == QLatin1Char('\\')) {
+      if (i + 1 >= length)
+        return false;
+
+      const QChar escaped = pattern.at(i + 1);
+      if (escaped == QLatin1Char('Q')) {
+        const int end = pattern.indexOf(QLatin1String("\\E"), i + 2);
+        if (end < 0)
+          return false;
+        i = end + 1;
+        continue;
+      }
+
+      if (!inClass) {
+        // \1, \g1, \g{1} and \g<1>, relative and named references stay valid
+        if (escaped.isDigit() && escaped != QLatin1Char('0'))
+          return true;
+
+        if (escaped == QLatin1Char('g') && i + 2 < length) {
+          QChar first = pattern.at(i + 2);
+          if ((first == QLatin1Char('{') || first == QLatin1Char('<') || first == QLatin1Char('\'')) && i + 3 < length)
+            first = pattern.at(i + 3);
+          if (first.isDigit())
+            return true;
+        }
+      }
+
+      ++i;
+      continue;
+    }
+
+    if (inClass) {
+      if (c == QLatin1Char(']'))
+        inClass = false;
+      continue;
+    }
+
+    if (c == QLatin1Char('[')) {
+      inClass = true;
+
+      // a closing bracket right at the start is part of the class
+      if (i + 1 < length && pattern.at(i + 1) == QLatin1Char('^'))
+        ++i;
+      if (i + 1 < length && pattern.at(i + 1) == QLatin1Char(']'))
+        ++i;
+      continue;
+    }
+
+    if (c == QLatin1Char('(') && i + 2 < length && pattern.at(i + 1) == QLatin1Char('?')) {
+      QChar first = pattern.at(i + 2);
+
+      if (first == QLatin1Char('#')) {
+        const int end = pattern.indexOf(QLatin1Char(')'), i + 3);
+        if (end < 0)
+          return false;
+        i = end;
+        continue;
+      }
+
+      // (?R), (?1) and the conditions (?(1)...) and (?(R)...)
+      if (first == QLatin1Char('(') && i + 3 < length)
+        first = pattern.at(i + 3);
+      if (first.isDigit() || first == QLatin1Char('R'))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+DeclarativeHighlightRule::DeclarativeHighlightRule(QObject *parent)
+  : QObject(parent)
+  , m_caseSensitive(true)
+  , m_bold(false)
+  , m_italic(false)
+  , m_underline(false)
+{
+}
+
+void DeclarativeHighlightRule::setPattern(const QString &pattern)
+{
+  if (m_pattern == pattern)
+    return;
+
+  m_pattern = pattern;
+  emit changed();
+}
+
+QString DeclarativeHighlightRule::pattern() const
+{
+  return m_pattern;
+}
+
+void DeclarativeHighlightRule::setCaseSensitive(bool caseSensitive)
+{
+  if (m_caseSensitive == caseSensitive)
+    return;
+
+  m_caseSensitive = caseSensitive;
+  emit changed();
+}
+
+bool DeclarativeHighlightRule::caseSensitive() const
+{
+  return m_caseSensitive;
+}
+
+void DeclarativeHighlightRule::setColor(const QColor &color)
+{
+  if (m_color == color)
+    return;
+
+  m_color = color;
+  emit changed();
+}
+
+QColor DeclarativeHighlightRule::color() const
+{
+  return m_color;
+}
+
+void DeclarativeHighlightRule::setBackground(const QColor &background)
+{
+  if (m_background == background)
+    return;
+
+  m_background = background;
+  emit changed();
+}
+
+QColor DeclarativeHighlightRule::background() const
+{
+  return m_background;
+}
+
+void DeclarativeHighlightRule::setBold(bool bold)
+{
+  if (m_bold == bold)
+    return;
+
+  m_bold = bold;
+  emit changed();
+}
+
+bool DeclarativeHighlightRule::bold() const
+{
+  return m_bold;
+}
+
+void DeclarativeHighlightRule::setItalic(bool italic)
+{
+  if (m_italic == italic)
+    return;
+
+  m_italic = italic;
+  emit changed();
+}
+
+bool DeclarativeHighlightRule::italic() const
+{
+  return m_italic;
+}
+
+void DeclarativeHighlightRule::setUnderline(bool underline)
+{
+  if (m_underline == underline)
+    return;
+
+  m_underline = underline;
+  emit changed();
+}
+
+bool DeclarativeHighlightRule::underline() const
+{
+  return m_underline;
+}
+
+class DeclarativeSyntaxHighlighter::Private
+{
+  public:
+    Private(DeclarativeSyntaxHighlighter *qq)
+      : q(qq)
+      , timer(0)
+      , compiled(false)
+      , componentComplete(true)
+      , applyingFormats(false)
+      , busy(false)
+      , generation(0)
+      , scanBlock(-1)
+    {}
+
+    void compile();
+    void highlightBlock(QTextBlock block);
+    void scheduleFrom(int blockNumber);
+    void setBusy(bool busy);
+
+    DeclarativeSyntaxHighlighter *q;
+    QPointer<QTextDocument> document;
+    QList<DeclarativeHighlightRule*> rules;
+    QTimer *timer;
+
+    bool compiled;
+    bool componentComplete;
+    bool applyingFormats;
+    bool busy;
+
+    struct RuleMatch
+    {
+      int start;
+      int end;
+      int rule;
+    };
+
+    void findMatch(int expressionIndex, const QString &text, int from, RuleMatch *match) const;
+
+    // the rule of each expression, -1 for the one joining the other rules
+    QVector<QRegularExpression> expressions;
+    QVector<int> expressionRules;
+
+    // the group of each rule in the joined expression, -1 for rules with their own
+    QVector<int> ruleGroups;
+    QVector<QTextCharFormat> ruleFormats;
+
+    // blocks whose user state differs from the generation are highlighted by the next pass
+    int generation;
+    int scanBlock;
+};
+
+void DeclarativeSyntaxHighlighter::Private::compile()
+{
+  compiled = true;
+
+  // rules become alternatives of one expression, so each block is matched once,
+  // earlier rules win where matches overlap
+  QStringList alternatives;
+  QVector<DeclarativeHighlightRule*> compiledRules;
+  QVector<int> separateRules;
+
+  foreach (DeclarativeHighlightRule *rule, rules) {
+    if (rule->pattern().isEmpty())
+      continue;
+
+    const QRegularExpression check(rule->pattern());
+    if (!check.isValid()) {
+      qmlInfo(rule) << "Invalid pattern " << rule->pattern() << ": " << check.errorString();
+      continue;
+    }
+
+    if (hasAbsoluteGroupReference(rule->pattern())) {
+      separateRules << compiledRules.count();
+    } else {
+      const QString option = rule->caseSensitive() ? QString() : QStringLiteral("(?i)");
+      alternatives << QStringLiteral("(?<r%1>%2%3)").arg(compiledRules.count()).arg(option, rule->pattern());
+    }
+    compiledRules << rule;
+  }
+
+  expressions.clear();
+  expressionRules.clear();
+  ruleGroups.fill(-1, compiledRules.count());
+  ruleFormats.clear();
+
+  if (!alternatives.isEmpty()) {
+    QRegularExpression joined(alternatives.join(QLatin1Char('|')));
+
+    // not the case when several rules use the same group name, then every rule gets its own
+    if (joined.isValid()) {
+      const QStringList groupNames = joined.namedCaptureGroups();
+      for (int i = 0; i < compiledRules.count(); ++i) {
+        if (!separateRules.contains(i))
+          ruleGroups[i] = groupNames.indexOf(QStringLiteral("r%1").arg(i));
+      }
+
+      joined.optimize();
+      expressions << joined;
+      expressionRules << -1;
+    } else {
+      separateRules.clear();
+      for (int i = 0; i < compiledRules.count(); ++i)
+        separateRules << i;
+    }
+  }
+
+  foreach (int i, separateRules) {
+    const DeclarativeHighlightRule *rule = compiledRules.at(i);
+
+    QRegularExpression separate(rule->pattern());
+    if (!rule->caseSensitive())
+      separate.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
+    separate.optimize();
+
+    expressions << separate;
+    expressionRules << i;
+  }
+
+  for (int i = 0; i < compiledRules.count(); ++i) {
+    DeclarativeHighlightRule *rule = compiledRules.at(i);
+
+    QTextCharFormat format;
+    if (rule->color().isValid())
+      format.setForeground(rule->color());
+    if (rule->background().isValid())
+      format.setBackground(rule->background());
+    if (rule->bold())
+      format.setFontWeight(QFont::Bold);
+    if (rule->italic())
+      format.setFontItalic(true);
+    if (rule->underline())
+      format.setFontUnderline(true);
+
+    ruleFormats << format;
+  }
+}
+
+void DeclarativeSyntaxHighlighter::Private::findMatch(int expressionIndex, const QString &text, int from,
+                                                     RuleMatch *match) const
+{
+  match->start = -1;
+  if (from > text.length())
+    return;
+
+  const QRegularExpressionMatch result = expressions.at(expressionIndex).match(text, from);
+  if (!result.hasMatch())
+    return;
+
+  match->rule = expressionRules.at(expressionIndex);
+  if (match->rule < 0) {
+    for (int i = 0; i < ruleGroups.count(); ++i) {
+      if (ruleGroups.at(i) >= 0 && result.capturedStart(ruleGroups.at(i)) >= 0) {
+        match->rule = i;
+        break;
+      }
+    }
+  }
+
+  match->start = result.capturedStart();
+  match->end = result.capturedEnd();
+}
+
+void DeclarativeSyntaxHighlighter::Private::highlightBlock(QTextBlock block)
+{
+  QVector<QTextLayout::FormatRange> ranges;
+
+  if (expressions.count() == 1 && expressionRules.first() < 0) {
+    QRegularExpressionMatchIterator it = expressions.first().globalMatch(block.text());
+    while (it.hasNext()) {
+      const QRegularExpressionMatch match = it.next();
+      if (match.capturedLength() == 0)
+        continue;
+
+      for (int i = 0; i < ruleGroups.count(); ++i) {
+        if (match.capturedStart(ruleGroups.at(i)) < 0)
+          continue;
+
+        QTextLayout::FormatRange range;
+        range.start = match.capturedStart();
+        range.length = match.capturedLength();
+        range.format = ruleFormats.at(i);
+        ranges << range;
+        break;
+      }
+    }
+  } else if (!expressions.isEmpty()) {
+    // merges the matches of all expressions like the alternatives of a single one:
+    // the leftmost match wins, on the same position the one of the earlier rule
+    const QString text = block.text();
+
+    QVector<RuleMatch> matches(expressions.count());
+    for (int i = 0; i < expressions.count(); ++i)
+      findMatch(i, text, 0, &matches[i]);
+
+    forever {
+      int best = -1;
+      for (int i = 0; i < matches.count(); ++i) {
+        const RuleMatch &match = matches.at(i);
+        if (match.start < 0)
+          continue;
+
+        if (best < 0 || match.start < matches.at(best).start ||
+            (match.start == matches.at(best).start && match.rule < matches.at(best).rule))
+          best = i;
+      }
+
+      if (best < 0)
+        break;
+
+      const RuleMatch match = matches.at(best);
+      if (match.end == match.start) {
+        findMatch(best, text, match.start + 1, &matches[best]);
+        continue;
+      }
+
+      QTextLayout::FormatRange range;
+      range.start = match.start;
+      range.length = match.end - match.start;
+      range.format = ruleFormats.at(match.rule);
+      ranges << range;
+
+      // matches overlapping this one are gone
+      for (int i = 0; i < matches.count(); ++i) {
+        if (matches.at(i).start >= 0 && matches.at(i).start < match.end)
+          findMatch(i, text, match.end, &matches[i]);
+      }
+    }
+  }
+
+  block.setUserState(generation);
+
+  QTextLayout *layout = block.layout();
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+  if (ranges.isEmpty() && layout->formats().isEmpty())
+    return;
+
+  layout->setFormats(ranges);
+#else
+  if (ranges.isEmpty() && layout->additionalFormats().isEmpty())
+    return;
+
+  layout->setAdditionalFormats(ranges.toList());
+#endif
+
+  // like QSyntaxHighlighter, this makes the document emit contentsChange()
+  applyingFormats = true;
+  document->markContentsDirty(block.position(), block.length());
+  applyingFormats = false;
+}
+
+void DeclarativeSyntaxHighlighter::Private::scheduleFrom(int blockNumber)
+{
+  if (!document || !componentComplete)
+    return;
+
+  scanBlock = scanBlock < 0 ? blockNumber : qMin(scanBlock, blockNumber);
+  timer->start();
+  setBusy(true);
+}
+
+void DeclarativeSyntaxHighlighter::Private::setBusy(bool value)
+{
+  if (busy == value)
+    return;
+
+  busy = value;
+  if (!busy) {
+    timer->stop();
+    scanBlock = -1;
+  }
+
+  emit q->busyChanged(busy);
+}
+
+DeclarativeSyntaxHighlighter::DeclarativeSyntaxHighlighter(QObject *parent)
+  : QObject(parent)
+  , d(new Private(this))
+{
+  d->timer = new QTimer(this);
+  d->timer->setInterval(0);
+  connect(d->timer, SIGNAL(timeout()), this, SLOT(highlightPending()));
+}
+
+DeclarativeSyntaxHighlighter::~DeclarativeSyntaxHighlighter()
+{
+  delete d;
+}
+
+void DeclarativeSyntaxHighlighter::setDocument(QTextDocument *document)
+{
+  if (d->document == document)
+    return;
+
+  if (d->document)
+    disconnect(d->document, 0, this, 0);
+
+  d->setBusy(false);
+  d->document = document;
+
+  if (document)
+    connect(document, SIGNAL(contentsChange(int,int,int)), this, SLOT(onContentsChange(int,int,int)));
+
+  emit documentChanged();
+
+  rehighlight();
+}
+
+QTextDocument *DeclarativeSyntaxHighlighter::document() const
+{
+  return d->document;
+}
+
+QQmlListProperty<DeclarativeHighlightRule> DeclarativeSyntaxHighlighter::rules()
+{
+  return QQmlListProperty<DeclarativeHighlightRule>(this, 0, DeclarativeSyntaxHighlighter::rules_append,
+                                                             DeclarativeSyntaxHighlighter::rules_count,
+                                                             DeclarativeSyntaxHighlighter::rules_at,
+                                                             DeclarativeSyntaxHighlighter::rules_clear);
+}
+
+bool DeclarativeSyntaxHighlighter::isBusy() const
+{
+  return d->busy;
+}
+
+void DeclarativeSyntaxHighlighter::rehighlight()
+{
+  ++d->generation;
+  d->scheduleFrom(0);
+}
+
+void DeclarativeSyntaxHighlighter::classBegin()
+{
+  d->componentComplete = false;
+}
+
+void DeclarativeSyntaxHighlighter::componentComplete()
+{
+  d->componentComplete = true;
+  rehighlight();
+}
+
+void DeclarativeSyntaxHighlighter::onContentsChange(int position, int charsRemoved, int charsAdded)
+{
+  Q_UNUSED(charsRemoved);
+
+  if (d->applyingFormats || !d->componentComplete)
+    return;
+
+  if (!d->compiled)
+    d->compile();
+
+  QTextBlock block = d->document->findBlock(position);
+  const QTextBlock last = d->document->findBlock(position + charsAdded);
+  if (!block.isValid())
+    return;
+
+  const int lastNumber = last.isValid() ? last.blockNumber() : d->document->blockCount() - 1;
+
+  if (lastNumber - block.blockNumber() < s_synchronousBlockLimit) {
+    for (; block.isValid() && block.blockNumber() <= lastNumber; block = block.next())
+      d->highlightBlock(block);
+    return;
+  }
+
+  // the blocks in between are new and therefore dirty, only the edited ones at the ends keep their state
+  d->highlightBlock(block);
+  if (last.isValid())
+    d->highlightBlock(last);
+
+  d->scheduleFrom(block.blockNumber() + 1);
+}
+
+void DeclarativeSyntaxHighlighter::onRuleChanged()
+{
+  d->compiled = false;
+  rehighlight();
+}
+
+void DeclarativeSyntaxHighlighter::highlightPending()
+{
+  if (!d->document) {
+    d->setBusy(false);
+    return;
+  }
+
+  if (!d->compiled)
+    d->compile();
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QTextBlock block = d->document->findBlockByNumber(d->scanBlock);
+  int processed = 0;
+  while (block.isValid()) {
+    if (block.userState() != d->generation)
+      d->highlightBlock(block);
+
+    block = block.next();
+
+    if (++processed % 64 == 0 && timer.elapsed() >= s_highlightTimeSlice) {
+      if (block.isValid())
+        d->scanBlock = block.blockNumber();
+      break;
+    }
+  }
+
+  if (!block.isValid())
+    d->setBusy(false);
+}
+
+void DeclarativeSyntaxHighlighter::rules_append(QQmlListProperty<DeclarativeHighlightRule> *property, DeclarativeHighlightRule *rule)
+{
+  DeclarativeSyntaxHighlighter *that = static_cast<DeclarativeSyntaxHighlighter*>(property->object);
+  if (!rule)
+    return;
+
+  that->d->rules.append(rule);
+  connect(rule, SIGNAL(changed()), that, SLOT(onRuleChanged()));
+  that->onRuleChanged();
+}
+
+int DeclarativeSyntaxHighlighter::rules_count(QQmlListProperty<DeclarativeHighlightRule> *property)
+{
+  DeclarativeSyntaxHighlighter *that = static_cast<DeclarativeSyntaxHighlighter*>(property->object);
+  return that->d->rules.count();
+}
+
+DeclarativeHighlightRule *DeclarativeSyntaxHighlighter::rules_at(QQmlListProperty<DeclarativeHighlightRule> *property, int index)
+{
+  DeclarativeSyntaxHighlighter *that = static_cast<DeclarativeSyntaxHighlighter*>(property->object);
+  return that->d->rules.value(index);
+}
+
+void DeclarativeSyntaxHighlighter::rules_clear(QQmlListProperty<DeclarativeHighlightRule> *property)
+{
+  DeclarativeSyntaxHighlighter *that = static_cast<DeclarativeSyntaxHighlighter*>(property->object);
+
+  foreach (DeclarativeHighlightRule *rule, that->d->rules)
+    disconnect(rule, 0, that, 0);
+
+  that->d->rules.clear();
+  that->onRuleChanged();
+}
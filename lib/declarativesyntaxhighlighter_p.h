@@ -0,0 +1,138 @@
+/*
+  declarativesyntaxhighlighter_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVESYNTAXHIGHLIGHTER_P_H
+#define DECLARATIVESYNTAXHIGHLIGHTER_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QColor>
+#include <QObject>
+#include <QQmlListProperty>
+#include <QQmlParserStatus>
+
+QT_BEGIN_NAMESPACE
+class QTextDocument;
+QT_END_NAMESPACE
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeHighlightRule : public QObject
+{
+  Q_OBJECT
+  Q_PROPERTY(QString pattern READ pattern WRITE setPattern NOTIFY changed)
+  Q_PROPERTY(bool caseSensitive READ caseSensitive WRITE setCaseSensitive NOTIFY changed)
+  Q_PROPERTY(QColor color READ color WRITE setColor NOTIFY changed)
+  Q_PROPERTY(QColor background READ background WRITE setBackground NOTIFY changed)
+  Q_PROPERTY(bool bold READ bold WRITE setBold NOTIFY changed)
+  Q_PROPERTY(bool italic READ italic WRITE setItalic NOTIFY changed)
+  Q_PROPERTY(bool underline READ underline WRITE setUnderline NOTIFY changed)
+
+  public:
+    explicit DeclarativeHighlightRule(QObject *parent = 0);
+
+    void setPattern(const QString &pattern);
+    QString pattern() const;
+
+    void setCaseSensitive(bool caseSensitive);
+    bool caseSensitive() const;
+
+    void setColor(const QColor &color);
+    QColor color() const;
+
+    void setBackground(const QColor &background);
+    QColor background() const;
+
+    void setBold(bool bold);
+    bool bold() const;
+
+    void setItalic(bool italic);
+    bool italic() const;
+
+    void setUnderline(bool underline);
+    bool underline() const;
+
+  Q_SIGNALS:
+    void changed();
+
+  private:
+    QString m_pattern;
+    bool m_caseSensitive;
+    QColor m_color;
+    QColor m_background;
+    bool m_bold;
+    bool m_italic;
+    bool m_underline;
+};
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeSyntaxHighlighter : public QObject, public QQmlParserStatus
+{
+  Q_OBJECT
+  Q_INTERFACES(QQmlParserStatus)
+
+  Q_PROPERTY(QTextDocument* document READ document WRITE setDocument NOTIFY documentChanged)
+  Q_PROPERTY(QQmlListProperty<DeclarativeHighlightRule> rules READ rules DESIGNABLE false)
+  Q_PROPERTY(bool busy READ isBusy NOTIFY busyChanged)
+
+  Q_CLASSINFO("DefaultProperty", "rules")
+
+  public:
+    explicit DeclarativeSyntaxHighlighter(QObject *parent = 0);
+    ~DeclarativeSyntaxHighlighter();
+
+    void setDocument(QTextDocument *document);
+    QTextDocument *document() const;
+
+    QQmlListProperty<DeclarativeHighlightRule> rules();
+
+    bool isBusy() const;
+
+    Q_INVOKABLE void rehighlight();
+
+    void classBegin();
+    void componentComplete();
+
+    // true for patterns that can not be joined with other rules into one expression
+    static bool hasAbsoluteGroupReference(const QString &pattern);
+
+  Q_SIGNALS:
+    void documentChanged();
+    void busyChanged(bool busy);
+
+  private Q_SLOTS:
+    void onContentsChange(int position, int charsRemoved, int charsAdded);
+    void onRuleChanged();
+    void highlightPending();
+
+  private:
+    static void rules_append(QQmlListProperty<DeclarativeHighlightRule> *property, DeclarativeHighlightRule *rule);
+    static int rules_count(QQmlListProperty<DeclarativeHighlightRule> *property);
+    static DeclarativeHighlightRule *rules_at(QQmlListProperty<DeclarativeHighlightRule> *property, int index);
+    static void rules_clear(QQmlListProperty<DeclarativeHighlightRule> *property);
+
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVESYNTAXHIGHLIGHTER_P_H
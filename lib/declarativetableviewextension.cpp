@@ -27,10 +27,16 @@
 
 #include "declarativetableviewextension_p.h"
 
+#include "headerviewsampler_p.h"
+
+#include <QHeaderView>
 #include <QTableView>
 
 DeclarativeTableViewExtension::DeclarativeTableViewExtension(QObject *parent)
   : DeclarativeItemViewExtension(parent)
+  , m_sampledResizeColumnsToContents(false)
+  , m_sampledResizeRowsToContents(false)
+  , m_sampleSize(HeaderViewSampler::DefaultSampleSize)
 {
 }
 
@@ -48,6 +54,8 @@ void DeclarativeTableViewExtension::setHorizontalHeader(QHeaderView *header)
     return;
 
   extendedTableView()->setHorizontalHeader(header);
+  HeaderViewSampler::configure(header, m_sampledResizeColumnsToContents, m_sampleSize);
+
   emit horizontalHeaderChanged(header);
 }
 
@@ -62,6 +70,8 @@ void DeclarativeTableViewExtension::setVerticalHeader(QHeaderView *header)
     return;
 
   extendedTableView()->setVerticalHeader(header);
+  HeaderViewSampler::configure(header, m_sampledResizeRowsToContents, m_sampleSize);
+
   emit verticalHeaderChanged(header);
 }
 
@@ -69,3 +79,53 @@ QHeaderView *DeclarativeTableViewExtension::verticalHeader() const
 {
   return extendedTableView()->verticalHeader();
 }
+
+void DeclarativeTableViewExtension::setSampledResizeColumnsToContents(bool enable)
+{
+  if (enable == m_sampledResizeColumnsToContents)
+    return;
+
+  m_sampledResizeColumnsToContents = enable;
+  HeaderViewSampler::configure(horizontalHeader(), enable, m_sampleSize);
+
+  emit sampledResizeColumnsToContentsChanged(enable);
+}
+
+bool DeclarativeTableViewExtension::sampledResizeColumnsToContents() const
+{
+  return m_sampledResizeColumnsToContents;
+}
+
+void DeclarativeTableViewExtension::setSampledResizeRowsToContents(bool enable)
+{
+  if (enable == m_sampledResizeRowsToContents)
+    return;
+
+  m_sampledResizeRowsToContents = enable;
+  HeaderViewSampler::configure(verticalHeader(), enable, m_sampleSize);
+
+  emit sampledResizeRowsToContentsChanged(enable);
+}
+
+bool DeclarativeTableViewExtension::sampledResizeRowsToContents() const
+{
+  return m_sampledResizeRowsToContents;
+}
+
+void DeclarativeTableViewExtension::setSampleSize(int sampleSize)
+{
+  sampleSize = qMax(1, sampleSize);
+  if (sampleSize == m_sampleSize)
+    return;
+
+  m_sampleSize = sampleSize;
+  HeaderViewSampler::configure(horizontalHeader(), m_sampledResizeColumnsToContents, sampleSize);
+  HeaderViewSampler::configure(verticalHeader(), m_sampledResizeRowsToContents, sampleSize);
+
+  emit sampleSizeChanged(sampleSize);
+}
+
+int DeclarativeTableViewExtension::sampleSize() const
+{
+  return m_sampleSize;
+}
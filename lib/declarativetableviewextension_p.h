@@ -42,6 +42,9 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeTableViewExtension : public Declarati
 
   Q_PROPERTY(QHeaderView* horizontalHeader READ horizontalHeader WRITE setHorizontalHeader NOTIFY horizontalHeaderChanged)
   Q_PROPERTY(QHeaderView* verticalHeader READ verticalHeader WRITE setVerticalHeader NOTIFY verticalHeaderChanged)
+  Q_PROPERTY(bool sampledResizeColumnsToContents READ sampledResizeColumnsToContents WRITE setSampledResizeColumnsToContents NOTIFY sampledResizeColumnsToContentsChanged)
+  Q_PROPERTY(bool sampledResizeRowsToContents READ sampledResizeRowsToContents WRITE setSampledResizeRowsToContents NOTIFY sampledResizeRowsToContentsChanged)
+  Q_PROPERTY(int sampleSize READ sampleSize WRITE setSampleSize NOTIFY sampleSizeChanged)
 
   // repeat property declarations, qmlRegisterExtendedType doesn't see the ones from base class
   Q_PROPERTY(QAbstractItemModel* model READ model WRITE setModel NOTIFY modelChanged)
@@ -62,12 +65,32 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeTableViewExtension : public Declarati
     void setVerticalHeader(QHeaderView *header);
     QHeaderView *verticalHeader() const;
 
+    // column widths and the row height are estimated from at most sampleSize rows,
+    // see HeaderViewSampler
+    void setSampledResizeColumnsToContents(bool enable);
+    bool sampledResizeColumnsToContents() const;
+
+    void setSampledResizeRowsToContents(bool enable);
+    bool sampledResizeRowsToContents() const;
+
+    void setSampleSize(int sampleSize);
+    int sampleSize() const;
+
   Q_SIGNALS:
     void modelChanged(QAbstractItemModel *model);
     void selectionModelChanged(QItemSelectionModel *selectionModel);
 
     void horizontalHeaderChanged(QHeaderView *header);
     void verticalHeaderChanged(QHeaderView *header);
+
+    void sampledResizeColumnsToContentsChanged(bool enable);
+    void sampledResizeRowsToContentsChanged(bool enable);
+    void sampleSizeChanged(int sampleSize);
+
+  private:
+    bool m_sampledResizeColumnsToContents;
+    bool m_sampledResizeRowsToContents;
+    int m_sampleSize;
 };
 
 #endif // DECLARATIVETABLEVIEWEXTENSION_P_H
@@ -0,0 +1,289 @@
+/*
+  declarativetextdocumentbuilder.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativetextdocumentbuilder_p.h"
+
+#include "declarativetexteditextension_p.h"
+
+#include <QFile>
+#include <QFutureWatcher>
+#include <QPointer>
+#include <QQmlInfo>
+#include <QTextCodec>
+#include <QTextDocument>
+#include <QTextEdit>
+#include <QThread>
+#include <QtConcurrent>
+
+struct TextDocumentBuildResult
+{
+  TextDocumentBuildResult()
+    : document(0)
+  {}
+
+  QTextDocument *document;
+  QString errorString;
+};
+
+typedef QFutureWatcher<TextDocumentBuildResult> TextDocumentBuildWatcher;
+
+static TextDocumentBuildResult buildDocument(const QString &text, const QString &fileName,
+                                             DeclarativeTextDocumentBuilder::Format format, QThread *targetThread)
+{
+  TextDocumentBuildResult result;
+
+  QString content = text;
+  if (!fileName.isEmpty()) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+      result.errorString = file.errorString();
+      return result;
+    }
+
+    const QByteArray data = file.readAll();
+    if (format == DeclarativeTextDocumentBuilder::Html)
+      content = QTextCodec::codecForHtml(data, QTextCodec::codecForName("UTF-8"))->toUnicode(data);
+    else
+      content = QString::fromUtf8(data);
+  }
+
+  // QTextDocument is reentrant, it only has to end up in the thread of the widget showing it
+  QTextDocument *document = new QTextDocument;
+
+  switch (format) {
+  case DeclarativeTextDocumentBuilder::Html:
+    document->setHtml(content);
+    break;
+
+  case DeclarativeTextDocumentBuilder::Markdown:
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+    document->setMarkdown(content);
+    break;
+#endif
+
+  case DeclarativeTextDocumentBuilder::PlainText:
+    document->setPlainText(content);
+    break;
+  }
+
+  document->setModified(false);
+  document->moveToThread(targetThread);
+
+  result.document = document;
+  return result;
+}
+
+class DeclarativeTextDocumentBuilder::Private
+{
+  public:
+    Private()
+      : format(PlainText)
+      , watcher(0)
+    {}
+
+    void assignToTarget(QTextDocument *previous);
+
+    QString text;
+    QString fileName;
+    Format format;
+    QPointer<QWidget> target;
+
+    QPointer<QTextDocument> document;
+    TextDocumentBuildWatcher *watcher;
+    QList<TextDocumentBuildWatcher*> runningWatchers;
+};
+
+void DeclarativeTextDocumentBuilder::Private::assignToTarget(QTextDocument *previous)
+{
+  QTextEdit *textEdit = qobject_cast<QTextEdit*>(target);
+  if (!textEdit)
+    return;
+
+  const bool replacesPrevious = previous && textEdit->document() == previous;
+
+  // going through the extension keeps its modified and documentChanged notifications intact
+  DeclarativeTextEditExtension *extension =
+    textEdit->findChild<DeclarativeTextEditExtension*>(QString(), Qt::FindDirectChildrenOnly);
+  if (extension)
+    extension->setDocument(document);
+  else
+    textEdit->setDocument(document);
+
+  document->setParent(textEdit);
+
+  // the document built before is owned by the target as well, unless someone took it over
+  if (replacesPrevious && previous->parent() == textEdit)
+    previous->deleteLater();
+}
+
+DeclarativeTextDocumentBuilder::DeclarativeTextDocumentBuilder(QObject *parent)
+  : QObject(parent)
+  , d(new Private)
+{
+}
+
+DeclarativeTextDocumentBuilder::~DeclarativeTextDocumentBuilder()
+{
+  // results of builds that are still running have nobody else to clean them up
+  foreach (TextDocumentBuildWatcher *watcher, d->runningWatchers) {
+    watcher->waitForFinished();
+    delete watcher->result().document;
+  }
+
+  delete d;
+}
+
+void DeclarativeTextDocumentBuilder::setText(const QString &text)
+{
+  if (d->text == text)
+    return;
+
+  d->text = text;
+  emit textChanged(text);
+}
+
+QString DeclarativeTextDocumentBuilder::text() const
+{
+  return d->text;
+}
+
+void DeclarativeTextDocumentBuilder::setFileName(const QString &fileName)
+{
+  if (d->fileName == fileName)
+    return;
+
+  d->fileName = fileName;
+  emit fileNameChanged(fileName);
+}
+
+QString DeclarativeTextDocumentBuilder::fileName() const
+{
+  return d->fileName;
+}
+
+void DeclarativeTextDocumentBuilder::setFormat(Format format)
+{
+  if (d->format == format)
+    return;
+
+#if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
+  if (format == Markdown)
+    qmlInfo(this) << "Markdown requires Qt 5.14, the text will be imported as plain text";
+#endif
+
+  d->format = format;
+  emit formatChanged(format);
+}
+
+DeclarativeTextDocumentBuilder::Format DeclarativeTextDocumentBuilder::format() const
+{
+  return d->format;
+}
+
+void DeclarativeTextDocumentBuilder::setTarget(QWidget *target)
+{
+  if (d->target == target)
+    return;
+
+  if (target && !qobject_cast<QTextEdit*>(target)) {
+    qmlInfo(this) << "Target has to be a TextEdit or TextBrowser";
+    return;
+  }
+
+  d->target = target;
+  emit targetChanged(target);
+}
+
+QWidget *DeclarativeTextDocumentBuilder::target() const
+{
+  return d->target;
+}
+
+QTextDocument *DeclarativeTextDocumentBuilder::document() const
+{
+  return d->document;
+}
+
+bool DeclarativeTextDocumentBuilder::isBuilding() const
+{
+  return d->watcher != 0;
+}
+
+void DeclarativeTextDocumentBuilder::build()
+{
+  const bool wasBuilding = isBuilding();
+
+  // a running build can not be interrupted, its result is dropped when it arrives
+  d->watcher = new TextDocumentBuildWatcher(this);
+  connect(d->watcher, SIGNAL(finished()), this, SLOT(onJobFinished()));
+  d->runningWatchers.append(d->watcher);
+  d->watcher->setFuture(QtConcurrent::run(buildDocument, d->text, d->fileName, d->format, thread()));
+
+  if (!wasBuilding)
+    emit buildingChanged(true);
+}
+
+void DeclarativeTextDocumentBuilder::cancel()
+{
+  if (!d->watcher)
+    return;
+
+  d->watcher = 0;
+  emit buildingChanged(false);
+}
+
+void DeclarativeTextDocumentBuilder::onJobFinished()
+{
+  TextDocumentBuildWatcher *watcher = static_cast<TextDocumentBuildWatcher*>(sender());
+  const TextDocumentBuildResult result = watcher->result();
+
+  d->runningWatchers.removeOne(watcher);
+  watcher->deleteLater();
+
+  if (watcher != d->watcher) {
+    delete result.document; // superseded or canceled
+    return;
+  }
+
+  d->watcher = 0;
+  emit buildingChanged(false);
+
+  if (!result.document) {
+    emit failed(result.errorString);
+    return;
+  }
+
+  QPointer<QTextDocument> previous = d->document;
+  d->document = result.document;
+
+  if (d->target)
+    d->assignToTarget(previous);
+  else
+    d->document->setParent(this);
+
+  emit documentChanged(d->document);
+  emit built(d->document);
+}
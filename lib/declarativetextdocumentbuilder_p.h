@@ -0,0 +1,100 @@
+/*
+  declarativetextdocumentbuilder_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVETEXTDOCUMENTBUILDER_P_H
+#define DECLARATIVETEXTDOCUMENTBUILDER_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QObject>
+#include <QWidget>
+
+QT_BEGIN_NAMESPACE
+class QTextDocument;
+QT_END_NAMESPACE
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeTextDocumentBuilder : public QObject
+{
+  Q_OBJECT
+  Q_PROPERTY(QString text READ text WRITE setText NOTIFY textChanged)
+  Q_PROPERTY(QString fileName READ fileName WRITE setFileName NOTIFY fileNameChanged)
+  Q_PROPERTY(Format format READ format WRITE setFormat NOTIFY formatChanged)
+  Q_PROPERTY(QWidget* target READ target WRITE setTarget NOTIFY targetChanged)
+  Q_PROPERTY(QTextDocument* document READ document NOTIFY documentChanged)
+  Q_PROPERTY(bool building READ isBuilding NOTIFY buildingChanged)
+  Q_ENUMS(Format)
+
+  public:
+    enum Format {
+      PlainText,
+      Html,
+      Markdown
+    };
+
+    explicit DeclarativeTextDocumentBuilder(QObject *parent = 0);
+    ~DeclarativeTextDocumentBuilder();
+
+    void setText(const QString &text);
+    QString text() const;
+
+    // read on the worker thread, takes precedence over text
+    void setFileName(const QString &fileName);
+    QString fileName() const;
+
+    void setFormat(Format format);
+    Format format() const;
+
+    // a TextEdit or TextBrowser that gets the document once it has been built
+    void setTarget(QWidget *target);
+    QWidget *target() const;
+
+    QTextDocument *document() const;
+
+    bool isBuilding() const;
+
+    Q_INVOKABLE void build();
+    Q_INVOKABLE void cancel();
+
+  Q_SIGNALS:
+    void textChanged(const QString &text);
+    void fileNameChanged(const QString &fileName);
+    void formatChanged(Format format);
+    void targetChanged(QWidget *target);
+    void documentChanged(QTextDocument *document);
+    void buildingChanged(bool building);
+
+    void built(QTextDocument *document);
+    void failed(const QString &errorString);
+
+  private Q_SLOTS:
+    void onJobFinished();
+
+  private:
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVETEXTDOCUMENTBUILDER_P_H
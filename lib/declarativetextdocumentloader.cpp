@@ -0,0 +1,421 @@
+/*
+  declarativetextdocumentloader.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativetextdocumentloader.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QPointer>
+#include <QQmlInfo>
+#include <QQueue>
+#include <QSharedPointer>
+#include <QTextCodec>
+#include <QTextCursor>
+#include <QTextDocument>
+#include <QWaitCondition>
+#include <QtConcurrent>
+
+// decoded chunks waiting for the GUI thread, bounds the memory used when the GUI can not keep up
+static const int s_maxQueuedChunks = 4;
+
+// time the GUI thread spends appending before it returns to the event loop
+static const int s_appendTimeSlice = 15;
+
+struct TextDocumentChunk
+{
+  QString text;
+  qint64 offset;
+};
+
+struct TextDocumentLoadJob
+{
+  TextDocumentLoadJob()
+    : receiver(0)
+    , chunkSize(0)
+    , canceled(false)
+    , finished(false)
+  {}
+
+  // called with the mutex locked, posting an event is safe while the receiver is alive
+  // and cancel() takes the mutex before the receiver goes away
+  void notifyReceiver()
+  {
+    QMetaObject::invokeMethod(receiver, "appendChunks", Qt::QueuedConnection);
+  }
+
+  bool enqueue(const TextDocumentChunk &chunk)
+  {
+    QMutexLocker locker(&mutex);
+    while (chunks.count() >= s_maxQueuedChunks && !canceled)
+      spaceAvailable.wait(&mutex);
+
+    if (canceled)
+      return false;
+
+    if (chunks.isEmpty())
+      notifyReceiver();
+    chunks.enqueue(chunk);
+
+    return true;
+  }
+
+  void finish(const QString &error)
+  {
+    QMutexLocker locker(&mutex);
+    if (canceled)
+      return;
+
+    finished = true;
+    errorString = error;
+    notifyReceiver();
+  }
+
+  QObject *receiver;
+  QString fileName;
+  QByteArray encoding;
+  int chunkSize;
+
+  QMutex mutex;
+  QWaitCondition spaceAvailable;
+  QQueue<TextDocumentChunk> chunks;
+  bool canceled;
+  bool finished;
+  QString errorString;
+};
+
+typedef QSharedPointer<TextDocumentLoadJob> TextDocumentLoadJobPtr;
+
+static void runLoadJob(TextDocumentLoadJobPtr job)
+{
+  QFile file(job->fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    job->finish(file.errorString());
+    return;
+  }
+
+  QTextCodec *codec = QTextCodec::codecForName(job->encoding);
+  if (!codec)
+    codec = QTextCodec::codecForName("UTF-8");
+
+  // the decoder keeps state, multibyte sequences may span chunk boundaries
+  QScopedPointer<QTextDecoder> decoder(codec->makeDecoder());
+
+  const qint64 size = file.size();
+  const uchar *mapped = size > 0 ? file.map(0, size) : 0;
+
+  // a CR ending a chunk waits for the next one, QTextCursor::insertText() would
+  // turn a CR LF pair split across two chunks into two paragraph breaks
+  QString carriedOver;
+
+  qint64 offset = 0;
+  QByteArray buffer;
+  while (offset < size) {
+    qint64 length = qMin<qint64>(job->chunkSize, size - offset);
+
+    const char *data = 0;
+    if (mapped) {
+      data = reinterpret_cast<const char*>(mapped) + offset;
+    } else {
+      buffer = file.read(length);
+      if (buffer.isEmpty())
+        break;
+
+      data = buffer.constData();
+      length = buffer.size();
+    }
+
+    TextDocumentChunk chunk;
+    chunk.text = carriedOver + decoder->toUnicode(data, length);
+    offset += length;
+    chunk.offset = offset;
+
+    carriedOver.clear();
+    if (offset < size && chunk.text.endsWith(QLatin1Char('\r'))) {
+      chunk.text.chop(1);
+      carriedOver = QStringLiteral("\r");
+    }
+
+    if (!job->enqueue(chunk))
+      return;
+  }
+
+  if (!carriedOver.isEmpty()) {
+    TextDocumentChunk chunk;
+    chunk.text = carriedOver;
+    chunk.offset = offset;
+
+    if (!job->enqueue(chunk))
+      return;
+  }
+
+  job->finish(offset < size ? file.errorString() : QString());
+}
+
+class DeclarativeTextDocumentLoader::Private
+{
+  public:
+    Private()
+      : encoding(QStringLiteral("UTF-8"))
+      , chunkSize(256 * 1024)
+      , bytesLoaded(0)
+      , bytesTotal(0)
+      , undoRedoEnabled(true)
+    {}
+
+    void stop();
+
+    QPointer<QTextDocument> document;
+    QString fileName;
+    QString encoding;
+    int chunkSize;
+
+    TextDocumentLoadJobPtr job;
+    qint64 bytesLoaded;
+    qint64 bytesTotal;
+    bool undoRedoEnabled;
+};
+
+void DeclarativeTextDocumentLoader::Private::stop()
+{
+  if (job) {
+    QMutexLocker locker(&job->mutex);
+    job->canceled = true;
+    job->spaceAvailable.wakeAll();
+  }
+
+  job.clear();
+
+  if (document) {
+    document->setUndoRedoEnabled(undoRedoEnabled);
+    document->setModified(false);
+  }
+}
+
+DeclarativeTextDocumentLoader::DeclarativeTextDocumentLoader(QObject *parent)
+  : QObject(parent)
+  , d(new Private)
+{
+}
+
+DeclarativeTextDocumentLoader::~DeclarativeTextDocumentLoader()
+{
+  // leaves documents alone that were not being loaded
+  if (d->job)
+    d->stop();
+
+  delete d;
+}
+
+void DeclarativeTextDocumentLoader::setDocument(QTextDocument *document)
+{
+  if (d->document == document)
+    return;
+
+  cancel();
+
+  d->document = document;
+  emit documentChanged();
+}
+
+QTextDocument *DeclarativeTextDocumentLoader::document() const
+{
+  return d->document;
+}
+
+QString DeclarativeTextDocumentLoader::fileName() const
+{
+  return d->fileName;
+}
+
+void DeclarativeTextDocumentLoader::setEncoding(const QString &encoding)
+{
+  if (d->encoding == encoding)
+    return;
+
+  d->encoding = encoding;
+  emit encodingChanged(encoding);
+}
+
+QString DeclarativeTextDocumentLoader::encoding() const
+{
+  return d->encoding;
+}
+
+void DeclarativeTextDocumentLoader::setChunkSize(int chunkSize)
+{
+  chunkSize = qMax(4096, chunkSize);
+  if (d->chunkSize == chunkSize)
+    return;
+
+  d->chunkSize = chunkSize;
+  emit chunkSizeChanged(chunkSize);
+}
+
+int DeclarativeTextDocumentLoader::chunkSize() const
+{
+  return d->chunkSize;
+}
+
+bool DeclarativeTextDocumentLoader::isLoading() const
+{
+  return !d->job.isNull();
+}
+
+qint64 DeclarativeTextDocumentLoader::bytesLoaded() const
+{
+  return d->bytesLoaded;
+}
+
+qint64 DeclarativeTextDocumentLoader::bytesTotal() const
+{
+  return d->bytesTotal;
+}
+
+qreal DeclarativeTextDocumentLoader::progress() const
+{
+  if (d->bytesTotal <= 0)
+    return isLoading() ? 0.0 : 1.0;
+
+  return qreal(d->bytesLoaded) / d->bytesTotal;
+}
+
+bool DeclarativeTextDocumentLoader::load(const QString &fileName)
+{
+  if (!d->document) {
+    qmlInfo(this) << "Can not load " << fileName << " without a document";
+    return false;
+  }
+
+  cancel();
+
+  if (d->fileName != fileName) {
+    d->fileName = fileName;
+    emit fileNameChanged(fileName);
+  }
+
+  // fail early, the document is only cleared when there is something to replace it with
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly)) {
+    emit failed(file.errorString());
+    return false;
+  }
+
+  d->bytesLoaded = 0;
+  d->bytesTotal = file.size();
+  file.close();
+
+  d->undoRedoEnabled = d->document->isUndoRedoEnabled();
+  d->document->setUndoRedoEnabled(false);
+  d->document->clear();
+
+  d->job = TextDocumentLoadJobPtr(new TextDocumentLoadJob);
+  d->job->receiver = this;
+  d->job->fileName = fileName;
+  d->job->encoding = d->encoding.toLatin1();
+  d->job->chunkSize = d->chunkSize;
+
+  QtConcurrent::run(runLoadJob, d->job);
+
+  emit loadingChanged(true);
+  emit progressChanged();
+
+  return true;
+}
+
+void DeclarativeTextDocumentLoader::cancel()
+{
+  if (!d->job)
+    return;
+
+  d->stop();
+
+  emit loadingChanged(false);
+  emit canceled();
+}
+
+void DeclarativeTextDocumentLoader::appendChunks()
+{
+  // notifications of canceled jobs can still be in the event queue
+  TextDocumentLoadJobPtr job = d->job;
+  if (!job)
+    return;
+
+  if (!d->document) {
+    cancel();
+    return;
+  }
+
+  QTextCursor cursor(d->document);
+  cursor.movePosition(QTextCursor::End);
+
+  QElapsedTimer timer;
+  timer.start();
+
+  forever {
+    TextDocumentChunk chunk;
+    {
+      QMutexLocker locker(&job->mutex);
+      if (job->chunks.isEmpty())
+        break;
+
+      chunk = job->chunks.dequeue();
+      job->spaceAvailable.wakeOne();
+    }
+
+    cursor.insertText(chunk.text);
+    d->bytesLoaded = chunk.offset;
+
+    if (timer.elapsed() >= s_appendTimeSlice)
+      break;
+  }
+
+  // a document being loaded is not modified by the user
+  d->document->setModified(false);
+  emit progressChanged();
+
+  QMutexLocker locker(&job->mutex);
+  if (!job->chunks.isEmpty()) {
+    job->notifyReceiver();
+    return;
+  }
+
+  if (!job->finished)
+    return;
+
+  const QString errorString = job->errorString;
+  locker.unlock();
+
+  d->job.clear();
+  d->document->setUndoRedoEnabled(d->undoRedoEnabled);
+
+  emit loadingChanged(false);
+
+  if (errorString.isEmpty())
+    emit loaded();
+  else
+    emit failed(errorString);
+}
@@ -0,0 +1,96 @@
+/*
+  declarativetextdocumentloader.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVETEXTDOCUMENTLOADER_H
+#define DECLARATIVETEXTDOCUMENTLOADER_H
+
+#include "declarativewidgets_export.h"
+
+#include <QObject>
+
+QT_BEGIN_NAMESPACE
+class QTextDocument;
+QT_END_NAMESPACE
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeTextDocumentLoader : public QObject
+{
+  Q_OBJECT
+
+  Q_PROPERTY(QTextDocument* document READ document WRITE setDocument NOTIFY documentChanged)
+  Q_PROPERTY(QString fileName READ fileName NOTIFY fileNameChanged)
+  Q_PROPERTY(QString encoding READ encoding WRITE setEncoding NOTIFY encodingChanged)
+  Q_PROPERTY(int chunkSize READ chunkSize WRITE setChunkSize NOTIFY chunkSizeChanged)
+  Q_PROPERTY(bool loading READ isLoading NOTIFY loadingChanged)
+  Q_PROPERTY(qint64 bytesLoaded READ bytesLoaded NOTIFY progressChanged)
+  Q_PROPERTY(qint64 bytesTotal READ bytesTotal NOTIFY progressChanged)
+  Q_PROPERTY(qreal progress READ progress NOTIFY progressChanged)
+
+  public:
+    explicit DeclarativeTextDocumentLoader(QObject *parent = 0);
+    ~DeclarativeTextDocumentLoader();
+
+    void setDocument(QTextDocument *document);
+    QTextDocument *document() const;
+
+    QString fileName() const;
+
+    void setEncoding(const QString &encoding);
+    QString encoding() const;
+
+    // number of bytes decoded per step, the document grows by at most that much per event loop iteration
+    void setChunkSize(int chunkSize);
+    int chunkSize() const;
+
+    bool isLoading() const;
+
+    qint64 bytesLoaded() const;
+    qint64 bytesTotal() const;
+    qreal progress() const;
+
+    Q_INVOKABLE bool load(const QString &fileName);
+    Q_INVOKABLE void cancel();
+
+  Q_SIGNALS:
+    void documentChanged();
+    void fileNameChanged(const QString &fileName);
+    void encodingChanged(const QString &encoding);
+    void chunkSizeChanged(int chunkSize);
+    void loadingChanged(bool loading);
+    void progressChanged();
+
+    void loaded();
+    void failed(const QString &errorString);
+    void canceled();
+
+  private Q_SLOTS:
+    void appendChunks();
+
+  private:
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVETEXTDOCUMENTLOADER_H
@@ -0,0 +1,256 @@
+/*
+  declarativetextdocumentsaver.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativetextdocumentsaver.h"
+
+#include <QAtomicInt>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QPointer>
+#include <QQmlInfo>
+#include <QSaveFile>
+#include <QSharedPointer>
+#include <QTextCodec>
+#include <QTextDocument>
+#include <QtConcurrent>
+
+// the text is encoded and written in slices of this many characters
+static const int s_writeSliceSize = 64 * 1024;
+
+struct TextDocumentSaveJob
+{
+  QString text;
+  QString fileName;
+  QByteArray encoding;
+  QAtomicInt canceled;
+  QSharedPointer<QMutex> commitMutex;
+};
+
+typedef QSharedPointer<TextDocumentSaveJob> TextDocumentSaveJobPtr;
+
+// one mutex per file for the jobs writing it, the jobs hold it from their last cancel check
+// through the commit. Only called by save(), so the registry itself needs no lock
+static QSharedPointer<QMutex> commitMutex(const QString &fileName)
+{
+  static QHash<QString, QWeakPointer<QMutex> > mutexes;
+
+  const QString key = QFileInfo(fileName).absoluteFilePath();
+
+  QSharedPointer<QMutex> mutex = mutexes.value(key).toStrongRef();
+  if (!mutex) {
+    mutex = QSharedPointer<QMutex>(new QMutex);
+    mutexes.insert(key, mutex);
+  }
+
+  return mutex;
+}
+
+// returns an error string, empty on success
+static QString runSaveJob(TextDocumentSaveJobPtr job)
+{
+  QTextCodec *codec = QTextCodec::codecForName(job->encoding);
+  if (!codec)
+    codec = QTextCodec::codecForName("UTF-8");
+
+  QScopedPointer<QTextEncoder> encoder(codec->makeEncoder(QTextCodec::IgnoreHeader));
+
+  QSaveFile file(job->fileName);
+  if (!file.open(QIODevice::WriteOnly))
+    return file.errorString();
+
+  // the encoder keeps state, surrogate pairs may span slice boundaries
+  const QString &text = job->text;
+  for (int position = 0; position < text.length(); position += s_writeSliceSize) {
+    if (job->canceled.load()) {
+      file.cancelWriting();
+      return QString();
+    }
+
+    const QByteArray encoded = encoder->fromUnicode(text.constData() + position,
+                                                    qMin(s_writeSliceSize, text.length() - position));
+    if (file.write(encoded) != encoded.size())
+      return file.errorString();
+  }
+
+  // a newer save cancels this job before it starts its own, so once that one has
+  // committed this job sees the flag and can not replace the newer file
+  QMutexLocker locker(job->commitMutex.data());
+
+  if (job->canceled.load()) {
+    file.cancelWriting();
+    return QString();
+  }
+
+  if (!file.commit())
+    return file.errorString();
+
+  return QString();
+}
+
+class DeclarativeTextDocumentSaver::Private
+{
+  public:
+    Private()
+      : encoding(QStringLiteral("UTF-8"))
+      , watcher(0)
+      , revision(-1)
+    {}
+
+    QPointer<QTextDocument> document;
+    QString fileName;
+    QString encoding;
+
+    TextDocumentSaveJobPtr job;
+    QFutureWatcher<QString> *watcher;
+    int revision;
+};
+
+DeclarativeTextDocumentSaver::DeclarativeTextDocumentSaver(QObject *parent)
+  : QObject(parent)
+  , d(new Private)
+{
+  d->watcher = new QFutureWatcher<QString>(this);
+  connect(d->watcher, SIGNAL(finished()), this, SLOT(onJobFinished()));
+}
+
+DeclarativeTextDocumentSaver::~DeclarativeTextDocumentSaver()
+{
+  // a save that is already running is completed, the file is left consistent either way
+  d->watcher->waitForFinished();
+  delete d;
+}
+
+void DeclarativeTextDocumentSaver::setDocument(QTextDocument *document)
+{
+  if (d->document == document)
+    return;
+
+  d->document = document;
+  emit documentChanged();
+}
+
+QTextDocument *DeclarativeTextDocumentSaver::document() const
+{
+  return d->document;
+}
+
+QString DeclarativeTextDocumentSaver::fileName() const
+{
+  return d->fileName;
+}
+
+void DeclarativeTextDocumentSaver::setEncoding(const QString &encoding)
+{
+  if (d->encoding == encoding)
+    return;
+
+  d->encoding = encoding;
+  emit encodingChanged(encoding);
+}
+
+QString DeclarativeTextDocumentSaver::encoding() const
+{
+  return d->encoding;
+}
+
+bool DeclarativeTextDocumentSaver::isSaving() const
+{
+  return !d->job.isNull();
+}
+
+bool DeclarativeTextDocumentSaver::save(const QString &fileName)
+{
+  if (!d->document) {
+    qmlInfo(this) << "Can not save " << fileName << " without a document";
+    return false;
+  }
+
+  if (fileName.isEmpty()) {
+    qmlInfo(this) << "Can not save to an empty file name";
+    return false;
+  }
+
+  const bool wasSaving = isSaving();
+  if (d->job)
+    d->job->canceled.store(1);
+
+  if (d->fileName != fileName) {
+    d->fileName = fileName;
+    emit fileNameChanged(fileName);
+  }
+
+  // one copy of the plain text is the cheapest consistent snapshot, unlike clone() it
+  // does not rebuild the document structure, encoding and writing happen on the worker
+  d->job = TextDocumentSaveJobPtr(new TextDocumentSaveJob);
+  d->job->text = d->document->toPlainText();
+  d->job->fileName = fileName;
+  d->job->encoding = d->encoding.toLatin1();
+  d->job->commitMutex = commitMutex(fileName);
+  d->revision = d->document->revision();
+
+  d->watcher->setFuture(QtConcurrent::run(runSaveJob, d->job));
+
+  if (!wasSaving)
+    emit savingChanged(true);
+
+  return true;
+}
+
+void DeclarativeTextDocumentSaver::cancel()
+{
+  if (!d->job)
+    return;
+
+  d->job->canceled.store(1);
+  d->job.clear();
+
+  emit savingChanged(false);
+  emit canceled();
+}
+
+void DeclarativeTextDocumentSaver::onJobFinished()
+{
+  if (!d->job)
+    return; // canceled
+
+  const QString errorString = d->watcher->result();
+  d->job.clear();
+
+  emit savingChanged(false);
+
+  if (!errorString.isEmpty()) {
+    emit failed(errorString);
+    return;
+  }
+
+  // edits made while saving keep the document modified
+  if (d->document && d->document->revision() == d->revision)
+    d->document->setModified(false);
+
+  emit saved(d->fileName);
+}
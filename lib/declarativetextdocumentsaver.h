@@ -0,0 +1,83 @@
+/*
+  declarativetextdocumentsaver.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVETEXTDOCUMENTSAVER_H
+#define DECLARATIVETEXTDOCUMENTSAVER_H
+
+#include "declarativewidgets_export.h"
+
+#include <QObject>
+
+QT_BEGIN_NAMESPACE
+class QTextDocument;
+QT_END_NAMESPACE
+
+class DECLARATIVEWIDGETS_EXPORT DeclarativeTextDocumentSaver : public QObject
+{
+  Q_OBJECT
+
+  Q_PROPERTY(QTextDocument* document READ document WRITE setDocument NOTIFY documentChanged)
+  Q_PROPERTY(QString fileName READ fileName NOTIFY fileNameChanged)
+  Q_PROPERTY(QString encoding READ encoding WRITE setEncoding NOTIFY encodingChanged)
+  Q_PROPERTY(bool saving READ isSaving NOTIFY savingChanged)
+
+  public:
+    explicit DeclarativeTextDocumentSaver(QObject *parent = 0);
+    ~DeclarativeTextDocumentSaver();
+
+    void setDocument(QTextDocument *document);
+    QTextDocument *document() const;
+
+    QString fileName() const;
+
+    void setEncoding(const QString &encoding);
+    QString encoding() const;
+
+    bool isSaving() const;
+
+    // writes a snapshot of the document, the file is only replaced once all of it has been written
+    Q_INVOKABLE bool save(const QString &fileName);
+    Q_INVOKABLE void cancel();
+
+  Q_SIGNALS:
+    void documentChanged();
+    void fileNameChanged(const QString &fileName);
+    void encodingChanged(const QString &encoding);
+    void savingChanged(bool saving);
+
+    void saved(const QString &fileName);
+    void failed(const QString &errorString);
+    void canceled();
+
+  private Q_SLOTS:
+    void onJobFinished();
+
+  private:
+    class Private;
+    Private *const d;
+};
+
+#endif // DECLARATIVETEXTDOCUMENTSAVER_H
@@ -27,11 +27,18 @@
 
 #include "declarativetreeviewextension_p.h"
 
+#include "declarativelazytreemodel_p.h"
+#include "headerviewsampler_p.h"
+
+#include <QHeaderView>
 #include <QTreeView>
 
 DeclarativeTreeViewExtension::DeclarativeTreeViewExtension(QObject *parent)
   : DeclarativeItemViewExtension(parent)
+  , m_sampledResizeColumnsToContents(false)
+  , m_sampleSize(HeaderViewSampler::DefaultSampleSize)
 {
+  connect(extendedTreeView(), SIGNAL(collapsed(QModelIndex)), this, SLOT(onCollapsed(QModelIndex)));
 }
 
 QTreeView *DeclarativeTreeViewExtension::extendedTreeView() const
@@ -48,6 +55,8 @@ void DeclarativeTreeViewExtension::setHeader(QHeaderView *header)
     return;
 
   extendedTreeView()->setHeader(header);
+  HeaderViewSampler::configure(header, m_sampledResizeColumnsToContents, m_sampleSize);
+
   emit headerChanged(header);
 }
 
@@ -55,3 +64,44 @@ QHeaderView *DeclarativeTreeViewExtension::header() const
 {
   return extendedTreeView()->header();
 }
+
+void DeclarativeTreeViewExtension::setSampledResizeColumnsToContents(bool enable)
+{
+  if (enable == m_sampledResizeColumnsToContents)
+    return;
+
+  m_sampledResizeColumnsToContents = enable;
+  HeaderViewSampler::configure(header(), enable, m_sampleSize);
+
+  emit sampledResizeColumnsToContentsChanged(enable);
+}
+
+bool DeclarativeTreeViewExtension::sampledResizeColumnsToContents() const
+{
+  return m_sampledResizeColumnsToContents;
+}
+
+void DeclarativeTreeViewExtension::setSampleSize(int sampleSize)
+{
+  sampleSize = qMax(1, sampleSize);
+  if (sampleSize == m_sampleSize)
+    return;
+
+  m_sampleSize = sampleSize;
+  HeaderViewSampler::configure(header(), m_sampledResizeColumnsToContents, sampleSize);
+
+  emit sampleSizeChanged(sampleSize);
+}
+
+int DeclarativeTreeViewExtension::sampleSize() const
+{
+  return m_sampleSize;
+}
+
+void DeclarativeTreeViewExtension::onCollapsed(const QModelIndex &index)
+{
+  // a node that is collapsed before its children arrived does not need them anymore
+  DeclarativeLazyTreeModel *lazyModel = qobject_cast<DeclarativeLazyTreeModel*>(extendedTreeView()->model());
+  if (lazyModel)
+    lazyModel->cancel(index);
+}
@@ -31,6 +31,8 @@
 #include "declarativewidgets_export.h"
 #include "declarativeitemviewextension_p.h"
 
+#include <QModelIndex>
+
 QT_BEGIN_NAMESPACE
 class QHeaderView;
 class QTreeView;
@@ -41,6 +43,8 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeTreeViewExtension : public Declarativ
   Q_OBJECT
 
   Q_PROPERTY(QHeaderView* header READ header WRITE setHeader NOTIFY headerChanged)
+  Q_PROPERTY(bool sampledResizeColumnsToContents READ sampledResizeColumnsToContents WRITE setSampledResizeColumnsToContents NOTIFY sampledResizeColumnsToContentsChanged)
+  Q_PROPERTY(int sampleSize READ sampleSize WRITE setSampleSize NOTIFY sampleSizeChanged)
 
   // repeat property declarations, qmlRegisterExtendedType doesn't see the ones from base class
   Q_PROPERTY(QAbstractItemModel* model READ model WRITE setModel NOTIFY modelChanged)
@@ -58,11 +62,28 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeTreeViewExtension : public Declarativ
     void setHeader(QHeaderView *header);
     QHeaderView *header() const;
 
+    // column widths are estimated from at most sampleSize expanded rows, see HeaderViewSampler
+    void setSampledResizeColumnsToContents(bool enable);
+    bool sampledResizeColumnsToContents() const;
+
+    void setSampleSize(int sampleSize);
+    int sampleSize() const;
+
   Q_SIGNALS:
     void modelChanged(QAbstractItemModel *model);
     void selectionModelChanged(QItemSelectionModel *selectionModel);
 
     void headerChanged(QHeaderView *header);
+
+    void sampledResizeColumnsToContentsChanged(bool enable);
+    void sampleSizeChanged(int sampleSize);
+
+  private Q_SLOTS:
+    void onCollapsed(const QModelIndex &index);
+
+  private:
+    bool m_sampledResizeColumnsToContents;
+    int m_sampleSize;
 };
 
 #endif // DECLARATIVETREEVIEWEXTENSION_P_H
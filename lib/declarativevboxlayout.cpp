@@ -70,6 +70,8 @@ class VBoxLayoutContainer : public LayoutContainerInterface
     void addLayout(QLayout *layout);
     void addSpacer(DeclarativeSpacerItem *spacerItem);
     void addWidget(QWidget *widget);
+    void insertWidget(int index, QWidget *widget);
+    void removeWidget(QWidget *widget);
     void setContentsMargins(int left, int top, int right, int bottom);
     void getContentsMargins(int &left, int &top, int &right, int &bottom);
 
@@ -107,6 +109,11 @@ void VBoxLayoutContainer::addSpacer(DeclarativeSpacerItem *spacerItem)
 }
 
 void VBoxLayoutContainer::addWidget(QWidget *widget)
+{
+  insertWidget(-1, widget);
+}
+
+void VBoxLayoutContainer::insertWidget(int index, QWidget *widget)
 {
   int stretch = 0;
   Qt::Alignment alignment = 0;
@@ -120,7 +127,12 @@ void VBoxLayoutContainer::addWidget(QWidget *widget)
     properties->setParentLayout(m_layout);
   }
 
-  m_layout->addWidget(widget, stretch, alignment);
+  m_layout->insertWidget(index, widget, stretch, alignment);
+}
+
+void VBoxLayoutContainer::removeWidget(QWidget *widget)
+{
+  m_layout->removeWidget(widget);
 }
 
 void VBoxLayoutContainer::setContentsMargins(int left, int top, int right, int bottom)
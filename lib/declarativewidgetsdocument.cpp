@@ -46,27 +46,36 @@
 #include "declarativeinputdialog_p.h"
 #include "declarativeitemviewextension_p.h"
 #include "declarativelabelextension_p.h"
+#include "declarativelazytreemodel_p.h"
 #include "declarativeline_p.h"
 #include "declarativeloaderwidget_p.h"
 #include "declarativemessagebox_p.h"
 #include "declarativepixmap_p.h"
+#include "declarativepreloader_p.h"
 #include "declarativeqmlcontext_p.h"
 #include "declarativequickwidgetextension_p.h"
+#include "declarativerepeater_p.h"
 #include "declarativeseparator_p.h"
 #include "declarativespaceritem_p.h"
 #include "declarativestackedlayout_p.h"
 #include "declarativestatusbar_p.h"
 #include "declarativestringlistmodelextension_p.h"
+#include "declarativesyntaxhighlighter_p.h"
 #include "declarativetableviewextension_p.h"
 #include "declarativetabstops_p.h"
 #include "declarativetabwidget_p.h"
+#include "declarativetextdocumentbuilder_p.h"
+#include "declarativetextdocumentloader.h"
+#include "declarativetextdocumentsaver.h"
 #include "declarativetexteditextension_p.h"
 #include "declarativetreeviewextension_p.h"
 #include "declarativevboxlayout_p.h"
 #include "declarativewidgetextension.h"
+#include "declarativewidgetssnapshot.h"
 #include "mainwindowwidgetcontainer_p.h"
 #include "menubarwidgetcontainer_p.h"
 #include "menuwidgetcontainer_p.h"
+#include "pixmapcache_p.h"
 #include "scrollareawidgetcontainer_p.h"
 #include "stackedwidgetwidgetcontainer_p.h"
 #include "toolbarwidgetcontainer_p.h"
@@ -92,7 +101,9 @@
 #include <QListView>
 #include <QMainWindow>
 #include <QMenuBar>
+#include <QMetaProperty>
 #include <QPlainTextEdit>
+#include <QPointer>
 #include <QProgressBar>
 #include <QQmlComponent>
 #include <QQmlContext>
@@ -103,6 +114,7 @@
 #include <QStackedWidget>
 #include <QStringListModel>
 #include <QTableView>
+#include <QTabWidget>
 #include <QTextBrowser>
 #include <QTimer>
 #include <QToolBar>
@@ -119,17 +131,118 @@ class DeclarativeWidgetsDocument::Private
     Private(DeclarativeWidgetsDocument *qq, const QUrl &url)
       : q(qq)
       , m_url(url)
-      , m_engine(new QQmlEngine(q))
-      , m_component(new QQmlComponent(m_engine, q))
+      , m_engine(0)
+      , m_component(0)
+      , m_snapshotFailed(false)
     {
     }
 
+    // a document restored from a snapshot never needs the engine, so it is created on first use
+    QQmlEngine* engine()
+    {
+      if (!m_engine)
+        m_engine = new QQmlEngine(q);
+
+      return m_engine;
+    }
+
+    QQmlComponent* component()
+    {
+      if (m_component)
+        return m_component;
+
+      m_component = new QQmlComponent(engine(), q);
+      m_component->loadUrl(m_url);
+      if (m_component->isError()) {
+        foreach (const QQmlError &error, m_component->errors())
+          qDebug() << error.toString();
+      }
+
+      return m_component;
+    }
+
     DeclarativeWidgetsDocument* q;
     QUrl m_url;
     QQmlEngine* m_engine;
     QQmlComponent* m_component;
+    QList<QPointer<QObject> > m_createdObjects;
+    QString m_snapshotFileName;
+    bool m_snapshotFailed;
+};
+
+static qint64 pixmapBytes(const QPixmap &pixmap)
+{
+  return qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+// QIcon does not expose its decoded pixmaps, the available sizes at 32 bits per pixel are an estimate
+static qint64 iconBytes(const QIcon &icon)
+{
+  qint64 bytes = 0;
+  foreach (const QSize &size, icon.availableSizes())
+    bytes += qint64(size.width()) * size.height() * 4;
+
+  return bytes;
+}
+
+struct ImageUsage
+{
+  ImageUsage() : pixmapReferences(0), iconReferences(0) {}
+
+  QHash<qint64, qint64> pixmaps;
+  QHash<qint64, qint64> icons;
+  int pixmapReferences;
+  int iconReferences;
+
+  void addPixmap(const QPixmap &pixmap)
+  {
+    if (pixmap.isNull())
+      return;
+
+    ++pixmapReferences;
+    pixmaps.insert(pixmap.cacheKey(), pixmapBytes(pixmap));
+  }
+
+  void addIcon(const QIcon &icon)
+  {
+    if (icon.isNull())
+      return;
+
+    ++iconReferences;
+    if (!icons.contains(icon.cacheKey()))
+      icons.insert(icon.cacheKey(), iconBytes(icon));
+  }
+
+  static qint64 sum(const QHash<qint64, qint64> &images)
+  {
+    qint64 bytes = 0;
+    foreach (qint64 imageBytes, images)
+      bytes += imageBytes;
+
+    return bytes;
+  }
 };
 
+static void collectImageUsage(QObject *object, ImageUsage *usage)
+{
+  const QMetaObject *metaObject = object->metaObject();
+  for (int i = 0; i < metaObject->propertyCount(); ++i) {
+    const QMetaProperty property = metaObject->property(i);
+
+    if (property.userType() == QMetaType::QPixmap)
+      usage->addPixmap(qvariant_cast<QPixmap>(property.read(object)));
+    else if (property.userType() == QMetaType::QIcon)
+      usage->addIcon(qvariant_cast<QIcon>(property.read(object)));
+  }
+
+  // tab icons are not properties of the tab widget
+  QTabWidget *tabWidget = qobject_cast<QTabWidget*>(object);
+  if (tabWidget) {
+    for (int i = 0; i < tabWidget->count(); ++i)
+      usage->addIcon(tabWidget->tabIcon(i));
+  }
+}
+
 DeclarativeWidgetsDocument::DeclarativeWidgetsDocument(const QUrl &url, QObject *parent)
   : QObject(parent)
   , d(new Private(this, url))
@@ -140,16 +253,24 @@ DeclarativeWidgetsDocument::DeclarativeWidgetsDocument(const QUrl &url, QObject
   qmlRegisterExtendedType<DeclarativeAction, DeclarativeObjectExtension>("QtWidgets", 1, 0, "Action");
   qmlRegisterExtendedType<DeclarativeActionItem, DeclarativeObjectExtension>("QtWidgets", 1, 0, "ActionItem");
   qmlRegisterExtendedType<QButtonGroup, DeclarativeButtonGroupExtension>("QtWidgets", 1, 0, "ButtonGroup");
+  qmlRegisterType<DeclarativeHighlightRule>("QtWidgets", 1, 0, "HighlightRule");
   qmlRegisterType<DeclarativeQmlContextProperty>("QtWidgets", 1, 0, "QmlContextProperty");
   qmlRegisterType<DeclarativeQmlContext>("QtWidgets", 1, 0, "QmlContext");
   qmlRegisterExtendedType<QFileSystemModel, DeclarativeFileSystemModelExtension>("QtWidgets", 1, 0, "FileSystemModel");
   qmlRegisterType<DeclarativeIcon>("QtWidgets", 1, 0, "Icon");
   qmlRegisterType<QItemSelectionModel>();
+  qmlRegisterType<DeclarativeLazyTreeModel>("QtWidgets", 1, 0, "LazyTreeModel");
   qmlRegisterType<DeclarativePixmap>("QtWidgets", 1, 0, "Pixmap");
+  qmlRegisterType<DeclarativePreloader>("QtWidgets", 1, 0, "Preloader");
+  qmlRegisterType<DeclarativeRepeater>("QtWidgets", 1, 0, "Repeater");
   qmlRegisterExtendedType<DeclarativeSeparator, DeclarativeObjectExtension>("QtWidgets", 1, 0, "Separator");
   qmlRegisterExtendedType<QStringListModel, DeclarativeStringListModelExtension>("QtCore", 1, 0, "StringListModel");
+  qmlRegisterType<DeclarativeSyntaxHighlighter>("QtWidgets", 1, 0, "SyntaxHighlighter");
   qmlRegisterType<DeclarativeTabStops>("QtWidgets", 1, 0, "TabStops");
   qmlRegisterType<QTextDocument>();
+  qmlRegisterType<DeclarativeTextDocumentBuilder>("QtWidgets", 1, 0, "TextDocumentBuilder");
+  qmlRegisterType<DeclarativeTextDocumentLoader>("QtWidgets", 1, 0, "TextDocumentLoader");
+  qmlRegisterType<DeclarativeTextDocumentSaver>("QtWidgets", 1, 0, "TextDocumentSaver");
   qmlRegisterType<QTimer>("QtCore", 1, 0, "Timer");
 
   // layouts
@@ -214,12 +335,6 @@ DeclarativeWidgetsDocument::DeclarativeWidgetsDocument(const QUrl &url, QObject
   qmlRegisterExtendedType<QWebEngineView, DeclarativeWidgetExtension>("QtWidgets", 1, 0, "WebEngineView");
 #endif
   qmlRegisterExtendedType<QWidget, DeclarativeWidgetExtension>("QtWidgets", 1, 0, "Widget");
-
-  d->m_component->loadUrl(d->m_url);
-  if (d->m_component->isError()) {
-    foreach (const QQmlError &error, d->m_component->errors())
-      qDebug() << error.toString();
-  }
 }
 
 DeclarativeWidgetsDocument::~DeclarativeWidgetsDocument()
@@ -229,22 +344,73 @@ DeclarativeWidgetsDocument::~DeclarativeWidgetsDocument()
 
 void DeclarativeWidgetsDocument::setContextProperty(const QString &name, const QVariant &value)
 {
-  d->m_engine->rootContext()->setContextProperty(name, value);
+  d->engine()->rootContext()->setContextProperty(name, value);
 }
 
 void DeclarativeWidgetsDocument::setContextProperty(const QString &name, QObject *object)
 {
-  d->m_engine->rootContext()->setContextProperty(name, object);
+  d->engine()->rootContext()->setContextProperty(name, object);
 }
 
 QQmlEngine* DeclarativeWidgetsDocument::engine() const
 {
-  return d->m_engine;
+  return d->engine();
+}
+
+void DeclarativeWidgetsDocument::setSnapshotFileName(const QString &fileName)
+{
+  d->m_snapshotFileName = fileName;
+  d->m_snapshotFailed = false;
+}
+
+QString DeclarativeWidgetsDocument::snapshotFileName() const
+{
+  return d->m_snapshotFileName;
+}
+
+QVariantMap DeclarativeWidgetsDocument::imageMemoryReport() const
+{
+  ImageUsage usage;
+
+  foreach (const QPointer<QObject> &root, d->m_createdObjects) {
+    if (!root)
+      continue;
+
+    collectImageUsage(root, &usage);
+    foreach (QObject *object, root->findChildren<QObject*>())
+      collectImageUsage(object, &usage);
+  }
+
+  const PixmapCache *cache = PixmapCache::instance();
+
+  QVariantMap report;
+  report.insert(QStringLiteral("pixmapReferences"), usage.pixmapReferences);
+  report.insert(QStringLiteral("pixmaps"), usage.pixmaps.count());
+  report.insert(QStringLiteral("pixmapBytes"), ImageUsage::sum(usage.pixmaps));
+  report.insert(QStringLiteral("iconReferences"), usage.iconReferences);
+  report.insert(QStringLiteral("icons"), usage.icons.count());
+  report.insert(QStringLiteral("iconBytes"), ImageUsage::sum(usage.icons));
+  report.insert(QStringLiteral("cacheEntries"), cache->count());
+  report.insert(QStringLiteral("cacheBytes"), cache->totalBytes());
+  report.insert(QStringLiteral("cacheDeduplicated"), cache->deduplicated());
+
+  return report;
 }
 
 QWidget* DeclarativeWidgetsDocument::createWidget()
 {
-  QObject *object = d->m_component->create();
+  QByteArray sourceHash;
+  if (!d->m_snapshotFileName.isEmpty() && !d->m_snapshotFailed) {
+    sourceHash = DeclarativeWidgetsSnapshot::sourceHash(d->m_url);
+
+    QWidget *widget = DeclarativeWidgetsSnapshot::load(d->m_snapshotFileName, sourceHash);
+    if (widget) {
+      d->m_createdObjects.append(widget);
+      return widget;
+    }
+  }
+
+  QObject *object = d->component()->create();
   if (!object) {
     qWarning("Unable to create component");
     return 0;
@@ -252,14 +418,29 @@ QWidget* DeclarativeWidgetsDocument::createWidget()
 
   AbstractDeclarativeObject *declarativeObject = dynamic_cast<AbstractDeclarativeObject*>(object);
 
+  QWidget *widget = 0;
   if (declarativeObject) {
     declarativeObject->setParent(this);
-    return qobject_cast<QWidget*>(declarativeObject->object());
+    d->m_createdObjects.append(declarativeObject->object());
+    widget = qobject_cast<QWidget*>(declarativeObject->object());
+  } else {
+    widget = qobject_cast<QWidget*>(object);
+    if (widget)
+      d->m_createdObjects.append(widget);
   }
 
-  QWidget *widget = qobject_cast<QWidget*>(object);
-  if (widget)
+  if (widget) {
+    // missing or outdated, the next document opens from the new one
+    if (!sourceHash.isEmpty()) {
+      QString errorString;
+      if (!DeclarativeWidgetsSnapshot::save(widget, sourceHash, d->m_snapshotFileName, &errorString)) {
+        qWarning() << "Unable to write snapshot" << d->m_snapshotFileName << ":" << errorString;
+        d->m_snapshotFailed = true;
+      }
+    }
+
     return widget;
+  }
 
   qFatal("Root Element is neither an AbstractDeclarativeObject nor a widget");
   return 0;
@@ -33,6 +33,7 @@
 
 #include <QObject>
 #include <QUrl>
+#include <QVariantMap>
 
 QT_BEGIN_NAMESPACE
 class QQmlEngine;
@@ -51,6 +52,16 @@ class DECLARATIVEWIDGETS_EXPORT DeclarativeWidgetsDocument : public QObject
 
     QQmlEngine* engine() const;
 
+    // widget trees are restored from this file instead of being created by the QML engine
+    // as long as it matches the QML file, otherwise it is rewritten after the next create().
+    // Only the static state is kept, see DeclarativeWidgetsSnapshot
+    void setSnapshotFileName(const QString &fileName);
+    QString snapshotFileName() const;
+
+    // bytes of the pixmaps and icons used by the objects created so far,
+    // every image is counted once no matter how many widgets or actions share it
+    QVariantMap imageMemoryReport() const;
+
     template <typename T>
     T* create()
     {
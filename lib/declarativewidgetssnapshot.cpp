@@ -0,0 +1,1393 @@
+/*
+  declarativewidgetssnapshot.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "declarativewidgetssnapshot.h"
+
+#include <QAction>
+#include <QCalendarWidget>
+#include <QCheckBox>
+#include <QColumnView>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateEdit>
+#include <QDateTimeEdit>
+#include <QDebug>
+#include <QDial>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QDockWidget>
+#include <QDoubleSpinBox>
+#include <QFile>
+#include <QFileInfo>
+#include <QFontComboBox>
+#include <QFormLayout>
+#include <QFrame>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QLCDNumber>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QListWidget>
+#include <QMainWindow>
+#include <QMdiArea>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMetaProperty>
+#include <QPixmap>
+#include <QPlainTextEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QSaveFile>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QSet>
+#include <QSizeGrip>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QStackedLayout>
+#include <QStackedWidget>
+#include <QStatusBar>
+#include <QTabWidget>
+#include <QTableView>
+#include <QTableWidget>
+#include <QTextBrowser>
+#include <QTextEdit>
+#include <QTimeEdit>
+#include <QToolBar>
+#include <QToolBox>
+#include <QToolButton>
+#include <QTreeView>
+#include <QTreeWidget>
+#include <QUrl>
+#include <QVBoxLayout>
+#include <QWidgetAction>
+
+#include <private/qqmldata_p.h>
+
+#include <algorithm>
+#include <cstring>
+
+static const quint32 snapshotMagic = 0x44575353; // "DWSS"
+static const quint16 snapshotFormatVersion = 2;
+
+// every record starts with its kind, a parent's list of children ends with EndNode
+enum NodeKind {
+  EndNode,
+  WidgetNode,
+  LayoutNode,
+  SpacerNode,
+  ActionNode,
+  SeparatorNode,
+  ActionReferenceNode // an action or menu that is already part of the snapshot
+};
+
+// how a node is added to its parent, followed by the arguments it needs
+enum Placement {
+  ChildPlacement,         // window flags
+  LayoutPlacement,        // layout of the parent widget
+  LayoutItemPlacement,    // four layout specific values and the alignment
+  TabPlacement,           // label and icon
+  ToolBoxPlacement,       // label and icon
+  PagePlacement,          // addWidget() of stacked widgets, splitters, status bars and tool bars
+  WidgetPlacement,        // setWidget() of scroll areas and dock widgets
+  CentralWidgetPlacement,
+  MenuBarPlacement,
+  StatusBarPlacement,
+  ToolBarPlacement,       // tool bar area
+  DockWidgetPlacement,    // dock widget area
+  ActionPlacement
+};
+
+enum WidgetFlag {
+  HiddenFlag = 0x1
+};
+
+typedef QObject *(*CreateFunction)(QWidget *parent);
+
+template <typename T>
+static QObject *createWidget(QWidget *parent)
+{
+  return new T(parent);
+}
+
+template <typename T>
+static QObject *createLayout(QWidget *)
+{
+  return new T;
+}
+
+static QObject *createAction(QWidget *parent)
+{
+  return new QAction(parent);
+}
+
+struct SnapshotClass
+{
+  const char *className;
+  CreateFunction create;
+};
+
+// sorted by class name for the binary search in findClass()
+static const SnapshotClass snapshotClasses[] = {
+  { "QAction", &createAction },
+  { "QCalendarWidget", &createWidget<QCalendarWidget> },
+  { "QCheckBox", &createWidget<QCheckBox> },
+  { "QColumnView", &createWidget<QColumnView> },
+  { "QComboBox", &createWidget<QComboBox> },
+  { "QCommandLinkButton", &createWidget<QCommandLinkButton> },
+  { "QDateEdit", &createWidget<QDateEdit> },
+  { "QDateTimeEdit", &createWidget<QDateTimeEdit> },
+  { "QDial", &createWidget<QDial> },
+  { "QDialog", &createWidget<QDialog> },
+  { "QDialogButtonBox", &createWidget<QDialogButtonBox> },
+  { "QDockWidget", &createWidget<QDockWidget> },
+  { "QDoubleSpinBox", &createWidget<QDoubleSpinBox> },
+  { "QFontComboBox", &createWidget<QFontComboBox> },
+  { "QFormLayout", &createLayout<QFormLayout> },
+  { "QFrame", &createWidget<QFrame> },
+  { "QGridLayout", &createLayout<QGridLayout> },
+  { "QGroupBox", &createWidget<QGroupBox> },
+  { "QHBoxLayout", &createLayout<QHBoxLayout> },
+  { "QLCDNumber", &createWidget<QLCDNumber> },
+  { "QLabel", &createWidget<QLabel> },
+  { "QLineEdit", &createWidget<QLineEdit> },
+  { "QListView", &createWidget<QListView> },
+  { "QListWidget", &createWidget<QListWidget> },
+  { "QMainWindow", &createWidget<QMainWindow> },
+  { "QMdiArea", &createWidget<QMdiArea> },
+  { "QMenu", &createWidget<QMenu> },
+  { "QMenuBar", &createWidget<QMenuBar> },
+  { "QPlainTextEdit", &createWidget<QPlainTextEdit> },
+  { "QProgressBar", &createWidget<QProgressBar> },
+  { "QPushButton", &createWidget<QPushButton> },
+  { "QRadioButton", &createWidget<QRadioButton> },
+  { "QScrollArea", &createWidget<QScrollArea> },
+  { "QScrollBar", &createWidget<QScrollBar> },
+  { "QSlider", &createWidget<QSlider> },
+  { "QSpinBox", &createWidget<QSpinBox> },
+  { "QSplitter", &createWidget<QSplitter> },
+  { "QStackedLayout", &createLayout<QStackedLayout> },
+  { "QStackedWidget", &createWidget<QStackedWidget> },
+  { "QStatusBar", &createWidget<QStatusBar> },
+  { "QTabWidget", &createWidget<QTabWidget> },
+  { "QTableView", &createWidget<QTableView> },
+  { "QTableWidget", &createWidget<QTableWidget> },
+  { "QTextBrowser", &createWidget<QTextBrowser> },
+  { "QTextEdit", &createWidget<QTextEdit> },
+  { "QTimeEdit", &createWidget<QTimeEdit> },
+  { "QToolBar", &createWidget<QToolBar> },
+  { "QToolBox", &createWidget<QToolBox> },
+  { "QToolButton", &createWidget<QToolButton> },
+  { "QTreeView", &createWidget<QTreeView> },
+  { "QTreeWidget", &createWidget<QTreeWidget> },
+  { "QVBoxLayout", &createLayout<QVBoxLayout> },
+  { "QWidget", &createWidget<QWidget> }
+};
+
+static bool classNameLessThan(const SnapshotClass &snapshotClass, const char *className)
+{
+  return std::strcmp(snapshotClass.className, className) < 0;
+}
+
+static const SnapshotClass *findClass(const char *className)
+{
+  const SnapshotClass *begin = snapshotClasses;
+  const SnapshotClass *end = snapshotClasses + sizeof(snapshotClasses) / sizeof(snapshotClasses[0]);
+
+  const SnapshotClass *it = std::lower_bound(begin, end, className, classNameLessThan);
+  if (it == end || std::strcmp(it->className, className) != 0)
+    return 0;
+
+  return it;
+}
+
+// the library's own subclasses that only add QML plumbing are restored as their Qt class
+static const char *const wrapperClasses[][2] = {
+  { "DeclarativeLine", "QFrame" },
+  { "DeclarativeStatusBar", "QStatusBar" },
+  { "DeclarativeTabWidget", "QTabWidget" },
+  { "Dialog", "QDialog" },
+  { "Menu", "QMenu" }
+};
+
+static const SnapshotClass *findClass(const QObject *object)
+{
+  const char *className = object->metaObject()->className();
+
+  const int wrapperCount = sizeof(wrapperClasses) / sizeof(wrapperClasses[0]);
+  for (int i = 0; i < wrapperCount; ++i) {
+    if (std::strcmp(wrapperClasses[i][0], className) == 0)
+      return findClass(wrapperClasses[i][1]);
+  }
+
+  return findClass(className);
+}
+
+// value types QDataStream can write, everything else is left out of a snapshot
+static bool isStorableType(int type)
+{
+  switch (type) {
+  case QMetaType::Bool:
+  case QMetaType::Int:
+  case QMetaType::UInt:
+  case QMetaType::LongLong:
+  case QMetaType::ULongLong:
+  case QMetaType::Double:
+  case QMetaType::Float:
+  case QMetaType::QChar:
+  case QMetaType::QString:
+  case QMetaType::QStringList:
+  case QMetaType::QByteArray:
+  case QMetaType::QDate:
+  case QMetaType::QTime:
+  case QMetaType::QDateTime:
+  case QMetaType::QUrl:
+  case QMetaType::QLocale:
+  case QMetaType::QRect:
+  case QMetaType::QRectF:
+  case QMetaType::QSize:
+  case QMetaType::QSizeF:
+  case QMetaType::QLine:
+  case QMetaType::QLineF:
+  case QMetaType::QPoint:
+  case QMetaType::QPointF:
+  case QMetaType::QFont:
+  case QMetaType::QPixmap:
+  case QMetaType::QBrush:
+  case QMetaType::QColor:
+  case QMetaType::QPalette:
+  case QMetaType::QIcon:
+  case QMetaType::QImage:
+  case QMetaType::QKeySequence:
+  case QMetaType::QSizePolicy:
+  case QMetaType::QCursor:
+    return true;
+  default:
+    return false;
+  }
+}
+
+static bool isNullImage(const QVariant &value)
+{
+  switch (value.userType()) {
+  case QMetaType::QIcon:
+    return value.value<QIcon>().isNull();
+  case QMetaType::QPixmap:
+    return value.value<QPixmap>().isNull();
+  case QMetaType::QImage:
+    return value.value<QImage>().isNull();
+  default:
+    return false;
+  }
+}
+
+static int enumValue(const QVariant &value)
+{
+  bool ok = false;
+  const int result = value.toInt(&ok);
+  if (ok)
+    return result;
+
+  // QFlags and enums without registered conversion hold a plain int
+  return *static_cast<const int*>(value.constData());
+}
+
+// widgets whose children are all content, like the DefaultWidgetContainer ones
+static bool isPlainContainer(const QWidget *widget)
+{
+  const SnapshotClass *snapshotClass = findClass(widget);
+  if (!snapshotClass)
+    return false;
+
+  const char *className = snapshotClass->className;
+  return std::strcmp(className, "QWidget") == 0 || std::strcmp(className, "QFrame") == 0 ||
+         std::strcmp(className, "QGroupBox") == 0 || std::strcmp(className, "QDialog") == 0;
+}
+
+// bindings and signal handlers are not part of a snapshot, a restored form would
+// silently lose the behavior they implement
+static bool hasQmlBehavior(QObject *object)
+{
+  // the handlers of a Connections element are kept by the element itself
+  if (qstrcmp(object->metaObject()->className(), "QQmlConnections") == 0)
+    return true;
+
+  QQmlData *data = QQmlData::get(object);
+  if (!data)
+    return false;
+
+  if (data->bindings || data->signalHandlers)
+    return true;
+
+  // e.g. Component.onCompleted or a bound GridLayout.row
+  if (data->hasExtendedData()) {
+    foreach (QObject *attached, *data->attachedProperties()) {
+      if (attached && hasQmlBehavior(attached))
+        return true;
+    }
+  }
+
+  return false;
+}
+
+static QObject *findQmlBehavior(QWidget *root)
+{
+  if (hasQmlBehavior(root))
+    return root;
+
+  foreach (QObject *object, root->findChildren<QObject*>()) {
+    if (hasQmlBehavior(object))
+      return object;
+  }
+
+  return 0;
+}
+
+static bool addFileToHash(QCryptographicHash *hash, const QString &fileName)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  return hash->addData(&file);
+}
+
+static bool readHeader(QDataStream &stream, const QByteArray &sourceHash)
+{
+  quint32 magic = 0;
+  quint16 formatVersion = 0;
+  quint16 streamVersion = 0;
+  quint32 qtVersion = 0;
+  QByteArray hash;
+  stream >> magic >> formatVersion >> streamVersion >> qtVersion >> hash;
+
+  // values are written with the QDataStream format of the Qt that wrote them
+  return stream.status() == QDataStream::Ok && magic == snapshotMagic &&
+         formatVersion == snapshotFormatVersion && streamVersion == QDataStream::Qt_DefaultCompiledVersion &&
+         qtVersion == QT_VERSION && hash == sourceHash;
+}
+
+class SnapshotWriter
+{
+  public:
+    explicit SnapshotWriter(QDataStream &stream);
+    ~SnapshotWriter();
+
+    bool writeTree(QWidget *root);
+
+    QList<QByteArray> strings() const;
+
+    QString errorString() const;
+
+  private:
+    QDataStream &m_stream;
+    QString m_errorString;
+
+    QList<QByteArray> m_strings;
+    QHash<QByteArray, quint16> m_stringIndexes;
+
+    // node numbers in stream order, for references
+    QHash<QObject*, qint32> m_nodes;
+    QSet<QWidget*> m_writtenWidgets;
+    QList<QPair<QLabel*, QWidget*> > m_buddies;
+
+    // freshly created instances the property values are compared with
+    QHash<const SnapshotClass*, QObject*> m_defaults;
+
+  private:
+    quint16 stringIndex(const QByteArray &string);
+    bool writeClass(QObject *object);
+    bool writeWidget(QWidget *widget, bool isRoot);
+    bool writeChildren(QWidget *widget);
+    bool writeActions(QWidget *widget);
+    bool writeLayout(QLayout *layout);
+    void writeProperties(QObject *object, bool isRoot);
+    QObject *defaultInstance(const SnapshotClass *snapshotClass);
+};
+
+SnapshotWriter::SnapshotWriter(QDataStream &stream)
+  : m_stream(stream)
+{
+}
+
+SnapshotWriter::~SnapshotWriter()
+{
+  qDeleteAll(m_defaults);
+}
+
+bool SnapshotWriter::writeTree(QWidget *root)
+{
+  if (!writeWidget(root, true))
+    return false;
+
+  // buddies may come later in the tree than their labels
+  m_stream << quint32(m_buddies.count());
+  for (int i = 0; i < m_buddies.count(); ++i) {
+    m_stream << m_nodes.value(m_buddies[i].first, -1) << m_nodes.value(m_buddies[i].second, -1);
+  }
+
+  return true;
+}
+
+QList<QByteArray> SnapshotWriter::strings() const
+{
+  return m_strings;
+}
+
+QString SnapshotWriter::errorString() const
+{
+  return m_errorString;
+}
+
+quint16 SnapshotWriter::stringIndex(const QByteArray &string)
+{
+  QHash<QByteArray, quint16>::const_iterator it = m_stringIndexes.constFind(string);
+  if (it != m_stringIndexes.constEnd())
+    return *it;
+
+  const quint16 index = m_strings.count();
+  m_strings.append(string);
+  m_stringIndexes.insert(string, index);
+
+  return index;
+}
+
+bool SnapshotWriter::writeClass(QObject *object)
+{
+  const SnapshotClass *snapshotClass = findClass(object);
+  if (!snapshotClass) {
+    m_errorString = QString::fromLatin1("%1 cannot be restored from a snapshot")
+                    .arg(QLatin1String(object->metaObject()->className()));
+    return false;
+  }
+
+  m_nodes.insert(object, m_nodes.count());
+  m_stream << stringIndex(snapshotClass->className);
+
+  return true;
+}
+
+bool SnapshotWriter::writeWidget(QWidget *widget, bool isRoot)
+{
+  if (!writeClass(widget))
+    return false;
+
+  m_writtenWidgets.insert(widget);
+
+  // hidden through visible: false rather than by a parent that has not been shown yet
+  quint8 flags = 0;
+  if (!isRoot && widget->testAttribute(Qt::WA_WState_ExplicitShowHide) && widget->testAttribute(Qt::WA_WState_Hidden))
+    flags |= HiddenFlag;
+  m_stream << flags;
+
+  // content the widgets keep outside of properties
+  QComboBox *comboBox = qobject_cast<QComboBox*>(widget);
+  if (comboBox) {
+    QStringList items;
+    for (int i = 0; i < comboBox->count(); ++i)
+      items << comboBox->itemText(i);
+    m_stream << items;
+  }
+
+  QAbstractItemView *itemView = qobject_cast<QAbstractItemView*>(widget);
+  if (itemView && itemView->model() && itemView->model()->rowCount() > 0) {
+    m_errorString = QString::fromLatin1("%1 shows a model, models cannot be restored from a snapshot")
+                    .arg(QLatin1String(widget->metaObject()->className()));
+    return false;
+  }
+
+  QLabel *label = qobject_cast<QLabel*>(widget);
+  if (label && label->buddy())
+    m_buddies.append(qMakePair(label, label->buddy()));
+
+  if (!writeChildren(widget) || !writeActions(widget))
+    return false;
+  m_stream << quint8(EndNode);
+
+  writeProperties(widget, isRoot);
+
+  return true;
+}
+
+bool SnapshotWriter::writeChildren(QWidget *widget)
+{
+  if (QTabWidget *tabWidget = qobject_cast<QTabWidget*>(widget)) {
+    for (int i = 0; i < tabWidget->count(); ++i) {
+      m_stream << quint8(WidgetNode) << quint8(TabPlacement) << tabWidget->tabText(i) << tabWidget->tabIcon(i);
+      if (!writeWidget(tabWidget->widget(i), false))
+        return false;
+    }
+  } else if (QToolBox *toolBox = qobject_cast<QToolBox*>(widget)) {
+    for (int i = 0; i < toolBox->count(); ++i) {
+      m_stream << quint8(WidgetNode) << quint8(ToolBoxPlacement) << toolBox->itemText(i) << toolBox->itemIcon(i);
+      if (!writeWidget(toolBox->widget(i), false))
+        return false;
+    }
+  } else if (QStackedWidget *stackedWidget = qobject_cast<QStackedWidget*>(widget)) {
+    for (int i = 0; i < stackedWidget->count(); ++i) {
+      m_stream << quint8(WidgetNode) << quint8(PagePlacement);
+      if (!writeWidget(stackedWidget->widget(i), false))
+        return false;
+    }
+  } else if (QSplitter *splitter = qobject_cast<QSplitter*>(widget)) {
+    for (int i = 0; i < splitter->count(); ++i) {
+      m_stream << quint8(WidgetNode) << quint8(PagePlacement);
+      if (!writeWidget(splitter->widget(i), false))
+        return false;
+    }
+  } else if (QScrollArea *scrollArea = qobject_cast<QScrollArea*>(widget)) {
+    if (scrollArea->widget()) {
+      m_stream << quint8(WidgetNode) << quint8(WidgetPlacement);
+      if (!writeWidget(scrollArea->widget(), false))
+        return false;
+    }
+  } else if (QDockWidget *dockWidget = qobject_cast<QDockWidget*>(widget)) {
+    if (dockWidget->widget()) {
+      m_stream << quint8(WidgetNode) << quint8(WidgetPlacement);
+      if (!writeWidget(dockWidget->widget(), false))
+        return false;
+    }
+  } else if (QMainWindow *mainWindow = qobject_cast<QMainWindow*>(widget)) {
+    // menuBar() and statusBar() would create them
+    QMenuBar *menuBar = qobject_cast<QMenuBar*>(mainWindow->menuWidget());
+    if (menuBar) {
+      m_stream << quint8(WidgetNode) << quint8(MenuBarPlacement);
+      if (!writeWidget(menuBar, false))
+        return false;
+    }
+
+    foreach (QToolBar *toolBar, mainWindow->findChildren<QToolBar*>(QString(), Qt::FindDirectChildrenOnly)) {
+      m_stream << quint8(WidgetNode) << quint8(ToolBarPlacement) << qint32(mainWindow->toolBarArea(toolBar));
+      if (!writeWidget(toolBar, false))
+        return false;
+    }
+
+    foreach (QDockWidget *dock, mainWindow->findChildren<QDockWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+      m_stream << quint8(WidgetNode) << quint8(DockWidgetPlacement) << qint32(mainWindow->dockWidgetArea(dock));
+      if (!writeWidget(dock, false))
+        return false;
+    }
+
+    if (mainWindow->centralWidget()) {
+      m_stream << quint8(WidgetNode) << quint8(CentralWidgetPlacement);
+      if (!writeWidget(mainWindow->centralWidget(), false))
+        return false;
+    }
+
+    QStatusBar *statusBar = mainWindow->findChild<QStatusBar*>(QString(), Qt::FindDirectChildrenOnly);
+    if (statusBar) {
+      m_stream << quint8(WidgetNode) << quint8(StatusBarPlacement);
+      if (!writeWidget(statusBar, false))
+        return false;
+    }
+  } else if (qobject_cast<QStatusBar*>(widget)) {
+    foreach (QWidget *child, widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+      if (qobject_cast<QSizeGrip*>(child) || child->isWindow())
+        continue;
+
+      m_stream << quint8(WidgetNode) << quint8(PagePlacement);
+      if (!writeWidget(child, false))
+        return false;
+    }
+  } else if (isPlainContainer(widget)) {
+    if (widget->layout()) {
+      m_stream << quint8(LayoutNode) << quint8(LayoutPlacement);
+      if (!writeLayout(widget->layout()))
+        return false;
+    }
+
+    // children outside of the layout, positioned by their geometry
+    foreach (QWidget *child, widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+      if (m_writtenWidgets.contains(child) || child->isWindow())
+        continue;
+
+      m_stream << quint8(WidgetNode) << quint8(ChildPlacement) << qint32(0);
+      if (!writeWidget(child, false))
+        return false;
+    }
+  }
+
+  // dialogs and other windows belonging to the widget, popups of widgets like
+  // QComboBox are private classes and created by the widget itself
+  foreach (QWidget *child, widget->findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly)) {
+    if (m_writtenWidgets.contains(child) || !child->isWindow() || qobject_cast<QMenu*>(child) ||
+        !findClass(child))
+      continue;
+
+    m_stream << quint8(WidgetNode) << quint8(ChildPlacement) << qint32(child->windowFlags());
+    if (!writeWidget(child, false))
+      return false;
+  }
+
+  return true;
+}
+
+bool SnapshotWriter::writeActions(QWidget *widget)
+{
+  // line edits add the actions of their clear button and completer themselves
+  if (qobject_cast<QLineEdit*>(widget))
+    return true;
+
+  foreach (QAction *action, widget->actions()) {
+    QWidgetAction *widgetAction = qobject_cast<QWidgetAction*>(action);
+    QObject *node = action->menu() ? static_cast<QObject*>(action->menu()) : action;
+
+    if (m_nodes.contains(node)) {
+      m_stream << quint8(ActionReferenceNode) << quint8(ActionPlacement) << m_nodes.value(node);
+    } else if (action->menu()) {
+      m_stream << quint8(WidgetNode) << quint8(ActionPlacement);
+      if (!writeWidget(action->menu(), false))
+        return false;
+    } else if (widgetAction && qobject_cast<QToolBar*>(widget)) {
+      m_stream << quint8(WidgetNode) << quint8(PagePlacement);
+      if (!writeWidget(widgetAction->defaultWidget(), false))
+        return false;
+    } else if (action->isSeparator()) {
+      m_stream << quint8(SeparatorNode) << quint8(ActionPlacement);
+    } else {
+      m_stream << quint8(ActionNode) << quint8(ActionPlacement);
+      if (!writeClass(action))
+        return false;
+      writeProperties(action, false);
+    }
+  }
+
+  return true;
+}
+
+bool SnapshotWriter::writeLayout(QLayout *layout)
+{
+  if (!writeClass(layout))
+    return false;
+
+  int left, top, right, bottom;
+  layout->getContentsMargins(&left, &top, &right, &bottom);
+  m_stream << qint32(left) << qint32(top) << qint32(right) << qint32(bottom);
+
+  QGridLayout *gridLayout = qobject_cast<QGridLayout*>(layout);
+  QBoxLayout *boxLayout = qobject_cast<QBoxLayout*>(layout);
+  QFormLayout *formLayout = qobject_cast<QFormLayout*>(layout);
+
+  // form layouts are filled row by row, whatever order the items were added in
+  QVector<QPair<int, int> > items;
+  for (int i = 0; i < layout->count(); ++i) {
+    int order = i;
+    if (formLayout) {
+      int row;
+      QFormLayout::ItemRole role;
+      formLayout->getItemPosition(i, &row, &role);
+      order = row * 3 + role;
+    }
+    items.append(qMakePair(order, i));
+  }
+  std::sort(items.begin(), items.end());
+
+  for (int i = 0; i < items.count(); ++i) {
+    const int index = items[i].second;
+    QLayoutItem *item = layout->itemAt(index);
+
+    qint32 values[4] = { 0, 0, 0, 0 };
+    if (gridLayout) {
+      int row, column, rowSpan, columnSpan;
+      gridLayout->getItemPosition(index, &row, &column, &rowSpan, &columnSpan);
+      values[0] = row;
+      values[1] = column;
+      values[2] = rowSpan;
+      values[3] = columnSpan;
+    } else if (boxLayout) {
+      values[0] = boxLayout->stretch(index);
+    } else if (formLayout) {
+      int row;
+      QFormLayout::ItemRole role;
+      formLayout->getItemPosition(index, &row, &role);
+      values[0] = row;
+      values[1] = role;
+    }
+
+    if (item->widget()) {
+      m_stream << quint8(WidgetNode);
+    } else if (item->layout()) {
+      m_stream << quint8(LayoutNode);
+    } else if (item->spacerItem()) {
+      m_stream << quint8(SpacerNode);
+    } else {
+      continue;
+    }
+
+    m_stream << quint8(LayoutItemPlacement) << values[0] << values[1] << values[2] << values[3]
+             << qint32(item->alignment());
+
+    if (item->widget()) {
+      if (!writeWidget(item->widget(), false))
+        return false;
+    } else if (item->layout()) {
+      if (!writeLayout(item->layout()))
+        return false;
+    } else {
+      QSpacerItem *spacer = item->spacerItem();
+      const QSizePolicy sizePolicy = spacer->sizePolicy();
+      m_stream << qint32(spacer->sizeHint().width()) << qint32(spacer->sizeHint().height())
+               << qint32(sizePolicy.horizontalPolicy()) << qint32(sizePolicy.verticalPolicy());
+    }
+  }
+  m_stream << quint8(EndNode);
+
+  writeProperties(layout, false);
+
+  return true;
+}
+
+void SnapshotWriter::writeProperties(QObject *object, bool isRoot)
+{
+  // properties of wrapper subclasses come after the ones of their Qt class and are left out
+  const QMetaObject *metaObject = object->metaObject();
+  QObject *defaults = defaultInstance(findClass(object));
+
+  QVector<QPair<quint16, QVariant> > properties;
+
+  for (int i = 0; i < defaults->metaObject()->propertyCount(); ++i) {
+    const QMetaProperty property = metaObject->property(i);
+    // the same selection as Designer, visibility is a flag of the widget record and
+    // plainText would replace the formatted text of text edits
+    if (!property.isReadable() || !property.isWritable() || !property.isStored() || !property.isDesignable())
+      continue;
+
+    QByteArray name = property.name();
+
+    QVariant value = property.read(object);
+    QVariant defaultValue = property.read(defaults);
+
+    if (property.isEnumType() || property.isFlagType()) {
+      value = enumValue(value);
+      defaultValue = enumValue(defaultValue);
+    } else if (!isStorableType(property.userType())) {
+      continue;
+    }
+
+    // a window keeps its size but is placed by the window system
+    if (isRoot && name == "geometry") {
+      name = "size";
+      value = value.toRect().size();
+      defaultValue = defaultValue.toRect().size();
+    }
+
+    if (value == defaultValue || isNullImage(value))
+      continue;
+
+    properties.append(qMakePair(stringIndex(name), value));
+  }
+
+  m_stream << quint16(properties.count());
+  for (int i = 0; i < properties.count(); ++i)
+    m_stream << properties[i].first << properties[i].second;
+}
+
+QObject *SnapshotWriter::defaultInstance(const SnapshotClass *snapshotClass)
+{
+  QObject *&instance = m_defaults[snapshotClass];
+  if (!instance)
+    instance = snapshotClass->create(0);
+
+  return instance;
+}
+
+class SnapshotReader
+{
+  public:
+    SnapshotReader(QDataStream &stream, const QVector<QByteArray> &strings);
+
+    QWidget *readTree(QWidget *parent);
+
+  private:
+    QDataStream &m_stream;
+    const QVector<QByteArray> m_strings;
+    QVector<QObject*> m_nodes;
+
+    struct PlacementArguments
+    {
+        PlacementArguments()
+          : area(0)
+          , alignment(0)
+        {
+          values[0] = values[1] = values[2] = values[3] = 0;
+        }
+
+        qint32 values[4];
+        qint32 area;
+        qint32 alignment;
+        QString text;
+        QIcon icon;
+    };
+
+  private:
+    bool isOk() const;
+    void setCorrupt();
+    QObject *createObject(QWidget *parent);
+    void readPlacement(quint8 placement, PlacementArguments *arguments);
+    void readChildren(QObject *container, QWidget *parentWidget);
+    void readWidget(QObject *container, QWidget *parentWidget, quint8 placement, const PlacementArguments &arguments);
+    void readLayout(QObject *container, QWidget *parentWidget, quint8 placement, const PlacementArguments &arguments);
+    void placeWidget(QObject *container, QWidget *widget, quint8 placement, const PlacementArguments &arguments);
+    void addLayoutItem(QObject *container, QWidget *widget, QLayout *layout, QSpacerItem *spacer,
+                       const PlacementArguments &arguments);
+    void addAction(QObject *container, QAction *action);
+    void readProperties(QObject *object);
+};
+
+SnapshotReader::SnapshotReader(QDataStream &stream, const QVector<QByteArray> &strings)
+  : m_stream(stream)
+  , m_strings(strings)
+{
+}
+
+QWidget *SnapshotReader::readTree(QWidget *parent)
+{
+  QWidget *root = qobject_cast<QWidget*>(createObject(parent));
+  if (!root)
+    return 0;
+
+  quint8 flags;
+  m_stream >> flags;
+
+  if (qobject_cast<QComboBox*>(root)) {
+    QStringList items;
+    m_stream >> items;
+    static_cast<QComboBox*>(root)->addItems(items);
+  }
+
+  readChildren(root, root);
+  readProperties(root);
+
+  quint32 buddyCount = 0;
+  m_stream >> buddyCount;
+  for (quint32 i = 0; i < buddyCount && isOk(); ++i) {
+    qint32 labelIndex, buddyIndex;
+    m_stream >> labelIndex >> buddyIndex;
+
+    QLabel *label = qobject_cast<QLabel*>(m_nodes.value(labelIndex));
+    QWidget *buddy = qobject_cast<QWidget*>(m_nodes.value(buddyIndex));
+    if (label && buddy)
+      label->setBuddy(buddy);
+  }
+
+  if (!isOk()) {
+    delete root;
+    return 0;
+  }
+
+  return root;
+}
+
+bool SnapshotReader::isOk() const
+{
+  return m_stream.status() == QDataStream::Ok;
+}
+
+void SnapshotReader::setCorrupt()
+{
+  m_stream.setStatus(QDataStream::ReadCorruptData);
+}
+
+QObject *SnapshotReader::createObject(QWidget *parent)
+{
+  quint16 classIndex = 0;
+  m_stream >> classIndex;
+
+  const SnapshotClass *snapshotClass = isOk() ? findClass(m_strings.value(classIndex).constData()) : 0;
+  if (!snapshotClass) {
+    setCorrupt();
+    return 0;
+  }
+
+  QObject *object = snapshotClass->create(parent);
+  m_nodes.append(object);
+
+  return object;
+}
+
+void SnapshotReader::readPlacement(quint8 placement, PlacementArguments *arguments)
+{
+  switch (placement) {
+  case ChildPlacement:
+    m_stream >> arguments->values[0];
+    break;
+  case LayoutItemPlacement:
+    m_stream >> arguments->values[0] >> arguments->values[1] >> arguments->values[2] >> arguments->values[3]
+             >> arguments->alignment;
+    break;
+  case TabPlacement:
+  case ToolBoxPlacement:
+    m_stream >> arguments->text >> arguments->icon;
+    break;
+  case ToolBarPlacement:
+  case DockWidgetPlacement:
+    m_stream >> arguments->area;
+    break;
+  default:
+    break;
+  }
+}
+
+void SnapshotReader::readChildren(QObject *container, QWidget *parentWidget)
+{
+  while (isOk()) {
+    quint8 kind = EndNode;
+    m_stream >> kind;
+    if (kind == EndNode)
+      return;
+
+    quint8 placement = ChildPlacement;
+    m_stream >> placement;
+
+    PlacementArguments arguments;
+    readPlacement(placement, &arguments);
+
+    switch (kind) {
+    case WidgetNode:
+      readWidget(container, parentWidget, placement, arguments);
+      break;
+
+    case LayoutNode:
+      readLayout(container, parentWidget, placement, arguments);
+      break;
+
+    case SpacerNode: {
+      qint32 width, height, horizontalPolicy, verticalPolicy;
+      m_stream >> width >> height >> horizontalPolicy >> verticalPolicy;
+
+      QSpacerItem *spacer = new QSpacerItem(width, height, QSizePolicy::Policy(horizontalPolicy),
+                                            QSizePolicy::Policy(verticalPolicy));
+      addLayoutItem(container, 0, 0, spacer, arguments);
+      break;
+    }
+
+    case ActionNode: {
+      QAction *action = qobject_cast<QAction*>(createObject(parentWidget));
+      if (!action) {
+        setCorrupt();
+        return;
+      }
+
+      addAction(container, action);
+      readProperties(action);
+      break;
+    }
+
+    case SeparatorNode: {
+      QAction *separator = new QAction(parentWidget);
+      separator->setSeparator(true);
+      addAction(container, separator);
+      break;
+    }
+
+    case ActionReferenceNode: {
+      qint32 index = -1;
+      m_stream >> index;
+
+      QObject *node = m_nodes.value(index);
+      QMenu *menu = qobject_cast<QMenu*>(node);
+      addAction(container, menu ? menu->menuAction() : qobject_cast<QAction*>(node));
+      break;
+    }
+
+    default:
+      setCorrupt();
+      return;
+    }
+  }
+}
+
+void SnapshotReader::readWidget(QObject *container, QWidget *parentWidget, quint8 placement,
+                                const PlacementArguments &arguments)
+{
+  QWidget *widget = qobject_cast<QWidget*>(createObject(parentWidget));
+  if (!widget) {
+    setCorrupt();
+    return;
+  }
+
+  quint8 flags = 0;
+  m_stream >> flags;
+
+  placeWidget(container, widget, placement, arguments);
+
+  if (flags & HiddenFlag)
+    widget->hide();
+
+  if (qobject_cast<QComboBox*>(widget)) {
+    QStringList items;
+    m_stream >> items;
+    static_cast<QComboBox*>(widget)->addItems(items);
+  }
+
+  readChildren(widget, widget);
+  readProperties(widget);
+}
+
+void SnapshotReader::readLayout(QObject *container, QWidget *parentWidget, quint8 placement,
+                                const PlacementArguments &arguments)
+{
+  QLayout *layout = qobject_cast<QLayout*>(createObject(0));
+  if (!layout) {
+    setCorrupt();
+    return;
+  }
+
+  qint32 left, top, right, bottom;
+  m_stream >> left >> top >> right >> bottom;
+
+  if (placement == LayoutPlacement && qobject_cast<QWidget*>(container)) {
+    static_cast<QWidget*>(container)->setLayout(layout);
+  } else if (placement == LayoutItemPlacement) {
+    addLayoutItem(container, 0, layout, 0, arguments);
+  } else {
+    delete layout;
+    setCorrupt();
+    return;
+  }
+
+  layout->setContentsMargins(left, top, right, bottom);
+
+  readChildren(layout, parentWidget);
+  readProperties(layout);
+}
+
+void SnapshotReader::placeWidget(QObject *container, QWidget *widget, quint8 placement,
+                                 const PlacementArguments &arguments)
+{
+  QMainWindow *mainWindow = qobject_cast<QMainWindow*>(container);
+
+  switch (placement) {
+  case ChildPlacement:
+    if (arguments.values[0] != 0)
+      widget->setWindowFlags(Qt::WindowFlags(arguments.values[0]));
+    return;
+
+  case LayoutItemPlacement:
+    addLayoutItem(container, widget, 0, 0, arguments);
+    return;
+
+  case TabPlacement:
+    if (QTabWidget *tabWidget = qobject_cast<QTabWidget*>(container)) {
+      tabWidget->addTab(widget, arguments.icon, arguments.text);
+      return;
+    }
+    break;
+
+  case ToolBoxPlacement:
+    if (QToolBox *toolBox = qobject_cast<QToolBox*>(container)) {
+      toolBox->addItem(widget, arguments.icon, arguments.text);
+      return;
+    }
+    break;
+
+  case PagePlacement:
+    if (QStackedWidget *stackedWidget = qobject_cast<QStackedWidget*>(container)) {
+      stackedWidget->addWidget(widget);
+      return;
+    } else if (QSplitter *splitter = qobject_cast<QSplitter*>(container)) {
+      splitter->addWidget(widget);
+      return;
+    } else if (QStatusBar *statusBar = qobject_cast<QStatusBar*>(container)) {
+      statusBar->addWidget(widget);
+      return;
+    } else if (QToolBar *toolBar = qobject_cast<QToolBar*>(container)) {
+      toolBar->addWidget(widget);
+      return;
+    }
+    break;
+
+  case WidgetPlacement:
+    if (QScrollArea *scrollArea = qobject_cast<QScrollArea*>(container)) {
+      scrollArea->setWidget(widget);
+      return;
+    } else if (QDockWidget *dockWidget = qobject_cast<QDockWidget*>(container)) {
+      dockWidget->setWidget(widget);
+      return;
+    }
+    break;
+
+  case CentralWidgetPlacement:
+    if (mainWindow) {
+      mainWindow->setCentralWidget(widget);
+      return;
+    }
+    break;
+
+  case MenuBarPlacement:
+    if (mainWindow && qobject_cast<QMenuBar*>(widget)) {
+      mainWindow->setMenuBar(static_cast<QMenuBar*>(widget));
+      return;
+    }
+    break;
+
+  case StatusBarPlacement:
+    if (mainWindow && qobject_cast<QStatusBar*>(widget)) {
+      mainWindow->setStatusBar(static_cast<QStatusBar*>(widget));
+      return;
+    }
+    break;
+
+  case ToolBarPlacement:
+    if (mainWindow && qobject_cast<QToolBar*>(widget)) {
+      mainWindow->addToolBar(Qt::ToolBarArea(arguments.area), static_cast<QToolBar*>(widget));
+      return;
+    }
+    break;
+
+  case DockWidgetPlacement:
+    if (mainWindow && qobject_cast<QDockWidget*>(widget)) {
+      mainWindow->addDockWidget(Qt::DockWidgetArea(arguments.area), static_cast<QDockWidget*>(widget));
+      return;
+    }
+    break;
+
+  case ActionPlacement:
+    if (qobject_cast<QMenu*>(widget)) {
+      addAction(container, static_cast<QMenu*>(widget)->menuAction());
+      return;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  setCorrupt();
+}
+
+void SnapshotReader::addLayoutItem(QObject *container, QWidget *widget, QLayout *layout, QSpacerItem *spacer,
+                                   const PlacementArguments &arguments)
+{
+  const qint32 *values = arguments.values;
+  const Qt::Alignment alignment(arguments.alignment);
+
+  if (QGridLayout *gridLayout = qobject_cast<QGridLayout*>(container)) {
+    if (widget)
+      gridLayout->addWidget(widget, values[0], values[1], values[2], values[3], alignment);
+    else if (layout)
+      gridLayout->addLayout(layout, values[0], values[1], values[2], values[3], alignment);
+    else
+      gridLayout->addItem(spacer, values[0], values[1], values[2], values[3], alignment);
+  } else if (QBoxLayout *boxLayout = qobject_cast<QBoxLayout*>(container)) {
+    if (widget) {
+      boxLayout->addWidget(widget, values[0], alignment);
+    } else if (layout) {
+      boxLayout->addLayout(layout, values[0]);
+      if (alignment != 0)
+        boxLayout->setAlignment(layout, alignment);
+    } else {
+      boxLayout->addSpacerItem(spacer);
+      boxLayout->setStretch(boxLayout->count() - 1, values[0]);
+    }
+  } else if (QFormLayout *formLayout = qobject_cast<QFormLayout*>(container)) {
+    const QFormLayout::ItemRole role = QFormLayout::ItemRole(values[1]);
+    if (widget)
+      formLayout->setWidget(values[0], role, widget);
+    else if (layout)
+      formLayout->setLayout(values[0], role, layout);
+    else
+      formLayout->setItem(values[0], role, spacer);
+  } else if (QStackedLayout *stackedLayout = qobject_cast<QStackedLayout*>(container)) {
+    if (widget) {
+      stackedLayout->addWidget(widget);
+    } else {
+      delete layout;
+      delete spacer;
+      setCorrupt();
+    }
+  } else {
+    delete layout;
+    delete spacer;
+    setCorrupt();
+  }
+}
+
+void SnapshotReader::addAction(QObject *container, QAction *action)
+{
+  QWidget *widget = qobject_cast<QWidget*>(container);
+  if (!widget || !action) {
+    setCorrupt();
+    return;
+  }
+
+  widget->addAction(action);
+}
+
+void SnapshotReader::readProperties(QObject *object)
+{
+  quint16 count = 0;
+  m_stream >> count;
+
+  for (quint16 i = 0; i < count && isOk(); ++i) {
+    quint16 nameIndex;
+    QVariant value;
+    m_stream >> nameIndex >> value;
+
+    if (nameIndex >= m_strings.count()) {
+      setCorrupt();
+      return;
+    }
+
+    object->setProperty(m_strings[nameIndex].constData(), value);
+  }
+}
+
+QByteArray DeclarativeWidgetsSnapshot::sourceHash(const QUrl &url)
+{
+  QString fileName;
+  if (url.isLocalFile())
+    fileName = url.toLocalFile();
+  else if (url.scheme() == QLatin1String("qrc"))
+    fileName = QLatin1Char(':') + url.path();
+  else
+    return QByteArray();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  if (!addFileToHash(&hash, fileName))
+    return QByteArray();
+
+  // components in the same directory are used without an import, so a change to any
+  // of them, or one being added or removed, makes the snapshot outdated as well
+  const QFileInfo fileInfo(fileName);
+  const QStringList nameFilters = QStringList() << QStringLiteral("*.qml") << QStringLiteral("*.js") << QStringLiteral("qmldir");
+  foreach (const QString &name, fileInfo.dir().entryList(nameFilters, QDir::Files, QDir::Name)) {
+    if (name == fileInfo.fileName())
+      continue;
+
+    hash.addData(name.toUtf8());
+    hash.addData("\0", 1);
+    if (!addFileToHash(&hash, fileInfo.dir().filePath(name)))
+      return QByteArray();
+  }
+
+  return hash.result();
+}
+
+bool DeclarativeWidgetsSnapshot::save(QWidget *widget, const QByteArray &sourceHash, const QString &fileName,
+                                      QString *errorString)
+{
+  Q_ASSERT(widget);
+
+  QObject *dynamicObject = findQmlBehavior(widget);
+  if (dynamicObject) {
+    if (errorString)
+      *errorString = QString::fromLatin1("%1 \"%2\" has bindings or signal handlers, they cannot be restored from a snapshot")
+                     .arg(QLatin1String(dynamicObject->metaObject()->className()), dynamicObject->objectName());
+    return false;
+  }
+
+  // the tree is written first, it collects the class and property names for the string table
+  QByteArray tree;
+  QDataStream treeStream(&tree, QIODevice::WriteOnly);
+
+  SnapshotWriter writer(treeStream);
+  if (!writer.writeTree(widget)) {
+    if (errorString)
+      *errorString = writer.errorString();
+    return false;
+  }
+
+  QSaveFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly)) {
+    if (errorString)
+      *errorString = file.errorString();
+    return false;
+  }
+
+  QDataStream stream(&file);
+  stream << snapshotMagic << snapshotFormatVersion << quint16(stream.version()) << quint32(QT_VERSION) << sourceHash;
+
+  const QList<QByteArray> strings = writer.strings();
+  stream << quint32(strings.count());
+  foreach (const QByteArray &string, strings)
+    stream << string;
+
+  stream.writeRawData(tree.constData(), tree.size());
+
+  if (stream.status() != QDataStream::Ok || !file.commit()) {
+    if (errorString)
+      *errorString = file.errorString();
+    return false;
+  }
+
+  return true;
+}
+
+QWidget *DeclarativeWidgetsSnapshot::load(const QString &fileName, const QByteArray &sourceHash, QWidget *parent)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return 0;
+
+  // read straight from the mapped pages instead of a copy of the file
+  uchar *data = file.map(0, file.size());
+  const QByteArray bytes = data ? QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size())
+                                : file.readAll();
+
+  QDataStream stream(bytes);
+  if (!readHeader(stream, sourceHash))
+    return 0;
+
+  quint32 stringCount = 0;
+  stream >> stringCount;
+
+  QVector<QByteArray> strings;
+  strings.reserve(qMin<quint32>(stringCount, 0xffff));
+  for (quint32 i = 0; i < stringCount && stream.status() == QDataStream::Ok; ++i) {
+    QByteArray string;
+    stream >> string;
+    strings.append(string);
+  }
+
+  SnapshotReader reader(stream, strings);
+  QWidget *widget = reader.readTree(parent);
+
+  if (!widget)
+    qWarning() << "Snapshot" << fileName << "is damaged";
+
+  return widget;
+}
+
+bool DeclarativeWidgetsSnapshot::isCurrent(const QString &fileName, const QByteArray &sourceHash)
+{
+  QFile file(fileName);
+  if (!file.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream stream(&file);
+  return readHeader(stream, sourceHash);
+}
@@ -0,0 +1,69 @@
+/*
+  declarativewidgetssnapshot.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef DECLARATIVEWIDGETSSNAPSHOT_H
+#define DECLARATIVEWIDGETSSNAPSHOT_H
+
+#include "declarativewidgets_export.h"
+
+#include <QByteArray>
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+class QUrl;
+class QWidget;
+QT_END_NAMESPACE
+
+// Binary snapshot of an instantiated widget tree: the widget, layout and action classes,
+// their non-default property values, the layout structure with the attached layout
+// properties, and the pages of container widgets. Restoring it needs neither the QML
+// engine nor the QML file, but only the static state is kept, so it is meant for forms
+// that do not change after creation. Trees with bindings or signal handlers are refused.
+//
+// The file starts with a versioned header holding the hash of the QML source, so a
+// snapshot of an older source or snapshot format is detected without reading further.
+// The file is memory mapped while loading.
+class DECLARATIVEWIDGETS_EXPORT DeclarativeWidgetsSnapshot
+{
+  public:
+    // SHA-1 of the QML file and of the QML, JavaScript and qmldir files in its directory,
+    // empty for files that are not local or in resources. Files the form imports from
+    // other directories are not part of it
+    static QByteArray sourceHash(const QUrl &url);
+
+    // returns false for trees with content a snapshot cannot restore, e.g. objects with
+    // QML bindings or signal handlers, item views showing a model or widget classes
+    // outside of the QtWidgets module
+    static bool save(QWidget *widget, const QByteArray &sourceHash, const QString &fileName,
+                     QString *errorString = 0);
+
+    // returns 0 if the file is missing, damaged or not current for sourceHash
+    static QWidget *load(const QString &fileName, const QByteArray &sourceHash, QWidget *parent = 0);
+
+    static bool isCurrent(const QString &fileName, const QByteArray &sourceHash);
+};
+
+#endif // DECLARATIVEWIDGETSSNAPSHOT_H
@@ -0,0 +1,313 @@
+/*
+  filesystempopulationproxymodel.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "filesystempopulationproxymodel_p.h"
+
+#include <QFileSystemModel>
+
+FileSystemPopulationProxyModel::FileSystemPopulationProxyModel(QFileSystemModel *model, QObject *parent)
+  : QAbstractProxyModel(parent)
+  , m_model(model)
+  , m_batchSize(0)
+  , m_forwardingChange(false)
+  , m_removedVisibleRows(0)
+{
+  setSourceModel(model);
+
+  connect(model, SIGNAL(rowsAboutToBeInserted(QModelIndex,int,int)), this, SLOT(onRowsAboutToBeInserted(QModelIndex,int,int)));
+  connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(onRowsInserted(QModelIndex,int,int)));
+  connect(model, SIGNAL(rowsAboutToBeRemoved(QModelIndex,int,int)), this, SLOT(onRowsAboutToBeRemoved(QModelIndex,int,int)));
+  connect(model, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(onRowsRemoved(QModelIndex,int,int)));
+  connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)), this, SLOT(onDataChanged(QModelIndex,QModelIndex,QVector<int>)));
+  connect(model, SIGNAL(headerDataChanged(Qt::Orientation,int,int)), this, SLOT(onHeaderDataChanged(Qt::Orientation,int,int)));
+  connect(model, SIGNAL(layoutAboutToBeChanged()), this, SLOT(onLayoutAboutToBeChanged()));
+  connect(model, SIGNAL(layoutChanged()), this, SLOT(onLayoutChanged()));
+  connect(model, SIGNAL(modelAboutToBeReset()), this, SLOT(onModelAboutToBeReset()));
+  connect(model, SIGNAL(modelReset()), this, SLOT(onModelReset()));
+}
+
+FileSystemPopulationProxyModel::~FileSystemPopulationProxyModel()
+{
+  qDeleteAll(m_mappings);
+}
+
+void FileSystemPopulationProxyModel::setBatchSize(int batchSize)
+{
+  m_batchSize = batchSize;
+  if (m_batchSize <= 0)
+    release(0);
+}
+
+bool FileSystemPopulationProxyModel::hasPendingRows() const
+{
+  return !m_throttled.isEmpty();
+}
+
+int FileSystemPopulationProxyModel::releaseBatch()
+{
+  return release(m_batchSize);
+}
+
+QModelIndex FileSystemPopulationProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+  if (!proxyIndex.isValid())
+    return QModelIndex();
+
+  const Mapping *mapping = static_cast<const Mapping*>(proxyIndex.internalPointer());
+  return m_model->index(proxyIndex.row(), proxyIndex.column(), mapping->sourceParent);
+}
+
+QModelIndex FileSystemPopulationProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+  if (!sourceIndex.isValid())
+    return QModelIndex();
+
+  const QModelIndex sourceParent = sourceIndex.parent();
+  if (sourceIndex.row() >= visibleRowCount(sourceParent) || !isVisible(sourceParent))
+    return QModelIndex();
+
+  return createIndex(sourceIndex.row(), sourceIndex.column(), mappingFor(sourceParent));
+}
+
+QModelIndex FileSystemPopulationProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+  const QModelIndex sourceParent = mapToSource(parent);
+  if (parent.isValid() && !sourceParent.isValid())
+    return QModelIndex();
+
+  if (row < 0 || column < 0 || row >= visibleRowCount(sourceParent) || column >= m_model->columnCount(sourceParent))
+    return QModelIndex();
+
+  return createIndex(row, column, mappingFor(sourceParent));
+}
+
+QModelIndex FileSystemPopulationProxyModel::parent(const QModelIndex &child) const
+{
+  if (!child.isValid())
+    return QModelIndex();
+
+  const Mapping *mapping = static_cast<const Mapping*>(child.internalPointer());
+  return mapFromSource(mapping->sourceParent);
+}
+
+int FileSystemPopulationProxyModel::rowCount(const QModelIndex &parent) const
+{
+  const QModelIndex sourceParent = mapToSource(parent);
+  if (parent.isValid() && !sourceParent.isValid())
+    return 0;
+
+  return visibleRowCount(sourceParent);
+}
+
+int FileSystemPopulationProxyModel::columnCount(const QModelIndex &parent) const
+{
+  const QModelIndex sourceParent = mapToSource(parent);
+  if (parent.isValid() && !sourceParent.isValid())
+    return 0;
+
+  return m_model->columnCount(sourceParent);
+}
+
+QVariant FileSystemPopulationProxyModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  return m_model->headerData(section, orientation, role);
+}
+
+void FileSystemPopulationProxyModel::onRowsAboutToBeInserted(const QModelIndex &sourceParent, int first, int last)
+{
+  Mapping *mapping = mappingFor(sourceParent);
+  if (m_batchSize > 0 && mapping->released < 0) {
+    // rows before the new ones have been visible already, those wait for releaseBatch()
+    mapping->released = m_model->rowCount(sourceParent);
+    m_throttled.insert(mapping);
+  }
+
+  // rows inserted in between visible ones show right away
+  m_forwardingChange = (mapping->released < 0 || first < mapping->released) && isVisible(sourceParent);
+  if (m_forwardingChange)
+    beginInsertRows(mapFromSource(sourceParent), first, last);
+}
+
+void FileSystemPopulationProxyModel::onRowsInserted(const QModelIndex &sourceParent, int first, int last)
+{
+  Mapping *mapping = mappingFor(sourceParent);
+  if (mapping->released >= 0 && first < mapping->released)
+    mapping->released += last - first + 1;
+
+  if (m_forwardingChange)
+    endInsertRows();
+
+  m_forwardingChange = false;
+}
+
+void FileSystemPopulationProxyModel::onRowsAboutToBeRemoved(const QModelIndex &sourceParent, int first, int last)
+{
+  m_removedVisibleRows = qMax(0, qMin(last + 1, visibleRowCount(sourceParent)) - first);
+
+  m_forwardingChange = m_removedVisibleRows > 0 && isVisible(sourceParent);
+  if (m_forwardingChange)
+    beginRemoveRows(mapFromSource(sourceParent), first, first + m_removedVisibleRows - 1);
+}
+
+void FileSystemPopulationProxyModel::onRowsRemoved(const QModelIndex &sourceParent, int first, int last)
+{
+  Q_UNUSED(first);
+  Q_UNUSED(last);
+
+  Mapping *mapping = m_mappings.value(sourceParent.internalPointer());
+  if (mapping && mapping->released >= 0)
+    mapping->released -= m_removedVisibleRows;
+
+  if (m_forwardingChange)
+    endRemoveRows();
+
+  m_forwardingChange = false;
+  m_removedVisibleRows = 0;
+
+  // the removed rows may have been directories with mappings of their own
+  QHash<const void*, Mapping*>::iterator it = m_mappings.begin();
+  while (it != m_mappings.end()) {
+    const bool isRoot = it.key() == 0;
+    if (!isRoot && !(*it)->sourceParent.isValid()) {
+      m_throttled.remove(*it);
+      delete *it;
+      it = m_mappings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void FileSystemPopulationProxyModel::onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+  const QModelIndex sourceParent = topLeft.parent();
+  const int lastRow = qMin(bottomRight.row(), visibleRowCount(sourceParent) - 1);
+  if (lastRow < topLeft.row() || !isVisible(sourceParent))
+    return;
+
+  const QModelIndex sourceBottomRight = m_model->index(lastRow, bottomRight.column(), sourceParent);
+  emit dataChanged(mapFromSource(topLeft), mapFromSource(sourceBottomRight), roles);
+}
+
+void FileSystemPopulationProxyModel::onHeaderDataChanged(Qt::Orientation orientation, int first, int last)
+{
+  emit headerDataChanged(orientation, first, last);
+}
+
+void FileSystemPopulationProxyModel::onLayoutAboutToBeChanged()
+{
+  emit layoutAboutToBeChanged();
+
+  foreach (const QModelIndex &proxyIndex, persistentIndexList()) {
+    m_layoutChangeProxyIndexes << proxyIndex;
+    m_layoutChangeSourceIndexes << mapToSource(proxyIndex);
+  }
+}
+
+void FileSystemPopulationProxyModel::onLayoutChanged()
+{
+  // sorting keeps the number of visible rows per directory, only which rows those are changes
+  for (int i = 0; i < m_layoutChangeProxyIndexes.count(); ++i)
+    changePersistentIndex(m_layoutChangeProxyIndexes.at(i), mapFromSource(m_layoutChangeSourceIndexes.at(i)));
+
+  m_layoutChangeProxyIndexes.clear();
+  m_layoutChangeSourceIndexes.clear();
+
+  emit layoutChanged();
+}
+
+void FileSystemPopulationProxyModel::onModelAboutToBeReset()
+{
+  beginResetModel();
+}
+
+void FileSystemPopulationProxyModel::onModelReset()
+{
+  qDeleteAll(m_mappings);
+  m_mappings.clear();
+  m_throttled.clear();
+
+  endResetModel();
+}
+
+FileSystemPopulationProxyModel::Mapping *FileSystemPopulationProxyModel::mappingFor(const QModelIndex &sourceParent) const
+{
+  Mapping *&mapping = m_mappings[sourceParent.internalPointer()];
+  if (!mapping) {
+    mapping = new Mapping;
+    mapping->sourceParent = sourceParent;
+    mapping->released = -1;
+  }
+
+  return mapping;
+}
+
+int FileSystemPopulationProxyModel::visibleRowCount(const QModelIndex &sourceParent) const
+{
+  const int rowCount = m_model->rowCount(sourceParent);
+
+  const Mapping *mapping = m_mappings.value(sourceParent.internalPointer());
+  if (!mapping || mapping->released < 0)
+    return rowCount;
+
+  return qMin(mapping->released, rowCount);
+}
+
+// false for directories held back in their parent, or in one of its ancestors
+bool FileSystemPopulationProxyModel::isVisible(const QModelIndex &sourceParent) const
+{
+  return !sourceParent.isValid() || mapFromSource(sourceParent).isValid();
+}
+
+int FileSystemPopulationProxyModel::release(int batchSize)
+{
+  int releasedCount = 0;
+
+  foreach (Mapping *mapping, m_throttled) {
+    const int rowCount = m_model->rowCount(mapping->sourceParent);
+    const int released = batchSize > 0 ? qMin(rowCount, mapping->released + batchSize) : rowCount;
+
+    if (released > mapping->released) {
+      // the rows of a hidden directory show up together with the directory
+      const bool visible = isVisible(mapping->sourceParent);
+      if (visible)
+        beginInsertRows(mapFromSource(mapping->sourceParent), mapping->released, released - 1);
+
+      releasedCount += released - mapping->released;
+      mapping->released = released;
+
+      if (visible)
+        endInsertRows();
+    }
+
+    if (released >= rowCount) {
+      mapping->released = -1;
+      m_throttled.remove(mapping);
+    }
+  }
+
+  return releasedCount;
+}
@@ -0,0 +1,113 @@
+/*
+  filesystempopulationproxymodel_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef FILESYSTEMPOPULATIONPROXYMODEL_P_H
+#define FILESYSTEMPOPULATIONPROXYMODEL_P_H
+
+#include <QAbstractProxyModel>
+#include <QHash>
+#include <QList>
+#include <QPersistentModelIndex>
+#include <QSet>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QFileSystemModel;
+QT_END_NAMESPACE
+
+// Shows the rows of a QFileSystemModel in the same tree structure but holds back rows the
+// model appended beyond a per-directory quota. The quota is raised in batches, each one
+// reaching views as a single row insertion per directory instead of re-filtering the model.
+class FileSystemPopulationProxyModel : public QAbstractProxyModel
+{
+  Q_OBJECT
+
+  public:
+    FileSystemPopulationProxyModel(QFileSystemModel *model, QObject *parent);
+    ~FileSystemPopulationProxyModel();
+
+    // 0 shows all rows right away
+    void setBatchSize(int batchSize);
+
+    bool hasPendingRows() const;
+
+    // returns the number of rows which became visible
+    int releaseBatch();
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const;
+
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+    QModelIndex parent(const QModelIndex &child) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+
+    // the columns are the source's, also while there are no rows to map sections through
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+  private Q_SLOTS:
+    void onRowsAboutToBeInserted(const QModelIndex &sourceParent, int first, int last);
+    void onRowsInserted(const QModelIndex &sourceParent, int first, int last);
+    void onRowsAboutToBeRemoved(const QModelIndex &sourceParent, int first, int last);
+    void onRowsRemoved(const QModelIndex &sourceParent, int first, int last);
+    void onDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void onHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+    void onLayoutAboutToBeChanged();
+    void onLayoutChanged();
+    void onModelAboutToBeReset();
+    void onModelReset();
+
+  private:
+    // the children of one source parent, proxy indexes point to the mapping of their parent
+    struct Mapping
+    {
+      QPersistentModelIndex sourceParent;
+      // leading rows that are visible, -1 if all of them are
+      int released;
+    };
+
+    Mapping *mappingFor(const QModelIndex &sourceParent) const;
+    int visibleRowCount(const QModelIndex &sourceParent) const;
+    bool isVisible(const QModelIndex &sourceParent) const;
+    int release(int batchSize);
+
+    QFileSystemModel *m_model;
+    int m_batchSize;
+
+    // keyed by the internal pointer of the source parent, QFileSystemModel's node
+    mutable QHash<const void*, Mapping*> m_mappings;
+    QSet<Mapping*> m_throttled;
+
+    // whether the change between the about to and done signals is visible in the proxy
+    bool m_forwardingChange;
+    int m_removedVisibleRows;
+
+    QList<QPersistentModelIndex> m_layoutChangeProxyIndexes;
+    QList<QPersistentModelIndex> m_layoutChangeSourceIndexes;
+};
+
+#endif // FILESYSTEMPOPULATIONPROXYMODEL_P_H
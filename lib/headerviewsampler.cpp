@@ -0,0 +1,357 @@
+/*
+  headerviewsampler.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "headerviewsampler_p.h"
+
+#include <QHeaderView>
+#include <QPointer>
+#include <QScrollBar>
+#include <QTableView>
+#include <QTimer>
+#include <QTreeView>
+
+static const int s_refinementChunkSize = 256;
+
+class HeaderViewSampler::Private
+{
+  public:
+    Private()
+      : header(0)
+      , refinementTimer(0)
+      , enabled(false)
+      , sampleSize(DefaultSampleSize)
+      , rowHeight(0)
+    {}
+
+    QAbstractItemView *view() const;
+    QModelIndex firstRow() const;
+    QModelIndex nextRow(const QModelIndex &index) const;
+    QModelIndex previousRow(const QModelIndex &index) const;
+    QModelIndexList sampleRows(bool includeNearby) const;
+
+    void measure(const QModelIndex &row);
+    void apply(bool growOnly);
+
+    QHeaderView *header;
+    QTimer *refinementTimer;
+    QPointer<QAbstractItemModel> model;
+    QPersistentModelIndex refinementCursor;
+
+    bool enabled;
+    int sampleSize;
+
+    QVector<int> sectionSizes;
+    int rowHeight;
+};
+
+QAbstractItemView *HeaderViewSampler::Private::view() const
+{
+  return qobject_cast<QAbstractItemView*>(header->parentWidget());
+}
+
+QModelIndex HeaderViewSampler::Private::firstRow() const
+{
+  if (!model || model->rowCount() == 0)
+    return QModelIndex();
+
+  return model->index(0, 0);
+}
+
+QModelIndex HeaderViewSampler::Private::nextRow(const QModelIndex &index) const
+{
+  QTreeView *treeView = qobject_cast<QTreeView*>(view());
+  if (treeView)
+    return treeView->indexBelow(index);
+
+  if (index.row() + 1 >= model->rowCount(index.parent()))
+    return QModelIndex();
+
+  return model->index(index.row() + 1, 0, index.parent());
+}
+
+QModelIndex HeaderViewSampler::Private::previousRow(const QModelIndex &index) const
+{
+  QTreeView *treeView = qobject_cast<QTreeView*>(view());
+  if (treeView)
+    return treeView->indexAbove(index);
+
+  if (index.row() == 0)
+    return QModelIndex();
+
+  return model->index(index.row() - 1, 0, index.parent());
+}
+
+QModelIndexList HeaderViewSampler::Private::sampleRows(bool includeNearby) const
+{
+  QModelIndexList rows;
+
+  QAbstractItemView *itemView = view();
+  QModelIndex top = itemView->indexAt(QPoint(0, 0));
+  top = top.isValid() ? top.sibling(top.row(), 0) : firstRow();
+
+  const int viewportHeight = itemView->viewport()->height();
+
+  QModelIndex index = top;
+  while (index.isValid() && rows.count() < sampleSize && itemView->visualRect(index).top() <= viewportHeight) {
+    rows << index;
+    index = nextRow(index);
+  }
+
+  if (!includeNearby)
+    return rows;
+
+  // spend the remaining budget on rows around the visible ones, half of it below
+  const int below = rows.count() + (sampleSize - rows.count()) / 2;
+  while (index.isValid() && rows.count() < below) {
+    rows << index;
+    index = nextRow(index);
+  }
+
+  index = top.isValid() ? previousRow(top) : QModelIndex();
+  while (index.isValid() && rows.count() < sampleSize) {
+    rows << index;
+    index = previousRow(index);
+  }
+
+  return rows;
+}
+
+void HeaderViewSampler::Private::measure(const QModelIndex &row)
+{
+  QAbstractItemView *itemView = view();
+
+  QTableView *tableView = qobject_cast<QTableView*>(itemView);
+  const int gridExtent = (tableView && tableView->showGrid()) ? 1 : 0;
+
+  if (header->orientation() == Qt::Horizontal) {
+    QTreeView *treeView = qobject_cast<QTreeView*>(itemView);
+    const int treeColumn = treeView ? header->logicalIndex(0) : -1;
+
+    for (int column = 0; column < sectionSizes.count(); ++column) {
+      if (header->isSectionHidden(column))
+        continue;
+
+      int width = itemView->sizeHintForIndex(model->index(row.row(), column, row.parent())).width() + gridExtent;
+
+      if (column == treeColumn) {
+        int depth = treeView->rootIsDecorated() ? 1 : 0;
+        for (QModelIndex parent = row.parent(); parent.isValid(); parent = parent.parent())
+          ++depth;
+        width += depth * treeView->indentation();
+      }
+
+      sectionSizes[column] = qMax(sectionSizes[column], width);
+    }
+  } else {
+    const int columnCount = model->columnCount(row.parent());
+    for (int column = 0; column < columnCount; ++column) {
+      const int height = itemView->sizeHintForIndex(model->index(row.row(), column, row.parent())).height() + gridExtent;
+      rowHeight = qMax(rowHeight, height);
+    }
+  }
+}
+
+void HeaderViewSampler::Private::apply(bool growOnly)
+{
+  if (header->orientation() == Qt::Horizontal) {
+    const int count = qMin(sectionSizes.count(), header->count());
+    for (int section = 0; section < count; ++section) {
+      if (!growOnly || sectionSizes[section] > header->sectionSize(section))
+        header->resizeSection(section, sectionSizes[section]);
+    }
+  } else {
+    // rows get a uniform estimated height instead of being measured one by one
+    if (!growOnly || rowHeight > header->defaultSectionSize())
+      header->setDefaultSectionSize(rowHeight);
+  }
+}
+
+void HeaderViewSampler::configure(QHeaderView *header, bool enabled, int sampleSize)
+{
+  if (!header)
+    return;
+
+  HeaderViewSampler *sampler = header->findChild<HeaderViewSampler*>(QString(), Qt::FindDirectChildrenOnly);
+  if (!sampler) {
+    if (!enabled)
+      return;
+
+    sampler = new HeaderViewSampler(header);
+  }
+
+  sampler->setSampleSize(sampleSize);
+  sampler->setEnabled(enabled);
+}
+
+HeaderViewSampler::HeaderViewSampler(QHeaderView *header)
+  : QObject(header)
+  , d(new Private)
+{
+  d->header = header;
+
+  d->refinementTimer = new QTimer(this);
+  d->refinementTimer->setInterval(0);
+  connect(d->refinementTimer, SIGNAL(timeout()), this, SLOT(refine()));
+
+  connect(d->header, SIGNAL(sectionCountChanged(int,int)), this, SLOT(onSectionCountChanged(int,int)));
+}
+
+HeaderViewSampler::~HeaderViewSampler()
+{
+  delete d;
+}
+
+void HeaderViewSampler::setEnabled(bool enable)
+{
+  if (d->enabled == enable)
+    return;
+
+  d->enabled = enable;
+
+  if (d->enabled)
+    d->header->setSectionResizeMode(QHeaderView::Interactive);
+
+  restart();
+}
+
+bool HeaderViewSampler::isEnabled() const
+{
+  return d->enabled;
+}
+
+void HeaderViewSampler::setSampleSize(int sampleSize)
+{
+  sampleSize = qMax(1, sampleSize);
+  if (d->sampleSize == sampleSize)
+    return;
+
+  d->sampleSize = sampleSize;
+
+  restart();
+}
+
+int HeaderViewSampler::sampleSize() const
+{
+  return d->sampleSize;
+}
+
+void HeaderViewSampler::restart()
+{
+  d->refinementTimer->stop();
+
+  if (d->model != d->header->model()) {
+    if (d->model)
+      disconnect(d->model, 0, this, 0);
+
+    d->model = d->header->model();
+
+    if (d->model) {
+      connect(d->model, SIGNAL(modelReset()), this, SLOT(restart()));
+      connect(d->model, SIGNAL(layoutChanged()), this, SLOT(restart()));
+      connect(d->model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(measureRows(QModelIndex,int,int)));
+      connect(d->model, SIGNAL(dataChanged(QModelIndex,QModelIndex)), this, SLOT(measureChanged(QModelIndex,QModelIndex)));
+    }
+  }
+
+  QAbstractItemView *itemView = d->view();
+  if (!d->enabled || !d->model || !itemView)
+    return;
+
+  connect(itemView->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(measureVisible()), Qt::UniqueConnection);
+
+  // one section per row for vertical headers, those only get the uniform row height
+  d->sectionSizes.clear();
+  if (d->header->orientation() == Qt::Horizontal) {
+    d->sectionSizes.resize(d->header->count());
+    for (int section = 0; section < d->sectionSizes.count(); ++section)
+      d->sectionSizes[section] = d->header->sectionSizeHint(section);
+  }
+  d->rowHeight = d->header->minimumSectionSize();
+
+  foreach (const QModelIndex &row, d->sampleRows(true))
+    d->measure(row);
+
+  d->apply(false);
+
+  d->refinementCursor = d->firstRow();
+  if (d->refinementCursor.isValid())
+    d->refinementTimer->start();
+}
+
+void HeaderViewSampler::onSectionCountChanged(int oldCount, int newCount)
+{
+  // vertical sections follow the rows, those are handled by measureRows()
+  if (d->header->orientation() == Qt::Horizontal || oldCount == 0 || newCount == 0)
+    restart();
+}
+
+void HeaderViewSampler::measureVisible()
+{
+  if (!d->enabled || !d->model || !d->view())
+    return;
+
+  foreach (const QModelIndex &row, d->sampleRows(false))
+    d->measure(row);
+
+  d->apply(true);
+}
+
+void HeaderViewSampler::measureRows(const QModelIndex &parent, int first, int last)
+{
+  if (!d->enabled || !d->model || !d->view())
+    return;
+
+  last = qMin(last, first + d->sampleSize - 1);
+  for (int row = first; row <= last; ++row)
+    d->measure(d->model->index(row, 0, parent));
+
+  d->apply(true);
+}
+
+void HeaderViewSampler::measureChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+  measureRows(topLeft.parent(), topLeft.row(), bottomRight.row());
+}
+
+void HeaderViewSampler::refine()
+{
+  if (!d->enabled || !d->model || !d->view()) {
+    d->refinementTimer->stop();
+    return;
+  }
+
+  QModelIndex row = d->refinementCursor;
+  for (int i = 0; i < s_refinementChunkSize && row.isValid(); ++i) {
+    d->measure(row);
+    row = d->nextRow(row);
+  }
+
+  d->refinementCursor = row;
+  d->apply(true);
+
+  if (!row.isValid())
+    d->refinementTimer->stop();
+}
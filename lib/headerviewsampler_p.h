@@ -0,0 +1,76 @@
+/*
+  headerviewsampler_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef HEADERVIEWSAMPLER_P_H
+#define HEADERVIEWSAMPLER_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QModelIndex>
+#include <QObject>
+
+QT_BEGIN_NAMESPACE
+class QHeaderView;
+QT_END_NAMESPACE
+
+// Resizes the sections of a header view to the contents of its item view without
+// measuring every row: section sizes are estimated from at most sampleSize rows around
+// the visible ones and then refined in chunks while the event loop is idle.
+// Lives as a child of the header, the view extensions install it on the headers the
+// item view created itself
+class DECLARATIVEWIDGETS_EXPORT HeaderViewSampler : public QObject
+{
+  Q_OBJECT
+
+  public:
+    static const int DefaultSampleSize = 100;
+
+    // creates the sampler of header if enabled and there is none yet
+    static void configure(QHeaderView *header, bool enabled, int sampleSize);
+
+    explicit HeaderViewSampler(QHeaderView *header);
+    ~HeaderViewSampler();
+
+    void setEnabled(bool enable);
+    bool isEnabled() const;
+
+    void setSampleSize(int sampleSize);
+    int sampleSize() const;
+
+  private Q_SLOTS:
+    void restart();
+    void onSectionCountChanged(int oldCount, int newCount);
+    void measureVisible();
+    void measureRows(const QModelIndex &parent, int first, int last);
+    void measureChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void refine();
+
+  private:
+    class Private;
+    Private *const d;
+};
+
+#endif // HEADERVIEWSAMPLER_P_H
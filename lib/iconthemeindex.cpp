@@ -0,0 +1,454 @@
+/*
+  iconthemeindex.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "iconthemeindex_p.h"
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QIconEngine>
+#include <QPainter>
+#include <QSaveFile>
+#include <QSettings>
+#include <QStandardPaths>
+#include <QtConcurrent>
+
+static const quint32 s_cacheMagic = 0x49544958; // "ITIX"
+static const qint32 s_cacheVersion = 1;
+
+IconThemeIndex *IconThemeIndex::s_instance = 0;
+
+static QDataStream &operator<<(QDataStream &stream, const ThemeIconFile &file)
+{
+  return stream << file.path << qint32(file.size) << file.scalable;
+}
+
+static QDataStream &operator>>(QDataStream &stream, ThemeIconFile &file)
+{
+  qint32 size;
+  stream >> file.path >> size >> file.scalable;
+  file.size = size;
+  return stream;
+}
+
+static QDataStream &operator<<(QDataStream &stream, const IndexedTheme &theme)
+{
+  return stream << theme.inherits << theme.icons << theme.directories;
+}
+
+static QDataStream &operator>>(QDataStream &stream, IndexedTheme &theme)
+{
+  return stream >> theme.inherits >> theme.icons >> theme.directories;
+}
+
+// keeps the theme icon's name(), which a QIcon assembled from files would not have
+class ThemeIndexIconEngine : public QIconEngine
+{
+  public:
+    ThemeIndexIconEngine(const QIcon &icon, const QString &name)
+      : m_icon(icon)
+      , m_name(name)
+    {
+    }
+
+    void paint(QPainter *painter, const QRect &rect, QIcon::Mode mode, QIcon::State state)
+    {
+      m_icon.paint(painter, rect, Qt::AlignCenter, mode, state);
+    }
+
+    QSize actualSize(const QSize &size, QIcon::Mode mode, QIcon::State state)
+    {
+      return m_icon.actualSize(size, mode, state);
+    }
+
+    QPixmap pixmap(const QSize &size, QIcon::Mode mode, QIcon::State state)
+    {
+      return m_icon.pixmap(size, mode, state);
+    }
+
+    QString key() const
+    {
+      return QStringLiteral("ThemeIndexIconEngine");
+    }
+
+    QIconEngine *clone() const
+    {
+      return new ThemeIndexIconEngine(m_icon, m_name);
+    }
+
+    void virtual_hook(int id, void *data)
+    {
+      switch (id) {
+        case QIconEngine::AvailableSizesHook: {
+          QIconEngine::AvailableSizesArgument &argument = *reinterpret_cast<QIconEngine::AvailableSizesArgument*>(data);
+          argument.sizes = m_icon.availableSizes(argument.mode, argument.state);
+          break;
+        }
+        case QIconEngine::IconNameHook:
+          *reinterpret_cast<QString*>(data) = m_name;
+          break;
+        default:
+          QIconEngine::virtual_hook(id, data);
+          break;
+      }
+    }
+
+  private:
+    QIcon m_icon;
+    QString m_name;
+};
+
+static qint64 directoryTimeStamp(const QString &path)
+{
+  const QFileInfo info(path);
+  return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+static bool isUpToDate(const IndexedTheme &theme)
+{
+  QHash<QString, qint64>::const_iterator it = theme.directories.constBegin();
+  for (; it != theme.directories.constEnd(); ++it) {
+    if (directoryTimeStamp(it.key()) != it.value())
+      return false;
+  }
+
+  return true;
+}
+
+static QString cacheFileName()
+{
+  const QString location = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (location.isEmpty())
+    return QString();
+
+  return location + QLatin1String("/iconthemeindex.cache");
+}
+
+// returns the cached themes that are still valid for the given search paths
+static IndexedThemeHash loadCache(const QStringList &searchPaths)
+{
+  QFile file(cacheFileName());
+  if (file.fileName().isEmpty() || !file.open(QIODevice::ReadOnly))
+    return IndexedThemeHash();
+
+  QDataStream stream(&file);
+
+  quint32 magic;
+  qint32 version;
+  stream >> magic >> version;
+  if (magic != s_cacheMagic || version != s_cacheVersion)
+    return IndexedThemeHash();
+
+  QStringList cachedSearchPaths;
+  IndexedThemeHash themes;
+  stream >> cachedSearchPaths >> themes;
+  if (stream.status() != QDataStream::Ok || cachedSearchPaths != searchPaths)
+    return IndexedThemeHash();
+
+  // only themes with changed directories need to be indexed again
+  IndexedThemeHash::iterator it = themes.begin();
+  while (it != themes.end()) {
+    if (isUpToDate(it.value()))
+      ++it;
+    else
+      it = themes.erase(it);
+  }
+
+  return themes;
+}
+
+static void saveCache(const QStringList &searchPaths, const IndexedThemeHash &themes)
+{
+  const QString fileName = cacheFileName();
+  if (fileName.isEmpty() || !QDir().mkpath(QFileInfo(fileName).absolutePath()))
+    return;
+
+  QSaveFile file(fileName);
+  if (!file.open(QIODevice::WriteOnly))
+    return;
+
+  QDataStream stream(&file);
+  stream << s_cacheMagic << s_cacheVersion << searchPaths << themes;
+
+  if (stream.status() == QDataStream::Ok)
+    file.commit();
+  else
+    file.cancelWriting();
+}
+
+static IndexedTheme indexTheme(const QString &themeName, const QStringList &searchPaths)
+{
+  IndexedTheme theme;
+
+  QStringList nameFilters;
+  nameFilters << QStringLiteral("*.png") << QStringLiteral("*.svg") << QStringLiteral("*.svgz") << QStringLiteral("*.xpm");
+
+  bool hasIndexFile = false;
+  foreach (const QString &searchPath, searchPaths) {
+    const QDir base(searchPath + QLatin1Char('/') + themeName);
+
+    // also remembers missing theme directories, so a theme installed later invalidates the cache
+    theme.directories.insert(base.absolutePath(), directoryTimeStamp(base.absolutePath()));
+    if (!base.exists())
+      continue;
+
+    const QString indexFileName = base.filePath(QStringLiteral("index.theme"));
+    if (!QFileInfo::exists(indexFileName))
+      continue;
+
+    QSettings index(indexFileName, QSettings::IniFormat);
+    if (!hasIndexFile) {
+      theme.inherits = index.value(QStringLiteral("Icon Theme/Inherits")).toStringList();
+      hasIndexFile = true;
+    }
+
+    const QStringList directories = index.value(QStringLiteral("Icon Theme/Directories")).toStringList();
+    foreach (const QString &directory, directories) {
+      const QDir dir(base.filePath(directory));
+      if (!dir.exists())
+        continue;
+
+      theme.directories.insert(dir.absolutePath(), directoryTimeStamp(dir.absolutePath()));
+
+      ThemeIconFile file;
+      file.size = index.value(directory + QStringLiteral("/Size")).toInt();
+      file.scalable = index.value(directory + QStringLiteral("/Type")).toString() == QLatin1String("Scalable");
+
+      foreach (const QFileInfo &entry, dir.entryInfoList(nameFilters, QDir::Files)) {
+        file.path = entry.filePath();
+        theme.icons[entry.completeBaseName()].append(file);
+      }
+    }
+  }
+
+  return theme;
+}
+
+static QStringList themeChain(const QString &themeName, const IndexedThemeHash &themes, QStringList *missing)
+{
+  QStringList chain;
+  QStringList queue;
+  queue << themeName << QStringLiteral("hicolor");
+
+  while (!queue.isEmpty()) {
+    const QString name = queue.takeFirst();
+    if (name.isEmpty() || chain.contains(name))
+      continue;
+
+    chain << name;
+
+    IndexedThemeHash::const_iterator it = themes.constFind(name);
+    if (it == themes.constEnd()) {
+      missing->append(name);
+      continue;
+    }
+
+    // inherited themes come before the hicolor fallback
+    for (int i = it->inherits.count() - 1; i >= 0; --i)
+      queue.prepend(it->inherits.at(i));
+  }
+
+  return chain;
+}
+
+// runs on the thread pool, returns the known themes plus the ones indexed for the given theme
+static IndexedThemeHash indexThemes(const QString &themeName, const QStringList &searchPaths, IndexedThemeHash themes)
+{
+  bool changed = false;
+
+  QStringList missing;
+  themeChain(themeName, themes, &missing);
+
+  // indexing a theme can reveal further inherited themes
+  while (!missing.isEmpty()) {
+    foreach (const QString &name, missing)
+      themes.insert(name, indexTheme(name, searchPaths));
+
+    changed = true;
+    missing.clear();
+    themeChain(themeName, themes, &missing);
+  }
+
+  if (changed)
+    saveCache(searchPaths, themes);
+
+  return themes;
+}
+
+IconThemeIndex::IconThemeIndex(QObject *parent)
+  : QObject(parent)
+  , m_watcher(0)
+  , m_cacheLoaded(false)
+{
+}
+
+IconThemeIndex::~IconThemeIndex()
+{
+  if (m_watcher) {
+    m_watcher->disconnect(this);
+    m_watcher->waitForFinished();
+  }
+
+  if (s_instance == this)
+    s_instance = 0;
+}
+
+IconThemeIndex *IconThemeIndex::instance()
+{
+  if (!s_instance)
+    s_instance = new IconThemeIndex(QCoreApplication::instance());
+
+  return s_instance;
+}
+
+QIcon IconThemeIndex::icon(const QString &name)
+{
+  prepare();
+
+  if (!isReady())
+    return QIcon::fromTheme(name);
+
+  QHash<QString, QIcon>::const_iterator it = m_icons.constFind(name);
+  if (it != m_icons.constEnd())
+    return it.value();
+
+  // platform icon engines and fallback paths are not part of the index
+  QIcon icon = lookup(name);
+  if (icon.isNull())
+    icon = QIcon::fromTheme(name);
+
+  m_icons.insert(name, icon);
+  return icon;
+}
+
+bool IconThemeIndex::isReady() const
+{
+  return !m_chain.isEmpty();
+}
+
+void IconThemeIndex::prepare()
+{
+  const QString themeName = QIcon::themeName();
+  const QStringList searchPaths = QIcon::themeSearchPaths();
+
+  if (!m_cacheLoaded) {
+    m_cacheLoaded = true;
+    m_searchPaths = searchPaths;
+    m_themes = loadCache(searchPaths);
+  }
+
+  // other search paths can change every theme, a different theme name only changes the chain
+  if (searchPaths != m_searchPaths) {
+    m_searchPaths = searchPaths;
+    m_themes.clear();
+    m_themeName.clear();
+    m_chain.clear();
+  }
+
+  if (themeName != m_themeName || m_chain.isEmpty()) {
+    m_themeName = themeName;
+    m_icons.clear();
+    updateChain();
+  }
+}
+
+void IconThemeIndex::onIndexed()
+{
+  const IndexedThemeHash themes = m_watcher->result();
+
+  m_watcher->deleteLater();
+  m_watcher = 0;
+
+  // results for outdated search paths are dropped, prepare() indexes again if still needed
+  if (m_indexingSearchPaths == m_searchPaths) {
+    m_themes = themes;
+    m_icons.clear();
+  }
+
+  updateChain();
+}
+
+void IconThemeIndex::updateChain()
+{
+  QStringList missing;
+  const QStringList chain = themeChain(m_themeName, m_themes, &missing);
+
+  if (missing.isEmpty()) {
+    m_chain = chain;
+    return;
+  }
+
+  m_chain.clear();
+  startIndexing();
+}
+
+void IconThemeIndex::startIndexing()
+{
+  if (m_watcher)
+    return;
+
+  m_indexingSearchPaths = m_searchPaths;
+
+  m_watcher = new QFutureWatcher<IndexedThemeHash>(this);
+  connect(m_watcher, SIGNAL(finished()), this, SLOT(onIndexed()));
+  m_watcher->setFuture(QtConcurrent::run(indexThemes, m_themeName, m_searchPaths, m_themes));
+}
+
+QIcon IconThemeIndex::lookup(const QString &name) const
+{
+  QString iconName = name;
+
+  // same fallback as the freedesktop spec: "edit-copy-all" tries "edit-copy", then "edit"
+  forever {
+    foreach (const QString &themeName, m_chain) {
+      const IndexedTheme &theme = *m_themes.constFind(themeName);
+      const QHash<QString, QVector<ThemeIconFile> >::const_iterator files = theme.icons.constFind(iconName);
+      if (files == theme.icons.constEnd())
+        continue;
+
+      QIcon icon;
+      foreach (const ThemeIconFile &file, files.value()) {
+        if (file.scalable)
+          icon.addFile(file.path);
+        else
+          icon.addFile(file.path, QSize(file.size, file.size));
+      }
+
+      return QIcon(new ThemeIndexIconEngine(icon, name));
+    }
+
+    const int dash = iconName.lastIndexOf(QLatin1Char('-'));
+    if (dash <= 0)
+      break;
+
+    iconName.truncate(dash);
+  }
+
+  return QIcon();
+}
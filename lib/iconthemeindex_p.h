@@ -0,0 +1,97 @@
+/*
+  iconthemeindex_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef ICONTHEMEINDEX_P_H
+#define ICONTHEMEINDEX_P_H
+
+#include <QHash>
+#include <QIcon>
+#include <QObject>
+#include <QStringList>
+#include <QVector>
+
+template <typename T> class QFutureWatcher;
+
+struct ThemeIconFile
+{
+  QString path;
+  int size;
+  bool scalable;
+};
+
+struct IndexedTheme
+{
+  QStringList inherits;
+  QHash<QString, QVector<ThemeIconFile> > icons;
+  // scanned directories and their modification time, a changed directory invalidates the theme
+  QHash<QString, qint64> directories;
+};
+
+typedef QHash<QString, IndexedTheme> IndexedThemeHash;
+
+// Maps icon names to the files of the current icon theme and its inherited themes.
+// Themes are indexed once on a worker thread and persisted to a cache file, so that
+// Icon.fromTheme() does not probe the theme directories for every icon.
+class IconThemeIndex : public QObject
+{
+  Q_OBJECT
+
+  public:
+    static IconThemeIndex *instance();
+
+    ~IconThemeIndex();
+
+    // falls back to QIcon::fromTheme() while indexing and for names the index does not know
+    QIcon icon(const QString &name);
+
+    // starts indexing the current theme ahead of the first lookup
+    void prepare();
+
+    bool isReady() const;
+
+  private Q_SLOTS:
+    void onIndexed();
+
+  private:
+    explicit IconThemeIndex(QObject *parent);
+
+    void updateChain();
+    void startIndexing();
+    QIcon lookup(const QString &name) const;
+
+    QString m_themeName;
+    QStringList m_searchPaths;
+    QStringList m_chain;
+    IndexedThemeHash m_themes;
+    QHash<QString, QIcon> m_icons;
+    QFutureWatcher<IndexedThemeHash> *m_watcher;
+    QStringList m_indexingSearchPaths;
+    bool m_cacheLoaded;
+
+    static IconThemeIndex *s_instance;
+};
+
+#endif // ICONTHEMEINDEX_P_H
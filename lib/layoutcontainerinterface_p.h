@@ -45,6 +45,8 @@ class DECLARATIVEWIDGETS_EXPORT LayoutContainerInterface
     virtual void addLayout(QLayout *layout) = 0;
     virtual void addSpacer(DeclarativeSpacerItem *spacerItem) = 0;
     virtual void addWidget(QWidget *widget) = 0;
+    virtual void insertWidget(int index, QWidget *widget) = 0;
+    virtual void removeWidget(QWidget *widget) = 0;
     virtual void setContentsMargins(int left, int top, int right, int bottom) = 0;
     virtual void getContentsMargins(int &left, int &top, int &right, int &bottom) = 0;
 };
@@ -2,7 +2,7 @@ TEMPLATE = lib
 
 TARGET = declarativewidgets
 
-QT += core-private qml widgets quickwidgets
+QT += core-private concurrent qml qml-private widgets quickwidgets
 
 qtHaveModule(webenginewidgets) {
     QT += webenginewidgets
@@ -35,32 +35,45 @@ HEADERS = \
   declarativeicon_p.h \
   declarativeinputdialog_p.h \
   declarativeitemviewextension_p.h \
+  declarativelazytreemodel_p.h \
   declarativelayoutextension.h \
   declarativemessagebox_p.h \
   declarativeobjectextension.h \
   declarativeobjectproxy_p.h \
   declarativepixmap_p.h \
+  declarativepreloader_p.h \
   declarativeqmlcontext_p.h \
   declarativequickwidgetextension_p.h \
+  declarativerepeater_p.h \
   declarativeseparator_p.h \
   declarativestackedlayout_p.h \
   declarativestatusbar_p.h \
   declarativestringlistmodelextension_p.h \
+  declarativesyntaxhighlighter_p.h \
   declarativetableviewextension_p.h \
   declarativetabwidget_p.h \
+  declarativetextdocumentbuilder_p.h \
+  declarativetextdocumentloader.h \
+  declarativetextdocumentsaver.h \
   declarativetexteditextension_p.h \
   declarativetreeviewextension_p.h \
   declarativevboxlayout_p.h \
   declarativewidgetextension.h \
   declarativewidgetsdocument.h \
+  declarativewidgetssnapshot.h \
   defaultobjectcontainer_p.h \
   defaultwidgetcontainer.h \
+  filesystempopulationproxymodel_p.h \
+  headerviewsampler_p.h \
+  iconthemeindex_p.h \
   layoutcontainerinterface_p.h \
   mainwindowwidgetcontainer_p.h \
   menubarwidgetcontainer_p.h \
   menuwidgetcontainer_p.h \
   objectadaptors_p.h \
   objectcontainerinterface_p.h \
+  pixmapcache_p.h \
+  repeatercontainerinterface_p.h \
   scrollareawidgetcontainer_p.h \
   stackedwidgetwidgetcontainer_p.h \
   staticdialogmethodattached_p.h \
@@ -89,29 +102,41 @@ SOURCES = \
   declarativeicon.cpp \
   declarativeinputdialog.cpp \
   declarativeitemviewextension.cpp \
+  declarativelazytreemodel.cpp \
   declarativelayoutextension.cpp \
   declarativemessagebox.cpp \
   declarativeobjectextension.cpp \
   declarativepixmap.cpp \
+  declarativepreloader.cpp \
   declarativeqmlcontext.cpp \
   declarativequickwidgetextension.cpp \
+  declarativerepeater.cpp \
   declarativeseparator.cpp \
   declarativestackedlayout.cpp \
   declarativestatusbar.cpp \
   declarativestringlistmodelextension.cpp \
+  declarativesyntaxhighlighter.cpp \
   declarativetableviewextension.cpp \
   declarativetabwidget.cpp \
+  declarativetextdocumentbuilder.cpp \
+  declarativetextdocumentloader.cpp \
+  declarativetextdocumentsaver.cpp \
   declarativetexteditextension.cpp \
   declarativetreeviewextension.cpp \
   declarativevboxlayout.cpp \
   declarativewidgetextension.cpp \
   declarativewidgetsdocument.cpp \
+  declarativewidgetssnapshot.cpp \
   defaultobjectcontainer.cpp \
   defaultwidgetcontainer.cpp \
+  filesystempopulationproxymodel.cpp \
+  headerviewsampler.cpp \
+  iconthemeindex.cpp \
   mainwindowwidgetcontainer.cpp \
   menubarwidgetcontainer.cpp \
   menuwidgetcontainer.cpp \
   objectadaptors.cpp \
+  pixmapcache.cpp \
   scrollareawidgetcontainer.cpp \
   stackedwidgetwidgetcontainer.cpp \
   staticdialogmethodattached.cpp \
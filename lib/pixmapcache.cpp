@@ -0,0 +1,335 @@
+/*
+  pixmapcache.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pixmapcache_p.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QGuiApplication>
+#include <QImageReader>
+#include <QtConcurrent>
+
+PixmapCache *PixmapCache::s_instance = 0;
+
+// icons decode lazily per requested size, so their memory is not known up front and
+// they are bounded by count instead of being charged against the cache limit
+static const int s_maxIcons = 256;
+
+static int pixmapCost(const QPixmap &pixmap)
+{
+  // cost in kilobytes, at least one so empty entries still count
+  const qint64 bytes = qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+  return qMax(1, int(bytes / 1024));
+}
+
+PixmapCache::PixmapCache(QObject *parent)
+  : QObject(parent)
+  , m_cache(10240)
+  , m_icons(s_maxIcons)
+  , m_hits(0)
+  , m_misses(0)
+  , m_deduplicated(0)
+{
+}
+
+PixmapCache::~PixmapCache()
+{
+  QHash<QFutureWatcher<DecodedImage>*, QString>::const_iterator it = m_pending.constBegin();
+  for (; it != m_pending.constEnd(); ++it) {
+    it.key()->disconnect(this);
+    it.key()->waitForFinished();
+  }
+
+  if (s_instance == this)
+    s_instance = 0;
+}
+
+PixmapCache *PixmapCache::instance()
+{
+  if (!s_instance)
+    s_instance = new PixmapCache(QCoreApplication::instance());
+
+  return s_instance;
+}
+
+QString PixmapCache::cacheKey(const QString &fileName, const QSize &size, qreal devicePixelRatio)
+{
+  // resource paths are already unique, file paths are made absolute so "a.png" and "./a.png" share an entry
+  const QString path = fileName.startsWith(QLatin1Char(':')) ? fileName : QFileInfo(fileName).absoluteFilePath();
+
+  return QString::fromLatin1("%1@%2x%3@%4").arg(path).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+}
+
+qreal PixmapCache::devicePixelRatio(const QSize &size)
+{
+  return size.isValid() && qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
+}
+
+int PixmapCache::cacheLimit() const
+{
+  return m_cache.maxCost();
+}
+
+void PixmapCache::setCacheLimit(int kilobytes)
+{
+  m_cache.setMaxCost(qMax(0, kilobytes));
+}
+
+QPixmap PixmapCache::find(const QString &key)
+{
+  QPixmap *pixmap = m_cache.object(key);
+  return pixmap ? *pixmap : QPixmap();
+}
+
+QPixmap PixmapCache::pixmap(const QString &fileName, const QSize &size, qreal devicePixelRatio)
+{
+  const QString key = cacheKey(fileName, size, devicePixelRatio);
+
+  QPixmap *cached = m_cache.object(key);
+  if (cached) {
+    ++m_hits;
+    return *cached;
+  }
+
+  ++m_misses;
+
+  // an asynchronous load of the same key, e.g. from a Preloader, is waited for instead of decoding twice
+  QFutureWatcher<DecodedImage> *watcher = m_pendingKeys.value(key);
+  if (watcher) {
+    watcher->waitForFinished();
+    return finishRead(watcher);
+  }
+
+  return insert(key, decodeImage(fileName, size, devicePixelRatio));
+}
+
+QPixmap PixmapCache::load(const QString &fileName, const QSize &size, qreal devicePixelRatio)
+{
+  const QString key = cacheKey(fileName, size, devicePixelRatio);
+
+  QPixmap *cached = m_cache.object(key);
+  if (cached) {
+    ++m_hits;
+    return *cached;
+  }
+
+  ++m_misses;
+
+  // a request for the same key is already running, its pixmapLoaded() covers this one as well
+  if (!m_pendingKeys.contains(key)) {
+    QFutureWatcher<DecodedImage> *watcher = new QFutureWatcher<DecodedImage>(this);
+    connect(watcher, SIGNAL(finished()), this, SLOT(onImageRead()));
+
+    m_pending.insert(watcher, key);
+    m_pendingKeys.insert(key, watcher);
+    watcher->setFuture(QtConcurrent::run(decodeImage, fileName, size, devicePixelRatio));
+  }
+
+  return QPixmap();
+}
+
+QIcon PixmapCache::icon(const QString &fileName)
+{
+  const QString key = cacheKey(fileName, QSize(), 0.0);
+
+  QIcon *cached = m_icons.object(key);
+  if (cached)
+    return *cached;
+
+  const QIcon icon(fileName);
+  m_icons.insert(key, new QIcon(icon));
+
+  return icon;
+}
+
+void PixmapCache::clear()
+{
+  m_cache.clear();
+  m_contents.clear();
+  m_icons.clear();
+  m_hits = 0;
+  m_misses = 0;
+  m_deduplicated = 0;
+}
+
+int PixmapCache::hits() const
+{
+  return m_hits;
+}
+
+int PixmapCache::misses() const
+{
+  return m_misses;
+}
+
+qreal PixmapCache::hitRate() const
+{
+  const int lookups = m_hits + m_misses;
+  return lookups > 0 ? qreal(m_hits) / lookups : 0.0;
+}
+
+qint64 PixmapCache::totalBytes() const
+{
+  return qint64(m_cache.totalCost()) * 1024;
+}
+
+int PixmapCache::count() const
+{
+  return m_cache.count();
+}
+
+int PixmapCache::deduplicated() const
+{
+  return m_deduplicated;
+}
+
+QImage PixmapCache::readImage(const QString &fileName, const QSize &size, qreal devicePixelRatio)
+{
+  QImageReader reader(fileName);
+
+  bool scaled = false;
+  if (size.isValid()) {
+    // let the image handler decode at the requested size instead of scaling the full image afterwards
+    const QSize target = size * devicePixelRatio;
+    const QSize original = reader.size();
+    if (original.isValid() && (original.width() > target.width() || original.height() > target.height())) {
+      reader.setScaledSize(original.scaled(target, Qt::KeepAspectRatio));
+      scaled = true;
+    }
+  }
+
+  QImage image = reader.read();
+  if (scaled || !size.isValid() || image.isNull()) {
+    image.setDevicePixelRatio(devicePixelRatio);
+    return image;
+  }
+
+  // the size only caps images that are already small enough, at the requested ratio
+  // they would show smaller than without a size
+  qreal ratio = 1.0;
+  if (size.width() > 0)
+    ratio = qMax(ratio, qreal(image.width()) / size.width());
+  if (size.height() > 0)
+    ratio = qMax(ratio, qreal(image.height()) / size.height());
+  image.setDevicePixelRatio(ratio);
+
+  return image;
+}
+
+PixmapCache::DecodedImage PixmapCache::decodeImage(const QString &fileName, const QSize &size, qreal devicePixelRatio)
+{
+  DecodedImage decoded;
+  decoded.image = readImage(fileName, size, devicePixelRatio);
+  decoded.contentHash = contentHash(decoded.image);
+
+  return decoded;
+}
+
+QByteArray PixmapCache::contentHash(const QImage &image)
+{
+  if (image.isNull())
+    return QByteArray();
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+
+  QByteArray header;
+  QDataStream stream(&header, QIODevice::WriteOnly);
+  stream << image.size() << qint32(image.format()) << image.devicePixelRatio() << image.colorTable();
+  hash.addData(header);
+
+  // line by line, the padding at the end of a scan line is not part of the content
+  const int lineBytes = (image.width() * image.depth() + 7) / 8;
+  for (int y = 0; y < image.height(); ++y)
+    hash.addData(reinterpret_cast<const char*>(image.constScanLine(y)), lineBytes);
+
+  return hash.result();
+}
+
+void PixmapCache::onImageRead()
+{
+  QFutureWatcher<DecodedImage> *watcher = static_cast<QFutureWatcher<DecodedImage>*>(sender());
+
+  // already finished by a synchronous request for the same key
+  if (!m_pending.contains(watcher))
+    return;
+
+  finishRead(watcher);
+}
+
+QPixmap PixmapCache::finishRead(QFutureWatcher<DecodedImage> *watcher)
+{
+  const QString key = m_pending.take(watcher);
+  m_pendingKeys.remove(key);
+  watcher->disconnect(this);
+  watcher->deleteLater();
+
+  // QPixmap can only be created in the GUI thread, so the conversion happens here
+  const QPixmap pixmap = insert(key, watcher->result());
+
+  emit pixmapLoaded(key, pixmap);
+
+  return pixmap;
+}
+
+QPixmap PixmapCache::insert(const QString &key, const DecodedImage &decoded)
+{
+  if (decoded.image.isNull())
+    return QPixmap();
+
+  QPixmap pixmap;
+
+  // equal images from different files or sizes share one pixmap. The digest covers size,
+  // format and ratio as well, so the pixels are not compared again in the GUI thread
+  QHash<QByteArray, Content>::iterator it = m_contents.find(decoded.contentHash);
+  if (it != m_contents.end()) {
+    const QPixmap *existing = m_cache.object(it->key);
+    if (existing && existing->cacheKey() == it->pixmapKey) {
+      pixmap = *existing;
+      ++m_deduplicated;
+    } else {
+      // evicted, or its key now holds different content
+      m_contents.erase(it);
+    }
+  }
+
+  if (pixmap.isNull()) {
+    pixmap = QPixmap::fromImage(decoded.image);
+
+    Content content;
+    content.key = key;
+    content.pixmapKey = pixmap.cacheKey();
+    m_contents.insert(decoded.contentHash, content);
+  }
+
+  // shared pixmaps are charged for every key, so the limit errs on the safe side.
+  // QCache drops entries larger than the whole limit, the caller still gets its pixmap
+  m_cache.insert(key, new QPixmap(pixmap), pixmapCost(pixmap));
+
+  return pixmap;
+}
@@ -0,0 +1,133 @@
+/*
+  pixmapcache_p.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PIXMAPCACHE_P_H
+#define PIXMAPCACHE_P_H
+
+#include "declarativewidgets_export.h"
+
+#include <QByteArray>
+#include <QCache>
+#include <QHash>
+#include <QIcon>
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QSize>
+
+template <typename T> class QFutureWatcher;
+
+// Process-wide cache for pixmaps loaded from files, keyed by path, size and device pixel ratio.
+// Least recently used entries are evicted once the cache limit is exceeded.
+class DECLARATIVEWIDGETS_EXPORT PixmapCache : public QObject
+{
+  Q_OBJECT
+
+  public:
+    // a decoded image and the digest of its content, both produced by the reading thread
+    struct DecodedImage
+    {
+      QImage image;
+      QByteArray contentHash;
+    };
+
+    static PixmapCache *instance();
+
+    ~PixmapCache();
+
+    static QString cacheKey(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+
+    // the application's ratio for size constrained loads, 1.0 for loads at the image's own size
+    static qreal devicePixelRatio(const QSize &size);
+
+    // limit in kilobytes, like QPixmapCache
+    int cacheLimit() const;
+    void setCacheLimit(int kilobytes);
+
+    // returns a null pixmap on a cache miss, does not load or count towards the statistics
+    QPixmap find(const QString &key);
+
+    // returns the cached pixmap or decodes it in the calling thread
+    QPixmap pixmap(const QString &fileName, const QSize &size = QSize(), qreal devicePixelRatio = 1.0);
+
+    // returns the cached pixmap or a null pixmap while decoding on the thread pool,
+    // pixmapLoaded() is emitted with the cacheKey() once decoding has finished
+    QPixmap load(const QString &fileName, const QSize &size = QSize(), qreal devicePixelRatio = 1.0);
+
+    // one shared QIcon per file, so its decoded sizes exist only once.
+    // Only the most recently used icons are kept, see s_maxIcons
+    QIcon icon(const QString &fileName);
+
+    void clear();
+
+    int hits() const;
+    int misses() const;
+    qreal hitRate() const;
+    qint64 totalBytes() const;
+    int count() const;
+    int deduplicated() const;
+
+    static QImage readImage(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+
+    // readImage() plus the content digest used for sharing equal pixmaps, meant for the thread pool
+    static DecodedImage decodeImage(const QString &fileName, const QSize &size, qreal devicePixelRatio);
+    static QByteArray contentHash(const QImage &image);
+
+  Q_SIGNALS:
+    void pixmapLoaded(const QString &key, const QPixmap &pixmap);
+
+  private Q_SLOTS:
+    void onImageRead();
+
+  private:
+    explicit PixmapCache(QObject *parent);
+
+    QPixmap insert(const QString &key, const DecodedImage &decoded);
+    QPixmap finishRead(QFutureWatcher<DecodedImage> *watcher);
+
+    struct Content
+    {
+      QString key;
+      // QPixmap::cacheKey() of the pixmap inserted for the content, tells apart a
+      // still cached entry from one that was evicted and reloaded from a changed file
+      qint64 pixmapKey;
+    };
+
+    QCache<QString, QPixmap> m_cache;
+    // content hash to the cached pixmap with that content
+    QHash<QByteArray, Content> m_contents;
+    QCache<QString, QIcon> m_icons;
+    QHash<QFutureWatcher<DecodedImage>*, QString> m_pending;
+    // the reverse of m_pending, for finding the running read of a key
+    QHash<QString, QFutureWatcher<DecodedImage>*> m_pendingKeys;
+    int m_hits;
+    int m_misses;
+    int m_deduplicated;
+
+    static PixmapCache *s_instance;
+};
+
+#endif // PIXMAPCACHE_P_H
@@ -29,13 +29,25 @@
 
 #include "abstractdeclarativeobject_p.h"
 
+#include <QDialog>
+#include <QHash>
 #include <QPointer>
+#include <QQmlEngine>
+#include <QQmlInfo>
 #include <QWidget>
 
 class StaticDialogMethodAttached::Private
 {
   public:
+    Private() : parentWindowResolved(false), hasParentWindow(false) {}
+
     QPointer<QObject> dialogParent;
+
+    QPointer<QWidget> parentWindow;
+    bool parentWindowResolved;
+    bool hasParentWindow;
+
+    QHash<QDialog*, QJSValue> callbacks;
 };
 
 StaticDialogMethodAttached::StaticDialogMethodAttached(QObject *parent)
@@ -54,6 +66,8 @@ void StaticDialogMethodAttached::setDialogParent(QObject *parent)
     return;
 
   d->dialogParent = parent;
+  d->parentWindowResolved = false;
+
   emit dialogParentChanged(parent);
 }
 
@@ -64,6 +78,13 @@ QObject *StaticDialogMethodAttached::dialogParent() const
 
 QWidget *StaticDialogMethodAttached::bestParentWindow() const
 {
+  // the object hierarchy is walked only once, again if the window was deleted or the parent changed
+  if (d->parentWindowResolved && (d->parentWindow || !d->hasParentWindow))
+    return d->parentWindow;
+
+  d->parentWindowResolved = true;
+  d->parentWindow = 0;
+
   QObject *parent = d->dialogParent;
 
   if (!parent)
@@ -76,11 +97,57 @@ QWidget *StaticDialogMethodAttached::bestParentWindow() const
 
   while (parent) {
     QWidget *widget = qobject_cast<QWidget*>(parent);
-    if (widget)
-      return widget->topLevelWidget();
+    if (widget) {
+      d->parentWindow = widget->topLevelWidget();
+      break;
+    }
 
     parent = parent->parent();
   }
 
-  return 0;
+  d->hasParentWindow = (d->parentWindow != 0);
+
+  return d->parentWindow;
+}
+
+void StaticDialogMethodAttached::openDialog(QDialog *dialog, const QJSValue &callback)
+{
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  d->callbacks.insert(dialog, callback);
+
+  connect(dialog, SIGNAL(finished(int)), this, SLOT(onDialogFinished(int)));
+  dialog->open();
+}
+
+QVariant StaticDialogMethodAttached::dialogResult(QDialog *dialog, bool *accepted)
+{
+  Q_UNUSED(accepted);
+  return dialog->result();
+}
+
+void StaticDialogMethodAttached::onDialogFinished(int result)
+{
+  QDialog *dialog = qobject_cast<QDialog*>(sender());
+  if (!dialog)
+    return;
+
+  QJSValue callback = d->callbacks.take(dialog);
+
+  bool accepted = (result == QDialog::Accepted);
+  const QVariant value = dialogResult(dialog, &accepted);
+
+  emit dialogFinished(value, accepted);
+
+  if (!callback.isCallable())
+    return;
+
+  QQmlEngine *engine = qmlEngine(parent());
+  if (!engine) {
+    qmlInfo(this) << "dialog callback can not be called without a QML engine";
+    return;
+  }
+
+  const QJSValue callResult = callback.call(QJSValueList() << engine->toScriptValue(value) << accepted);
+  if (callResult.isError())
+    qmlInfo(this) << "dialog callback failed: " << callResult.toString();
 }
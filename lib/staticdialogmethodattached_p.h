@@ -30,7 +30,13 @@
 
 #include "declarativewidgets_export.h"
 
+#include <QJSValue>
 #include <QObject>
+#include <QVariant>
+
+QT_BEGIN_NAMESPACE
+class QDialog;
+QT_END_NAMESPACE
 
 class DECLARATIVEWIDGETS_EXPORT StaticDialogMethodAttached : public QObject
 {
@@ -49,9 +55,21 @@ class DECLARATIVEWIDGETS_EXPORT StaticDialogMethodAttached : public QObject
   Q_SIGNALS:
     void dialogParentChanged(QObject *parent);
 
+    // result of an asynchronous dialog, emitted before its callback is called
+    void dialogFinished(const QVariant &result, bool accepted);
+
   protected:
     QWidget *bestParentWindow() const;
 
+    // shows the dialog window modal without a nested event loop, the dialog deletes itself when closed
+    void openDialog(QDialog *dialog, const QJSValue &callback);
+
+    // called when an asynchronous dialog finishes, accepted is preset from the dialog's result code
+    virtual QVariant dialogResult(QDialog *dialog, bool *accepted);
+
+  private Q_SLOTS:
+    void onDialogFinished(int result);
+
   private:
     class Private;
     Private *const d;
@@ -0,0 +1,1300 @@
+/*
+  cppgenerator.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cppgenerator.h"
+
+#include <QBoxLayout>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QIODevice>
+#include <QMainWindow>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMetaMethod>
+#include <QMetaProperty>
+#include <QScrollArea>
+#include <QStackedLayout>
+#include <QStackedWidget>
+#include <QStatusBar>
+#include <QTabWidget>
+#include <QTextCodec>
+#include <QTextStream>
+#include <QToolBar>
+
+// short form of an expression for diagnostics
+static QString describe(const QmlTokens &tokens)
+{
+  QString text;
+  QString previous;
+  Q_FOREACH (const QmlToken &token, tokens) {
+    const bool attach = token.text == QLatin1String(".") || token.text == QLatin1String(",") ||
+                        token.text == QLatin1String("(") || token.text == QLatin1String(")") ||
+                        previous == QLatin1String(".") || previous == QLatin1String("(") ||
+                        previous == QLatin1String("!");
+    if (!text.isEmpty() && !attach) {
+      text += QLatin1Char(' ');
+    }
+
+    if (token.kind == QmlToken::String) {
+      text += QLatin1Char('"') + token.text + QLatin1Char('"');
+    } else {
+      text += token.text;
+    }
+    previous = token.kind == QmlToken::Punctuator ? token.text : QString();
+  }
+
+  if (text.length() > 60) {
+    text = text.left(57) + QLatin1String("...");
+  }
+
+  return text;
+}
+
+static QString describe(const QmlValue &value)
+{
+  switch (value.kind) {
+  case QmlValue::Object:
+    return value.object->typeName + QLatin1String(" { }");
+  case QmlValue::List:
+    return QLatin1String("[ ... ]");
+  default:
+    return describe(value.tokens);
+  }
+}
+
+static bool numberToCpp(const QmlTokens &tokens, bool integer, QString *cpp)
+{
+  int index = 0;
+  if (tokens.count() == 2 && tokens.first().isPunctuator("-")) {
+    index = 1;
+  }
+
+  if (tokens.count() != index + 1 || tokens.at(index).kind != QmlToken::Number) {
+    return false;
+  }
+
+  const QString number = tokens.at(index).text;
+  const bool hex = number.startsWith(QLatin1String("0x"), Qt::CaseInsensitive);
+  if (integer && !hex && (number.contains(QLatin1Char('.')) || number.contains(QLatin1Char('e'), Qt::CaseInsensitive))) {
+    return false;
+  }
+
+  *cpp = (index == 1 ? QString::fromLatin1("-") : QString()) + number;
+  return true;
+}
+
+// splits name(arguments) or qualified.name(arguments)
+static bool splitCall(const QmlTokens &tokens, QString *function, QList<QmlTokens> *arguments)
+{
+  int index = 0;
+  QString name;
+  while (index < tokens.count() && tokens.at(index).kind == QmlToken::Identifier) {
+    name += tokens.at(index++).text;
+    if (index < tokens.count() && tokens.at(index).isPunctuator(".")) {
+      name += QLatin1Char('.');
+      ++index;
+    } else {
+      break;
+    }
+  }
+
+  if (name.isEmpty() || index >= tokens.count() || !tokens.at(index).isPunctuator("(") ||
+      !tokens.last().isPunctuator(")")) {
+    return false;
+  }
+
+  int depth = 0;
+  QmlTokens argument;
+  for (int i = index + 1; i < tokens.count() - 1; ++i) {
+    const QmlToken &token = tokens.at(i);
+    if (depth == 0 && token.isPunctuator(",")) {
+      *arguments << argument;
+      argument.clear();
+      continue;
+    }
+
+    if (token.isPunctuator("(") || token.isPunctuator("[") || token.isPunctuator("{")) {
+      ++depth;
+    } else if (token.isPunctuator(")") || token.isPunctuator("]") || token.isPunctuator("}")) {
+      if (--depth < 0) {
+        return false;
+      }
+    }
+    argument << token;
+  }
+
+  if (!argument.isEmpty()) {
+    *arguments << argument;
+  }
+
+  *function = name;
+  return depth == 0;
+}
+
+// Qt.size(), Qt.point() and Qt.rect() with numeric arguments
+static bool valueTypeToCpp(const QmlTokens &tokens, const char *function, int argumentCount, bool integer,
+                           const QString &className, QString *cpp)
+{
+  QString name;
+  QList<QmlTokens> arguments;
+  if (!splitCall(tokens, &name, &arguments) || name != QLatin1String(function) || arguments.count() != argumentCount) {
+    return false;
+  }
+
+  QStringList values;
+  Q_FOREACH (const QmlTokens &argument, arguments) {
+    QString value;
+    if (!numberToCpp(argument, integer, &value)) {
+      return false;
+    }
+    values << value;
+  }
+
+  *cpp = QString::fromLatin1("%1(%2)").arg(className, values.join(QLatin1String(", ")));
+  return true;
+}
+
+static QString escapedUtf8(const QString &text, bool *ascii)
+{
+  const QByteArray utf8 = text.toUtf8();
+
+  *ascii = true;
+  QString escaped;
+  escaped.reserve(utf8.size());
+
+  for (int i = 0; i < utf8.size(); ++i) {
+    const unsigned char c = utf8[i];
+    switch (c) {
+    case '\\':
+      escaped += QLatin1String("\\\\");
+      break;
+    case '"':
+      escaped += QLatin1String("\\\"");
+      break;
+    case '\n':
+      escaped += QLatin1String("\\n");
+      break;
+    case '\t':
+      escaped += QLatin1String("\\t");
+      break;
+    default:
+      if (c < 0x20 || c >= 0x7f) {
+        // octal escapes end after three digits, unlike hex escapes
+        escaped += QString::fromLatin1("\\%1").arg(int(c), 3, 8, QLatin1Char('0'));
+        *ascii = *ascii && c < 0x7f;
+      } else {
+        escaped += QLatin1Char(c);
+      }
+      break;
+    }
+  }
+
+  return escaped;
+}
+
+CppGenerator::CppGenerator()
+  : m_className(QLatin1String("Form"))
+  , m_anonymousCount(0)
+{
+}
+
+void CppGenerator::setClassName(const QString &className)
+{
+  m_className = className;
+}
+
+QString CppGenerator::className() const
+{
+  return m_className;
+}
+
+void CppGenerator::setTranslationContext(const QString &context)
+{
+  m_translationContext = context;
+}
+
+QString CppGenerator::translationContext() const
+{
+  return m_translationContext;
+}
+
+bool CppGenerator::generate(const QmlDocument &document, QIODevice *outputDevice)
+{
+  m_errorString.clear();
+  m_diagnostics.clear();
+  m_objects.clear();
+  m_objectsById.clear();
+  m_members.clear();
+  m_variables.clear();
+  m_anonymousCount = 0;
+  m_consumedBindings.clear();
+  m_rootVariable.clear();
+  m_parentWidget.clear();
+  m_body.clear();
+  m_deferred.clear();
+
+  const QmlObject *root = document.root.data();
+  if (root == 0) {
+    m_errorString = QLatin1String("The document has no root object");
+    return false;
+  }
+
+  const QmlTypes::Type *rootType = QmlTypes::find(root->typeName);
+  if (rootType == 0 || rootType->kind != QmlTypes::WidgetType) {
+    m_errorString = QString::fromLatin1("%1:%2: The root object %3 is not a supported widget type")
+                    .arg(root->location.line).arg(root->location.column).arg(root->typeName);
+    return false;
+  }
+
+  declareObject(root);
+  createObject(root, 0);
+
+  writeHeader(outputDevice);
+
+  return true;
+}
+
+QString CppGenerator::errorString() const
+{
+  return m_errorString;
+}
+
+QmlDiagnostics CppGenerator::diagnostics() const
+{
+  return m_diagnostics;
+}
+
+void CppGenerator::declareObject(const QmlObject *object)
+{
+  const QmlTypes::Type *type = QmlTypes::find(object->typeName);
+  if (type == 0) {
+    addDiagnostic(object->location, QString::fromLatin1("type %1 is not supported").arg(object->typeName));
+    return;
+  }
+
+  ObjectInfo info;
+  info.type = type;
+  info.className = QmlTypes::className(type);
+  info.variable = object->id;
+
+  if (info.variable.isEmpty() || m_variables.contains(info.variable)) {
+    QString base = info.className;
+    if (base.length() > 1 && base[0] == QLatin1Char('Q') && base[1].isUpper()) {
+      base = base.mid(1);
+    }
+    base[0] = base[0].toLower();
+
+    do {
+      info.variable = QString::fromLatin1("%1_%2").arg(base).arg(++m_anonymousCount);
+    } while (m_variables.contains(info.variable));
+  }
+
+  m_variables.insert(info.variable);
+  m_members << qMakePair(info.className, info.variable);
+  m_objects.insert(object, info);
+
+  if (!object->id.isEmpty()) {
+    m_objectsById.insert(object->id, object);
+  }
+
+  Q_FOREACH (const QmlBinding &binding, object->bindings) {
+    declareValueObjects(binding.value);
+  }
+
+  Q_FOREACH (const QmlObjectPtr &child, object->children) {
+    declareObject(child.data());
+  }
+}
+
+void CppGenerator::declareValueObjects(const QmlValue &value)
+{
+  if (value.kind == QmlValue::Object) {
+    declareObject(value.object.data());
+  } else if (value.kind == QmlValue::List) {
+    Q_FOREACH (const QmlValue &element, value.elements) {
+      declareValueObjects(element);
+    }
+  }
+}
+
+void CppGenerator::createObject(const QmlObject *object, const QmlObject *parent)
+{
+  if (!m_objects.contains(object)) {
+    return; // reported by declareObject()
+  }
+
+  const ObjectInfo info = m_objects.value(object);
+  const QmlTypes::Kind kind = info.type->kind;
+
+  if (parent != 0) {
+    const ObjectInfo parentInfo = m_objects.value(parent);
+    const QmlTypes::Kind parentKind = parentInfo.type->kind;
+
+    // only combinations the plain Qt API has a counterpart for
+    bool supported = true;
+    switch (kind) {
+    case QmlTypes::WidgetType:
+    case QmlTypes::LayoutType:
+      supported = parentKind == QmlTypes::WidgetType || parentKind == QmlTypes::LayoutType;
+      break;
+    case QmlTypes::ActionType:
+      supported = parentKind == QmlTypes::WidgetType;
+      break;
+    case QmlTypes::SeparatorType:
+      supported = QmlTypes::inherits(parentInfo.type->metaObject, &QMenu::staticMetaObject) ||
+                  QmlTypes::inherits(parentInfo.type->metaObject, &QToolBar::staticMetaObject);
+      break;
+    case QmlTypes::SpacerType:
+      supported = parentKind == QmlTypes::LayoutType;
+      break;
+    case QmlTypes::ObjectType:
+      break;
+    }
+
+    if (!supported) {
+      addDiagnostic(object->location, QString::fromLatin1("%1 inside %2 is not supported")
+                                      .arg(object->typeName, parent->typeName));
+      return;
+    }
+
+    if (kind == QmlTypes::SpacerType) {
+      writeSpacer(object);
+      addToLayout(object, parent);
+      return;
+    }
+
+    if (kind == QmlTypes::SeparatorType) {
+      m_body << QString::fromLatin1("%1 = %2->addSeparator();").arg(info.variable, parentInfo.variable);
+      writeBindings(object);
+      return;
+    }
+
+    if (kind == QmlTypes::LayoutType && parentKind == QmlTypes::WidgetType) {
+      m_body << QString::fromLatin1("%1 = new %2(%3);").arg(info.variable, info.className, parentInfo.variable);
+    } else if (kind == QmlTypes::LayoutType) {
+      m_body << QString::fromLatin1("%1 = new %2();").arg(info.variable, info.className);
+    } else {
+      // widgets in layouts belong to the widget the layouts are set on
+      m_body << QString::fromLatin1("%1 = new %2(%3);").arg(info.variable, info.className, m_parentWidget);
+    }
+
+    addToContainer(object, parent);
+  } else if (m_rootVariable.isEmpty()) {
+    m_rootVariable = info.variable;
+    m_body << QString::fromLatin1("%1 = new %2(parent);").arg(info.variable, info.className);
+  } else {
+    // objects assigned to properties, e.g. models
+    m_body << QString::fromLatin1("%1 = new %2(%3);").arg(info.variable, info.className, m_parentWidget);
+  }
+
+  const QString previousParentWidget = m_parentWidget;
+  if (kind == QmlTypes::WidgetType) {
+    m_parentWidget = info.variable;
+  }
+
+  writeBindings(object);
+
+  Q_FOREACH (const QmlObjectPtr &child, object->children) {
+    createObject(child.data(), object);
+  }
+
+  m_parentWidget = previousParentWidget;
+}
+
+void CppGenerator::addToContainer(const QmlObject *object, const QmlObject *container)
+{
+  const ObjectInfo info = m_objects.value(object);
+  const ObjectInfo containerInfo = m_objects.value(container);
+
+  if (containerInfo.type->kind == QmlTypes::LayoutType) {
+    addToLayout(object, container);
+    return;
+  }
+
+  if (containerInfo.type->kind != QmlTypes::WidgetType) {
+    return;
+  }
+
+  if (info.type->kind == QmlTypes::ActionType) {
+    m_body << QString::fromLatin1("%1->addAction(%2);").arg(containerInfo.variable, info.variable);
+    return;
+  }
+
+  // layouts are set on their widget when they are created
+  if (info.type->kind != QmlTypes::WidgetType) {
+    return;
+  }
+
+  const QMetaObject *containerMetaObject = containerInfo.type->metaObject;
+  const QMetaObject *metaObject = info.type->metaObject;
+
+  QString method;
+  QString arguments = info.variable;
+
+  if (QmlTypes::inherits(containerMetaObject, &QTabWidget::staticMetaObject)) {
+    QString label = QLatin1String("QString()");
+    attachedValue(object, QLatin1String("TabWidget"), "label", "QString", false, &label);
+
+    method = QLatin1String("addTab");
+    arguments += QLatin1String(", ") + label;
+  } else if (QmlTypes::inherits(containerMetaObject, &QMainWindow::staticMetaObject)) {
+    if (QmlTypes::inherits(metaObject, &QMenuBar::staticMetaObject)) {
+      method = QLatin1String("setMenuBar");
+    } else if (QmlTypes::inherits(metaObject, &QStatusBar::staticMetaObject)) {
+      method = QLatin1String("setStatusBar");
+    } else if (QmlTypes::inherits(metaObject, &QToolBar::staticMetaObject)) {
+      method = QLatin1String("addToolBar");
+    } else {
+      method = QLatin1String("setCentralWidget");
+    }
+  } else if (QmlTypes::inherits(containerMetaObject, &QScrollArea::staticMetaObject)) {
+    method = QLatin1String("setWidget");
+  } else if (QmlTypes::inherits(containerMetaObject, &QStackedWidget::staticMetaObject) ||
+             QmlTypes::inherits(containerMetaObject, &QStatusBar::staticMetaObject) ||
+             QmlTypes::inherits(containerMetaObject, &QToolBar::staticMetaObject)) {
+    method = QLatin1String("addWidget");
+  } else if ((QmlTypes::inherits(containerMetaObject, &QMenuBar::staticMetaObject) ||
+              QmlTypes::inherits(containerMetaObject, &QMenu::staticMetaObject)) &&
+             QmlTypes::inherits(metaObject, &QMenu::staticMetaObject)) {
+    method = QLatin1String("addMenu");
+  }
+
+  // plain child widgets only need their parent
+  if (!method.isEmpty()) {
+    m_body << QString::fromLatin1("%1->%2(%3);").arg(containerInfo.variable, method, arguments);
+  }
+}
+
+void CppGenerator::addToLayout(const QmlObject *object, const QmlObject *layout)
+{
+  const ObjectInfo info = m_objects.value(object);
+  const ObjectInfo layoutInfo = m_objects.value(layout);
+  const QMetaObject *layoutMetaObject = layoutInfo.type->metaObject;
+
+  // attached properties use the name of the layout type, e.g. GridLayout.row
+  const QString attachingType = layout->typeName.section(QLatin1Char('.'), -1);
+  const QmlTypes::Kind kind = info.type->kind;
+
+  if (QmlTypes::inherits(layoutMetaObject, &QGridLayout::staticMetaObject)) {
+    QString row = QLatin1String("0");
+    QString column = QLatin1String("0");
+    QString rowSpan = QLatin1String("1");
+    QString columnSpan = QLatin1String("1");
+    QString alignment;
+    attachedValue(object, attachingType, "row", "int", false, &row);
+    attachedValue(object, attachingType, "column", "int", false, &column);
+    attachedValue(object, attachingType, "rowSpan", "int", false, &rowSpan);
+    attachedValue(object, attachingType, "columnSpan", "int", false, &columnSpan);
+    attachedValue(object, attachingType, "alignment", "Qt::Alignment", true, &alignment);
+
+    const char *method = kind == QmlTypes::WidgetType ? "addWidget" : (kind == QmlTypes::LayoutType ? "addLayout" : "addItem");
+    QStringList arguments;
+    arguments << info.variable << row << column << rowSpan << columnSpan;
+    if (!alignment.isEmpty()) {
+      arguments << alignment;
+    }
+
+    m_body << QString::fromLatin1("%1->%2(%3);")
+              .arg(layoutInfo.variable, QLatin1String(method), arguments.join(QLatin1String(", ")));
+    return;
+  }
+
+  if (QmlTypes::inherits(layoutMetaObject, &QBoxLayout::staticMetaObject)) {
+    QString stretch;
+    QString alignment;
+    attachedValue(object, attachingType, "stretch", "int", false, &stretch);
+    attachedValue(object, attachingType, "alignment", "Qt::Alignment", true, &alignment);
+
+    if (kind == QmlTypes::SpacerType) {
+      m_body << QString::fromLatin1("%1->addSpacerItem(%2);").arg(layoutInfo.variable, info.variable);
+      return;
+    }
+
+    QStringList arguments;
+    arguments << info.variable;
+    if (!stretch.isEmpty() || (!alignment.isEmpty() && kind == QmlTypes::WidgetType)) {
+      arguments << (stretch.isEmpty() ? QString::fromLatin1("0") : stretch);
+    }
+    if (!alignment.isEmpty() && kind == QmlTypes::WidgetType) {
+      arguments << alignment;
+    }
+
+    const char *method = kind == QmlTypes::WidgetType ? "addWidget" : "addLayout";
+    m_body << QString::fromLatin1("%1->%2(%3);")
+              .arg(layoutInfo.variable, QLatin1String(method), arguments.join(QLatin1String(", ")));
+
+    if (!alignment.isEmpty() && kind == QmlTypes::LayoutType) {
+      m_body << QString::fromLatin1("%1->setAlignment(%2, %3);").arg(layoutInfo.variable, info.variable, alignment);
+    }
+    return;
+  }
+
+  if (QmlTypes::inherits(layoutMetaObject, &QFormLayout::staticMetaObject)) {
+    if (kind == QmlTypes::SpacerType) {
+      m_body << QString::fromLatin1("%1->addItem(%2);").arg(layoutInfo.variable, info.variable);
+      return;
+    }
+
+    QString label;
+    if (attachedValue(object, attachingType, "label", "QString", false, &label)) {
+      m_body << QString::fromLatin1("%1->addRow(%2, %3);").arg(layoutInfo.variable, label, info.variable);
+    } else {
+      m_body << QString::fromLatin1("%1->addRow(%2);").arg(layoutInfo.variable, info.variable);
+    }
+    return;
+  }
+
+  if (QmlTypes::inherits(layoutMetaObject, &QStackedLayout::staticMetaObject) && kind == QmlTypes::WidgetType) {
+    m_body << QString::fromLatin1("%1->addWidget(%2);").arg(layoutInfo.variable, info.variable);
+    return;
+  }
+
+  addDiagnostic(object->location, QString::fromLatin1("%1 inside %2 is not supported")
+                                  .arg(object->typeName, layout->typeName));
+}
+
+void CppGenerator::writeSpacer(const QmlObject *object)
+{
+  const ObjectInfo info = m_objects.value(object);
+
+  // the defaults of DeclarativeSpacerItem
+  QString width = QLatin1String("0");
+  QString height = QLatin1String("0");
+  QString horizontalPolicy = QLatin1String("QSizePolicy::Minimum");
+  QString verticalPolicy = QLatin1String("QSizePolicy::Minimum");
+
+  Q_FOREACH (const QmlBinding &binding, object->bindings) {
+    // attached layout properties
+    if (binding.name.count() == 2 && binding.name.first().at(0).isUpper()) {
+      continue;
+    }
+
+    const QString name = binding.name.join(QLatin1Char('.'));
+    bool ok = binding.value.kind == QmlValue::Expression;
+
+    if (ok && name == QLatin1String("sizeHint")) {
+      QString function;
+      QList<QmlTokens> arguments;
+      ok = splitCall(binding.value.tokens, &function, &arguments) && function == QLatin1String("Qt.size") &&
+           arguments.count() == 2 && numberToCpp(arguments.at(0), true, &width) &&
+           numberToCpp(arguments.at(1), true, &height);
+    } else if (ok && name == QLatin1String("horizontalSizePolicy")) {
+      ok = enumToCpp(binding.value.tokens, &horizontalPolicy);
+    } else if (ok && name == QLatin1String("verticalSizePolicy")) {
+      ok = enumToCpp(binding.value.tokens, &verticalPolicy);
+    } else {
+      addDiagnostic(binding.location, QString::fromLatin1("property %1 of %2 is not supported").arg(name, object->typeName));
+      continue;
+    }
+
+    if (!ok) {
+      addDiagnostic(binding.location, QString::fromLatin1("value %1 of %2 is not supported")
+                                      .arg(describe(binding.value), name));
+    }
+  }
+
+  m_body << QString::fromLatin1("%1 = new QSpacerItem(%2, %3, %4, %5);")
+            .arg(info.variable, width, height, horizontalPolicy, verticalPolicy);
+}
+
+void CppGenerator::writeBindings(const QmlObject *object)
+{
+  const QmlTypes::Kind kind = m_objects.value(object).type->kind;
+
+  QList<const QmlBinding*> fontBindings;
+  QList<const QmlBinding*> marginBindings;
+
+  for (int i = 0; i < object->bindings.count(); ++i) {
+    const QmlBinding &binding = object->bindings.at(i);
+    if (m_consumedBindings.contains(&binding)) {
+      continue;
+    }
+
+    if (binding.name.count() == 2 && binding.name.first() == QLatin1String("font") &&
+        kind == QmlTypes::WidgetType) {
+      fontBindings << &binding;
+    } else if (binding.name.count() == 2 && binding.name.first() == QLatin1String("contentsMargins") &&
+               kind == QmlTypes::LayoutType) {
+      marginBindings << &binding;
+    } else {
+      writeBinding(object, binding);
+    }
+  }
+
+  if (!fontBindings.isEmpty()) {
+    writeFont(object, fontBindings);
+  }
+
+  if (!marginBindings.isEmpty()) {
+    writeContentsMargins(object, marginBindings);
+  }
+}
+
+void CppGenerator::writeBinding(const QmlObject *object, const QmlBinding &binding)
+{
+  const ObjectInfo info = m_objects.value(object);
+  const QString fullName = binding.name.join(QLatin1Char('.'));
+  const QString name = binding.name.first();
+
+  if (binding.name.count() == 1 && name.length() > 2 && name.startsWith(QLatin1String("on")) && name.at(2).isUpper()) {
+    addDiagnostic(binding.location, QString::fromLatin1("signal handler %1 is not supported").arg(name));
+    return;
+  }
+
+  if (binding.value.kind == QmlValue::Block) {
+    addDiagnostic(binding.location, QString::fromLatin1("JavaScript block for %1 is not supported").arg(fullName));
+    return;
+  }
+
+  if (binding.name.count() > 1) {
+    if (name.at(0).isUpper()) {
+      addDiagnostic(binding.location, QString::fromLatin1("attached property %1 is not supported here").arg(fullName));
+    } else {
+      addDiagnostic(binding.location, QString::fromLatin1("grouped property %1 is not supported").arg(fullName));
+    }
+    return;
+  }
+
+  const QMetaObject *metaObject = info.type->metaObject;
+
+  // geometry parts added by DeclarativeWidgetExtension
+  if (info.type->kind == QmlTypes::WidgetType &&
+      (name == QLatin1String("x") || name == QLatin1String("y") ||
+       name == QLatin1String("width") || name == QLatin1String("height"))) {
+    QString value;
+    if (binding.value.kind != QmlValue::Expression || !valueToCpp(binding.value.tokens, "int", false, &value)) {
+      addDiagnostic(binding.location, QString::fromLatin1("value %1 of %2 is not supported")
+                                      .arg(describe(binding.value), name));
+      return;
+    }
+
+    QString line;
+    if (name == QLatin1String("x")) {
+      line = QLatin1String("%1->move(%2, %1->y());");
+    } else if (name == QLatin1String("y")) {
+      line = QLatin1String("%1->move(%1->x(), %2);");
+    } else if (name == QLatin1String("width")) {
+      line = QLatin1String("%1->resize(%2, %1->height());");
+    } else {
+      line = QLatin1String("%1->resize(%1->width(), %2);");
+    }
+
+    m_body << line.arg(info.variable, value);
+    return;
+  }
+
+  const int index = metaObject->indexOfProperty(name.toLatin1().constData());
+  if (index >= 0) {
+    const QMetaProperty property = metaObject->property(index);
+    if (!property.isWritable()) {
+      addDiagnostic(binding.location, QString::fromLatin1("property %1 of %2 is read-only").arg(name, object->typeName));
+      return;
+    }
+
+    writeProperty(object, binding, QmlTypes::setterName(metaObject, name), property.typeName(),
+                  property.isEnumType() || property.isFlagType());
+    return;
+  }
+
+  const QmlTypes::ExtensionProperty *extensionProperty = QmlTypes::findExtensionProperty(metaObject, name);
+  if (extensionProperty != 0) {
+    writeProperty(object, binding, QLatin1String(extensionProperty->setter), extensionProperty->typeName, false);
+    return;
+  }
+
+  addDiagnostic(binding.location, QString::fromLatin1("unknown property %1 of %2").arg(name, object->typeName));
+}
+
+void CppGenerator::writeProperty(const QmlObject *object, const QmlBinding &binding, const QString &setter,
+                                 const QByteArray &typeName, bool isEnum)
+{
+  const ObjectInfo info = m_objects.value(object);
+  const QString name = binding.name.first();
+  const QmlValue &value = binding.value;
+  const QmlTokens &tokens = value.tokens;
+
+  if (typeName.endsWith('*')) {
+    if (value.kind == QmlValue::Object) {
+      const QmlObject *valueObject = value.object.data();
+      if (!m_objects.contains(valueObject)) {
+        return; // reported by declareObject()
+      }
+
+      const ObjectInfo valueInfo = m_objects.value(valueObject);
+      if (valueInfo.type->kind == QmlTypes::ObjectType || valueInfo.type->kind == QmlTypes::WidgetType ||
+          valueInfo.type->kind == QmlTypes::ActionType) {
+        createObject(valueObject, 0);
+        m_body << QString::fromLatin1("%1->%2(%3);").arg(info.variable, setter, valueInfo.variable);
+        return;
+      }
+    }
+
+    // references are resolved once all objects exist
+    if (value.kind == QmlValue::Expression && tokens.count() == 1 && m_objectsById.contains(tokens.first().text)) {
+      const ObjectInfo referenceInfo = m_objects.value(m_objectsById.value(tokens.first().text));
+      m_deferred << QString::fromLatin1("%1->%2(%3);").arg(info.variable, setter, referenceInfo.variable);
+      return;
+    }
+
+    // objects owned by other objects, e.g. the selection model of a view
+    if (value.kind == QmlValue::Expression && tokens.count() == 3 && tokens.at(1).isPunctuator(".") &&
+        m_objectsById.contains(tokens.first().text)) {
+      const ObjectInfo sourceInfo = m_objects.value(m_objectsById.value(tokens.first().text));
+      const QmlTypes::ExtensionProperty *extensionProperty =
+          QmlTypes::findExtensionProperty(sourceInfo.type->metaObject, tokens.at(2).text);
+
+      if (extensionProperty != 0) {
+        m_deferred << QString::fromLatin1("%1->%2(%3->%4());")
+                      .arg(info.variable, setter, sourceInfo.variable, QLatin1String(extensionProperty->getter));
+        return;
+      }
+    }
+
+    addDiagnostic(binding.location, QString::fromLatin1("value %1 of %2 is not supported").arg(describe(value), name));
+    return;
+  }
+
+  QString cpp;
+  if (value.kind == QmlValue::List) {
+    if (!listToCpp(value, typeName, &cpp)) {
+      addDiagnostic(binding.location, QString::fromLatin1("value %1 of %2 is not supported").arg(describe(value), name));
+      return;
+    }
+  } else if (value.kind == QmlValue::Expression && !isEnum && writePropertyBinding(object, binding, setter, typeName)) {
+    return;
+  } else if (value.kind != QmlValue::Expression || !valueToCpp(tokens, typeName, isEnum, &cpp)) {
+    addDiagnostic(binding.location, QString::fromLatin1("value %1 of %2 is not supported").arg(describe(value), name));
+    return;
+  }
+
+  const QString line = QString::fromLatin1("%1->%2(%3);").arg(info.variable, setter, cpp);
+
+  // the current index refers to pages and items that are added later on
+  if (name == QLatin1String("currentIndex") || name == QLatin1String("currentRow")) {
+    m_deferred << line;
+  } else {
+    m_body << line;
+  }
+}
+
+bool CppGenerator::writePropertyBinding(const QmlObject *object, const QmlBinding &binding, const QString &setter,
+                                        const QByteArray &typeName)
+{
+  const QmlTokens &tokens = binding.value.tokens;
+  const QString name = binding.name.first();
+
+  // otherId.property or !otherId.property
+  const int offset = tokens.count() == 4 && tokens.first().isPunctuator("!") ? 1 : 0;
+  if (tokens.count() != offset + 3 || tokens.at(offset).kind != QmlToken::Identifier ||
+      !tokens.at(offset + 1).isPunctuator(".") || tokens.at(offset + 2).kind != QmlToken::Identifier) {
+    return false;
+  }
+
+  // enum values, e.g. Qt.Horizontal
+  const QString id = tokens.at(offset).text;
+  if (id.at(0).isUpper()) {
+    return false;
+  }
+
+  const QmlObject *source = m_objectsById.value(id);
+  if (source == 0 || m_objects.value(source).type->metaObject == 0 ||
+      (offset == 1 && typeName != "bool")) {
+    addDiagnostic(binding.location, QString::fromLatin1("binding of %1 to %2 is not supported")
+                                    .arg(name, describe(tokens)));
+    return true;
+  }
+
+  const ObjectInfo sourceInfo = m_objects.value(source);
+  const ObjectInfo targetInfo = m_objects.value(object);
+  const QMetaObject *sourceMetaObject = sourceInfo.type->metaObject;
+  const QString sourceProperty = tokens.at(offset + 2).text;
+
+  QString read;
+  QMetaMethod notifySignal;
+
+  const int index = sourceMetaObject->indexOfProperty(sourceProperty.toLatin1().constData());
+  const QmlTypes::ExtensionProperty *extensionProperty = QmlTypes::findExtensionProperty(sourceMetaObject, sourceProperty);
+
+  if (index >= 0) {
+    read = QString::fromLatin1("qvariant_cast<%1>(source->property(%2))")
+           .arg(QLatin1String(typeName), cStringLiteral(sourceProperty));
+    notifySignal = sourceMetaObject->property(index).notifySignal();
+  } else if (extensionProperty != 0) {
+    read = QString::fromLatin1("source->%1()").arg(QLatin1String(extensionProperty->getter));
+  } else {
+    addDiagnostic(binding.location, QString::fromLatin1("unknown property %1 of %2").arg(sourceProperty, source->typeName));
+    return true;
+  }
+
+  if (offset == 1) {
+    read.prepend(QLatin1Char('!'));
+  }
+
+  const QString update = QString::fromLatin1("target->%1(%2);").arg(setter, read);
+
+  m_deferred << QLatin1String("{")
+             << QString::fromLatin1("  %1 *source = %2;").arg(sourceInfo.className, sourceInfo.variable)
+             << QString::fromLatin1("  %1 *target = %2;").arg(targetInfo.className, targetInfo.variable)
+             << QLatin1String("  ") + update;
+
+  // properties without notify signal are only assigned once, like constants
+  if (notifySignal.isValid()) {
+    m_deferred << QString::fromLatin1("  QObject::connect(source, %1, target, [source, target]() {")
+                  .arg(signalPointer(sourceInfo.className, sourceMetaObject, notifySignal))
+               << QLatin1String("    ") + update
+               << QLatin1String("  });");
+  }
+
+  m_deferred << QLatin1String("}");
+
+  return true;
+}
+
+void CppGenerator::writeFont(const QmlObject *object, const QList<const QmlBinding*> &bindings)
+{
+  static const struct {
+    const char *name;
+    const char *setter;
+    const char *typeName;
+  } fontProperties[] = {
+    { "bold", "setBold", "bool" },
+    { "family", "setFamily", "QString" },
+    { "italic", "setItalic", "bool" },
+    { "kerning", "setKerning", "bool" },
+    { "overline", "setOverline", "bool" },
+    { "pixelSize", "setPixelSize", "int" },
+    { "pointSize", "setPointSizeF", "double" },
+    { "strikeout", "setStrikeOut", "bool" },
+    { "underline", "setUnderline", "bool" },
+    { "weight", "setWeight", "int" }
+  };
+
+  const QString variable = m_objects.value(object).variable;
+
+  QStringList lines;
+  Q_FOREACH (const QmlBinding *binding, bindings) {
+    const QString name = binding->name.last();
+
+    int index = -1;
+    for (unsigned int i = 0; i < sizeof(fontProperties) / sizeof(fontProperties[0]); ++i) {
+      if (name == QLatin1String(fontProperties[i].name)) {
+        index = i;
+        break;
+      }
+    }
+
+    QString value;
+    if (index < 0 || binding->value.kind != QmlValue::Expression ||
+        !valueToCpp(binding->value.tokens, fontProperties[index].typeName, false, &value)) {
+      addDiagnostic(binding->location, QString::fromLatin1("value %1 of font.%2 is not supported")
+                                       .arg(describe(binding->value), name));
+      continue;
+    }
+
+    lines << QString::fromLatin1("  font.%1(%2);").arg(QLatin1String(fontProperties[index].setter), value);
+  }
+
+  if (lines.isEmpty()) {
+    return;
+  }
+
+  m_body << QLatin1String("{")
+         << QString::fromLatin1("  QFont font = %1->font();").arg(variable)
+         << lines
+         << QString::fromLatin1("  %1->setFont(font);").arg(variable)
+         << QLatin1String("}");
+}
+
+void CppGenerator::writeContentsMargins(const QmlObject *object, const QList<const QmlBinding*> &bindings)
+{
+  static const char *const names[] = { "left", "top", "right", "bottom" };
+
+  const QString variable = m_objects.value(object).variable;
+
+  QString margins[4];
+  bool complete = true;
+
+  for (int i = 0; i < 4; ++i) {
+    Q_FOREACH (const QmlBinding *binding, bindings) {
+      if (binding->name.last() != QLatin1String(names[i])) {
+        continue;
+      }
+
+      if (binding->value.kind != QmlValue::Expression || !valueToCpp(binding->value.tokens, "int", false, &margins[i])) {
+        addDiagnostic(binding->location, QString::fromLatin1("value %1 of contentsMargins.%2 is not supported")
+                                         .arg(describe(binding->value), binding->name.last()));
+      }
+    }
+    complete = complete && !margins[i].isEmpty();
+  }
+
+  Q_FOREACH (const QmlBinding *binding, bindings) {
+    const QString name = binding->name.last();
+    if (name != QLatin1String("left") && name != QLatin1String("top") &&
+        name != QLatin1String("right") && name != QLatin1String("bottom")) {
+      addDiagnostic(binding->location, QString::fromLatin1("unknown property contentsMargins.%1").arg(name));
+    }
+  }
+
+  if (complete) {
+    m_body << QString::fromLatin1("%1->setContentsMargins(%2, %3, %4, %5);")
+              .arg(variable, margins[0], margins[1], margins[2], margins[3]);
+    return;
+  }
+
+  if (margins[0].isEmpty() && margins[1].isEmpty() && margins[2].isEmpty() && margins[3].isEmpty()) {
+    return;
+  }
+
+  // keep the style's default for margins that are not set
+  QStringList values;
+  for (int i = 0; i < 4; ++i) {
+    values << (margins[i].isEmpty() ? QString::fromLatin1(names[i]) : margins[i]);
+  }
+
+  m_body << QLatin1String("{")
+         << QLatin1String("  int left, top, right, bottom;")
+         << QString::fromLatin1("  %1->getContentsMargins(&left, &top, &right, &bottom);").arg(variable)
+         << QString::fromLatin1("  %1->setContentsMargins(%2);").arg(variable, values.join(QLatin1String(", ")))
+         << QLatin1String("}");
+}
+
+void CppGenerator::writeHeader(QIODevice *outputDevice)
+{
+  QTextStream writer(outputDevice);
+  writer.setCodec(QTextCodec::codecForName("UTF-8"));
+
+  const QString guard = QString::fromLatin1("QML2CPP_%1_H").arg(m_className.toUpper());
+  QString rootClass = QLatin1String("QWidget");
+  for (int i = 0; i < m_members.count(); ++i) {
+    if (m_members[i].second == m_rootVariable) {
+      rootClass = m_members[i].first;
+      break;
+    }
+  }
+
+  const QByteArray memberIndent(4, ' ');
+  const QByteArray bodyIndent(6, ' ');
+
+  writer << "// Generated by qml2cpp, changes will be lost when the QML file is compiled again" << endl;
+  writer << endl;
+  writer << "#ifndef " << guard << endl;
+  writer << "#define " << guard << endl;
+  writer << endl;
+  writer << "#include <QtWidgets>" << endl;
+  writer << endl;
+  writer << "namespace Qml2cpp {" << endl;
+  writer << endl;
+  writer << "class " << m_className << endl;
+  writer << "{" << endl;
+  writer << "  public:" << endl;
+
+  for (int i = 0; i < m_members.count(); ++i) {
+    writer << memberIndent << m_members[i].first << " *" << m_members[i].second << ";" << endl;
+  }
+  if (!m_members.isEmpty()) {
+    writer << endl;
+  }
+
+  writer << memberIndent << rootClass << " *create(QWidget *parent = 0)" << endl;
+  writer << memberIndent << "{" << endl;
+
+  Q_FOREACH (const QString &line, m_body) {
+    writer << bodyIndent << line << endl;
+  }
+
+  if (!m_deferred.isEmpty()) {
+    writer << endl;
+    Q_FOREACH (const QString &line, m_deferred) {
+      writer << bodyIndent << line << endl;
+    }
+  }
+
+  writer << endl;
+  writer << bodyIndent << "return " << m_rootVariable << ";" << endl;
+  writer << memberIndent << "}" << endl;
+  writer << "};" << endl;
+  writer << endl;
+  writer << "} // namespace Qml2cpp" << endl;
+  writer << endl;
+  writer << "#endif // " << guard << endl;
+}
+
+const QmlBinding *CppGenerator::attachedBinding(const QmlObject *object, const QString &attachingType, const char *name)
+{
+  for (int i = 0; i < object->bindings.count(); ++i) {
+    const QmlBinding &binding = object->bindings.at(i);
+    if (binding.name.count() == 2 && binding.name.first() == attachingType &&
+        binding.name.last() == QLatin1String(name)) {
+      m_consumedBindings.insert(&binding);
+      return &binding;
+    }
+  }
+
+  return 0;
+}
+
+bool CppGenerator::attachedValue(const QmlObject *object, const QString &attachingType, const char *name,
+                                 const QByteArray &typeName, bool isEnum, QString *cpp)
+{
+  const QmlBinding *binding = attachedBinding(object, attachingType, name);
+  if (binding == 0) {
+    return false;
+  }
+
+  QString value;
+  if (binding->value.kind != QmlValue::Expression || !valueToCpp(binding->value.tokens, typeName, isEnum, &value)) {
+    addDiagnostic(binding->location, QString::fromLatin1("value %1 of %2 is not supported")
+                                     .arg(describe(binding->value), binding->name.join(QLatin1Char('.'))));
+    return false;
+  }
+
+  *cpp = value;
+  return true;
+}
+
+bool CppGenerator::valueToCpp(const QmlTokens &tokens, const QByteArray &typeName, bool isEnum, QString *cpp) const
+{
+  if (isEnum) {
+    return enumToCpp(tokens, cpp);
+  }
+
+  QString string;
+
+  switch (QMetaType::type(typeName.constData())) {
+  case QMetaType::QString:
+    return stringToCpp(tokens, cpp);
+
+  case QMetaType::Bool:
+    if (tokens.count() == 1 &&
+        (tokens.first().is(QmlToken::Identifier, "true") || tokens.first().is(QmlToken::Identifier, "false"))) {
+      *cpp = tokens.first().text;
+      return true;
+    }
+    return false;
+
+  case QMetaType::Int:
+  case QMetaType::UInt:
+  case QMetaType::Long:
+  case QMetaType::ULong:
+  case QMetaType::LongLong:
+  case QMetaType::ULongLong:
+  case QMetaType::Short:
+  case QMetaType::UShort:
+    return numberToCpp(tokens, true, cpp);
+
+  case QMetaType::Double:
+  case QMetaType::Float:
+    return numberToCpp(tokens, false, cpp);
+
+  case QMetaType::QSize:
+    return valueTypeToCpp(tokens, "Qt.size", 2, true, QLatin1String("QSize"), cpp);
+  case QMetaType::QSizeF:
+    return valueTypeToCpp(tokens, "Qt.size", 2, false, QLatin1String("QSizeF"), cpp);
+  case QMetaType::QPoint:
+    return valueTypeToCpp(tokens, "Qt.point", 2, true, QLatin1String("QPoint"), cpp);
+  case QMetaType::QPointF:
+    return valueTypeToCpp(tokens, "Qt.point", 2, false, QLatin1String("QPointF"), cpp);
+  case QMetaType::QRect:
+    return valueTypeToCpp(tokens, "Qt.rect", 4, true, QLatin1String("QRect"), cpp);
+  case QMetaType::QRectF:
+    return valueTypeToCpp(tokens, "Qt.rect", 4, false, QLatin1String("QRectF"), cpp);
+
+  // types QML converts from strings
+  case QMetaType::QColor:
+  case QMetaType::QKeySequence:
+  case QMetaType::QUrl:
+    if (tokens.count() != 1 || tokens.first().kind != QmlToken::String) {
+      return false;
+    }
+    *cpp = QString::fromLatin1("%1(%2)").arg(QLatin1String(typeName), stringLiteral(tokens.first().text));
+    return true;
+
+  case QMetaType::QStringList:
+    if (!stringToCpp(tokens, &string)) {
+      return false;
+    }
+    *cpp = QString::fromLatin1("QStringList(%1)").arg(string);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+bool CppGenerator::listToCpp(const QmlValue &value, const QByteArray &typeName, QString *cpp) const
+{
+  if (QMetaType::type(typeName.constData()) != QMetaType::QStringList) {
+    return false;
+  }
+
+  QString list = QLatin1String("QStringList()");
+  Q_FOREACH (const QmlValue &element, value.elements) {
+    QString string;
+    if (element.kind != QmlValue::Expression || !stringToCpp(element.tokens, &string)) {
+      return false;
+    }
+    list += QLatin1String(" << ") + string;
+  }
+
+  *cpp = list;
+  return true;
+}
+
+bool CppGenerator::stringToCpp(const QmlTokens &tokens, QString *cpp) const
+{
+  if (tokens.count() == 1 && tokens.first().kind == QmlToken::String) {
+    *cpp = stringLiteral(tokens.first().text);
+    return true;
+  }
+
+  QString function;
+  QList<QmlTokens> arguments;
+  if (!splitCall(tokens, &function, &arguments) || function != QLatin1String("qsTr") || arguments.count() != 1 ||
+      arguments.first().count() != 1 || arguments.first().first().kind != QmlToken::String) {
+    return false;
+  }
+
+  // qsTr() uses the QML file's base name as context
+  *cpp = QString::fromLatin1("QCoreApplication::translate(%1, %2)")
+         .arg(cStringLiteral(m_translationContext), cStringLiteral(arguments.first().first().text));
+  return true;
+}
+
+bool CppGenerator::enumToCpp(const QmlTokens &tokens, QString *cpp) const
+{
+  // Scope.Key, optionally combined with |
+  QStringList values;
+  for (int i = 0; i < tokens.count(); i += 4) {
+    if (i + 2 >= tokens.count() || tokens.at(i).kind != QmlToken::Identifier || !tokens.at(i + 1).isPunctuator(".") ||
+        tokens.at(i + 2).kind != QmlToken::Identifier) {
+      return false;
+    }
+
+    if (i + 3 < tokens.count() && !tokens.at(i + 3).isPunctuator("|")) {
+      return false;
+    }
+
+    const QString scope = tokens.at(i).text;
+    const QString key = tokens.at(i + 2).text;
+
+    if (scope == QLatin1String("Qt")) {
+      values << QLatin1String("Qt::") + key;
+      continue;
+    }
+
+    const QmlTypes::Type *type = QmlTypes::find(scope);
+    if (type == 0) {
+      return false;
+    }
+
+    // DeclarativeSpacerItem mirrors the QSizePolicy values
+    if (type->kind == QmlTypes::SpacerType) {
+      values << QLatin1String("QSizePolicy::") + key;
+      continue;
+    }
+
+    QString value;
+    const QByteArray keyName = key.toLatin1();
+    for (int e = 0; e < type->metaObject->enumeratorCount() && value.isEmpty(); ++e) {
+      const QMetaEnum enumerator = type->metaObject->enumerator(e);
+      for (int k = 0; k < enumerator.keyCount(); ++k) {
+        if (keyName == enumerator.key(k)) {
+          value = QString::fromLatin1("%1::%2").arg(QLatin1String(enumerator.scope()), key);
+          break;
+        }
+      }
+    }
+
+    if (value.isEmpty()) {
+      return false;
+    }
+    values << value;
+  }
+
+  if (values.isEmpty()) {
+    return false;
+  }
+
+  *cpp = values.join(QLatin1String(" | "));
+  return true;
+}
+
+void CppGenerator::addDiagnostic(const QmlToken &location, const QString &message)
+{
+  m_diagnostics << QmlDiagnostic(location, message);
+}
+
+QString CppGenerator::stringLiteral(const QString &text)
+{
+  bool ascii = true;
+  const QString escaped = escapedUtf8(text, &ascii);
+
+  if (ascii) {
+    return QString::fromLatin1("QStringLiteral(\"%1\")").arg(escaped);
+  }
+
+  return QString::fromLatin1("QString::fromUtf8(\"%1\")").arg(escaped);
+}
+
+QString CppGenerator::cStringLiteral(const QString &text)
+{
+  bool ascii = true;
+  return QLatin1Char('"') + escapedUtf8(text, &ascii) + QLatin1Char('"');
+}
+
+QString CppGenerator::signalPointer(const QString &className, const QMetaObject *metaObject, const QMetaMethod &signal)
+{
+  const QByteArray name = signal.name();
+
+  int overloads = 0;
+  for (int i = 0; i < metaObject->methodCount(); ++i) {
+    const QMetaMethod method = metaObject->method(i);
+    if (method.methodType() == QMetaMethod::Signal && method.name() == name) {
+      ++overloads;
+    }
+  }
+
+  const QString pointer = QString::fromLatin1("&%1::%2").arg(className, QLatin1String(name));
+  if (overloads < 2) {
+    return pointer;
+  }
+
+  // the meta object only knows normalized types, values of classes are
+  // passed by const reference by convention
+  QStringList parameters;
+  Q_FOREACH (const QByteArray &parameterType, signal.parameterTypes()) {
+    const int type = QMetaType::type(parameterType.constData());
+    const bool byValue = parameterType.endsWith('*') || parameterType.contains("::") ||
+                         (type != QMetaType::UnknownType && type < QMetaType::User &&
+                          (QMetaType::typeFlags(type) & QMetaType::MovableType) &&
+                          !(QMetaType::typeFlags(type) & QMetaType::NeedsConstruction));
+    parameters << (byValue ? QString::fromLatin1(parameterType) : QString::fromLatin1("const %1 &").arg(QLatin1String(parameterType)));
+  }
+
+  return QString::fromLatin1("static_cast<void (%1::*)(%2)>(%3)")
+         .arg(className, parameters.join(QLatin1String(", ")), pointer);
+}
@@ -0,0 +1,132 @@
+/*
+  cppgenerator.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CPPGENERATOR_H
+#define CPPGENERATOR_H
+
+#include "qmlparser.h"
+#include "qmltypes.h"
+
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+class QMetaMethod;
+QT_END_NAMESPACE
+
+// Writes a header with a class whose create() function builds the widget
+// tree of a DeclarativeWidgets QML document without a QML engine.
+// Supported are the object tree of the types in QmlTypes, literal values,
+// the attached layout and tab widget properties, references to other
+// objects by id and bindings to a single property of another object.
+// Everything else is skipped and reported in diagnostics().
+class CppGenerator
+{
+  public:
+    CppGenerator();
+
+    // defaults to Form
+    void setClassName(const QString &className);
+    QString className() const;
+
+    // context of qsTr() translations, the base name of the QML file
+    void setTranslationContext(const QString &context);
+    QString translationContext() const;
+
+    // returns false if the root object cannot be compiled
+    bool generate(const QmlDocument &document, QIODevice *outputDevice);
+
+    QString errorString() const;
+
+    QmlDiagnostics diagnostics() const;
+
+  private:
+    struct ObjectInfo
+    {
+        const QmlTypes::Type *type;
+        QString variable;
+        QString className;
+    };
+
+    QString m_className;
+    QString m_translationContext;
+    QString m_errorString;
+    QmlDiagnostics m_diagnostics;
+
+    QHash<const QmlObject*, ObjectInfo> m_objects;
+    QHash<QString, const QmlObject*> m_objectsById;
+    QVector<QPair<QString, QString> > m_members;
+    QSet<QString> m_variables;
+    int m_anonymousCount;
+
+    // bindings handled by the parent, e.g. attached layout properties
+    QSet<const QmlBinding*> m_consumedBindings;
+
+    QString m_rootVariable;
+    QString m_parentWidget;
+    QStringList m_body;
+    QStringList m_deferred;
+
+  private:
+    void declareObject(const QmlObject *object);
+    void declareValueObjects(const QmlValue &value);
+
+    void createObject(const QmlObject *object, const QmlObject *parent);
+    void addToContainer(const QmlObject *object, const QmlObject *container);
+    void addToLayout(const QmlObject *object, const QmlObject *layout);
+    void writeSpacer(const QmlObject *object);
+
+    void writeBindings(const QmlObject *object);
+    void writeBinding(const QmlObject *object, const QmlBinding &binding);
+    void writeProperty(const QmlObject *object, const QmlBinding &binding, const QString &setter,
+                       const QByteArray &typeName, bool isEnum);
+    bool writePropertyBinding(const QmlObject *object, const QmlBinding &binding, const QString &setter,
+                              const QByteArray &typeName);
+    void writeFont(const QmlObject *object, const QList<const QmlBinding*> &bindings);
+    void writeContentsMargins(const QmlObject *object, const QList<const QmlBinding*> &bindings);
+    void writeHeader(QIODevice *outputDevice);
+
+    const QmlBinding *attachedBinding(const QmlObject *object, const QString &attachingType, const char *name);
+    bool attachedValue(const QmlObject *object, const QString &attachingType, const char *name,
+                       const QByteArray &typeName, bool isEnum, QString *cpp);
+
+    bool valueToCpp(const QmlTokens &tokens, const QByteArray &typeName, bool isEnum, QString *cpp) const;
+    bool listToCpp(const QmlValue &value, const QByteArray &typeName, QString *cpp) const;
+    bool stringToCpp(const QmlTokens &tokens, QString *cpp) const;
+    bool enumToCpp(const QmlTokens &tokens, QString *cpp) const;
+
+    void addDiagnostic(const QmlToken &location, const QString &message);
+
+    static QString stringLiteral(const QString &text);
+    static QString cStringLiteral(const QString &text);
+    static QString signalPointer(const QString &className, const QMetaObject *metaObject, const QMetaMethod &signal);
+};
+
+#endif // CPPGENERATOR_H
@@ -0,0 +1,179 @@
+/*
+  main.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cppgenerator.h"
+#include "qmlparser.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace std;
+
+void printUsage()
+{
+  cout << "Usage: qml2cpp [ -c <classname> ] [ --strict ] [ -o <outputfile> ] inputfile" << endl;
+  cout << endl;
+  cout << "  -c <classname>  name of the generated class, defaults to the capitalized base name of the input" << endl;
+  cout << "  --strict        fail instead of skipping constructs that cannot be compiled" << endl;
+}
+
+static bool diagnosticLessThan(const QmlDiagnostic &left, const QmlDiagnostic &right)
+{
+  if (left.line != right.line) {
+    return left.line < right.line;
+  }
+  return left.column < right.column;
+}
+
+static void printDiagnostics(const QString &inputFileName, QmlDiagnostics diagnostics)
+{
+  std::stable_sort(diagnostics.begin(), diagnostics.end(), diagnosticLessThan);
+
+  Q_FOREACH (const QmlDiagnostic &diagnostic, diagnostics) {
+    cerr << inputFileName.toLocal8Bit().constData() << ":" << diagnostic.line << ":" << diagnostic.column
+         << ": unsupported: " << diagnostic.message.toLocal8Bit().constData() << endl;
+  }
+
+  if (!diagnostics.isEmpty()) {
+    cerr << inputFileName.toLocal8Bit().constData() << ": skipped " << diagnostics.count()
+         << " unsupported construct(s)" << endl;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2) {
+    cerr << "Too few arguments" << endl;
+    printUsage();
+    return 1;
+  }
+
+  QString inputFileName;
+  QString outputFileName;
+  QString className;
+  bool strict = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const QString argument = QString::fromLocal8Bit(argv[i]);
+
+    if (argument == QLatin1String("-o") || argument == QLatin1String("-c")) {
+      if (++i == argc) {
+        cerr << "Invalid usage" << endl;
+        printUsage();
+        return 2;
+      }
+
+      if (argument == QLatin1String("-o")) {
+        outputFileName = QString::fromLocal8Bit(argv[i]);
+      } else {
+        className = QString::fromLocal8Bit(argv[i]);
+      }
+    } else if (argument == QLatin1String("--strict")) {
+      strict = true;
+    } else if (argument.startsWith(QLatin1Char('-'))) {
+      cerr << "Invalid usage" << endl;
+      printUsage();
+      return 2;
+    } else if (inputFileName.isEmpty()) {
+      inputFileName = argument;
+    } else {
+      cerr << "Too many arguments" << endl;
+      printUsage();
+      return 1;
+    }
+  }
+
+  if (inputFileName.isEmpty()) {
+    cerr << "Too few arguments" << endl;
+    printUsage();
+    return 1;
+  }
+
+  QFile inputFile(inputFileName);
+  if (!inputFile.open(QIODevice::ReadOnly)) {
+    cerr << "Error: Can not open input file " << inputFileName.toLocal8Bit().constData() << ": "
+         << inputFile.errorString().toLocal8Bit().constData() << endl;
+    return 3;
+  }
+
+  QmlParser parser(QString::fromUtf8(inputFile.readAll()));
+  const QmlDocument document = parser.parse();
+  if (document.root.isNull()) {
+    cerr << "Error: " << inputFileName.toLocal8Bit().constData() << ":"
+         << parser.errorString().toLocal8Bit().constData() << endl;
+    return 5;
+  }
+
+  const QString baseName = QFileInfo(inputFileName).completeBaseName();
+  if (className.isEmpty()) {
+    className = baseName;
+    className[0] = className[0].toUpper();
+  }
+
+  // QML registers the file's base name as translation context of qsTr()
+  CppGenerator generator;
+  generator.setClassName(className);
+  generator.setTranslationContext(baseName);
+
+  QByteArray output;
+  {
+    QBuffer buffer(&output);
+    buffer.open(QIODevice::WriteOnly);
+    if (!generator.generate(document, &buffer)) {
+      cerr << "Error: " << inputFileName.toLocal8Bit().constData() << ":"
+           << generator.errorString().toLocal8Bit().constData() << endl;
+      return 5;
+    }
+  }
+
+  const QmlDiagnostics diagnostics = parser.diagnostics() + generator.diagnostics();
+  printDiagnostics(inputFileName, diagnostics);
+
+  if (strict && !diagnostics.isEmpty()) {
+    return 6;
+  }
+
+  if (outputFileName.isEmpty()) {
+    cout << output.constData();
+    return 0;
+  }
+
+  QSaveFile outputFile(outputFileName);
+  if (!outputFile.open(QIODevice::WriteOnly) || outputFile.write(output) != output.size() || !outputFile.commit()) {
+    cerr << "Error: Can not write output file " << outputFileName.toLocal8Bit().constData() << ": "
+         << outputFile.errorString().toLocal8Bit().constData() << endl;
+    return 4;
+  }
+
+  return 0;
+}
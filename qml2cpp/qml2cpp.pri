@@ -0,0 +1,16 @@
+QT += widgets
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += \
+    $$PWD/qmllexer.cpp \
+    $$PWD/qmlparser.cpp \
+    $$PWD/qmltypes.cpp \
+    $$PWD/cppgenerator.cpp
+
+HEADERS += \
+    $$PWD/qmllexer.h \
+    $$PWD/qmlparser.h \
+    $$PWD/qmltypes.h \
+    $$PWD/cppgenerator.h
@@ -0,0 +1,19 @@
+QT       += core
+
+TARGET = qml2cpp
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TEMPLATE = app
+
+
+SOURCES += main.cpp
+
+include(qml2cpp.pri)
+
+target.path = $$[QT_INSTALL_BINS]
+
+features.files = $$PWD/../mkspecs/features/qml2cpp.prf
+features.path = $$[QT_HOST_DATA]/mkspecs/features
+
+INSTALLS += target features
@@ -0,0 +1,270 @@
+/*
+  qmllexer.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "qmllexer.h"
+
+#include <cctype>
+
+QmlLexer::QmlLexer(const QString &source)
+  : m_source(source)
+  , m_position(0)
+  , m_line(1)
+  , m_lineStart(0)
+{
+}
+
+QmlTokens QmlLexer::tokenize()
+{
+  QmlTokens tokens;
+
+  m_position = 0;
+  m_line = 1;
+  m_lineStart = 0;
+  m_errorString.clear();
+
+  bool newline = true;
+  while (skipWhitespaceAndComments(&newline) && m_position < m_source.length()) {
+    QmlToken token;
+    token.line = m_line;
+    token.column = m_position - m_lineStart + 1;
+    token.newlineBefore = newline;
+    newline = false;
+
+    const QChar c = m_source.at(m_position);
+    if (c.isLetter() || c == QLatin1Char('_') || c == QLatin1Char('$')) {
+      const int start = m_position;
+      while (m_position < m_source.length() &&
+             (m_source.at(m_position).isLetterOrNumber() || m_source.at(m_position) == QLatin1Char('_') ||
+              m_source.at(m_position) == QLatin1Char('$'))) {
+        ++m_position;
+      }
+      token.kind = QmlToken::Identifier;
+      token.text = m_source.mid(start, m_position - start);
+    } else if (c.isDigit() ||
+               (c == QLatin1Char('.') && m_position + 1 < m_source.length() && m_source.at(m_position + 1).isDigit())) {
+      readNumber(&token);
+    } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+      if (!readString(&token)) {
+        break;
+      }
+    } else {
+      readPunctuator(&token);
+    }
+
+    tokens << token;
+  }
+
+  QmlToken endOfFile;
+  endOfFile.line = m_line;
+  endOfFile.column = m_position - m_lineStart + 1;
+  endOfFile.newlineBefore = true;
+  tokens << endOfFile;
+
+  return tokens;
+}
+
+QString QmlLexer::errorString() const
+{
+  return m_errorString;
+}
+
+bool QmlLexer::skipWhitespaceAndComments(bool *newline)
+{
+  while (m_position < m_source.length()) {
+    const QChar c = m_source.at(m_position);
+    const QChar next = m_position + 1 < m_source.length() ? m_source.at(m_position + 1) : QChar();
+
+    if (c == QLatin1Char('\n')) {
+      ++m_position;
+      ++m_line;
+      m_lineStart = m_position;
+      *newline = true;
+    } else if (c.isSpace()) {
+      ++m_position;
+    } else if (c == QLatin1Char('/') && next == QLatin1Char('/')) {
+      while (m_position < m_source.length() && m_source.at(m_position) != QLatin1Char('\n')) {
+        ++m_position;
+      }
+    } else if (c == QLatin1Char('/') && next == QLatin1Char('*')) {
+      const int end = m_source.indexOf(QLatin1String("*/"), m_position + 2);
+      if (end < 0) {
+        setError(QLatin1String("Unterminated comment"));
+        return false;
+      }
+
+      for (int i = m_position; i < end; ++i) {
+        if (m_source.at(i) == QLatin1Char('\n')) {
+          ++m_line;
+          m_lineStart = i + 1;
+          *newline = true;
+        }
+      }
+      m_position = end + 2;
+    } else {
+      break;
+    }
+  }
+
+  return true;
+}
+
+bool QmlLexer::readString(QmlToken *token)
+{
+  const QChar quote = m_source.at(m_position++);
+
+  token->kind = QmlToken::String;
+
+  while (m_position < m_source.length()) {
+    QChar c = m_source.at(m_position++);
+    if (c == quote) {
+      return true;
+    }
+
+    if (c == QLatin1Char('\n')) {
+      break;
+    }
+
+    if (c != QLatin1Char('\\')) {
+      token->text += c;
+      continue;
+    }
+
+    if (m_position >= m_source.length()) {
+      break;
+    }
+
+    c = m_source.at(m_position++);
+    switch (c.unicode()) {
+    case 'b':
+      token->text += QLatin1Char('\b');
+      break;
+    case 'f':
+      token->text += QLatin1Char('\f');
+      break;
+    case 'n':
+      token->text += QLatin1Char('\n');
+      break;
+    case 'r':
+      token->text += QLatin1Char('\r');
+      break;
+    case 't':
+      token->text += QLatin1Char('\t');
+      break;
+    case 'v':
+      token->text += QLatin1Char('\v');
+      break;
+    case '0':
+      token->text += QChar(0);
+      break;
+    case 'u':
+    case 'x': {
+      const int digits = c == QLatin1Char('u') ? 4 : 2;
+      bool ok = false;
+      const ushort code = m_source.mid(m_position, digits).toUShort(&ok, 16);
+      if (!ok) {
+        setError(QLatin1String("Invalid escape sequence in string"));
+        return false;
+      }
+      token->text += QChar(code);
+      m_position += digits;
+      break;
+    }
+    case '\n':
+      // line continuation
+      ++m_line;
+      m_lineStart = m_position;
+      break;
+    default:
+      token->text += c;
+      break;
+    }
+  }
+
+  setError(QLatin1String("Unterminated string"));
+  return false;
+}
+
+void QmlLexer::readNumber(QmlToken *token)
+{
+  const int start = m_position;
+
+  token->kind = QmlToken::Number;
+
+  if (m_source.at(m_position) == QLatin1Char('0') && m_position + 1 < m_source.length() &&
+      (m_source.at(m_position + 1) == QLatin1Char('x') || m_source.at(m_position + 1) == QLatin1Char('X'))) {
+    m_position += 2;
+    while (m_position < m_source.length() && isxdigit(m_source.at(m_position).toLatin1())) {
+      ++m_position;
+    }
+    token->text = m_source.mid(start, m_position - start);
+    return;
+  }
+
+  while (m_position < m_source.length() &&
+         (m_source.at(m_position).isDigit() || m_source.at(m_position) == QLatin1Char('.'))) {
+    ++m_position;
+  }
+
+  if (m_position < m_source.length() &&
+      (m_source.at(m_position) == QLatin1Char('e') || m_source.at(m_position) == QLatin1Char('E'))) {
+    ++m_position;
+    if (m_position < m_source.length() &&
+        (m_source.at(m_position) == QLatin1Char('+') || m_source.at(m_position) == QLatin1Char('-'))) {
+      ++m_position;
+    }
+    while (m_position < m_source.length() && m_source.at(m_position).isDigit()) {
+      ++m_position;
+    }
+  }
+
+  token->text = m_source.mid(start, m_position - start);
+}
+
+void QmlLexer::readPunctuator(QmlToken *token)
+{
+  static const char *const punctuators[] = {
+    "===", "!==", "...",
+    "==", "!=", "<=", ">=", "&&", "||", "++", "--", "+=", "-=", "*=", "/=", "=>"
+  };
+
+  token->kind = QmlToken::Punctuator;
+
+  for (unsigned int i = 0; i < sizeof(punctuators) / sizeof(punctuators[0]); ++i) {
+    const QLatin1String punctuator(punctuators[i]);
+    if (m_source.midRef(m_position, punctuator.size()) == punctuator) {
+      token->text = punctuator;
+      m_position += punctuator.size();
+      return;
+    }
+  }
+
+  token->text = m_source.at(m_position++);
+}
+
+void QmlLexer::setError(const QString &message)
+{
+  m_errorString = QString::fromLatin1("%1:%2: %3").arg(m_line).arg(m_position - m_lineStart + 1).arg(message);
+}
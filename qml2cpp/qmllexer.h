@@ -0,0 +1,99 @@
+/*
+  qmllexer.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QMLLEXER_H
+#define QMLLEXER_H
+
+#include <QString>
+#include <QVector>
+
+struct QmlToken
+{
+    enum Kind {
+      EndOfFile,
+      Identifier,
+      Number,
+      String,
+      Punctuator
+    };
+
+    QmlToken()
+      : kind(EndOfFile)
+      , line(0)
+      , column(0)
+      , newlineBefore(false)
+    {
+    }
+
+    bool is(Kind tokenKind, const char *tokenText) const
+    {
+      return kind == tokenKind && text == QLatin1String(tokenText);
+    }
+
+    bool isPunctuator(const char *punctuator) const
+    {
+      return is(Punctuator, punctuator);
+    }
+
+    Kind kind;
+    // the decoded value for strings, the source text otherwise
+    QString text;
+    int line;
+    int column;
+    // the token is the first on its line, QML statements can end there
+    bool newlineBefore;
+};
+
+typedef QVector<QmlToken> QmlTokens;
+
+// Splits QML source into tokens, skipping whitespace and comments.
+// Only as much of JavaScript as is needed to find where bindings end
+class QmlLexer
+{
+  public:
+    explicit QmlLexer(const QString &source);
+
+    // the last token is always an EndOfFile token, even on errors
+    QmlTokens tokenize();
+
+    QString errorString() const;
+
+  private:
+    const QString m_source;
+    int m_position;
+    int m_line;
+    int m_lineStart;
+    QString m_errorString;
+
+  private:
+    bool skipWhitespaceAndComments(bool *newline);
+    bool readString(QmlToken *token);
+    void readNumber(QmlToken *token);
+    void readPunctuator(QmlToken *token);
+    void setError(const QString &message);
+};
+
+#endif // QMLLEXER_H
@@ -0,0 +1,516 @@
+/*
+  qmlparser.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "qmlparser.h"
+
+QmlParser::QmlParser(const QString &source)
+  : m_source(source)
+  , m_index(0)
+{
+}
+
+QmlDocument QmlParser::parse()
+{
+  QmlDocument document;
+
+  m_index = 0;
+  m_errorString.clear();
+  m_diagnostics.clear();
+
+  QmlLexer lexer(m_source);
+  m_tokens = lexer.tokenize();
+  if (!lexer.errorString().isEmpty()) {
+    m_errorString = lexer.errorString();
+    return document;
+  }
+
+  while (current().is(QmlToken::Identifier, "import") || current().is(QmlToken::Identifier, "pragma")) {
+    const bool isImport = current().text == QLatin1String("import");
+    ++m_index;
+
+    QString statement;
+    while (!atEnd() && !current().newlineBefore && !current().isPunctuator(";")) {
+      if (!statement.isEmpty() && !current().isPunctuator(".") && !statement.endsWith(QLatin1Char('.'))) {
+        statement += QLatin1Char(' ');
+      }
+      statement += current().text;
+      ++m_index;
+    }
+    if (current().isPunctuator(";")) {
+      ++m_index;
+    }
+
+    if (isImport) {
+      document.imports << statement;
+    }
+  }
+
+  const QmlToken location = current();
+
+  QStringList typeName;
+  if (!parseQualifiedName(&typeName)) {
+    return document;
+  }
+
+  if (!isObjectTypeName(typeName)) {
+    setError(location, QString::fromLatin1("Expected an object type, found %1").arg(typeName.join(QLatin1Char('.'))));
+    return document;
+  }
+
+  const QmlObjectPtr root = parseObject(typeName.join(QLatin1Char('.')), location);
+  if (root.isNull()) {
+    return document;
+  }
+
+  if (!atEnd()) {
+    setError(current(), QLatin1String("Unexpected content after the root object"));
+    return document;
+  }
+
+  document.root = root;
+  return document;
+}
+
+QString QmlParser::errorString() const
+{
+  return m_errorString;
+}
+
+QmlDiagnostics QmlParser::diagnostics() const
+{
+  return m_diagnostics;
+}
+
+const QmlToken &QmlParser::current() const
+{
+  return m_tokens.at(qMin(m_index, m_tokens.count() - 1));
+}
+
+const QmlToken &QmlParser::peek(int offset) const
+{
+  return m_tokens.at(qMin(m_index + offset, m_tokens.count() - 1));
+}
+
+bool QmlParser::atEnd() const
+{
+  return current().kind == QmlToken::EndOfFile;
+}
+
+bool QmlParser::expect(const char *punctuator)
+{
+  if (!current().isPunctuator(punctuator)) {
+    setError(current(), QString::fromLatin1("Expected %1, found %2")
+                        .arg(QLatin1String(punctuator), atEnd() ? QString::fromLatin1("end of file") : current().text));
+    return false;
+  }
+
+  ++m_index;
+  return true;
+}
+
+void QmlParser::setError(const QmlToken &token, const QString &message)
+{
+  // the first error is the one that matters
+  if (m_errorString.isEmpty()) {
+    m_errorString = QString::fromLatin1("%1:%2: %3").arg(token.line).arg(token.column).arg(message);
+  }
+}
+
+QmlObjectPtr QmlParser::parseObject(const QString &typeName, const QmlToken &location)
+{
+  if (!expect("{")) {
+    return QmlObjectPtr();
+  }
+
+  QmlObjectPtr object(new QmlObject);
+  object->typeName = typeName;
+  object->location = location;
+
+  while (!current().isPunctuator("}")) {
+    if (atEnd()) {
+      setError(current(), QString::fromLatin1("Unexpected end of file in %1").arg(typeName));
+      return QmlObjectPtr();
+    }
+
+    if (current().isPunctuator(";")) {
+      ++m_index;
+      continue;
+    }
+
+    if (!parseMember(object.data())) {
+      return QmlObjectPtr();
+    }
+  }
+  ++m_index;
+
+  return object;
+}
+
+bool QmlParser::parseMember(QmlObject *object)
+{
+  const QmlToken location = current();
+  if (location.kind != QmlToken::Identifier) {
+    setError(location, QString::fromLatin1("Unexpected %1").arg(location.text));
+    return false;
+  }
+
+  // declarations are only followed by an identifier
+  if (peek().kind == QmlToken::Identifier) {
+    if (location.text == QLatin1String("property") || location.text == QLatin1String("readonly") ||
+        location.text == QLatin1String("default")) {
+      return skipDeclaration(QLatin1String("property declaration"));
+    }
+
+    if (location.text == QLatin1String("signal")) {
+      return skipDeclaration(QLatin1String("signal declaration"));
+    }
+
+    if (location.text == QLatin1String("function")) {
+      return skipFunction();
+    }
+  }
+
+  QStringList name;
+  if (!parseQualifiedName(&name)) {
+    return false;
+  }
+
+  if (current().isPunctuator("{")) {
+    if (!isObjectTypeName(name)) {
+      setError(location, QString::fromLatin1("Expected an object type, found %1").arg(name.join(QLatin1Char('.'))));
+      return false;
+    }
+
+    const QmlObjectPtr child = parseObject(name.join(QLatin1Char('.')), location);
+    if (child.isNull()) {
+      return false;
+    }
+
+    object->children << child;
+    return true;
+  }
+
+  // property value sources and interceptors, e.g. Behavior on x { }
+  if (current().is(QmlToken::Identifier, "on")) {
+    ++m_index;
+
+    QStringList target;
+    if (!parseQualifiedName(&target)) {
+      return false;
+    }
+
+    m_diagnostics << QmlDiagnostic(location, QString::fromLatin1("%1 on %2 is not supported")
+                                             .arg(name.join(QLatin1Char('.')), target.join(QLatin1Char('.'))));
+
+    return !parseObject(name.join(QLatin1Char('.')), location).isNull();
+  }
+
+  if (!expect(":")) {
+    return false;
+  }
+
+  if (name.count() == 1 && name.first() == QLatin1String("id")) {
+    if (current().kind != QmlToken::Identifier) {
+      setError(current(), QLatin1String("Expected an id"));
+      return false;
+    }
+
+    object->id = current().text;
+    ++m_index;
+
+    if (current().isPunctuator(";")) {
+      ++m_index;
+    }
+    return true;
+  }
+
+  QmlBinding binding;
+  binding.name = name;
+  binding.location = location;
+
+  if (!parseValue(&binding.value)) {
+    return false;
+  }
+
+  object->bindings << binding;
+  return true;
+}
+
+bool QmlParser::parseValue(QmlValue *value)
+{
+  if (current().isPunctuator("[")) {
+    return parseList(value);
+  }
+
+  if (current().isPunctuator("{")) {
+    value->kind = QmlValue::Block;
+    return parseBlock(&value->tokens);
+  }
+
+  if (isObjectValue()) {
+    const QmlToken location = current();
+
+    QStringList typeName;
+    parseQualifiedName(&typeName);
+
+    value->kind = QmlValue::Object;
+    value->object = parseObject(typeName.join(QLatin1Char('.')), location);
+    return !value->object.isNull();
+  }
+
+  value->kind = QmlValue::Expression;
+  return parseExpression(&value->tokens, false);
+}
+
+bool QmlParser::parseList(QmlValue *value)
+{
+  value->kind = QmlValue::List;
+  ++m_index;
+
+  while (!current().isPunctuator("]")) {
+    if (atEnd()) {
+      setError(current(), QLatin1String("Unexpected end of file in list"));
+      return false;
+    }
+
+    QmlValue element;
+    if (isObjectValue()) {
+      if (!parseValue(&element)) {
+        return false;
+      }
+    } else if (!parseExpression(&element.tokens, true)) {
+      return false;
+    }
+    value->elements << element;
+
+    if (current().isPunctuator(",")) {
+      ++m_index;
+    } else if (!current().isPunctuator("]")) {
+      setError(current(), QString::fromLatin1("Expected , or ], found %1").arg(current().text));
+      return false;
+    }
+  }
+  ++m_index;
+
+  if (current().isPunctuator(";")) {
+    ++m_index;
+  }
+
+  return true;
+}
+
+bool QmlParser::parseExpression(QmlTokens *tokens, bool inList)
+{
+  int depth = 0;
+
+  while (!atEnd()) {
+    const QmlToken &token = current();
+
+    if (!tokens->isEmpty() && depth == 0) {
+      if (inList) {
+        if (token.isPunctuator(",") || token.isPunctuator("]")) {
+          break;
+        }
+      } else {
+        if (token.isPunctuator(";")) {
+          ++m_index;
+          break;
+        }
+
+        if (token.isPunctuator("}") || (token.newlineBefore && !continuesExpression(tokens->last(), token))) {
+          break;
+        }
+      }
+    }
+
+    if (token.isPunctuator("(") || token.isPunctuator("[") || token.isPunctuator("{")) {
+      ++depth;
+    } else if (token.isPunctuator(")") || token.isPunctuator("]") || token.isPunctuator("}")) {
+      if (depth == 0) {
+        setError(token, QString::fromLatin1("Unexpected %1").arg(token.text));
+        return false;
+      }
+      --depth;
+    }
+
+    *tokens << token;
+    ++m_index;
+  }
+
+  if (tokens->isEmpty() || depth > 0) {
+    setError(current(), QLatin1String("Expected an expression"));
+    return false;
+  }
+
+  return true;
+}
+
+bool QmlParser::parseBlock(QmlTokens *tokens)
+{
+  int depth = 0;
+
+  do {
+    const QmlToken &token = current();
+    if (atEnd()) {
+      setError(token, QLatin1String("Unexpected end of file in block"));
+      return false;
+    }
+
+    if (token.isPunctuator("(") || token.isPunctuator("[") || token.isPunctuator("{")) {
+      ++depth;
+    } else if (token.isPunctuator(")") || token.isPunctuator("]") || token.isPunctuator("}")) {
+      --depth;
+    }
+
+    *tokens << token;
+    ++m_index;
+  } while (depth > 0);
+
+  if (current().isPunctuator(";")) {
+    ++m_index;
+  }
+
+  return true;
+}
+
+bool QmlParser::parseQualifiedName(QStringList *name)
+{
+  if (current().kind != QmlToken::Identifier) {
+    setError(current(), QString::fromLatin1("Expected a name, found %1")
+                        .arg(atEnd() ? QString::fromLatin1("end of file") : current().text));
+    return false;
+  }
+
+  *name << current().text;
+  ++m_index;
+
+  while (current().isPunctuator(".") && peek().kind == QmlToken::Identifier) {
+    *name << peek().text;
+    m_index += 2;
+  }
+
+  return true;
+}
+
+bool QmlParser::skipDeclaration(const QString &kind)
+{
+  const QmlToken location = current();
+  ++m_index;
+
+  // the declared name is the last identifier outside of parentheses,
+  // e.g. property int count or signal clicked(int button)
+  QString declaredName;
+  int depth = 0;
+
+  while (!atEnd()) {
+    const QmlToken &token = current();
+    if (depth == 0 && (token.newlineBefore || token.isPunctuator("}") || token.isPunctuator(":") ||
+                       token.isPunctuator(";"))) {
+      break;
+    }
+
+    if (token.isPunctuator("(")) {
+      ++depth;
+    } else if (token.isPunctuator(")")) {
+      --depth;
+    } else if (depth == 0 && token.kind == QmlToken::Identifier) {
+      declaredName = token.text;
+    }
+
+    ++m_index;
+  }
+
+  m_diagnostics << QmlDiagnostic(location, QString::fromLatin1("%1 %2 is not supported").arg(kind, declaredName));
+
+  if (current().isPunctuator(";")) {
+    ++m_index;
+  } else if (current().isPunctuator(":")) {
+    ++m_index;
+
+    QmlValue value;
+    return parseValue(&value);
+  }
+
+  return true;
+}
+
+bool QmlParser::skipFunction()
+{
+  const QmlToken location = current();
+  const QString functionName = peek().text;
+  m_index += 2;
+
+  if (!current().isPunctuator("(")) {
+    setError(current(), QLatin1String("Expected ("));
+    return false;
+  }
+
+  QmlTokens parameters;
+  QmlTokens body;
+  if (!parseBlock(&parameters) || !current().isPunctuator("{") || !parseBlock(&body)) {
+    setError(current(), QString::fromLatin1("Expected the body of function %1").arg(functionName));
+    return false;
+  }
+
+  m_diagnostics << QmlDiagnostic(location, QString::fromLatin1("function %1 is not supported").arg(functionName));
+
+  return true;
+}
+
+bool QmlParser::isObjectValue() const
+{
+  int offset = 0;
+  while (peek(offset).kind == QmlToken::Identifier && peek(offset + 1).isPunctuator(".") &&
+         peek(offset + 2).kind == QmlToken::Identifier) {
+    offset += 2;
+  }
+
+  const QmlToken &last = peek(offset);
+  return last.kind == QmlToken::Identifier && !last.text.isEmpty() && last.text.at(0).isUpper() &&
+         peek(offset + 1).isPunctuator("{");
+}
+
+bool QmlParser::isObjectTypeName(const QStringList &name)
+{
+  return !name.isEmpty() && !name.last().isEmpty() && name.last().at(0).isUpper();
+}
+
+bool QmlParser::continuesExpression(const QmlToken &previous, const QmlToken &next)
+{
+  // a member never starts with an operator
+  if (next.kind == QmlToken::Punctuator) {
+    return next.text != QLatin1String("++") && next.text != QLatin1String("--") && next.text != QLatin1String("}");
+  }
+
+  // nor can a line end with one, apart from postfix operators
+  if (previous.kind == QmlToken::Punctuator) {
+    return previous.text != QLatin1String(")") && previous.text != QLatin1String("]") &&
+           previous.text != QLatin1String("}") && previous.text != QLatin1String("++") &&
+           previous.text != QLatin1String("--");
+  }
+
+  return false;
+}
@@ -0,0 +1,153 @@
+/*
+  qmlparser.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QMLPARSER_H
+#define QMLPARSER_H
+
+#include "qmllexer.h"
+
+#include <QList>
+#include <QSharedPointer>
+#include <QStringList>
+
+struct QmlObject;
+typedef QSharedPointer<QmlObject> QmlObjectPtr;
+
+// A construct of the document that cannot be compiled, reported to the user
+struct QmlDiagnostic
+{
+    QmlDiagnostic()
+      : line(0)
+      , column(0)
+    {
+    }
+
+    QmlDiagnostic(const QmlToken &token, const QString &diagnosticMessage)
+      : line(token.line)
+      , column(token.column)
+      , message(diagnosticMessage)
+    {
+    }
+
+    int line;
+    int column;
+    QString message;
+};
+
+typedef QList<QmlDiagnostic> QmlDiagnostics;
+
+// Right hand side of a binding
+struct QmlValue
+{
+    enum Kind {
+      // tokens of a single JavaScript expression
+      Expression,
+      // tokens of a JavaScript block, including the braces
+      Block,
+      Object,
+      List
+    };
+
+    QmlValue()
+      : kind(Expression)
+    {
+    }
+
+    Kind kind;
+    QmlTokens tokens;
+    QmlObjectPtr object;
+    QList<QmlValue> elements;
+};
+
+struct QmlBinding
+{
+    // more than one part for grouped and attached properties
+    QStringList name;
+    QmlToken location;
+    QmlValue value;
+};
+
+struct QmlObject
+{
+    QString typeName;
+    QString id;
+    QmlToken location;
+    QList<QmlBinding> bindings;
+    QList<QmlObjectPtr> children;
+};
+
+struct QmlDocument
+{
+    QStringList imports;
+    QmlObjectPtr root;
+};
+
+// Parses the declarative part of QML: imports, the object tree, ids and
+// property bindings. Property, signal and function declarations are
+// skipped and reported, the generator decides about everything else
+class QmlParser
+{
+  public:
+    explicit QmlParser(const QString &source);
+
+    // returns a document without root on syntax errors
+    QmlDocument parse();
+
+    QString errorString() const;
+
+    // constructs the parser skipped
+    QmlDiagnostics diagnostics() const;
+
+  private:
+    const QString m_source;
+    QmlTokens m_tokens;
+    int m_index;
+    QString m_errorString;
+    QmlDiagnostics m_diagnostics;
+
+  private:
+    const QmlToken &current() const;
+    const QmlToken &peek(int offset = 1) const;
+    bool atEnd() const;
+    bool expect(const char *punctuator);
+    void setError(const QmlToken &token, const QString &message);
+
+    QmlObjectPtr parseObject(const QString &typeName, const QmlToken &location);
+    bool parseMember(QmlObject *object);
+    bool parseValue(QmlValue *value);
+    bool parseList(QmlValue *value);
+    bool parseExpression(QmlTokens *tokens, bool inList);
+    bool parseBlock(QmlTokens *tokens);
+    bool parseQualifiedName(QStringList *name);
+    bool skipDeclaration(const QString &kind);
+    bool skipFunction();
+    bool isObjectValue() const;
+
+    static bool isObjectTypeName(const QStringList &name);
+    static bool continuesExpression(const QmlToken &previous, const QmlToken &next);
+};
+
+#endif // QMLPARSER_H
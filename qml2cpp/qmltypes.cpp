@@ -0,0 +1,231 @@
+/*
+  qmltypes.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "qmltypes.h"
+
+#include <QAbstractItemView>
+#include <QAction>
+#include <QButtonGroup>
+#include <QCalendarWidget>
+#include <QCheckBox>
+#include <QColumnView>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QDateEdit>
+#include <QDateTimeEdit>
+#include <QDial>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDoubleSpinBox>
+#include <QFileSystemModel>
+#include <QFormLayout>
+#include <QFrame>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QLCDNumber>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QMainWindow>
+#include <QMenu>
+#include <QMenuBar>
+#include <QPlainTextEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QStackedLayout>
+#include <QStackedWidget>
+#include <QStatusBar>
+#include <QStringListModel>
+#include <QTabWidget>
+#include <QTableView>
+#include <QTextBrowser>
+#include <QTextEdit>
+#include <QTimeEdit>
+#include <QTimer>
+#include <QToolBar>
+#include <QToolButton>
+#include <QTreeView>
+#include <QVBoxLayout>
+#include <QWidget>
+
+#include <algorithm>
+#include <cstddef>
+
+// sorted by QML name for the binary search in find()
+static const QmlTypes::Type s_types[] = {
+  { "Action", QmlTypes::ActionType, &QAction::staticMetaObject },
+  { "ButtonGroup", QmlTypes::ObjectType, &QButtonGroup::staticMetaObject },
+  { "CalendarWidget", QmlTypes::WidgetType, &QCalendarWidget::staticMetaObject },
+  { "CheckBox", QmlTypes::WidgetType, &QCheckBox::staticMetaObject },
+  { "ColumnView", QmlTypes::WidgetType, &QColumnView::staticMetaObject },
+  { "ComboBox", QmlTypes::WidgetType, &QComboBox::staticMetaObject },
+  { "CommandLinkButton", QmlTypes::WidgetType, &QCommandLinkButton::staticMetaObject },
+  { "DateEdit", QmlTypes::WidgetType, &QDateEdit::staticMetaObject },
+  { "DateTimeEdit", QmlTypes::WidgetType, &QDateTimeEdit::staticMetaObject },
+  { "Dial", QmlTypes::WidgetType, &QDial::staticMetaObject },
+  { "Dialog", QmlTypes::WidgetType, &QDialog::staticMetaObject },
+  { "DialogButtonBox", QmlTypes::WidgetType, &QDialogButtonBox::staticMetaObject },
+  { "DoubleSpinBox", QmlTypes::WidgetType, &QDoubleSpinBox::staticMetaObject },
+  { "FileSystemModel", QmlTypes::ObjectType, &QFileSystemModel::staticMetaObject },
+  { "FormLayout", QmlTypes::LayoutType, &QFormLayout::staticMetaObject },
+  { "Frame", QmlTypes::WidgetType, &QFrame::staticMetaObject },
+  { "GridLayout", QmlTypes::LayoutType, &QGridLayout::staticMetaObject },
+  { "GroupBox", QmlTypes::WidgetType, &QGroupBox::staticMetaObject },
+  { "HBoxLayout", QmlTypes::LayoutType, &QHBoxLayout::staticMetaObject },
+  { "LCDNumber", QmlTypes::WidgetType, &QLCDNumber::staticMetaObject },
+  { "Label", QmlTypes::WidgetType, &QLabel::staticMetaObject },
+  { "LineEdit", QmlTypes::WidgetType, &QLineEdit::staticMetaObject },
+  { "ListView", QmlTypes::WidgetType, &QListView::staticMetaObject },
+  { "MainWindow", QmlTypes::WidgetType, &QMainWindow::staticMetaObject },
+  { "Menu", QmlTypes::WidgetType, &QMenu::staticMetaObject },
+  { "MenuBar", QmlTypes::WidgetType, &QMenuBar::staticMetaObject },
+  { "PlainTextEdit", QmlTypes::WidgetType, &QPlainTextEdit::staticMetaObject },
+  { "ProgressBar", QmlTypes::WidgetType, &QProgressBar::staticMetaObject },
+  { "PushButton", QmlTypes::WidgetType, &QPushButton::staticMetaObject },
+  { "RadioButton", QmlTypes::WidgetType, &QRadioButton::staticMetaObject },
+  { "ScrollArea", QmlTypes::WidgetType, &QScrollArea::staticMetaObject },
+  { "ScrollBar", QmlTypes::WidgetType, &QScrollBar::staticMetaObject },
+  { "Separator", QmlTypes::SeparatorType, &QAction::staticMetaObject },
+  { "Slider", QmlTypes::WidgetType, &QSlider::staticMetaObject },
+  { "Spacer", QmlTypes::SpacerType, 0 },
+  { "SpinBox", QmlTypes::WidgetType, &QSpinBox::staticMetaObject },
+  { "StackedLayout", QmlTypes::LayoutType, &QStackedLayout::staticMetaObject },
+  { "StackedWidget", QmlTypes::WidgetType, &QStackedWidget::staticMetaObject },
+  { "StatusBar", QmlTypes::WidgetType, &QStatusBar::staticMetaObject },
+  { "StringListModel", QmlTypes::ObjectType, &QStringListModel::staticMetaObject },
+  { "TabWidget", QmlTypes::WidgetType, &QTabWidget::staticMetaObject },
+  { "TableView", QmlTypes::WidgetType, &QTableView::staticMetaObject },
+  { "TextBrowser", QmlTypes::WidgetType, &QTextBrowser::staticMetaObject },
+  { "TextEdit", QmlTypes::WidgetType, &QTextEdit::staticMetaObject },
+  { "TimeEdit", QmlTypes::WidgetType, &QTimeEdit::staticMetaObject },
+  { "Timer", QmlTypes::ObjectType, &QTimer::staticMetaObject },
+  { "ToolBar", QmlTypes::WidgetType, &QToolBar::staticMetaObject },
+  { "ToolButton", QmlTypes::WidgetType, &QToolButton::staticMetaObject },
+  { "TreeView", QmlTypes::WidgetType, &QTreeView::staticMetaObject },
+  { "VBoxLayout", QmlTypes::LayoutType, &QVBoxLayout::staticMetaObject },
+  { "Widget", QmlTypes::WidgetType, &QWidget::staticMetaObject }
+};
+
+static const QmlTypes::ExtensionProperty s_extensionProperties[] = {
+  { &QAbstractItemView::staticMetaObject, "model", "setModel", "model", "QAbstractItemModel*" },
+  { &QAbstractItemView::staticMetaObject, "selectionModel", "setSelectionModel", "selectionModel", "QItemSelectionModel*" },
+  { &QComboBox::staticMetaObject, "model", "setModel", "model", "QAbstractItemModel*" },
+  { &QFileSystemModel::staticMetaObject, "nameFilters", "setNameFilters", "nameFilters", "QStringList" },
+  { &QFileSystemModel::staticMetaObject, "rootPath", "setRootPath", "rootPath", "QString" },
+  { &QLabel::staticMetaObject, "buddy", "setBuddy", "buddy", "QWidget*" },
+  { &QStringListModel::staticMetaObject, "stringList", "setStringList", "stringList", "QStringList" }
+};
+
+struct SetterException
+{
+    const QMetaObject *metaObject;
+    const char *propertyName;
+    const char *setter;
+};
+
+static const SetterException s_setterExceptions[] = {
+  { &QLCDNumber::staticMetaObject, "intValue", "display" },
+  { &QLCDNumber::staticMetaObject, "value", "display" },
+  { &QWidget::staticMetaObject, "pos", "move" },
+  { &QWidget::staticMetaObject, "size", "resize" }
+};
+
+template <typename T, std::size_t N>
+static std::size_t tableSize(const T (&)[N])
+{
+  return N;
+}
+
+static bool typeLessThan(const QmlTypes::Type &type, const QByteArray &qmlName)
+{
+  return qstrcmp(type.qmlName, qmlName.constData()) < 0;
+}
+
+const QmlTypes::Type *QmlTypes::find(const QString &qmlName)
+{
+  const QByteArray name = qmlName.toLatin1();
+
+  const Type *end = s_types + tableSize(s_types);
+  const Type *it = std::lower_bound(s_types, end, name, typeLessThan);
+  if (it == end || name != it->qmlName) {
+    return 0;
+  }
+
+  return it;
+}
+
+QString QmlTypes::className(const Type *type)
+{
+  if (type->metaObject == 0) {
+    return QLatin1String("QSpacerItem");
+  }
+
+  return QLatin1String(type->metaObject->className());
+}
+
+const QmlTypes::ExtensionProperty *QmlTypes::findExtensionProperty(const QMetaObject *metaObject, const QString &name)
+{
+  for (std::size_t i = 0; i < tableSize(s_extensionProperties); ++i) {
+    const ExtensionProperty &property = s_extensionProperties[i];
+    if (name == QLatin1String(property.name) && inherits(metaObject, property.metaObject)) {
+      return &property;
+    }
+  }
+
+  return 0;
+}
+
+QString QmlTypes::setterName(const QMetaObject *metaObject, const QString &propertyName)
+{
+  for (std::size_t i = 0; i < tableSize(s_setterExceptions); ++i) {
+    const SetterException &exception = s_setterExceptions[i];
+    if (propertyName == QLatin1String(exception.propertyName) && inherits(metaObject, exception.metaObject)) {
+      return QLatin1String(exception.setter);
+    }
+  }
+
+  QString setter = QLatin1String("set") + propertyName;
+  setter[3] = setter[3].toUpper();
+
+  return setter;
+}
+
+bool QmlTypes::inherits(const QMetaObject *metaObject, const QMetaObject *base)
+{
+  for (; metaObject != 0; metaObject = metaObject->superClass()) {
+    if (metaObject == base) {
+      return true;
+    }
+  }
+
+  return false;
+}
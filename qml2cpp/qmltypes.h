@@ -0,0 +1,80 @@
+/*
+  qmltypes.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QMLTYPES_H
+#define QMLTYPES_H
+
+#include <QString>
+
+struct QMetaObject;
+
+// The QtWidgets module types qml2cpp can compile, mapped to the plain Qt
+// classes the DeclarativeWidgets types are based on. All information comes
+// from the static meta objects, no instances are created
+class QmlTypes
+{
+  public:
+    enum Kind {
+      ObjectType,
+      WidgetType,
+      LayoutType,
+      ActionType,
+      SeparatorType,
+      SpacerType
+    };
+
+    struct Type
+    {
+        const char *qmlName;
+        Kind kind;
+        // 0 for spacers, which are not QObjects
+        const QMetaObject *metaObject;
+    };
+
+    // properties added by the DeclarativeWidgets extension objects
+    struct ExtensionProperty
+    {
+        const QMetaObject *metaObject;
+        const char *name;
+        const char *setter;
+        const char *getter;
+        const char *typeName;
+    };
+
+    // returns 0 for types that cannot be compiled
+    static const Type *find(const QString &qmlName);
+
+    static QString className(const Type *type);
+
+    static const ExtensionProperty *findExtensionProperty(const QMetaObject *metaObject, const QString &name);
+
+    // the write function of a Q_PROPERTY, most follow the setFoo() convention
+    static QString setterName(const QMetaObject *metaObject, const QString &propertyName);
+
+    static bool inherits(const QMetaObject *metaObject, const QMetaObject *base);
+};
+
+#endif // QMLTYPES_H
@@ -2,5 +2,11 @@ TEMPLATE = subdirs
 
 SUBDIRS = \
     quickwidget \
+    comboboxextension \
     instantiatetypes \
-    layouts
+    itemviews \
+    layouts \
+    pixmapcache \
+    repeater \
+    syntaxhighlighter \
+    ui2dw
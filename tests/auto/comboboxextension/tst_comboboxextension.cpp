@@ -0,0 +1,223 @@
+/*
+  tst_comboboxextension.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QAbstractProxyModel>
+#include <QComboBox>
+#include <QCompleter>
+#include <QStringListModel>
+
+#include "declarativecomboboxextension_p.h"
+
+// more than the extension updates incrementally, see s_incrementalUpdateLimit
+static const int s_largeChange = 200;
+
+class tst_ComboBoxExtension : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+    void swapModels();
+    void insertAndRemoveRows();
+    void changeData();
+
+private:
+    QComboBox *m_comboBox;
+    DeclarativeComboBoxExtension *m_extension;
+
+    static QStringList words(int count, const QString &prefix);
+    void verifyIndex(QAbstractItemModel *model);
+};
+
+void tst_ComboBoxExtension::init()
+{
+    m_comboBox = new QComboBox;
+    m_comboBox->setEditable(true);
+
+    // what qmlRegisterExtendedType() does, the extension is a child of the extended object
+    m_extension = new DeclarativeComboBoxExtension(m_comboBox);
+    m_extension->setLargeModel(true);
+}
+
+void tst_ComboBoxExtension::cleanup()
+{
+    delete m_comboBox;
+}
+
+// unsorted, in mixed case
+QStringList tst_ComboBoxExtension::words(int count, const QString &prefix)
+{
+    QStringList result;
+    for (int i = 0; i < count; ++i) {
+        const int number = (i * 7919) % count;
+        result << (number % 2 == 0 ? prefix : prefix.toUpper()) + QString::number(number);
+    }
+
+    return result;
+}
+
+void tst_ComboBoxExtension::verifyIndex(QAbstractItemModel *model)
+{
+    QCompleter *completer = m_comboBox->completer();
+    QVERIFY(completer != nullptr);
+    QCOMPARE(completer->modelSorting(), QCompleter::CaseInsensitivelySortedModel);
+
+    // the completer searches the sorted index, never the combobox model itself
+    QAbstractProxyModel *index = qobject_cast<QAbstractProxyModel*>(completer->model());
+    QVERIFY(index != nullptr);
+    QCOMPARE(index->sourceModel(), model);
+    QCOMPARE(index->rowCount(), model->rowCount());
+
+    for (int row = 1; row < index->rowCount(); ++row) {
+        const QString previous = index->index(row - 1, 0).data().toString();
+        const QString current = index->index(row, 0).data().toString();
+        QVERIFY2(QString::compare(previous, current, Qt::CaseInsensitive) <= 0,
+                 qPrintable(QStringLiteral("row %1: \"%2\" after \"%3\"").arg(row).arg(current, previous)));
+    }
+
+    for (int row = 0; row < model->rowCount(); ++row) {
+        const QModelIndex sourceIndex = model->index(row, 0);
+        const QModelIndex proxyIndex = index->mapFromSource(sourceIndex);
+        QVERIFY(proxyIndex.isValid());
+        QCOMPARE(index->mapToSource(proxyIndex), sourceIndex);
+    }
+}
+
+void tst_ComboBoxExtension::swapModels()
+{
+    QStringListModel *first = new QStringListModel(words(500, QStringLiteral("first")), m_comboBox);
+    m_extension->setModel(first);
+    QTRY_VERIFY(!m_extension->isIndexing());
+
+    verifyIndex(first);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 0);
+    QCOMPARE(m_comboBox->currentText(), first->stringList().at(0));
+
+    m_comboBox->setCurrentIndex(42);
+    QCOMPARE(m_comboBox->currentText(), first->stringList().at(42));
+
+    QStringListModel *second = new QStringListModel(words(300, QStringLiteral("second")), m_comboBox);
+    m_extension->setModel(second);
+    QCOMPARE(m_extension->model(), static_cast<QAbstractItemModel*>(second));
+    QTRY_VERIFY(!m_extension->isIndexing());
+
+    verifyIndex(second);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 0);
+    QCOMPARE(m_comboBox->currentText(), second->stringList().at(0));
+
+    // completion finds the first match in the sorted index
+    QCompleter *completer = m_comboBox->completer();
+    completer->setCompletionPrefix(QStringLiteral("second1"));
+    QCOMPARE(completer->currentCompletion(), QStringLiteral("SECOND1"));
+
+    completer->setCompletionPrefix(QStringLiteral("first"));
+    QVERIFY(completer->currentCompletion().isEmpty());
+}
+
+void tst_ComboBoxExtension::insertAndRemoveRows()
+{
+    QStringListModel *model = new QStringListModel(words(500, QStringLiteral("item")), m_comboBox);
+    m_extension->setModel(model);
+    QTRY_VERIFY(!m_extension->isIndexing());
+
+    m_comboBox->setCurrentIndex(100);
+    const QString currentText = m_comboBox->currentText();
+
+    // a few rows are sorted into the existing index
+    QVERIFY(model->insertRows(50, 3));
+    QVERIFY(!m_extension->isIndexing());
+    verifyIndex(model);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 103);
+    QCOMPARE(m_comboBox->currentText(), currentText);
+
+    QVERIFY(model->removeRows(10, 5));
+    QVERIFY(!m_extension->isIndexing());
+    verifyIndex(model);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 98);
+    QCOMPARE(m_comboBox->currentText(), currentText);
+
+    // many rows at once rebuild the index
+    QVERIFY(model->insertRows(0, s_largeChange));
+    QTRY_VERIFY(!m_extension->isIndexing());
+    verifyIndex(model);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 98 + s_largeChange);
+    QCOMPARE(m_comboBox->currentText(), currentText);
+
+    QVERIFY(model->removeRows(0, s_largeChange));
+    QVERIFY(m_extension->isIndexing());
+    QTRY_VERIFY(!m_extension->isIndexing());
+    verifyIndex(model);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(m_comboBox->currentIndex(), 98);
+    QCOMPARE(m_comboBox->currentText(), currentText);
+}
+
+void tst_ComboBoxExtension::changeData()
+{
+    QStringListModel *model = new QStringListModel(words(500, QStringLiteral("item")), m_comboBox);
+    m_extension->setModel(model);
+    QTRY_VERIFY(!m_extension->isIndexing());
+
+    QVERIFY(model->setData(model->index(250, 0), QStringLiteral("AAA")));
+    QVERIFY(model->setData(model->index(5, 0), QStringLiteral("zzz")));
+    QVERIFY(!m_extension->isIndexing());
+
+    verifyIndex(model);
+    if (QTest::currentTestFailed())
+        return;
+
+    QAbstractProxyModel *index = qobject_cast<QAbstractProxyModel*>(m_comboBox->completer()->model());
+    QCOMPARE(index->mapFromSource(model->index(250, 0)).row(), 0);
+    QCOMPARE(index->mapFromSource(model->index(5, 0)).row(), model->rowCount() - 1);
+
+    QCompleter *completer = m_comboBox->completer();
+    completer->setCompletionPrefix(QStringLiteral("aa"));
+    QCOMPARE(completer->currentCompletion(), QStringLiteral("AAA"));
+}
+
+QTEST_MAIN(tst_ComboBoxExtension)
+
+#include "tst_comboboxextension.moc"
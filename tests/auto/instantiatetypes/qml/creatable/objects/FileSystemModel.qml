@@ -28,5 +28,8 @@
 import QtWidgets 1.0
 
 FileSystemModel {
-
+  nameFilters: [ "*.qml" ]
+  resolveSymlinks: false
+  populationBatchSize: 100
+  populationInterval: 20
 }
@@ -28,5 +28,6 @@
 import QtWidgets 1.0
 
 ComboBox {
-
+  editable: true
+  largeModel: true
 }
@@ -28,5 +28,7 @@
 import QtWidgets 1.0
 
 TableView {
-
+  sampledResizeColumnsToContents: true
+  sampledResizeRowsToContents: true
+  sampleSize: 50
 }
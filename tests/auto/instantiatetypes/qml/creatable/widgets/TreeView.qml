@@ -28,5 +28,5 @@
 import QtWidgets 1.0
 
 TreeView {
-
+  sampledResizeColumnsToContents: true
 }
@@ -0,0 +1,222 @@
+/*
+  tst_itemviews.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QHeaderView>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QStandardItemModel>
+#include <QTableView>
+#include <QTreeView>
+
+static const int s_rowCount = 1000;
+
+// only reached by refinement, the initial sample covers the first rows
+static const int s_wideRow = 900;
+static const int s_tallRow = 5;
+
+static const QSize s_itemSize(80, 20);
+static const QSize s_wideItemSize(400, 20);
+static const QSize s_tallItemSize(150, 30);
+
+// too many rows to query every vertical header section
+static const int s_largeRowCount = 100000;
+
+class HeaderCountingModel : public QAbstractTableModel
+{
+public:
+    explicit HeaderCountingModel(QObject *parent = nullptr)
+        : QAbstractTableModel(parent)
+        , verticalHeaderDataCalls(0)
+    {
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const
+    {
+        return parent.isValid() ? 0 : s_largeRowCount;
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const
+    {
+        return parent.isValid() ? 0 : 2;
+    }
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const
+    {
+        if (role == Qt::DisplayRole)
+            return QStringLiteral("%1,%2").arg(index.row()).arg(index.column());
+        if (role == Qt::SizeHintRole)
+            return s_itemSize;
+
+        return QVariant();
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const
+    {
+        if (orientation == Qt::Vertical)
+            ++verticalHeaderDataCalls;
+
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+    mutable int verticalHeaderDataCalls;
+};
+
+class tst_ItemViews : public QObject
+{
+    Q_OBJECT
+public:
+    tst_ItemViews();
+
+private slots:
+    void initTestCase();
+    void init();
+    void tableViewSampledResize();
+    void tableViewWithoutSampling();
+    void tableViewSampledRowsBounded();
+    void treeViewSampledResize();
+
+private:
+    QQmlEngine *m_qmlEngine;
+    QStandardItemModel *m_model;
+    HeaderCountingModel *m_headerCountingModel;
+
+    template <typename T>
+    QSharedPointer<T> createView(const QString &fileName);
+};
+
+tst_ItemViews::tst_ItemViews()
+    : QObject()
+    , m_qmlEngine(new QQmlEngine(this))
+    , m_model(new QStandardItemModel(this))
+    , m_headerCountingModel(new HeaderCountingModel(this))
+{
+}
+
+void tst_ItemViews::initTestCase()
+{
+    // Add extensionplugin import path
+    const QString importPath = QStringLiteral("%1/../../../qml")
+            .arg(QCoreApplication::applicationDirPath());
+    QVERIFY2(QFileInfo::exists(importPath),
+             qPrintable(QStringLiteral("Extensionplugin import path does not exist: %1")
+                        .arg(importPath)));
+    m_qmlEngine->addImportPath(importPath);
+    m_qmlEngine->rootContext()->setContextProperty(QStringLiteral("sizeHintModel"), m_model);
+    m_qmlEngine->rootContext()->setContextProperty(QStringLiteral("headerCountingModel"), m_headerCountingModel);
+}
+
+void tst_ItemViews::init()
+{
+    // the delegates report the size hint role as their size hint
+    m_model->clear();
+    m_model->setColumnCount(2);
+    for (int row = 0; row < s_rowCount; ++row) {
+        QList<QStandardItem*> items;
+        for (int column = 0; column < 2; ++column) {
+            QStandardItem *item = new QStandardItem(QStringLiteral("%1,%2").arg(row).arg(column));
+            item->setSizeHint(s_itemSize);
+            items << item;
+        }
+        m_model->appendRow(items);
+    }
+
+    m_model->item(s_wideRow, 0)->setSizeHint(s_wideItemSize);
+    m_model->item(s_tallRow, 1)->setSizeHint(s_tallItemSize);
+}
+
+void tst_ItemViews::tableViewSampledResize()
+{
+    QSharedPointer<QTableView> view = createView<QTableView>(QStringLiteral("qrc:/qml/SampledTableViewTest.qml"));
+    QVERIFY(view != nullptr);
+
+    // the grid takes one pixel
+    QHeaderView *horizontalHeader = view->horizontalHeader();
+    QCOMPARE(horizontalHeader->sectionSize(0), s_itemSize.width() + 1);
+    QCOMPARE(horizontalHeader->sectionSize(1), s_tallItemSize.width() + 1);
+    QCOMPARE(view->verticalHeader()->defaultSectionSize(), s_tallItemSize.height() + 1);
+
+    QTRY_COMPARE(horizontalHeader->sectionSize(0), s_wideItemSize.width() + 1);
+    QCOMPARE(horizontalHeader->sectionSize(1), s_tallItemSize.width() + 1);
+
+    // sizes grow with changed contents
+    m_model->item(1, 1)->setSizeHint(QSize(200, 20));
+    QCOMPARE(horizontalHeader->sectionSize(1), 201);
+}
+
+void tst_ItemViews::tableViewWithoutSampling()
+{
+    QSharedPointer<QTableView> view = createView<QTableView>(QStringLiteral("qrc:/qml/TableViewTest.qml"));
+    QVERIFY(view != nullptr);
+
+    QHeaderView *horizontalHeader = view->horizontalHeader();
+    const int defaultSize = horizontalHeader->defaultSectionSize();
+
+    QCoreApplication::processEvents();
+
+    QCOMPARE(horizontalHeader->sectionSize(0), defaultSize);
+    QCOMPARE(horizontalHeader->sectionSize(1), defaultSize);
+}
+
+void tst_ItemViews::tableViewSampledRowsBounded()
+{
+    m_headerCountingModel->verticalHeaderDataCalls = 0;
+
+    QSharedPointer<QTableView> view = createView<QTableView>(QStringLiteral("qrc:/qml/SampledRowsTableViewTest.qml"));
+    QVERIFY(view != nullptr);
+
+    QHeaderView *verticalHeader = view->verticalHeader();
+    QCOMPARE(verticalHeader->defaultSectionSize(), qMax(verticalHeader->minimumSectionSize(), s_itemSize.height() + 1));
+
+    // rows are sampled, the vertical header is not asked for a size hint per row
+    QVERIFY2(m_headerCountingModel->verticalHeaderDataCalls < 1000,
+             qPrintable(QString::number(m_headerCountingModel->verticalHeaderDataCalls)));
+}
+
+void tst_ItemViews::treeViewSampledResize()
+{
+    QSharedPointer<QTreeView> view = createView<QTreeView>(QStringLiteral("qrc:/qml/SampledTreeViewTest.qml"));
+    QVERIFY(view != nullptr);
+
+    // the last section stretches, the first one includes the root decoration
+    QHeaderView *header = view->header();
+    QCOMPARE(header->sectionSize(0), s_itemSize.width() + view->indentation());
+
+    QTRY_COMPARE(header->sectionSize(0), s_wideItemSize.width() + view->indentation());
+}
+
+template <typename T>
+QSharedPointer<T> tst_ItemViews::createView(const QString &fileName)
+{
+    QQmlComponent component(m_qmlEngine, QUrl(fileName));
+    return QSharedPointer<T>(qobject_cast<T*>(component.create()));
+}
+
+QTEST_MAIN(tst_ItemViews)
+
+#include "tst_itemviews.moc"
@@ -0,0 +1,308 @@
+/*
+  tst_pixmapcache.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QColor>
+#include <QImage>
+#include <QPixmap>
+#include <QTemporaryDir>
+
+#include "declarativepreloader_p.h"
+#include "pixmapcache_p.h"
+
+// 64x64 ARGB32 images, each costs 16 kilobytes in the cache
+static const int s_imageSize = 64;
+static const int s_imageCost = s_imageSize * s_imageSize * 4 / 1024;
+
+class tst_PixmapCache : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+    void hitsAndMisses();
+    void eviction();
+    void deduplication();
+    void sizeOnlyCaps_data();
+    void sizeOnlyCaps();
+    void pixmapWaitsForPendingLoad();
+    void preloaderProgress();
+    void preloaderCachedSources();
+
+private:
+    QTemporaryDir m_dir;
+    int m_defaultLimit;
+
+    QString imagePath(const QString &name) const;
+};
+
+void tst_PixmapCache::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    const QVector<QPair<QString, QColor> > images = QVector<QPair<QString, QColor> >()
+            << qMakePair(QStringLiteral("red"), QColor(Qt::red))
+            << qMakePair(QStringLiteral("red-copy"), QColor(Qt::red))
+            << qMakePair(QStringLiteral("green"), QColor(Qt::green))
+            << qMakePair(QStringLiteral("blue"), QColor(Qt::blue));
+
+    for (const auto &entry : images) {
+        QImage image(s_imageSize, s_imageSize, QImage::Format_ARGB32);
+        image.fill(entry.second);
+        QVERIFY(image.save(imagePath(entry.first)));
+    }
+
+    m_defaultLimit = PixmapCache::instance()->cacheLimit();
+}
+
+void tst_PixmapCache::init()
+{
+    PixmapCache::instance()->clear();
+}
+
+void tst_PixmapCache::cleanup()
+{
+    PixmapCache::instance()->setCacheLimit(m_defaultLimit);
+}
+
+QString tst_PixmapCache::imagePath(const QString &name) const
+{
+    return m_dir.filePath(name + QStringLiteral(".png"));
+}
+
+void tst_PixmapCache::hitsAndMisses()
+{
+    PixmapCache *cache = PixmapCache::instance();
+    const QString red = imagePath(QStringLiteral("red"));
+
+    QVERIFY(!cache->pixmap(red).isNull());
+    QCOMPARE(cache->misses(), 1);
+    QCOMPARE(cache->hits(), 0);
+    QCOMPARE(cache->count(), 1);
+
+    QVERIFY(!cache->pixmap(red).isNull());
+    QCOMPARE(cache->misses(), 1);
+    QCOMPARE(cache->hits(), 1);
+
+    // a cached entry is returned by load() right away and counts as a hit
+    QVERIFY(!cache->load(red).isNull());
+    QCOMPARE(cache->hits(), 2);
+
+    // find() does not count towards the statistics
+    QVERIFY(!cache->find(PixmapCache::cacheKey(red, QSize(), 1.0)).isNull());
+    QVERIFY(cache->find(PixmapCache::cacheKey(imagePath(QStringLiteral("green")), QSize(), 1.0)).isNull());
+    QCOMPARE(cache->hits(), 2);
+    QCOMPARE(cache->misses(), 1);
+    QCOMPARE(cache->hitRate(), 2.0 / 3.0);
+
+    // a missing file is a miss that does not add an entry
+    QVERIFY(cache->pixmap(imagePath(QStringLiteral("missing"))).isNull());
+    QCOMPARE(cache->misses(), 2);
+    QCOMPARE(cache->count(), 1);
+
+    cache->clear();
+    QCOMPARE(cache->hits(), 0);
+    QCOMPARE(cache->misses(), 0);
+    QCOMPARE(cache->count(), 0);
+}
+
+void tst_PixmapCache::eviction()
+{
+    PixmapCache *cache = PixmapCache::instance();
+    cache->setCacheLimit(2 * s_imageCost + s_imageCost / 2);
+
+    const QString red = imagePath(QStringLiteral("red"));
+    const QString green = imagePath(QStringLiteral("green"));
+    const QString blue = imagePath(QStringLiteral("blue"));
+
+    QVERIFY(!cache->pixmap(red).isNull());
+    QVERIFY(!cache->pixmap(green).isNull());
+    QCOMPARE(cache->count(), 2);
+    QCOMPARE(cache->totalBytes(), qint64(2 * s_imageCost) * 1024);
+
+    // touching red makes green the least recently used entry
+    QVERIFY(!cache->pixmap(red).isNull());
+    QVERIFY(!cache->pixmap(blue).isNull());
+
+    QCOMPARE(cache->count(), 2);
+    QVERIFY(cache->totalBytes() <= qint64(cache->cacheLimit()) * 1024);
+    QVERIFY(!cache->find(PixmapCache::cacheKey(red, QSize(), 1.0)).isNull());
+    QVERIFY(cache->find(PixmapCache::cacheKey(green, QSize(), 1.0)).isNull());
+    QVERIFY(!cache->find(PixmapCache::cacheKey(blue, QSize(), 1.0)).isNull());
+
+    // an evicted entry is decoded again
+    const int misses = cache->misses();
+    QVERIFY(!cache->pixmap(green).isNull());
+    QCOMPARE(cache->misses(), misses + 1);
+
+    // entries larger than the whole limit are not kept, the caller still gets the pixmap
+    cache->setCacheLimit(s_imageCost / 2);
+    QCOMPARE(cache->count(), 0);
+    QVERIFY(!cache->pixmap(red).isNull());
+    QCOMPARE(cache->count(), 0);
+}
+
+void tst_PixmapCache::deduplication()
+{
+    PixmapCache *cache = PixmapCache::instance();
+
+    const QPixmap red = cache->pixmap(imagePath(QStringLiteral("red")));
+    const QPixmap copy = cache->pixmap(imagePath(QStringLiteral("red-copy")));
+    const QPixmap green = cache->pixmap(imagePath(QStringLiteral("green")));
+
+    QCOMPARE(cache->count(), 3);
+    QCOMPARE(cache->deduplicated(), 1);
+    QCOMPARE(copy.cacheKey(), red.cacheKey());
+    QVERIFY(green.cacheKey() != red.cacheKey());
+}
+
+void tst_PixmapCache::sizeOnlyCaps_data()
+{
+    QTest::addColumn<QSize>("size");
+    QTest::addColumn<qreal>("devicePixelRatio");
+    QTest::addColumn<QSize>("expectedSize");
+    QTest::addColumn<qreal>("expectedRatio");
+
+    QTest::newRow("scaled down") << QSize(16, 16) << qreal(2.0) << QSize(32, 32) << qreal(2.0);
+    QTest::newRow("at size") << QSize(32, 32) << qreal(2.0) << QSize(64, 64) << qreal(2.0);
+    QTest::newRow("between size and ratio") << QSize(48, 48) << qreal(2.0) << QSize(64, 64) << qreal(64.0 / 48.0);
+    QTest::newRow("smaller than size") << QSize(128, 128) << qreal(2.0) << QSize(64, 64) << qreal(1.0);
+    QTest::newRow("smaller than fractional size") << QSize(96, 96) << qreal(1.5) << QSize(64, 64) << qreal(1.0);
+}
+
+void tst_PixmapCache::sizeOnlyCaps()
+{
+    QFETCH(QSize, size);
+    QFETCH(qreal, devicePixelRatio);
+    QFETCH(QSize, expectedSize);
+    QFETCH(qreal, expectedRatio);
+
+    // never shown larger than the requested size, nor smaller than without a size
+    const QPixmap pixmap = PixmapCache::instance()->pixmap(imagePath(QStringLiteral("red")), size, devicePixelRatio);
+    QCOMPARE(pixmap.size(), expectedSize);
+    QCOMPARE(pixmap.devicePixelRatio(), expectedRatio);
+
+    const QSizeF logicalSize = QSizeF(pixmap.size()) / pixmap.devicePixelRatio();
+    QVERIFY(logicalSize.width() <= size.width());
+    QVERIFY(logicalSize.width() >= qMin<qreal>(size.width(), s_imageSize));
+}
+
+void tst_PixmapCache::pixmapWaitsForPendingLoad()
+{
+    PixmapCache *cache = PixmapCache::instance();
+    QSignalSpy loadedSpy(cache, SIGNAL(pixmapLoaded(QString,QPixmap)));
+
+    const QString blue = imagePath(QStringLiteral("blue"));
+    const QString key = PixmapCache::cacheKey(blue, QSize(), 1.0);
+
+    QVERIFY(cache->load(blue).isNull());
+    QCOMPARE(cache->misses(), 1);
+
+    // the synchronous request finishes the pending load instead of decoding a second time
+    const QPixmap pixmap = cache->pixmap(blue);
+    QVERIFY(!pixmap.isNull());
+    QCOMPARE(pixmap.size(), QSize(s_imageSize, s_imageSize));
+    QCOMPARE(cache->misses(), 2);
+    QCOMPARE(cache->count(), 1);
+
+    QCOMPARE(loadedSpy.count(), 1);
+    QCOMPARE(loadedSpy.at(0).at(0).toString(), key);
+    QCOMPARE(loadedSpy.at(0).at(1).value<QPixmap>().cacheKey(), pixmap.cacheKey());
+
+    // the watcher's own finished() notification must not report the key again
+    QTest::qWait(100);
+    QCOMPARE(loadedSpy.count(), 1);
+    QCOMPARE(cache->find(key).cacheKey(), pixmap.cacheKey());
+}
+
+void tst_PixmapCache::preloaderProgress()
+{
+    PixmapCache *cache = PixmapCache::instance();
+
+    DeclarativePreloader preloader;
+    QSignalSpy finishedSpy(&preloader, SIGNAL(finished()));
+    QSignalSpy loadingSpy(&preloader, SIGNAL(loadingChanged(bool)));
+    QSignalSpy progressSpy(&preloader, SIGNAL(progressChanged()));
+
+    // duplicates are loaded once, missing files count as failed
+    preloader.setSources(QStringList()
+                         << imagePath(QStringLiteral("red"))
+                         << imagePath(QStringLiteral("green"))
+                         << imagePath(QStringLiteral("red"))
+                         << imagePath(QStringLiteral("missing")));
+
+    QVERIFY(preloader.loading());
+    QCOMPARE(loadingSpy.count(), 1);
+    QCOMPARE(preloader.progress(), 0.0);
+    QCOMPARE(finishedSpy.count(), 0);
+
+    QTRY_COMPARE(finishedSpy.count(), 1);
+    QVERIFY(!preloader.loading());
+    QCOMPARE(loadingSpy.count(), 2);
+    QCOMPARE(preloader.loaded(), 2);
+    QCOMPARE(preloader.failed(), 1);
+    QCOMPARE(preloader.progress(), 1.0);
+
+    // the initial notification plus one per distinct source
+    QCOMPARE(progressSpy.count(), 4);
+
+    QCOMPARE(cache->count(), 2);
+    QVERIFY(!cache->find(PixmapCache::cacheKey(imagePath(QStringLiteral("green")), QSize(), 1.0)).isNull());
+
+    QTest::qWait(50);
+    QCOMPARE(finishedSpy.count(), 1);
+}
+
+void tst_PixmapCache::preloaderCachedSources()
+{
+    PixmapCache *cache = PixmapCache::instance();
+    QVERIFY(!cache->pixmap(imagePath(QStringLiteral("red"))).isNull());
+    QVERIFY(!cache->pixmap(imagePath(QStringLiteral("blue"))).isNull());
+
+    DeclarativePreloader preloader;
+    QSignalSpy finishedSpy(&preloader, SIGNAL(finished()));
+    QSignalSpy loadingSpy(&preloader, SIGNAL(loadingChanged(bool)));
+
+    // everything is a hit, so the preloader finishes without ever loading
+    preloader.setSources(QStringList()
+                         << imagePath(QStringLiteral("red"))
+                         << imagePath(QStringLiteral("blue")));
+
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(loadingSpy.count(), 0);
+    QVERIFY(!preloader.loading());
+    QCOMPARE(preloader.loaded(), 2);
+    QCOMPARE(preloader.failed(), 0);
+    QCOMPARE(preloader.progress(), 1.0);
+    QCOMPARE(cache->hits(), 2);
+}
+
+QTEST_MAIN(tst_PixmapCache)
+
+#include "tst_pixmapcache.moc"
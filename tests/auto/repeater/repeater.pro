@@ -0,0 +1,6 @@
+include("$$PWD/../auto.pri")
+
+SOURCES += tst_repeater.cpp
+
+RESOURCES += \
+    qml.qrc
@@ -0,0 +1,260 @@
+/*
+  tst_repeater.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QLabel>
+#include <QLayout>
+#include <QPointer>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QStringListModel>
+
+typedef QSharedPointer<QWidget> QWidgetPtr;
+
+// The Repeater is enclosed by a header and a footer label
+static const int s_staticItemCount = 2;
+
+class tst_Repeater : public QObject
+{
+    Q_OBJECT
+public:
+    tst_Repeater();
+
+private slots:
+    void initTestCase();
+    void init();
+    void createItems();
+    void insertRows();
+    void removeRows();
+    void moveRows_data();
+    void moveRows();
+    void moveRowsWithoutDelegate();
+
+private:
+    QQmlEngine *m_qmlEngine;
+    QStringListModel *m_model;
+
+    QWidgetPtr createWidget(const QString &fileName);
+    static QList<QWidget*> rowWidgets(QWidget *widget);
+    static void verifyLayout(QWidget *widget, const QStringList &rows);
+};
+
+tst_Repeater::tst_Repeater()
+    : QObject()
+    , m_qmlEngine(new QQmlEngine(this))
+    , m_model(new QStringListModel(this))
+{
+}
+
+void tst_Repeater::initTestCase()
+{
+    // Add extensionplugin import path
+    const QString importPath = QStringLiteral("%1/../../../qml")
+            .arg(QCoreApplication::applicationDirPath());
+    QVERIFY2(QFileInfo::exists(importPath),
+             qPrintable(QStringLiteral("Extensionplugin import path does not exist: %1")
+                        .arg(importPath)));
+    m_qmlEngine->addImportPath(importPath);
+    m_qmlEngine->rootContext()->setContextProperty(QStringLiteral("testModel"), m_model);
+}
+
+void tst_Repeater::init()
+{
+    m_model->setStringList(QStringList() << QStringLiteral("A") << QStringLiteral("B")
+                                         << QStringLiteral("C") << QStringLiteral("D"));
+}
+
+void tst_Repeater::createItems()
+{
+    QWidgetPtr widget = createWidget(QStringLiteral("qrc:/qml/RepeaterTest.qml"));
+    QVERIFY(widget != nullptr);
+
+    verifyLayout(widget.data(), m_model->stringList());
+}
+
+void tst_Repeater::insertRows()
+{
+    QWidgetPtr widget = createWidget(QStringLiteral("qrc:/qml/RepeaterTest.qml"));
+    QVERIFY(widget != nullptr);
+
+    const QList<QWidget*> before = rowWidgets(widget.data());
+    QCOMPARE(before.count(), m_model->rowCount());
+
+    QVERIFY(m_model->insertRows(1, 2));
+    m_model->setData(m_model->index(1), QStringLiteral("X"));
+    m_model->setData(m_model->index(2), QStringLiteral("Y"));
+
+    verifyLayout(widget.data(), QStringList() << QStringLiteral("A") << QStringLiteral("X") << QStringLiteral("Y")
+                                              << QStringLiteral("B") << QStringLiteral("C") << QStringLiteral("D"));
+
+    // the existing rows keep their widgets
+    const QList<QWidget*> after = rowWidgets(widget.data());
+    QCOMPARE(after.count(), 6);
+    QCOMPARE(after.at(0), before.at(0));
+    QCOMPARE(after.at(3), before.at(1));
+    QCOMPARE(after.at(4), before.at(2));
+    QCOMPARE(after.at(5), before.at(3));
+    QVERIFY(!before.contains(after.at(1)));
+    QVERIFY(!before.contains(after.at(2)));
+
+    QVERIFY(m_model->insertRows(m_model->rowCount(), 1));
+    m_model->setData(m_model->index(m_model->rowCount() - 1), QStringLiteral("Z"));
+
+    verifyLayout(widget.data(), QStringList() << QStringLiteral("A") << QStringLiteral("X") << QStringLiteral("Y")
+                                              << QStringLiteral("B") << QStringLiteral("C") << QStringLiteral("D")
+                                              << QStringLiteral("Z"));
+}
+
+void tst_Repeater::removeRows()
+{
+    QWidgetPtr widget = createWidget(QStringLiteral("qrc:/qml/RepeaterTest.qml"));
+    QVERIFY(widget != nullptr);
+
+    const QList<QWidget*> before = rowWidgets(widget.data());
+    QCOMPARE(before.count(), m_model->rowCount());
+    QPointer<QWidget> removedFirst = before.at(1);
+    QPointer<QWidget> removedSecond = before.at(2);
+
+    QVERIFY(m_model->removeRows(1, 2));
+
+    verifyLayout(widget.data(), QStringList() << QStringLiteral("A") << QStringLiteral("D"));
+
+    const QList<QWidget*> after = rowWidgets(widget.data());
+    QCOMPARE(after.count(), 2);
+    QCOMPARE(after.at(0), before.at(0));
+    QCOMPARE(after.at(1), before.at(3));
+
+    QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    QVERIFY(removedFirst.isNull());
+    QVERIFY(removedSecond.isNull());
+
+    QVERIFY(m_model->removeRows(0, m_model->rowCount()));
+
+    verifyLayout(widget.data(), QStringList());
+}
+
+void tst_Repeater::moveRows_data()
+{
+    QTest::addColumn<int>("sourceRow");
+    QTest::addColumn<int>("count");
+    QTest::addColumn<int>("destinationRow");
+    QTest::addColumn<QList<int> >("order");
+
+    QTest::newRow("first to last") << 0 << 1 << 4 << (QList<int>() << 1 << 2 << 3 << 0);
+    QTest::newRow("last to first") << 3 << 1 << 0 << (QList<int>() << 3 << 0 << 1 << 2);
+    QTest::newRow("two down") << 0 << 2 << 3 << (QList<int>() << 2 << 0 << 1 << 3);
+    QTest::newRow("two up") << 2 << 2 << 1 << (QList<int>() << 0 << 2 << 3 << 1);
+}
+
+void tst_Repeater::moveRows()
+{
+    QFETCH(int, sourceRow);
+    QFETCH(int, count);
+    QFETCH(int, destinationRow);
+    QFETCH(QList<int>, order);
+
+    QWidgetPtr widget = createWidget(QStringLiteral("qrc:/qml/RepeaterTest.qml"));
+    QVERIFY(widget != nullptr);
+
+    const QStringList rows = m_model->stringList();
+    const QList<QWidget*> before = rowWidgets(widget.data());
+    QCOMPARE(before.count(), m_model->rowCount());
+
+    if (!m_model->moveRows(QModelIndex(), sourceRow, count, QModelIndex(), destinationRow))
+        QSKIP("QStringListModel does not support moving rows in this Qt version");
+
+    QStringList moved;
+    Q_FOREACH (int row, order) {
+        moved << rows.at(row);
+    }
+    QCOMPARE(m_model->stringList(), moved);
+
+    verifyLayout(widget.data(), moved);
+
+    // moved rows keep their widgets, nothing is recreated
+    const QList<QWidget*> after = rowWidgets(widget.data());
+    QCOMPARE(after.count(), order.count());
+    for (int i = 0; i < order.count(); ++i) {
+        QCOMPARE(after.at(i), before.at(order.at(i)));
+    }
+}
+
+void tst_Repeater::moveRowsWithoutDelegate()
+{
+    QWidgetPtr widget = createWidget(QStringLiteral("qrc:/qml/RepeaterWithoutDelegateTest.qml"));
+    QVERIFY(widget != nullptr);
+    QCOMPARE(widget->layout()->count(), s_staticItemCount);
+
+    if (!m_model->moveRows(QModelIndex(), 0, 2, QModelIndex(), 4))
+        QSKIP("QStringListModel does not support moving rows in this Qt version");
+
+    QCOMPARE(widget->layout()->count(), s_staticItemCount);
+}
+
+QWidgetPtr tst_Repeater::createWidget(const QString &fileName)
+{
+    QQmlComponent component(m_qmlEngine, QUrl(fileName));
+    QWidgetPtr widget(qobject_cast<QWidget*>(component.create()));
+    if (widget == nullptr || widget->layout() == nullptr)
+        return QWidgetPtr();
+
+    return widget;
+}
+
+QList<QWidget*> tst_Repeater::rowWidgets(QWidget *widget)
+{
+    QList<QWidget*> widgets;
+
+    QLayout *layout = widget->layout();
+    for (int i = 1; i < layout->count() - 1; ++i) {
+        widgets << layout->itemAt(i)->widget();
+    }
+
+    return widgets;
+}
+
+void tst_Repeater::verifyLayout(QWidget *widget, const QStringList &rows)
+{
+    QLayout *layout = widget->layout();
+    QCOMPARE(layout->count(), rows.count() + s_staticItemCount);
+
+    // the rows stay between the static siblings
+    QCOMPARE(layout->itemAt(0)->widget()->objectName(), QStringLiteral("header"));
+    QCOMPARE(layout->itemAt(layout->count() - 1)->widget()->objectName(), QStringLiteral("footer"));
+
+    for (int i = 0; i < rows.count(); ++i) {
+        QLabel *label = qobject_cast<QLabel*>(layout->itemAt(i + 1)->widget());
+        QVERIFY(label != nullptr);
+        QCOMPARE(label->text(), rows.at(i));
+        QCOMPARE(label->objectName(), QStringLiteral("row%1").arg(i));
+    }
+}
+
+QTEST_MAIN(tst_Repeater)
+
+#include "tst_repeater.moc"
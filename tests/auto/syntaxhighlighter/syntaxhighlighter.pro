@@ -0,0 +1,3 @@
+include("$$PWD/../auto.pri")
+
+SOURCES += tst_syntaxhighlighter.cpp
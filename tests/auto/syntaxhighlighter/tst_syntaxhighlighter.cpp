@@ -0,0 +1,174 @@
+/*
+  tst_syntaxhighlighter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QRegularExpression>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextLayout>
+
+#include "declarativesyntaxhighlighter_p.h"
+
+typedef QPair<int, int> Span;
+
+// captures groups ahead of the rule under test, never matches the texts below
+static const char s_groupsFirstPattern[] = "(@)(@)(@)";
+
+class tst_SyntaxHighlighter : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void groupReferences_data();
+    void groupReferences();
+    void joinedSpans_data();
+    void joinedSpans();
+
+private:
+    static QVector<Span> standaloneSpans(const QString &pattern, const QString &text);
+    static QVector<Span> highlightedSpans(const QTextDocument &document, const QColor &color);
+};
+
+void tst_SyntaxHighlighter::groupReferences_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QString>("text");
+    QTest::addColumn<bool>("absolute");
+
+    // numbered references
+    QTest::newRow("\\1") << QStringLiteral("(\\w)\\1") << QStringLiteral("aa bc dd") << true;
+    QTest::newRow("\\g1") << QStringLiteral("(\\w)\\g1") << QStringLiteral("aa bc dd") << true;
+    QTest::newRow("\\g{1}") << QStringLiteral("(\\w)\\g{1}") << QStringLiteral("aa bc dd") << true;
+    QTest::newRow("\\g<1>") << QStringLiteral("(a|b)\\g<1>") << QStringLiteral("ab ba ac") << true;
+    QTest::newRow("\\0") << QStringLiteral("(a)\\0") << QStringLiteral("a") << false;
+
+    // relative and named references survive renumbering
+    QTest::newRow("\\g{-1}") << QStringLiteral("(\\w)\\g{-1}") << QStringLiteral("aa bc dd") << false;
+    QTest::newRow("\\k<name>") << QStringLiteral("(?<ch>\\w)\\k<ch>") << QStringLiteral("aa bc dd") << false;
+    QTest::newRow("\\k{name}") << QStringLiteral("(?<ch>\\w)\\k{ch}") << QStringLiteral("aa bc dd") << false;
+    QTest::newRow("(?P=name)") << QStringLiteral("(?P<ch>\\w)(?P=ch)") << QStringLiteral("aa bc dd") << false;
+
+    // escapes inside character classes
+    QTest::newRow("escaped bracket in class") << QStringLiteral("[\\]1]+") << QStringLiteral("a]1]b11") << false;
+    QTest::newRow("octal in class") << QStringLiteral("[\\1a]+") << QStringLiteral("xa\001ay") << false;
+    QTest::newRow("leading bracket in class") << QStringLiteral("[]\\1]+") << QStringLiteral("a]\001b") << false;
+    QTest::newRow("leading bracket in negated class") << QStringLiteral("[^]\\1]+") << QStringLiteral("a]\001b") << false;
+    QTest::newRow("escaped backslash in class") << QStringLiteral("([\\\\])\\1") << QStringLiteral("a\\\\b\\") << true;
+
+    // groups that do not count, comments and quoted text
+    QTest::newRow("(?:") << QStringLiteral("(?:ab)+") << QStringLiteral("ababx ab") << false;
+    QTest::newRow("(?<name>") << QStringLiteral("(?<word>[a-z]+)") << QStringLiteral("one Two three") << false;
+    QTest::newRow("(?#comment)") << QStringLiteral("a(?#\\1 (?R)b") << QStringLiteral("ab a b") << false;
+    QTest::newRow("reference after comment") << QStringLiteral("(a)(?#c)\\1") << QStringLiteral("aa a") << true;
+    QTest::newRow("\\Q...\\E") << QStringLiteral("\\Q(\\1)\\E") << QStringLiteral("x(\\1)y") << false;
+    QTest::newRow("reference after \\Q...\\E") << QStringLiteral("(a)\\Q-\\E\\1") << QStringLiteral("a-a a-b") << true;
+
+    // recursion and conditions
+    QTest::newRow("(?R)") << QStringLiteral("\\((?:[^()]|(?R))*\\)") << QStringLiteral("(a(b)c) (d") << true;
+    QTest::newRow("(?1)") << QStringLiteral("(a|b)(?1)") << QStringLiteral("ab ba ac") << true;
+    QTest::newRow("(?(1)") << QStringLiteral("(<)?a(?(1)>)") << QStringLiteral("<a> a <a") << true;
+}
+
+void tst_SyntaxHighlighter::groupReferences()
+{
+    QFETCH(QString, pattern);
+    QFETCH(bool, absolute);
+
+    QVERIFY2(QRegularExpression(pattern).isValid(), qPrintable(pattern));
+    QCOMPARE(DeclarativeSyntaxHighlighter::hasAbsoluteGroupReference(pattern), absolute);
+}
+
+void tst_SyntaxHighlighter::joinedSpans_data()
+{
+    groupReferences_data();
+}
+
+void tst_SyntaxHighlighter::joinedSpans()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QString, text);
+
+    const QVector<Span> expected = standaloneSpans(pattern, text);
+
+    // alone, and after a rule whose groups shift the numbers in the joined expression
+    const QList<QStringList> ruleSets = QList<QStringList>()
+        << (QStringList() << pattern)
+        << (QStringList() << QLatin1String(s_groupsFirstPattern) << pattern);
+
+    for (const QStringList &patterns : ruleSets) {
+        QTextDocument document(text);
+
+        DeclarativeSyntaxHighlighter highlighter;
+        QQmlListProperty<DeclarativeHighlightRule> rules = highlighter.rules();
+        for (const QString &rulePattern : patterns) {
+            DeclarativeHighlightRule *rule = new DeclarativeHighlightRule(&highlighter);
+            rule->setPattern(rulePattern);
+            rule->setColor(rulePattern == pattern ? QColor(Qt::red) : QColor(Qt::blue));
+            rules.append(&rules, rule);
+        }
+
+        highlighter.setDocument(&document);
+        QTRY_VERIFY(!highlighter.isBusy());
+
+        QCOMPARE(highlightedSpans(document, Qt::red), expected);
+    }
+}
+
+QVector<Span> tst_SyntaxHighlighter::standaloneSpans(const QString &pattern, const QString &text)
+{
+    QVector<Span> spans;
+
+    QRegularExpressionMatchIterator it = QRegularExpression(pattern).globalMatch(text);
+    while (it.hasNext()) {
+        const QRegularExpressionMatch match = it.next();
+        if (match.capturedLength() > 0)
+            spans << Span(match.capturedStart(), match.capturedLength());
+    }
+
+    return spans;
+}
+
+QVector<Span> tst_SyntaxHighlighter::highlightedSpans(const QTextDocument &document, const QColor &color)
+{
+    QVector<Span> spans;
+
+#if QT_VERSION >= QT_VERSION_CHECK(5, 6, 0)
+    const QVector<QTextLayout::FormatRange> formats = document.firstBlock().layout()->formats();
+#else
+    const QList<QTextLayout::FormatRange> formats = document.firstBlock().layout()->additionalFormats();
+#endif
+    for (const QTextLayout::FormatRange &range : formats) {
+        if (range.format.foreground().color() == color)
+            spans << Span(range.start, range.length);
+    }
+
+    return spans;
+}
+
+QTEST_MAIN(tst_SyntaxHighlighter)
+
+#include "tst_syntaxhighlighter.moc"
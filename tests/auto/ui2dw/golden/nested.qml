@@ -0,0 +1,156 @@
+import QtWidgets 1.0
+
+import QtQuick 1.0 as QtQuick1_0
+
+
+Widget {
+  id: form
+  objectName: "form"
+  windowTitle: "Generated"
+
+  VBoxLayout {
+    id: mainLayout
+    objectName: "mainLayout"
+    contentsMargins {
+      left: 6
+      top: 6
+      right: 6
+      bottom: 6
+    }
+
+    GroupBox {
+      id: groupBox0
+      objectName: "groupBox0"
+      title: "Section 0"
+
+      VBoxLayout {
+        id: sectionLayout0
+        objectName: "sectionLayout0"
+
+        GridLayout {
+          id: gridLayout0
+          objectName: "gridLayout0"
+          contentsMargins {
+            left: 4
+            top: 4
+            right: 4
+            bottom: 4
+          }
+
+          Label {
+            id: gridLabel0_0
+            objectName: "gridLabel0_0"
+            GridLayout.row: 0
+            GridLayout.column: 0
+            text: "Grid 0_0"
+            buddy: gridLineEdit0_0
+            alignment: Qt.AlignRight | Qt.AlignVCenter
+            font {
+              pointSize: 10
+              bold: true
+              weight: QtQuick1_0.Font.Bold
+            }
+          }
+
+          LineEdit {
+            id: gridLineEdit0_0
+            objectName: "gridLineEdit0_0"
+            GridLayout.row: 0
+            GridLayout.column: 1
+            focusPolicy: Qt.StrongFocus
+            echoMode: LineEdit.Normal
+            placeholderText: "gridLineEdit0_0"
+          }
+
+          PushButton {
+            id: gridButton0_0
+            objectName: "gridButton0_0"
+            GridLayout.row: 0
+            GridLayout.column: 2
+            GridLayout.columnSpan: 2
+            text: "Clear"
+            default: false
+          }
+        }
+
+        FormLayout {
+          id: formLayout0
+          objectName: "formLayout0"
+
+          LineEdit {
+            id: formLineEdit0_0
+            objectName: "formLineEdit0_0"
+            FormLayout.label: "Form 0_0"
+            focusPolicy: Qt.StrongFocus
+            echoMode: LineEdit.Normal
+            placeholderText: "formLineEdit0_0"
+          }
+        }
+
+        HBoxLayout {
+          id: nestedLayout0_0
+          objectName: "nestedLayout0_0"
+          spacing: 2
+
+          CheckBox {
+            id: nestedCheckBox0_0
+            objectName: "nestedCheckBox0_0"
+            text: "nestedCheckBox0_0"
+            checked: true
+          }
+
+          VBoxLayout {
+            id: nestedLayout0_1
+            objectName: "nestedLayout0_1"
+            spacing: 3
+
+            CheckBox {
+              id: nestedCheckBox0_1
+              objectName: "nestedCheckBox0_1"
+              text: "nestedCheckBox0_1"
+              checked: true
+            }
+          }
+        }
+
+        Spacer {
+          id: verticalSpacer0
+          objectName: "verticalSpacer0"
+          horizontalSizePolicy: Spacer.Minimum
+          verticalSizePolicy: Spacer.Expanding
+        }
+      }
+
+      ActionItem {
+        action: action0
+      }
+    }
+  }
+
+  Action {
+    id: action0
+    objectName: "action0"
+    checkable: true
+    text: "Action 0"
+    shortcut: "Ctrl+0"
+  }
+
+  QtQuick1_0.Connections {
+    target: gridButton0_0
+    onClicked: gridLineEdit0_0.clear()
+  }
+
+  QtQuick1_0.Connections {
+    target: action0
+    onToggled: {
+      // TODO: find names of signal arguments or respective properties to pass to the slot
+      // arg0 is of type "bool"
+
+      groupBox0.setEnabled(arg0)
+    }
+  }
+
+  TabStops {
+    tabStops: [ gridLineEdit0_0, formLineEdit0_0, nestedCheckBox0_0, nestedCheckBox0_1 ]
+  }
+}
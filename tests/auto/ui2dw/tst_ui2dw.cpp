@@ -0,0 +1,432 @@
+/*
+  tst_ui2dw.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include "converter.h"
+#include "uigenerator.h"
+#include "widgetdefaults.h"
+
+#include <QBuffer>
+
+Q_DECLARE_METATYPE(UiGeneratorOptions)
+
+class tst_Ui2dw : public QObject
+{
+    Q_OBJECT
+public:
+    tst_Ui2dw();
+
+private slots:
+    void initTestCase();
+    void goldenOutput_data();
+    void goldenOutput();
+    void generatedStructure_data();
+    void generatedStructure();
+    void optimizedStructure_data();
+    void optimizedStructure();
+    void contextDependentDefaults();
+    void cppStructure_data();
+    void cppStructure();
+    void invalidInput();
+
+private:
+    static UiGeneratorOptions options(int sectionCount, int rowsPerSection, int nestingDepth, int actionCount);
+    static void addStructureRows();
+    static bool convert(const QByteArray &input, VisitorPipeline::Mode mode, QByteArray *output,
+                        QString *errorString = nullptr);
+    static bool convert(Converter *converter, const QByteArray &input, QByteArray *output);
+};
+
+tst_Ui2dw::tst_Ui2dw()
+    : QObject()
+{
+}
+
+void tst_Ui2dw::initTestCase()
+{
+    // --optimize reads the class defaults from widget instances
+    WidgetDefaults::initialize();
+    QVERIFY(WidgetDefaults::instance());
+    QVERIFY(WidgetDefaults::instance()->hasClass(QStringLiteral("QPushButton")));
+}
+
+void tst_Ui2dw::goldenOutput_data()
+{
+    QTest::addColumn<UiGeneratorOptions>("options");
+    QTest::addColumn<QString>("goldenFile");
+
+    QTest::newRow("nested") << options(1, 1, 2, 1) << QStringLiteral("nested.qml");
+}
+
+void tst_Ui2dw::goldenOutput()
+{
+    QFETCH(UiGeneratorOptions, options);
+    QFETCH(QString, goldenFile);
+
+    const QByteArray input = generateUi(options);
+
+    QByteArray sequential;
+    QVERIFY(convert(input, VisitorPipeline::Sequential, &sequential));
+
+    QByteArray fused;
+    QVERIFY(convert(input, VisitorPipeline::Fused, &fused));
+    QCOMPARE(fused, sequential);
+
+    const QString goldenFileName = QStringLiteral(GOLDEN_DIR "/") + goldenFile;
+
+    // after intended changes of the output the golden files are rewritten with
+    // UI2DW_UPDATE_GOLDEN=1 and the differences reviewed before committing them
+    if (qEnvironmentVariableIsSet("UI2DW_UPDATE_GOLDEN")) {
+        QFile file(goldenFileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(fused), qint64(fused.size()));
+        return;
+    }
+
+    QFile file(goldenFileName);
+    QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(goldenFileName));
+
+    const QByteArray expected = file.readAll();
+
+    // the complete output next to the test binary, to diff against the golden file
+    const QString actualFileName = QDir::current().absoluteFilePath(goldenFile + QStringLiteral(".actual"));
+    if (expected != fused) {
+        QFile actualFile(actualFileName);
+        QVERIFY(actualFile.open(QIODevice::WriteOnly));
+        QCOMPARE(actualFile.write(fused), qint64(fused.size()));
+    } else {
+        QFile::remove(actualFileName);
+    }
+
+    const QList<QByteArray> expectedLines = expected.split('\n');
+    const QList<QByteArray> actualLines = fused.split('\n');
+
+    // line by line, so a failure shows the first difference instead of two complete files
+    for (int i = 0; i < qMin(expectedLines.count(), actualLines.count()); ++i) {
+        QVERIFY2(actualLines.at(i) == expectedLines.at(i),
+                 qPrintable(QStringLiteral("line %1: \"%2\", expected \"%3\", output written to %4")
+                            .arg(i + 1)
+                            .arg(QString::fromUtf8(actualLines.at(i)), QString::fromUtf8(expectedLines.at(i)),
+                                 actualFileName)));
+    }
+    QVERIFY2(actualLines.count() == expectedLines.count(),
+             qPrintable(QStringLiteral("%1 lines, expected %2, output written to %3")
+                        .arg(actualLines.count()).arg(expectedLines.count()).arg(actualFileName)));
+}
+
+void tst_Ui2dw::addStructureRows()
+{
+    QTest::addColumn<UiGeneratorOptions>("options");
+
+    QTest::newRow("single section") << options(1, 4, 0, 0);
+    QTest::newRow("grids and forms") << options(20, 8, 0, 0);
+    QTest::newRow("nested layouts") << options(10, 2, 6, 0);
+    QTest::newRow("actions") << options(10, 2, 0, 4);
+    QTest::newRow("more actions than sections") << options(3, 2, 1, 5);
+    QTest::newRow("everything") << options(50, 4, 3, 10);
+}
+
+void tst_Ui2dw::generatedStructure_data()
+{
+    addStructureRows();
+}
+
+void tst_Ui2dw::generatedStructure()
+{
+    QFETCH(UiGeneratorOptions, options);
+
+    const int sections = options.sectionCount;
+    const int rows = sections * options.rowsPerSection;
+    const int checkBoxes = sections * options.nestingDepth;
+    const int addedActions = options.actionCount > 0 ? sections : 0;
+    const int connectedActions = qMin(options.actionCount, sections);
+
+    QByteArray output;
+    QVERIFY(convert(generateUi(options), VisitorPipeline::Fused, &output));
+
+    QCOMPARE(output.count("\n    GroupBox {\n"), sections);
+    QCOMPARE(output.count("      GridLayout {\n"), sections);
+    QCOMPARE(output.count("      FormLayout {\n"), sections);
+    QCOMPARE(output.count(" Spacer {\n"), sections);
+
+    // the labels of form rows become attached properties of the fields
+    QCOMPARE(output.count(" Label {\n"), rows);
+    QCOMPARE(output.count(" LineEdit {\n"), 2 * rows);
+    QCOMPARE(output.count("FormLayout.label: \"Form "), rows);
+    QCOMPARE(output.count("GridLayout.columnSpan: 2\n"), rows);
+    QCOMPARE(output.count("buddy: gridLineEdit"), rows);
+
+    QCOMPARE(output.count(" CheckBox {\n"), checkBoxes);
+    QCOMPARE(output.count(" HBoxLayout {\n") + output.count(" VBoxLayout {\n"), checkBoxes + sections + 1);
+
+    QCOMPARE(output.count("\n  Action {\n"), options.actionCount);
+    QCOMPARE(output.count(" ActionItem {\n"), addedActions);
+
+    // connections and tab stops are moved into the root widget
+    QCOMPARE(output.count("\n  QtQuick1_0.Connections {\n"), rows + connectedActions);
+    QCOMPARE(output.count("onClicked: gridLineEdit"), rows);
+    QCOMPARE(output.count("onToggled: {"), connectedActions);
+    QCOMPARE(output.count("\n  TabStops {\n"), 1);
+
+    const int tabStopsStart = output.indexOf("tabStops: [ ");
+    QVERIFY(tabStopsStart >= 0);
+    const int tabStopsEnd = output.indexOf(" ]", tabStopsStart);
+    const QByteArray tabStops = output.mid(tabStopsStart + 12, tabStopsEnd - tabStopsStart - 12);
+    QCOMPARE(tabStops.split(',').count(), 2 * rows + checkBoxes);
+
+    QVERIFY(output.startsWith("import QtWidgets 1.0\n\nimport QtQuick 1.0 as QtQuick1_0\n"));
+    QVERIFY(output.endsWith("\n}\n"));
+}
+
+void tst_Ui2dw::optimizedStructure_data()
+{
+    addStructureRows();
+}
+
+void tst_Ui2dw::optimizedStructure()
+{
+    QFETCH(UiGeneratorOptions, options);
+
+    const int sections = options.sectionCount;
+    const int rows = sections * options.rowsPerSection;
+    const int checkBoxes = sections * options.nestingDepth;
+    // the innermost nested layout of each section only holds a check box
+    const int collapsedLayouts = options.nestingDepth > 0 ? sections : 0;
+
+    const QByteArray input = generateUi(options);
+
+    Converter converter;
+    converter.setOptimizationEnabled(true);
+
+    QByteArray output;
+    QVERIFY(convert(&converter, input, &output));
+
+    // focusPolicy and echoMode of the line edits are the class defaults,
+    // the eliminated layouts take their spacing with them
+    const OptimizationStatistics statistics = converter.optimizationStatistics();
+    QCOMPARE(statistics.eliminatedObjects, collapsedLayouts);
+    QCOMPARE(statistics.eliminatedBindings, 2 * 2 * rows + collapsedLayouts);
+
+    QCOMPARE(output.count(" LineEdit {\n"), 2 * rows);
+    QCOMPARE(output.count("focusPolicy: "), 0);
+    QCOMPARE(output.count("echoMode: "), 0);
+    QCOMPARE(output.count("placeholderText: "), 2 * rows);
+
+    // depends on the dialog a button ends up in, not a class default
+    QCOMPARE(output.count("default: false\n"), rows);
+
+    QCOMPARE(output.count(" CheckBox {\n"), checkBoxes);
+    QCOMPARE(output.count("checked: true\n"), checkBoxes);
+    QCOMPARE(output.count(" HBoxLayout {\n") + output.count(" VBoxLayout {\n"),
+             checkBoxes + sections + 1 - collapsedLayouts);
+    QCOMPARE(output.count("      GridLayout {\n"), sections);
+    QCOMPARE(output.count("      FormLayout {\n"), sections);
+    QCOMPARE(output.count(" Spacer {\n"), sections);
+
+    // objects referenced by connections and tab stops are kept
+    QCOMPARE(output.count("\n  QtQuick1_0.Connections {\n"), rows + qMin(options.actionCount, sections));
+    const int tabStopsStart = output.indexOf("tabStops: [ ");
+    QVERIFY(tabStopsStart >= 0);
+    const int tabStopsEnd = output.indexOf(" ]", tabStopsStart);
+    QCOMPARE(output.mid(tabStopsStart, tabStopsEnd - tabStopsStart).split(',').count(), 2 * rows + checkBoxes);
+
+    converter.setPipelineMode(VisitorPipeline::Sequential);
+    QByteArray sequential;
+    QVERIFY(convert(&converter, input, &sequential));
+    QCOMPARE(sequential, output);
+}
+
+void tst_Ui2dw::contextDependentDefaults()
+{
+    const WidgetDefaults *defaults = WidgetDefaults::instance();
+    QVERIFY(defaults);
+
+    // QPushButton::autoDefault is true inside a QDialog, false in a parentless instance
+    QVERIFY(!defaults->isDefault(QStringLiteral("QPushButton"), QStringLiteral("autoDefault"), false));
+    QVERIFY(!defaults->isDefault(QStringLiteral("QPushButton"), QStringLiteral("default"), false));
+    QVERIFY(!defaults->isDefault(QStringLiteral("QCommandLinkButton"), QStringLiteral("autoDefault"), false));
+    // top level layouts get their margins from the style
+    QVERIFY(!defaults->isDefault(QStringLiteral("QVBoxLayout"), QStringLiteral("margin"), 0));
+    QVERIFY(!defaults->isDefault(QStringLiteral("QToolButton"), QStringLiteral("autoRaise"), false));
+
+    QVERIFY(defaults->isDefault(QStringLiteral("QPushButton"), QStringLiteral("flat"), false));
+    QVERIFY(defaults->isDefault(QStringLiteral("QCheckBox"), QStringLiteral("checked"), false));
+
+    const QByteArray input =
+            "<ui version=\"4.0\">\n"
+            " <class>Dialog</class>\n"
+            " <widget class=\"QDialog\" name=\"Dialog\">\n"
+            "  <layout class=\"QVBoxLayout\" name=\"dialogLayout\">\n"
+            "   <property name=\"margin\"><number>0</number></property>\n"
+            "   <item>\n"
+            "    <widget class=\"QPushButton\" name=\"okButton\">\n"
+            "     <property name=\"text\"><string>OK</string></property>\n"
+            "     <property name=\"autoDefault\"><bool>false</bool></property>\n"
+            "     <property name=\"flat\"><bool>false</bool></property>\n"
+            "    </widget>\n"
+            "   </item>\n"
+            "  </layout>\n"
+            " </widget>\n"
+            " <resources/>\n"
+            " <connections/>\n"
+            "</ui>\n";
+
+    Converter converter;
+    converter.setOptimizationEnabled(true);
+
+    QByteArray output;
+    QVERIFY(convert(&converter, input, &output));
+
+    QCOMPARE(converter.optimizationStatistics().eliminatedBindings, 1);
+    QVERIFY(output.contains("autoDefault: false\n"));
+    QVERIFY(output.contains("left: 0\n"));
+    QVERIFY(!output.contains("flat: "));
+}
+
+void tst_Ui2dw::cppStructure_data()
+{
+    QTest::addColumn<UiGeneratorOptions>("options");
+    QTest::addColumn<bool>("optimize");
+
+    QTest::newRow("single section") << options(1, 4, 0, 0) << false;
+    QTest::newRow("nested layouts") << options(10, 2, 6, 0) << false;
+    QTest::newRow("everything") << options(50, 4, 3, 10) << false;
+    QTest::newRow("single section, optimized") << options(1, 4, 0, 0) << true;
+    QTest::newRow("nested layouts, optimized") << options(10, 2, 6, 0) << true;
+    QTest::newRow("everything, optimized") << options(50, 4, 3, 10) << true;
+}
+
+void tst_Ui2dw::cppStructure()
+{
+    QFETCH(UiGeneratorOptions, options);
+    QFETCH(bool, optimize);
+
+    const int sections = options.sectionCount;
+    const int rows = sections * options.rowsPerSection;
+    const int checkBoxes = sections * options.nestingDepth;
+    const int addedActions = options.actionCount > 0 ? sections : 0;
+    const int connectedActions = qMin(options.actionCount, sections);
+    const int collapsedLayouts = optimize && options.nestingDepth > 0 ? sections : 0;
+
+    Converter converter;
+    converter.setOutputFormat(Converter::CppOutput);
+    converter.setOptimizationEnabled(optimize);
+
+    QByteArray output;
+    QVERIFY(convert(&converter, generateUi(options), &output));
+
+    QVERIFY(output.startsWith("// Generated by ui2dw"));
+    QVERIFY(output.contains("\n#ifndef UI2DW_FORM_H\n#define UI2DW_FORM_H\n"));
+    QVERIFY(output.contains("\nnamespace Ui2dw {\n\nclass Form\n{\n  public:\n"));
+    QVERIFY(output.contains("    QWidget *create(QWidget *parent = 0)\n"));
+    QVERIFY(output.contains("      form = new QWidget(parent);\n"));
+    QVERIFY(output.endsWith("\n      return form;\n    }\n};\n\n} // namespace Ui2dw\n\n#endif // UI2DW_FORM_H\n"));
+
+    // one member per object
+    QCOMPARE(output.count("\n    QGroupBox *groupBox"), sections);
+    QCOMPARE(output.count("\n    QCheckBox *nestedCheckBox"), checkBoxes);
+    QCOMPARE(output.count("\n    QLineEdit *"), 2 * rows);
+
+    QCOMPARE(output.count(" = new QGroupBox(form);\n"), sections);
+    QCOMPARE(output.count(" = new QGridLayout();\n"), sections);
+    QCOMPARE(output.count(" = new QFormLayout();\n"), sections);
+    QCOMPARE(output.count(" = new QHBoxLayout(") + output.count(" = new QVBoxLayout("),
+             checkBoxes + sections + 1 - collapsedLayouts);
+    QCOMPARE(output.count(" = new QSpacerItem(20, 40, QSizePolicy::Minimum, QSizePolicy::Expanding);\n"), sections);
+
+    // the form labels stay widgets, unlike in the QML output
+    QCOMPARE(output.count(" = new QLabel("), 2 * rows);
+    QCOMPARE(output.count(", QFormLayout::LabelRole, formLabel"), rows);
+    QCOMPARE(output.count(", QFormLayout::FieldRole, formLineEdit"), rows);
+    QCOMPARE(output.count(", 2, 1, 2);\n"), rows);
+    QCOMPARE(output.count("->setBuddy(gridLineEdit"), rows);
+
+    QCOMPARE(output.count("->setFocusPolicy(Qt::StrongFocus);\n"), optimize ? 0 : 2 * rows);
+    QCOMPARE(output.count("->setEchoMode(QLineEdit::Normal);\n"), optimize ? 0 : 2 * rows);
+    QCOMPARE(output.count("->setDefault(false);\n"), rows);
+    QCOMPARE(output.count("->setChecked(true);\n"), checkBoxes);
+
+    QCOMPARE(output.count(" = new QAction(form);\n"), options.actionCount);
+    QCOMPARE(output.count("->addAction(action"), addedActions);
+    QCOMPARE(output.count("QObject::connect("), rows + connectedActions);
+    QCOMPARE(output.count("SIGNAL(clicked()), gridLineEdit"), rows);
+    QCOMPARE(output.count("QWidget::setTabOrder("), 2 * rows + checkBoxes - 1);
+}
+
+void tst_Ui2dw::invalidInput()
+{
+    QByteArray input = generateUi(options(2, 2, 1, 1));
+    input.truncate(input.size() / 2);
+
+    QByteArray output;
+    QString errorString;
+    QVERIFY(!convert(input, VisitorPipeline::Fused, &output, &errorString));
+    QVERIFY(!errorString.isEmpty());
+}
+
+UiGeneratorOptions tst_Ui2dw::options(int sectionCount, int rowsPerSection, int nestingDepth, int actionCount)
+{
+    UiGeneratorOptions options;
+    options.sectionCount = sectionCount;
+    options.rowsPerSection = rowsPerSection;
+    options.nestingDepth = nestingDepth;
+    options.actionCount = actionCount;
+
+    return options;
+}
+
+bool tst_Ui2dw::convert(const QByteArray &input, VisitorPipeline::Mode mode, QByteArray *output,
+                        QString *errorString)
+{
+    Converter converter;
+    converter.setPipelineMode(mode);
+
+    const bool success = convert(&converter, input, output);
+    if (errorString) {
+        *errorString = converter.errorString();
+    }
+
+    return success;
+}
+
+bool tst_Ui2dw::convert(Converter *converter, const QByteArray &input, QByteArray *output)
+{
+    output->clear();
+
+    QBuffer inputBuffer;
+    inputBuffer.setData(input);
+    inputBuffer.open(QIODevice::ReadOnly);
+
+    QBuffer outputBuffer(output);
+    outputBuffer.open(QIODevice::WriteOnly);
+
+    return converter->convert(&inputBuffer, &outputBuffer);
+}
+
+QTEST_MAIN(tst_Ui2dw)
+
+#include "tst_ui2dw.moc"
@@ -0,0 +1,21 @@
+QT += testlib
+
+CONFIG += qt console warn_on depend_includepath testcase parallel_test
+macos:CONFIG -= app_bundle
+
+TARGET = tst_ui2dw
+
+include("$$PWD/../../../ui2dw/ui2dw.pri")
+
+SOURCES += tst_ui2dw.cpp \
+    $$PWD/../../benchmarks/ui2dw/uigenerator.cpp
+
+HEADERS += \
+    $$PWD/../../benchmarks/ui2dw/uigenerator.h
+
+INCLUDEPATH += $$PWD/../../benchmarks/ui2dw
+
+DISTFILES += \
+    golden/nested.qml
+
+DEFINES += GOLDEN_DIR=\\\"$$PWD/golden\\\"
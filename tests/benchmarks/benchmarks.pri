@@ -0,0 +1,8 @@
+QT += testlib qml widgets
+
+CONFIG += qt console warn_on depend_includepath testcase
+macos:CONFIG -= app_bundle
+
+INCLUDEPATH += . $$PWD/../../lib/
+
+LIBS += -ldeclarativewidgets
@@ -0,0 +1,8 @@
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    cppwriter \
+    qml2cpp \
+    repeater \
+    snapshot \
+    ui2dw
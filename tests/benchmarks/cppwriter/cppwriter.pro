@@ -0,0 +1,14 @@
+include("$$PWD/../benchmarks.pri")
+
+SOURCES += tst_bench_cppwriter.cpp
+
+# Both variants are generated from the same form at build time
+CONFIG += ui2dw
+
+UI2DW = $$shadowed($$PWD/../../../ui2dw)/ui2dw
+UI2DW_FORMS = settingsform.ui
+UI2DW_CPP_FORMS = settingsform.ui
+
+INCLUDEPATH += $$OUT_PWD
+
+DEFINES += UI2DW_QML_FILE=\\\"$$OUT_PWD/settingsform.qml\\\"
@@ -0,0 +1,130 @@
+/*
+  tst_bench_cppwriter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include "declarativewidgetsdocument.h"
+#include "settingsform_ui2dw.h"
+
+#include <QCheckBox>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSpinBox>
+
+typedef QSharedPointer<QWidget> QWidgetPtr;
+
+class tst_BenchCppWriter : public QObject
+{
+    Q_OBJECT
+public:
+    tst_BenchCppWriter();
+
+private slots:
+    void initTestCase();
+    void sameWidgets();
+    void createFromQmlDocument();
+    void createFromQmlComponent();
+    void createFromCpp();
+
+private:
+    QUrl m_qmlUrl;
+
+    static QWidgetPtr createCppWidget();
+    static QVector<int> widgetCounts(QWidget *widget);
+};
+
+tst_BenchCppWriter::tst_BenchCppWriter()
+    : QObject()
+    , m_qmlUrl(QUrl::fromLocalFile(QStringLiteral(UI2DW_QML_FILE)))
+{
+}
+
+void tst_BenchCppWriter::initTestCase()
+{
+    QVERIFY2(QFileInfo::exists(m_qmlUrl.toLocalFile()),
+             qPrintable(QStringLiteral("Generated QML file does not exist: %1").arg(m_qmlUrl.toLocalFile())));
+}
+
+void tst_BenchCppWriter::sameWidgets()
+{
+    DeclarativeWidgetsDocument document(m_qmlUrl);
+    QWidgetPtr qmlWidget(document.create<QWidget>());
+    QVERIFY(qmlWidget != nullptr);
+
+    QWidgetPtr cppWidget = createCppWidget();
+    QVERIFY(cppWidget != nullptr);
+
+    QCOMPARE(widgetCounts(cppWidget.data()), widgetCounts(qmlWidget.data()));
+    QCOMPARE(cppWidget->windowTitle(), qmlWidget->windowTitle());
+}
+
+void tst_BenchCppWriter::createFromQmlDocument()
+{
+    // includes loading and compiling the QML file
+    QBENCHMARK {
+        DeclarativeWidgetsDocument document(m_qmlUrl);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchCppWriter::createFromQmlComponent()
+{
+    DeclarativeWidgetsDocument document(m_qmlUrl);
+
+    QBENCHMARK {
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchCppWriter::createFromCpp()
+{
+    QBENCHMARK {
+        QWidgetPtr widget = createCppWidget();
+        QVERIFY(widget != nullptr);
+    }
+}
+
+QWidgetPtr tst_BenchCppWriter::createCppWidget()
+{
+    Ui2dw::SettingsForm form;
+    return QWidgetPtr(form.create());
+}
+
+QVector<int> tst_BenchCppWriter::widgetCounts(QWidget *widget)
+{
+    return QVector<int>() << widget->findChildren<QLineEdit*>().count()
+                          << widget->findChildren<QSpinBox*>().count()
+                          << widget->findChildren<QCheckBox*>().count()
+                          << widget->findChildren<QPushButton*>().count()
+                          << widget->findChildren<QLabel*>().count();
+}
+
+QTEST_MAIN(tst_BenchCppWriter)
+
+#include "tst_bench_cppwriter.moc"
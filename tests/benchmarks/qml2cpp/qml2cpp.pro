@@ -0,0 +1,26 @@
+include("$$PWD/../benchmarks.pri")
+include("$$PWD/../../../qml2cpp/qml2cpp.pri")
+
+TARGET = tst_bench_qml2cpp
+
+SOURCES += tst_bench_qml2cpp.cpp \
+    $$PWD/../../../ui2dw/memoryusage.cpp
+
+HEADERS += \
+    $$PWD/../../../ui2dw/memoryusage.h
+
+INCLUDEPATH += $$PWD/../../../ui2dw
+
+win32: LIBS += -lpsapi
+
+# The C++ variant is compiled from the same QML file at build time
+CONFIG += qml2cpp
+
+QML2CPP = $$shadowed($$PWD/../../../qml2cpp)/qml2cpp
+QML2CPP_FILES = settingsscreen.qml
+QML2CPP_FLAGS = --strict
+
+INCLUDEPATH += $$OUT_PWD
+
+DEFINES += QML2CPP_QML_FILE=\\\"$$PWD/settingsscreen.qml\\\"
+DEFINES += GALLERY_QML_FILE=\\\"$$PWD/../../../examples/gallery.qml\\\"
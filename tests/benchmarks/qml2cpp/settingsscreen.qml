@@ -0,0 +1,121 @@
+/*
+  settingsscreen.qml
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+import QtWidgets 1.0
+
+// Only uses the subset qml2cpp compiles, so both variants build the same widgets
+Widget {
+  windowTitle: qsTr("Settings")
+
+  VBoxLayout {
+    TabWidget {
+      Widget {
+        TabWidget.label: qsTr("General")
+
+        FormLayout {
+          LineEdit {
+            FormLayout.label: qsTr("Name:")
+            placeholderText: qsTr("Your name")
+          }
+
+          SpinBox {
+            FormLayout.label: qsTr("Age:")
+            minimum: 0
+            maximum: 150
+            value: 30
+          }
+
+          ComboBox {
+            FormLayout.label: qsTr("Language:")
+            model: StringListModel {
+              stringList: [ "English", "Deutsch", "Svenska" ]
+            }
+          }
+
+          CheckBox {
+            id: proxyCheckBox
+            text: qsTr("Use proxy")
+          }
+
+          LineEdit {
+            FormLayout.label: qsTr("Proxy:")
+            enabled: proxyCheckBox.checked
+          }
+        }
+      }
+
+      Widget {
+        TabWidget.label: qsTr("Appearance")
+
+        GridLayout {
+          Label {
+            GridLayout.row: 0
+            GridLayout.column: 0
+            text: qsTr("Font size:")
+            buddy: fontSizeSlider
+          }
+
+          Slider {
+            id: fontSizeSlider
+            GridLayout.row: 0
+            GridLayout.column: 1
+            orientation: Qt.Horizontal
+            minimum: 6
+            maximum: 32
+            value: 10
+          }
+
+          LCDNumber {
+            GridLayout.row: 0
+            GridLayout.column: 2
+            value: fontSizeSlider.value
+          }
+
+          CheckBox {
+            GridLayout.row: 1
+            GridLayout.column: 0
+            GridLayout.columnSpan: 3
+            text: qsTr("Dark theme")
+          }
+        }
+      }
+    }
+
+    HBoxLayout {
+      Spacer {
+        horizontalSizePolicy: Spacer.Expanding
+      }
+
+      PushButton {
+        text: qsTr("OK")
+      }
+
+      PushButton {
+        text: qsTr("Cancel")
+      }
+    }
+  }
+}
@@ -0,0 +1,263 @@
+/*
+  tst_bench_qml2cpp.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include "cppgenerator.h"
+#include "declarativewidgetsdocument.h"
+#include "memoryusage.h"
+#include "qmlparser.h"
+#include "settingsscreen_qml2cpp.h"
+
+#include <QCheckBox>
+#include <QLCDNumber>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSlider>
+#include <QSpinBox>
+
+typedef QSharedPointer<QWidget> QWidgetPtr;
+
+class tst_BenchQml2cpp : public QObject
+{
+    Q_OBJECT
+public:
+    tst_BenchQml2cpp();
+
+private slots:
+    void initTestCase();
+    void sameWidgets();
+    void sameBindings();
+    void createFromQmlDocument();
+    void createFromQmlComponent();
+    void createFromCpp();
+    void memoryUsage_data();
+    void memoryUsage();
+    void galleryReport();
+
+private:
+    QUrl m_qmlUrl;
+
+    static QWidgetPtr createCppWidget();
+    static QVector<int> widgetCounts(QWidget *widget);
+    static QWidget *labeledField(QWidget *widget, const QString &labelText);
+};
+
+tst_BenchQml2cpp::tst_BenchQml2cpp()
+    : QObject()
+    , m_qmlUrl(QUrl::fromLocalFile(QStringLiteral(QML2CPP_QML_FILE)))
+{
+}
+
+void tst_BenchQml2cpp::initTestCase()
+{
+    QVERIFY2(QFileInfo::exists(m_qmlUrl.toLocalFile()),
+             qPrintable(QStringLiteral("QML file does not exist: %1").arg(m_qmlUrl.toLocalFile())));
+}
+
+void tst_BenchQml2cpp::sameWidgets()
+{
+    DeclarativeWidgetsDocument document(m_qmlUrl);
+    QWidgetPtr qmlWidget(document.create<QWidget>());
+    QVERIFY(qmlWidget != nullptr);
+
+    QWidgetPtr cppWidget = createCppWidget();
+    QVERIFY(cppWidget != nullptr);
+
+    QCOMPARE(widgetCounts(cppWidget.data()), widgetCounts(qmlWidget.data()));
+    QCOMPARE(cppWidget->windowTitle(), qmlWidget->windowTitle());
+}
+
+void tst_BenchQml2cpp::sameBindings()
+{
+    DeclarativeWidgetsDocument document(m_qmlUrl);
+    QWidgetPtr qmlWidget(document.create<QWidget>());
+    QVERIFY(qmlWidget != nullptr);
+
+    QWidgetPtr cppWidget = createCppWidget();
+    QVERIFY(cppWidget != nullptr);
+
+    Q_FOREACH (const QWidgetPtr &widget, QVector<QWidgetPtr>() << qmlWidget << cppWidget) {
+        QWidget *proxyEdit = labeledField(widget.data(), QStringLiteral("Proxy:"));
+        QVERIFY(proxyEdit != nullptr);
+
+        QCheckBox *proxyCheckBox = nullptr;
+        Q_FOREACH (QCheckBox *checkBox, widget->findChildren<QCheckBox*>()) {
+            if (checkBox->text() == QStringLiteral("Use proxy")) {
+                proxyCheckBox = checkBox;
+            }
+        }
+        QVERIFY(proxyCheckBox != nullptr);
+
+        QVERIFY(!proxyEdit->isEnabled());
+        proxyCheckBox->setChecked(true);
+        QVERIFY(proxyEdit->isEnabled());
+
+        QSlider *slider = widget->findChild<QSlider*>();
+        QLCDNumber *lcdNumber = widget->findChild<QLCDNumber*>();
+        QVERIFY(slider != nullptr);
+        QVERIFY(lcdNumber != nullptr);
+
+        QCOMPARE(lcdNumber->intValue(), 10);
+        slider->setValue(20);
+        QCOMPARE(lcdNumber->intValue(), 20);
+    }
+}
+
+void tst_BenchQml2cpp::createFromQmlDocument()
+{
+    // includes loading and compiling the QML file
+    QBENCHMARK {
+        DeclarativeWidgetsDocument document(m_qmlUrl);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchQml2cpp::createFromQmlComponent()
+{
+    DeclarativeWidgetsDocument document(m_qmlUrl);
+
+    QBENCHMARK {
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchQml2cpp::createFromCpp()
+{
+    QBENCHMARK {
+        QWidgetPtr widget = createCppWidget();
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchQml2cpp::memoryUsage_data()
+{
+    QTest::addColumn<bool>("qml");
+
+    QTest::newRow("qml") << true;
+    QTest::newRow("cpp") << false;
+}
+
+void tst_BenchQml2cpp::memoryUsage()
+{
+    QFETCH(bool, qml);
+
+    if (currentMemoryUsage() < 0) {
+        QSKIP("Resident memory is not available on this platform");
+    }
+
+    const int instanceCount = 50;
+
+    // the QML engine and the widget styles have been set up by the earlier
+    // tests, so the difference is what the documents and widgets need
+    const qint64 before = currentMemoryUsage();
+
+    QScopedPointer<DeclarativeWidgetsDocument> document;
+    if (qml) {
+        document.reset(new DeclarativeWidgetsDocument(m_qmlUrl));
+    }
+
+    QVector<QWidgetPtr> widgets;
+    for (int i = 0; i < instanceCount; ++i) {
+        widgets << (qml ? QWidgetPtr(document->create<QWidget>()) : createCppWidget());
+        QVERIFY(widgets.last() != nullptr);
+    }
+
+    const qint64 after = currentMemoryUsage();
+
+    qDebug() << instanceCount << "instances:" << (after - before) / 1024 << "KiB,"
+             << (after - before) / instanceCount / 1024 << "KiB per instance";
+}
+
+void tst_BenchQml2cpp::galleryReport()
+{
+    QFile file(QStringLiteral(GALLERY_QML_FILE));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QmlParser parser(QString::fromUtf8(file.readAll()));
+    const QmlDocument document = parser.parse();
+    QVERIFY2(!document.root.isNull(), qPrintable(parser.errorString()));
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+
+    CppGenerator generator;
+    generator.setClassName(QStringLiteral("Gallery"));
+    QVERIFY2(generator.generate(document, &buffer), qPrintable(generator.errorString()));
+
+    QStringList messages;
+    Q_FOREACH (const QmlDiagnostic &diagnostic, parser.diagnostics() + generator.diagnostics()) {
+        messages << diagnostic.message;
+    }
+
+    // the gallery uses handlers, functions and types outside of the subset
+    QVERIFY(messages.contains(QStringLiteral("signal handler onTextChanged is not supported")));
+    QVERIFY(messages.contains(QStringLiteral("signal handler onClicked is not supported")));
+    QVERIFY(messages.contains(QStringLiteral("function load is not supported")));
+    QVERIFY(messages.contains(QStringLiteral("type WebEngineView is not supported")));
+
+    // while all of its literal properties are known
+    Q_FOREACH (const QString &message, messages) {
+        QVERIFY2(!message.startsWith(QStringLiteral("unknown property")), qPrintable(message));
+    }
+
+    QVERIFY(buffer.data().contains("class Gallery"));
+    QVERIFY(buffer.data().contains("tabWidget_1->addTab("));
+}
+
+QWidgetPtr tst_BenchQml2cpp::createCppWidget()
+{
+    Qml2cpp::Settingsscreen screen;
+    return QWidgetPtr(screen.create());
+}
+
+QVector<int> tst_BenchQml2cpp::widgetCounts(QWidget *widget)
+{
+    return QVector<int>() << widget->findChildren<QLineEdit*>().count()
+                          << widget->findChildren<QSpinBox*>().count()
+                          << widget->findChildren<QCheckBox*>().count()
+                          << widget->findChildren<QPushButton*>().count()
+                          << widget->findChildren<QLabel*>().count()
+                          << widget->findChildren<QSlider*>().count();
+}
+
+QWidget *tst_BenchQml2cpp::labeledField(QWidget *widget, const QString &labelText)
+{
+    Q_FOREACH (QLabel *label, widget->findChildren<QLabel*>()) {
+        if (label->text() == labelText) {
+            return label->buddy();
+        }
+    }
+
+    return nullptr;
+}
+
+QTEST_MAIN(tst_BenchQml2cpp)
+
+#include "tst_bench_qml2cpp.moc"
@@ -0,0 +1,6 @@
+include("$$PWD/../benchmarks.pri")
+
+SOURCES += tst_bench_repeater.cpp
+
+RESOURCES += \
+    qml.qrc
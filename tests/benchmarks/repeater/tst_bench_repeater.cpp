@@ -0,0 +1,218 @@
+/*
+  tst_bench_repeater.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include <QLayout>
+#include <QQmlComponent>
+#include <QQmlContext>
+#include <QQmlEngine>
+#include <QStringListModel>
+
+typedef QSharedPointer<QWidget> QWidgetPtr;
+
+static const int s_rowCount = 5000;
+static const int s_changedRow = s_rowCount / 2;
+
+// The Repeater is enclosed by a header and a footer label
+static const int s_staticItemCount = 2;
+
+class tst_BenchRepeater : public QObject
+{
+    Q_OBJECT
+public:
+    tst_BenchRepeater();
+
+private slots:
+    void initTestCase();
+    void init();
+    void insertRemoveRow_data();
+    void insertRemoveRow();
+    void moveRow_data();
+    void moveRow();
+    void changeRow_data();
+    void changeRow();
+
+private:
+    QQmlEngine *m_qmlEngine;
+    QStringListModel *m_model;
+    QStringList m_rows;
+
+    QWidgetPtr createWidget();
+    void rebuild(const QStringList &rows);
+    void addRebuildColumn();
+};
+
+tst_BenchRepeater::tst_BenchRepeater()
+    : QObject()
+    , m_qmlEngine(new QQmlEngine(this))
+    , m_model(new QStringListModel(this))
+{
+    m_rows.reserve(s_rowCount);
+    for (int i = 0; i < s_rowCount; ++i)
+        m_rows << QStringLiteral("Row %1").arg(i);
+}
+
+void tst_BenchRepeater::initTestCase()
+{
+    // Add extensionplugin import path
+    const QString importPath = QStringLiteral("%1/../../../qml")
+            .arg(QCoreApplication::applicationDirPath());
+    QVERIFY2(QFileInfo::exists(importPath),
+             qPrintable(QStringLiteral("Extensionplugin import path does not exist: %1")
+                        .arg(importPath)));
+    m_qmlEngine->addImportPath(importPath);
+    m_qmlEngine->rootContext()->setContextProperty(QStringLiteral("benchmarkModel"), m_model);
+}
+
+void tst_BenchRepeater::init()
+{
+    m_model->setStringList(m_rows);
+}
+
+void tst_BenchRepeater::insertRemoveRow_data()
+{
+    addRebuildColumn();
+}
+
+void tst_BenchRepeater::insertRemoveRow()
+{
+    QFETCH(bool, rebuild);
+
+    QWidgetPtr widget = createWidget();
+    QVERIFY(widget != nullptr);
+
+    QStringList inserted = m_rows;
+    inserted.insert(s_changedRow, QStringLiteral("Inserted"));
+
+    QBENCHMARK {
+        if (rebuild) {
+            this->rebuild(inserted);
+            this->rebuild(m_rows);
+        } else {
+            m_model->insertRows(s_changedRow, 1);
+            m_model->removeRows(s_changedRow, 1);
+        }
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QCOMPARE(widget->layout()->count(), s_rowCount + s_staticItemCount);
+}
+
+void tst_BenchRepeater::moveRow_data()
+{
+    addRebuildColumn();
+}
+
+void tst_BenchRepeater::moveRow()
+{
+    QFETCH(bool, rebuild);
+
+    QWidgetPtr widget = createWidget();
+    QVERIFY(widget != nullptr);
+
+    QStringList moved = m_rows;
+    moved.move(0, s_changedRow);
+
+    if (!m_model->moveRows(QModelIndex(), 0, 1, QModelIndex(), s_changedRow + 1))
+        QSKIP("QStringListModel does not support moving rows in this Qt version");
+    QCOMPARE(m_model->stringList(), moved);
+    m_model->moveRows(QModelIndex(), s_changedRow, 1, QModelIndex(), 0);
+
+    QBENCHMARK {
+        if (rebuild) {
+            this->rebuild(moved);
+            this->rebuild(m_rows);
+        } else {
+            m_model->moveRows(QModelIndex(), 0, 1, QModelIndex(), s_changedRow + 1);
+            m_model->moveRows(QModelIndex(), s_changedRow, 1, QModelIndex(), 0);
+        }
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QCOMPARE(widget->layout()->count(), s_rowCount + s_staticItemCount);
+}
+
+void tst_BenchRepeater::changeRow_data()
+{
+    addRebuildColumn();
+}
+
+void tst_BenchRepeater::changeRow()
+{
+    QFETCH(bool, rebuild);
+
+    QWidgetPtr widget = createWidget();
+    QVERIFY(widget != nullptr);
+
+    QStringList changed = m_rows;
+    changed[s_changedRow] = QStringLiteral("Changed");
+
+    const QModelIndex index = m_model->index(s_changedRow);
+
+    QBENCHMARK {
+        if (rebuild) {
+            this->rebuild(changed);
+            this->rebuild(m_rows);
+        } else {
+            m_model->setData(index, changed.at(s_changedRow));
+            m_model->setData(index, m_rows.at(s_changedRow));
+        }
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QCOMPARE(widget->layout()->count(), s_rowCount + s_staticItemCount);
+}
+
+QWidgetPtr tst_BenchRepeater::createWidget()
+{
+    QQmlComponent component(m_qmlEngine, QUrl(QStringLiteral("qrc:/qml/RepeaterBenchmark.qml")));
+    QWidgetPtr widget(qobject_cast<QWidget*>(component.create()));
+    if (widget == nullptr || widget->layout() == nullptr)
+        return QWidgetPtr();
+
+    if (widget->layout()->count() != s_rowCount + s_staticItemCount)
+        return QWidgetPtr();
+
+    return widget;
+}
+
+void tst_BenchRepeater::rebuild(const QStringList &rows)
+{
+    // setStringList() resets the model, which makes the Repeater recreate all of its widgets
+    m_model->setStringList(rows);
+}
+
+void tst_BenchRepeater::addRebuildColumn()
+{
+    QTest::addColumn<bool>("rebuild");
+    QTest::newRow("incremental") << false;
+    QTest::newRow("rebuild") << true;
+}
+
+QTEST_MAIN(tst_BenchRepeater)
+
+#include "tst_bench_repeater.moc"
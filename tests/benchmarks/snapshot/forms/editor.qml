@@ -0,0 +1,153 @@
+/*
+  editor.qml
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+import QtWidgets 1.0
+
+// examples/editor.qml without bindings and signal handlers, which snapshots refuse
+MainWindow {
+  windowTitle: "Declarative Widget Editor"
+
+  size: "500x300"
+
+  Dialog {
+    size: "300x200"
+    visible: false
+
+    VBoxLayout {
+      Label {
+        text: "Hello World"
+      }
+      DialogButtonBox {
+        standardButtons: DialogButtonBox.Ok
+      }
+    }
+  }
+
+  MenuBar {
+    Menu {
+      title: "File"
+
+      Action {
+        text: "New"
+      }
+
+      Action {
+        text: "Save"
+      }
+
+      Separator {}
+
+      Action {
+        text: "Print"
+      }
+
+      Separator {}
+
+      Action {
+        text: "Close"
+      }
+    }
+
+    Menu {
+      title: "Edit"
+
+      Action {
+        text: "Undo"
+      }
+
+      Action {
+        text: "Redo"
+      }
+
+      Separator {}
+
+      Action {
+        text: "Cut"
+      }
+
+      Action {
+        text: "Copy"
+      }
+
+      Action {
+        text: "Paste"
+      }
+
+      Separator {}
+
+      Action {
+        text: "Select All"
+      }
+    }
+
+    Menu {
+      title: "View"
+
+      Action {
+        text: "Enlarge Font"
+      }
+
+      Action {
+        text: "Shrink Font"
+      }
+    }
+
+    Menu {
+      title: "Help"
+
+      Action {
+        text: "About"
+      }
+
+      Action {
+        text: "About Qt"
+      }
+    }
+  }
+
+  ToolBar {
+    Action {
+      text: "New"
+    }
+
+    Separator {}
+
+    Label {
+      text: "Zoom"
+    }
+  }
+
+  TextEdit {
+    contextMenuPolicy: Qt.ActionsContextMenu
+  }
+
+  StatusBar {
+    Label {
+      StatusBar.stretch: 2
+      text: "Pos:"
+    }
+  }
+}
@@ -0,0 +1,8 @@
+include("$$PWD/../benchmarks.pri")
+
+TARGET = tst_bench_snapshot
+
+SOURCES += tst_bench_snapshot.cpp
+
+# static copies of examples, snapshots refuse forms with bindings or signal handlers
+DEFINES += FORMS_DIR=\\\"$$PWD/forms\\\"
@@ -0,0 +1,352 @@
+/*
+  tst_bench_snapshot.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include "declarativewidgetsdocument.h"
+#include "declarativewidgetssnapshot.h"
+
+#include <QAbstractButton>
+#include <QGroupBox>
+#include <QLabel>
+#include <QRegularExpression>
+#include <QTabWidget>
+
+typedef QSharedPointer<QWidget> QWidgetPtr;
+
+class tst_BenchSnapshot : public QObject
+{
+    Q_OBJECT
+public:
+    tst_BenchSnapshot();
+
+private slots:
+    void initTestCase();
+    void sameWidgets_data();
+    void sameWidgets();
+    void fallbackOnChange();
+    void fallbackOnSiblingChange();
+    void refuseBehavior_data();
+    void refuseBehavior();
+    void qmlOpen_data();
+    void qmlOpen();
+    void coldOpen_data();
+    void coldOpen();
+    void warmOpen_data();
+    void warmOpen();
+
+private:
+    QTemporaryDir m_tempDir;
+
+    void addFileRows();
+    QString snapshotFileName(const QString &qmlFile) const;
+    static bool writeFile(const QString &fileName, const QByteArray &content);
+    static QUrl formUrl(const QString &qmlFile);
+    static QStringList widgetSignature(QWidget *widget);
+};
+
+tst_BenchSnapshot::tst_BenchSnapshot()
+    : QObject()
+{
+}
+
+void tst_BenchSnapshot::initTestCase()
+{
+    QVERIFY(m_tempDir.isValid());
+}
+
+void tst_BenchSnapshot::sameWidgets_data()
+{
+    addFileRows();
+}
+
+void tst_BenchSnapshot::sameWidgets()
+{
+    QFETCH(QString, qmlFile);
+
+    const QString fileName = snapshotFileName(qmlFile);
+    QFile::remove(fileName);
+
+    // the first document creates through QML and writes the snapshot
+    DeclarativeWidgetsDocument qmlDocument(formUrl(qmlFile));
+    qmlDocument.setSnapshotFileName(fileName);
+    QWidgetPtr qmlWidget(qmlDocument.create<QWidget>());
+    QVERIFY(qmlWidget != nullptr);
+
+    const QByteArray sourceHash = DeclarativeWidgetsSnapshot::sourceHash(formUrl(qmlFile));
+    QVERIFY(!sourceHash.isEmpty());
+    QVERIFY(DeclarativeWidgetsSnapshot::isCurrent(fileName, sourceHash));
+
+    QWidgetPtr snapshotWidget(DeclarativeWidgetsSnapshot::load(fileName, sourceHash));
+    QVERIFY(snapshotWidget != nullptr);
+
+    QCOMPARE(widgetSignature(snapshotWidget.data()), widgetSignature(qmlWidget.data()));
+    QCOMPARE(snapshotWidget->windowTitle(), qmlWidget->windowTitle());
+    QCOMPARE(snapshotWidget->size(), qmlWidget->size());
+}
+
+void tst_BenchSnapshot::fallbackOnChange()
+{
+    QFile source(QStringLiteral(FORMS_DIR "/layouts.qml"));
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    QByteArray qml = source.readAll();
+
+    const QString qmlFileName = m_tempDir.path() + QStringLiteral("/changed.qml");
+    const QString fileName = m_tempDir.path() + QStringLiteral("/changed.snapshot");
+
+    QFile copy(qmlFileName);
+    QVERIFY(copy.open(QIODevice::WriteOnly));
+    QVERIFY(copy.write(qml) == qml.size());
+    copy.close();
+
+    const QUrl url = QUrl::fromLocalFile(qmlFileName);
+    {
+        DeclarativeWidgetsDocument document(url);
+        document.setSnapshotFileName(fileName);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+
+    const QByteArray oldHash = DeclarativeWidgetsSnapshot::sourceHash(url);
+    QVERIFY(DeclarativeWidgetsSnapshot::isCurrent(fileName, oldHash));
+
+    // a changed file makes the old snapshot unusable
+    qml.append("\n// changed\n");
+    QVERIFY(copy.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QVERIFY(copy.write(qml) == qml.size());
+    copy.close();
+
+    const QByteArray newHash = DeclarativeWidgetsSnapshot::sourceHash(url);
+    QVERIFY(newHash != oldHash);
+    QVERIFY(!DeclarativeWidgetsSnapshot::isCurrent(fileName, newHash));
+    QVERIFY(DeclarativeWidgetsSnapshot::load(fileName, newHash) == nullptr);
+
+    // so the document falls back to QML and replaces it
+    DeclarativeWidgetsDocument document(url);
+    document.setSnapshotFileName(fileName);
+    QWidgetPtr widget(document.create<QWidget>());
+    QVERIFY(widget != nullptr);
+    QVERIFY(document.engine() != nullptr);
+
+    QVERIFY(DeclarativeWidgetsSnapshot::isCurrent(fileName, newHash));
+}
+
+void tst_BenchSnapshot::fallbackOnSiblingChange()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QUrl url = QUrl::fromLocalFile(dir.path() + QStringLiteral("/main.qml"));
+    QVERIFY(writeFile(url.toLocalFile(), "import QtWidgets 1.0\n\nWidget {\n  Title {}\n}\n"));
+    QVERIFY(writeFile(dir.path() + QStringLiteral("/Title.qml"), "import QtWidgets 1.0\n\nLabel { text: \"A\" }\n"));
+
+    const QByteArray hash = DeclarativeWidgetsSnapshot::sourceHash(url);
+    QVERIFY(!hash.isEmpty());
+
+    // components used without an import are part of the hash
+    QVERIFY(writeFile(dir.path() + QStringLiteral("/Title.qml"), "import QtWidgets 1.0\n\nLabel { text: \"B\" }\n"));
+    const QByteArray changedHash = DeclarativeWidgetsSnapshot::sourceHash(url);
+    QVERIFY(changedHash != hash);
+
+    QVERIFY(writeFile(dir.path() + QStringLiteral("/Other.qml"), "import QtWidgets 1.0\n\nLabel {}\n"));
+    const QByteArray addedHash = DeclarativeWidgetsSnapshot::sourceHash(url);
+    QVERIFY(addedHash != changedHash);
+
+    // files QML does not load are not
+    QVERIFY(writeFile(dir.path() + QStringLiteral("/notes.txt"), "notes\n"));
+    QCOMPARE(DeclarativeWidgetsSnapshot::sourceHash(url), addedHash);
+}
+
+void tst_BenchSnapshot::refuseBehavior_data()
+{
+    QTest::addColumn<QByteArray>("qml");
+
+    QTest::newRow("signal handler")
+            << QByteArray("PushButton { text: \"Quit\"; onClicked: Qt.quit() }");
+    QTest::newRow("binding")
+            << QByteArray("Slider { id: slider }\n  Label { text: slider.value }");
+    QTest::newRow("attached binding")
+            << QByteArray("Label { id: label; text: \"A\" }\n  Label { HBoxLayout.stretch: label.text.length }");
+}
+
+void tst_BenchSnapshot::refuseBehavior()
+{
+    QFETCH(QByteArray, qml);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QUrl url = QUrl::fromLocalFile(dir.path() + QStringLiteral("/form.qml"));
+    const QString fileName = dir.path() + QStringLiteral("/form.snapshot");
+    QVERIFY(writeFile(url.toLocalFile(), "import QtWidgets 1.0\n\nWidget {\n HBoxLayout {\n  "
+                                        + qml + "\n }\n}\n"));
+
+    // a restored form would silently lose the behavior, so the document keeps creating through QML
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("^Unable to write snapshot")));
+
+    DeclarativeWidgetsDocument document(url);
+    document.setSnapshotFileName(fileName);
+    QWidgetPtr widget(document.create<QWidget>());
+    QVERIFY(widget != nullptr);
+    QVERIFY(!QFile::exists(fileName));
+
+    QString errorString;
+    QVERIFY(!DeclarativeWidgetsSnapshot::save(widget.data(), DeclarativeWidgetsSnapshot::sourceHash(url),
+                                              fileName, &errorString));
+    QVERIFY2(errorString.contains(QStringLiteral("bindings or signal handlers")), qPrintable(errorString));
+    QVERIFY(!QFile::exists(fileName));
+}
+
+void tst_BenchSnapshot::qmlOpen_data()
+{
+    addFileRows();
+}
+
+void tst_BenchSnapshot::qmlOpen()
+{
+    QFETCH(QString, qmlFile);
+
+    QBENCHMARK {
+        DeclarativeWidgetsDocument document(formUrl(qmlFile));
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchSnapshot::coldOpen_data()
+{
+    addFileRows();
+}
+
+void tst_BenchSnapshot::coldOpen()
+{
+    QFETCH(QString, qmlFile);
+
+    const QString fileName = snapshotFileName(qmlFile);
+
+    // creating through QML and writing the snapshot
+    QBENCHMARK {
+        QFile::remove(fileName);
+
+        DeclarativeWidgetsDocument document(formUrl(qmlFile));
+        document.setSnapshotFileName(fileName);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+
+    QVERIFY(QFile::exists(fileName));
+}
+
+void tst_BenchSnapshot::warmOpen_data()
+{
+    addFileRows();
+}
+
+void tst_BenchSnapshot::warmOpen()
+{
+    QFETCH(QString, qmlFile);
+
+    const QString fileName = snapshotFileName(qmlFile);
+    {
+        DeclarativeWidgetsDocument document(formUrl(qmlFile));
+        document.setSnapshotFileName(fileName);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+
+    // hashing the QML file and restoring the snapshot, without the QML engine
+    QBENCHMARK {
+        DeclarativeWidgetsDocument document(formUrl(qmlFile));
+        document.setSnapshotFileName(fileName);
+        QWidgetPtr widget(document.create<QWidget>());
+        QVERIFY(widget != nullptr);
+    }
+}
+
+void tst_BenchSnapshot::addFileRows()
+{
+    QTest::addColumn<QString>("qmlFile");
+
+    QTest::newRow("layouts") << QStringLiteral("layouts.qml");
+    QTest::newRow("editor") << QStringLiteral("editor.qml");
+}
+
+QString tst_BenchSnapshot::snapshotFileName(const QString &qmlFile) const
+{
+    return m_tempDir.path() + QLatin1Char('/') + QFileInfo(qmlFile).completeBaseName() + QStringLiteral(".snapshot");
+}
+
+bool tst_BenchSnapshot::writeFile(const QString &fileName, const QByteArray &content)
+{
+    QFile file(fileName);
+    return file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(content) == content.size();
+}
+
+QUrl tst_BenchSnapshot::formUrl(const QString &qmlFile)
+{
+    return QUrl::fromLocalFile(QStringLiteral(FORMS_DIR "/") + qmlFile);
+}
+
+QStringList tst_BenchSnapshot::widgetSignature(QWidget *widget)
+{
+    QStringList signature;
+
+    Q_FOREACH (QWidget *child, QList<QWidget*>() << widget << widget->findChildren<QWidget*>()) {
+        // the QML types are subclasses of the widgets the snapshot restores
+        const QMetaObject *metaObject = child->metaObject();
+        while (metaObject->className()[0] != 'Q') {
+            metaObject = metaObject->superClass();
+        }
+
+        QString text;
+        if (QAbstractButton *button = qobject_cast<QAbstractButton*>(child)) {
+            text = button->text();
+        } else if (QLabel *label = qobject_cast<QLabel*>(child)) {
+            text = label->text();
+        } else if (QGroupBox *groupBox = qobject_cast<QGroupBox*>(child)) {
+            text = groupBox->title();
+        }
+
+        signature << QStringLiteral("%1:%2").arg(QLatin1String(metaObject->className()), text);
+
+        Q_FOREACH (QAction *action, child->actions()) {
+            signature << QStringLiteral("action:%1").arg(action->text());
+        }
+
+        if (QTabWidget *tabWidget = qobject_cast<QTabWidget*>(child)) {
+            for (int i = 0; i < tabWidget->count(); ++i) {
+                signature << QStringLiteral("tab:%1").arg(tabWidget->tabText(i));
+            }
+        }
+    }
+
+    signature.sort();
+    return signature;
+}
+
+QTEST_MAIN(tst_BenchSnapshot)
+
+#include "tst_bench_snapshot.moc"
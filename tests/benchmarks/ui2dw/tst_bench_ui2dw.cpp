@@ -0,0 +1,483 @@
+/*
+  tst_bench_ui2dw.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <QtTest>
+
+#include "conversioncache.h"
+#include "converter.h"
+#include "memoryusage.h"
+#include "stagetimings.h"
+#include "uigenerator.h"
+#include "watchconverter.h"
+#include "widgetdefaults.h"
+
+#include <QBuffer>
+#include <QSaveFile>
+#include <QSettings>
+#include <QTemporaryDir>
+#include <QXmlStreamReader>
+
+// Corpus of generated files with 50 to 500 group box sections each
+static const int s_corpusFileCount = 10;
+static const int s_minSectionCount = 50;
+static const int s_sectionCountStep = 50;
+
+// Every generated section contains a group box with 20 widgets
+static const int s_widgetsPerSection = 21;
+
+// Allowed regression against the baseline in percent, unless set by UI2DW_BASELINE_TOLERANCE
+static const int s_defaultBaselineTolerance = 15;
+
+Q_DECLARE_METATYPE(VisitorPipeline::Mode)
+Q_DECLARE_METATYPE(UiGeneratorOptions)
+
+class tst_BenchUi2dw : public QObject
+{
+    Q_OBJECT
+public:
+    tst_BenchUi2dw();
+
+private slots:
+    void initTestCase();
+    void throughput_data();
+    void throughput();
+    void pipelineOutputMatches();
+    void optimizedOutputMatches();
+    void convertCorpus_data();
+    void convertCorpus();
+    void stageTimings_data();
+    void stageTimings();
+    void cachedConversion();
+    void largeForm_data();
+    void largeForm();
+    void watchedConversion();
+
+private:
+    QList<QByteArray> m_corpus;
+
+    static bool convert(const QByteArray &input, VisitorPipeline::Mode mode, QByteArray *output,
+                        StageTimings *timings = nullptr, bool optimize = false);
+    void addModeColumn();
+    static bool saveFile(const QString &fileName, const QByteArray &data);
+    static UiGeneratorOptions generatorOptions(int sectionCount, int rowsPerSection, int nestingDepth, int actionCount);
+    static int elementCount(const QByteArray &input);
+    static void compareWithBaseline(int nodeCount, double filesPerSecond, double nodesPerSecond, double bytesPerNode);
+};
+
+tst_BenchUi2dw::tst_BenchUi2dw()
+    : QObject()
+{
+}
+
+void tst_BenchUi2dw::initTestCase()
+{
+    WidgetDefaults::initialize();
+
+    for (int i = 0; i < s_corpusFileCount; ++i)
+        m_corpus << generateUi(s_minSectionCount + i * s_sectionCountStep);
+}
+
+void tst_BenchUi2dw::throughput_data()
+{
+    QTest::addColumn<UiGeneratorOptions>("options");
+    QTest::addColumn<int>("fileCount");
+
+    QTest::newRow("small forms") << generatorOptions(5, 4, 0, 0) << 200;
+    QTest::newRow("nested forms") << generatorOptions(20, 4, 4, 8) << 50;
+    QTest::newRow("large forms") << generatorOptions(200, 8, 2, 20) << 5;
+}
+
+void tst_BenchUi2dw::throughput()
+{
+    QFETCH(UiGeneratorOptions, options);
+    QFETCH(int, fileCount);
+
+    const QByteArray input = generateUi(options);
+    const int nodeCount = elementCount(input);
+
+    // best of three runs, the first one also warms up allocators and caches
+    qint64 best = -1;
+    for (int run = 0; run < 3; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int i = 0; i < fileCount; ++i) {
+            QByteArray output;
+            QVERIFY(convert(input, VisitorPipeline::Fused, &output));
+        }
+
+        const qint64 elapsed = timer.nsecsElapsed();
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    const double seconds = qMax<qint64>(1, best) / 1000000000.0;
+    const double filesPerSecond = fileCount / seconds;
+    const double nodesPerSecond = double(fileCount) * nodeCount / seconds;
+
+    // the tree of one conversion, the process wide peak also contains the earlier test functions
+    QBuffer inputBuffer;
+    inputBuffer.setData(input);
+    inputBuffer.open(QIODevice::ReadOnly);
+
+    QByteArray output;
+    QBuffer outputBuffer(&output);
+    outputBuffer.open(QIODevice::WriteOnly);
+
+    Converter converter;
+    QVERIFY(converter.convert(&inputBuffer, &outputBuffer));
+    const double bytesPerNode = double(converter.treeMemoryUsage()) / nodeCount;
+
+    qDebug("%d nodes per file: %.1f files/s, %.0f nodes/s, node tree %.1f bytes per node",
+           nodeCount, filesPerSecond, nodesPerSecond, bytesPerNode);
+
+    compareWithBaseline(nodeCount, filesPerSecond, nodesPerSecond, bytesPerNode);
+}
+
+void tst_BenchUi2dw::pipelineOutputMatches()
+{
+    Q_FOREACH (const QByteArray &input, m_corpus) {
+        QByteArray sequential;
+        QVERIFY(convert(input, VisitorPipeline::Sequential, &sequential));
+
+        QByteArray fused;
+        QVERIFY(convert(input, VisitorPipeline::Fused, &fused));
+
+        QVERIFY(!fused.isEmpty());
+        QCOMPARE(fused, sequential);
+    }
+}
+
+void tst_BenchUi2dw::optimizedOutputMatches()
+{
+    Q_FOREACH (const QByteArray &input, m_corpus) {
+        QByteArray sequential;
+        QVERIFY(convert(input, VisitorPipeline::Sequential, &sequential, nullptr, true));
+
+        QByteArray fused;
+        QVERIFY(convert(input, VisitorPipeline::Fused, &fused, nullptr, true));
+
+        QByteArray unoptimized;
+        QVERIFY(convert(input, VisitorPipeline::Fused, &unoptimized));
+
+        QVERIFY(!fused.isEmpty());
+        QCOMPARE(fused, sequential);
+        QVERIFY(fused.size() <= unoptimized.size());
+    }
+}
+
+void tst_BenchUi2dw::convertCorpus_data()
+{
+    addModeColumn();
+}
+
+void tst_BenchUi2dw::convertCorpus()
+{
+    QFETCH(VisitorPipeline::Mode, mode);
+
+    QBENCHMARK {
+        Q_FOREACH (const QByteArray &input, m_corpus) {
+            QByteArray output;
+            QVERIFY(convert(input, mode, &output));
+        }
+    }
+}
+
+void tst_BenchUi2dw::stageTimings_data()
+{
+    addModeColumn();
+}
+
+void tst_BenchUi2dw::stageTimings()
+{
+    QFETCH(VisitorPipeline::Mode, mode);
+
+    StageTimings timings;
+    Q_FOREACH (const QByteArray &input, m_corpus) {
+        QByteArray output;
+        QVERIFY(convert(input, mode, &output, &timings));
+    }
+
+    QCOMPARE(timings.traversals(), m_corpus.count() * (mode == VisitorPipeline::Fused ? 3 : 9));
+
+    Q_FOREACH (const QString &stage, timings.stages())
+        qDebug("%-24s %10.3f ms", qPrintable(stage), timings.time(stage) / 1000000.0);
+}
+
+void tst_BenchUi2dw::cachedConversion()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    QStringList inputFileNames;
+    for (int i = 0; i < m_corpus.count(); ++i) {
+        const QString inputFileName = dir.path() + QStringLiteral("/form%1.ui").arg(i);
+        QFile inputFile(inputFileName);
+        QVERIFY(inputFile.open(QIODevice::WriteOnly));
+        inputFile.write(m_corpus.at(i));
+        inputFileNames << inputFileName;
+    }
+
+    const ConversionCache cache(dir.path() + QStringLiteral("/cache"));
+
+    Converter converter;
+    converter.setConversionCache(&cache);
+
+    // cold cache, every file is converted
+    Q_FOREACH (const QString &inputFileName, inputFileNames) {
+        QVERIFY(converter.convert(inputFileName, inputFileName + QStringLiteral(".qml")));
+        QVERIFY(!converter.isCacheHit());
+    }
+
+    QBENCHMARK {
+        Q_FOREACH (const QString &inputFileName, inputFileNames) {
+            QVERIFY(converter.convert(inputFileName, inputFileName + QStringLiteral(".qml")));
+            QVERIFY(converter.isCacheHit());
+        }
+    }
+
+    // a cached result is the same as a fresh conversion
+    QByteArray expected;
+    QVERIFY(convert(m_corpus.first(), VisitorPipeline::Fused, &expected));
+
+    QFile outputFile(inputFileNames.first() + QStringLiteral(".qml"));
+    QVERIFY(outputFile.open(QIODevice::ReadOnly));
+    QCOMPARE(outputFile.readAll(), expected);
+}
+
+void tst_BenchUi2dw::largeForm_data()
+{
+    QTest::addColumn<int>("sectionCount");
+
+    Q_FOREACH (int sectionCount, QList<int>() << 500 << 1000 << 2000) {
+        const QByteArray name = QByteArray::number(sectionCount * s_widgetsPerSection) + " widgets";
+        QTest::newRow(name.constData()) << sectionCount;
+    }
+}
+
+void tst_BenchUi2dw::largeForm()
+{
+    QFETCH(int, sectionCount);
+
+    const QByteArray input = generateUi(sectionCount);
+
+    qint64 treeMemoryUsage = 0;
+    QBENCHMARK {
+        QBuffer inputBuffer;
+        inputBuffer.setData(input);
+        inputBuffer.open(QIODevice::ReadOnly);
+
+        QByteArray output;
+        QBuffer outputBuffer(&output);
+        outputBuffer.open(QIODevice::WriteOnly);
+
+        Converter converter;
+        QVERIFY(converter.convert(&inputBuffer, &outputBuffer));
+        treeMemoryUsage = converter.treeMemoryUsage();
+    }
+
+    qDebug("input %lld KiB, node tree %lld KiB, peak memory usage %lld KiB",
+           qint64(input.size()) / 1024, treeMemoryUsage / 1024, peakMemoryUsage() / 1024);
+}
+
+bool tst_BenchUi2dw::convert(const QByteArray &input, VisitorPipeline::Mode mode, QByteArray *output,
+                             StageTimings *timings, bool optimize)
+{
+    QBuffer inputBuffer;
+    inputBuffer.setData(input);
+    inputBuffer.open(QIODevice::ReadOnly);
+
+    QBuffer outputBuffer(output);
+    outputBuffer.open(QIODevice::WriteOnly);
+
+    Converter converter;
+    converter.setPipelineMode(mode);
+    converter.setStageTimings(timings);
+    converter.setOptimizationEnabled(optimize);
+
+    return converter.convert(&inputBuffer, &outputBuffer);
+}
+
+void tst_BenchUi2dw::watchedConversion()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString inputDirectory = dir.path() + QStringLiteral("/forms");
+    QVERIFY(QDir().mkpath(inputDirectory));
+
+    const QString inputFileName = inputDirectory + QStringLiteral("/form.ui");
+    const QString outputFileName = dir.path() + QStringLiteral("/output/form.qml");
+    QVERIFY(saveFile(inputFileName, m_corpus.at(0)));
+
+    WatchConverter watchConverter;
+    watchConverter.setOutputDirectory(dir.path() + QStringLiteral("/output"));
+    watchConverter.setCoalescingInterval(10);
+    QVERIFY(watchConverter.addInput(inputDirectory));
+
+    QSignalSpy convertedSpy(&watchConverter, SIGNAL(fileConverted(QString,QString,qint64)));
+    QSignalSpy failedSpy(&watchConverter, SIGNAL(conversionFailed(QString,QString)));
+
+    watchConverter.start();
+    QCOMPARE(convertedSpy.count(), 1);
+    QCOMPARE(convertedSpy.first().at(1).toString(), outputFileName);
+
+    // saving without changes does not convert again
+    QVERIFY(saveFile(inputFileName, m_corpus.at(0)));
+    QTest::qWait(200);
+    QCOMPARE(convertedSpy.count(), 1);
+
+    // every save replaces the file, which has to be watched again each time
+    for (int i = 1; i < 3; ++i) {
+        QVERIFY(saveFile(inputFileName, m_corpus.at(i)));
+        QTRY_COMPARE(convertedSpy.count(), i + 1);
+        qDebug("reconverted in %lld ms", convertedSpy.last().at(2).toLongLong());
+
+        QByteArray expected;
+        QVERIFY(convert(m_corpus.at(i), VisitorPipeline::Fused, &expected));
+
+        QFile outputFile(outputFileName);
+        QVERIFY(outputFile.open(QIODevice::ReadOnly));
+        QCOMPARE(outputFile.readAll(), expected);
+    }
+
+    // new files are picked up as well
+    QVERIFY(saveFile(inputDirectory + QStringLiteral("/sub/other.ui"), m_corpus.at(0)));
+    QTRY_VERIFY(QFile::exists(dir.path() + QStringLiteral("/output/sub/other.qml")));
+    QCOMPARE(watchConverter.fileCount(), 2);
+
+    QCOMPARE(failedSpy.count(), 0);
+}
+
+void tst_BenchUi2dw::addModeColumn()
+{
+    QTest::addColumn<VisitorPipeline::Mode>("mode");
+    QTest::newRow("sequential") << VisitorPipeline::Sequential;
+    QTest::newRow("fused") << VisitorPipeline::Fused;
+}
+
+bool tst_BenchUi2dw::saveFile(const QString &fileName, const QByteArray &data)
+{
+    if (!QDir().mkpath(QFileInfo(fileName).path())) {
+        return false;
+    }
+
+    QSaveFile file(fileName);
+    return file.open(QIODevice::WriteOnly) && file.write(data) == data.size() && file.commit();
+}
+
+UiGeneratorOptions tst_BenchUi2dw::generatorOptions(int sectionCount, int rowsPerSection, int nestingDepth,
+                                                    int actionCount)
+{
+    UiGeneratorOptions options;
+    options.sectionCount = sectionCount;
+    options.rowsPerSection = rowsPerSection;
+    options.nestingDepth = nestingDepth;
+    options.actionCount = actionCount;
+
+    return options;
+}
+
+int tst_BenchUi2dw::elementCount(const QByteArray &input)
+{
+    int count = 0;
+
+    QXmlStreamReader reader(input);
+    while (!reader.atEnd()) {
+        if (reader.readNext() == QXmlStreamReader::StartElement) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+// Throughput depends on the machine, so it is only compared against a baseline file passed in
+// UI2DW_BASELINE_FILE, e.g. one kept for a CI machine. UI2DW_UPDATE_BASELINE records that file.
+// Timings are too noisy to fail a test run, a slower run only warns. The node tree size per
+// XML node does not depend on the machine or the load and fails when it grows
+void tst_BenchUi2dw::compareWithBaseline(int nodeCount, double filesPerSecond, double nodesPerSecond,
+                                         double bytesPerNode)
+{
+    if (!qEnvironmentVariableIsSet("UI2DW_BASELINE_FILE")) {
+        return;
+    }
+
+    const QString fileName = QString::fromLocal8Bit(qgetenv("UI2DW_BASELINE_FILE"));
+
+    QSettings baseline(fileName, QSettings::IniFormat);
+    baseline.beginGroup(QString::fromLatin1(QTest::currentDataTag()));
+
+    if (qEnvironmentVariableIsSet("UI2DW_UPDATE_BASELINE")) {
+        baseline.setValue(QStringLiteral("nodes"), nodeCount);
+        baseline.setValue(QStringLiteral("filesPerSecond"), filesPerSecond);
+        baseline.setValue(QStringLiteral("nodesPerSecond"), nodesPerSecond);
+        baseline.setValue(QStringLiteral("bytesPerNode"), bytesPerNode);
+        baseline.sync();
+        QVERIFY2(baseline.status() == QSettings::NoError,
+                 qPrintable(QStringLiteral("can not write baseline %1").arg(fileName)));
+
+        qDebug("recorded baseline in %s", qPrintable(fileName));
+        return;
+    }
+
+    QVERIFY2(baseline.contains(QStringLiteral("nodes")),
+             qPrintable(QStringLiteral("no baseline in %1, record it with UI2DW_UPDATE_BASELINE").arg(fileName)));
+
+    // a different generator makes the old values meaningless
+    QVERIFY2(baseline.value(QStringLiteral("nodes")).toInt() == nodeCount,
+             qPrintable(QStringLiteral("%1 nodes per file, baseline %2 nodes, record it again with UI2DW_UPDATE_BASELINE")
+                        .arg(nodeCount).arg(baseline.value(QStringLiteral("nodes")).toInt())));
+
+    bool ok = false;
+    int tolerance = qEnvironmentVariableIntValue("UI2DW_BASELINE_TOLERANCE", &ok);
+    if (!ok) {
+        tolerance = s_defaultBaselineTolerance;
+    }
+
+    const double slowest = 1.0 - tolerance / 100.0;
+    const double largest = 1.0 + tolerance / 100.0;
+
+    const double baselineFilesPerSecond = baseline.value(QStringLiteral("filesPerSecond")).toDouble();
+    const double baselineNodesPerSecond = baseline.value(QStringLiteral("nodesPerSecond")).toDouble();
+    const double baselineBytesPerNode = baseline.value(QStringLiteral("bytesPerNode")).toDouble();
+
+    if (filesPerSecond < baselineFilesPerSecond * slowest) {
+        qWarning("%.1f files/s, baseline %.1f files/s", filesPerSecond, baselineFilesPerSecond);
+    }
+    if (nodesPerSecond < baselineNodesPerSecond * slowest) {
+        qWarning("%.0f nodes/s, baseline %.0f nodes/s", nodesPerSecond, baselineNodesPerSecond);
+    }
+
+    QVERIFY2(bytesPerNode <= baselineBytesPerNode * largest,
+             qPrintable(QStringLiteral("node tree %1 bytes per node, baseline %2 bytes per node")
+                        .arg(bytesPerNode).arg(baselineBytesPerNode)));
+}
+
+QTEST_MAIN(tst_BenchUi2dw)
+
+#include "tst_bench_ui2dw.moc"
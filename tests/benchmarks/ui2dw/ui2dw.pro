@@ -0,0 +1,14 @@
+QT += testlib
+
+CONFIG += qt console warn_on depend_includepath testcase
+macos:CONFIG -= app_bundle
+
+TARGET = tst_bench_ui2dw
+
+include("$$PWD/../../../ui2dw/ui2dw.pri")
+
+SOURCES += tst_bench_ui2dw.cpp \
+    uigenerator.cpp
+
+HEADERS += \
+    uigenerator.h
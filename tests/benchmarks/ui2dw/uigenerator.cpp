@@ -0,0 +1,348 @@
+/*
+  uigenerator.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "uigenerator.h"
+
+#include <QStringList>
+#include <QXmlStreamWriter>
+
+UiGeneratorOptions::UiGeneratorOptions()
+    : sectionCount(1)
+    , rowsPerSection(4)
+    , nestingDepth(0)
+    , actionCount(0)
+{
+}
+
+static void writeProperty(QXmlStreamWriter &writer, const QString &name, const QString &type, const QString &value)
+{
+    writer.writeStartElement(QStringLiteral("property"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+    writer.writeTextElement(type, value);
+    writer.writeEndElement();
+}
+
+static void writeMargins(QXmlStreamWriter &writer, int margin)
+{
+    writeProperty(writer, QStringLiteral("leftMargin"), QStringLiteral("number"), QString::number(margin));
+    writeProperty(writer, QStringLiteral("topMargin"), QStringLiteral("number"), QString::number(margin));
+    writeProperty(writer, QStringLiteral("rightMargin"), QStringLiteral("number"), QString::number(margin));
+    writeProperty(writer, QStringLiteral("bottomMargin"), QStringLiteral("number"), QString::number(margin));
+}
+
+static void writeLabel(QXmlStreamWriter &writer, const QString &name, const QString &text, const QString &buddy)
+{
+    writer.writeStartElement(QStringLiteral("widget"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QLabel"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+
+    writeProperty(writer, QStringLiteral("text"), QStringLiteral("string"), text);
+    writeProperty(writer, QStringLiteral("buddy"), QStringLiteral("cstring"), buddy);
+
+    writer.writeStartElement(QStringLiteral("property"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("alignment"));
+    writer.writeTextElement(QStringLiteral("set"), QStringLiteral("Qt::AlignRight|Qt::AlignVCenter"));
+    writer.writeEndElement();
+
+    writer.writeStartElement(QStringLiteral("property"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("font"));
+    writer.writeStartElement(QStringLiteral("font"));
+    writer.writeTextElement(QStringLiteral("pointsize"), QStringLiteral("10"));
+    writer.writeTextElement(QStringLiteral("weight"), QStringLiteral("75"));
+    writer.writeTextElement(QStringLiteral("bold"), QStringLiteral("true"));
+    writer.writeTextElement(QStringLiteral("kerning"), QStringLiteral("false"));
+    writer.writeEndElement();
+    writer.writeEndElement();
+
+    writer.writeEndElement();
+}
+
+static void writeLineEdit(QXmlStreamWriter &writer, const QString &name)
+{
+    writer.writeStartElement(QStringLiteral("widget"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QLineEdit"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+
+    writeProperty(writer, QStringLiteral("focusPolicy"), QStringLiteral("enum"), QStringLiteral("Qt::StrongFocus"));
+    writeProperty(writer, QStringLiteral("echoMode"), QStringLiteral("enum"), QStringLiteral("QLineEdit::Normal"));
+    writeProperty(writer, QStringLiteral("placeholderText"), QStringLiteral("string"), name);
+
+    writer.writeEndElement();
+}
+
+static void writeButton(QXmlStreamWriter &writer, const QString &name)
+{
+    writer.writeStartElement(QStringLiteral("widget"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QPushButton"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+
+    writeProperty(writer, QStringLiteral("text"), QStringLiteral("string"), QStringLiteral("Clear"));
+    writeProperty(writer, QStringLiteral("default"), QStringLiteral("bool"), QStringLiteral("false"));
+
+    writer.writeEndElement();
+}
+
+static void writeSpacer(QXmlStreamWriter &writer, const QString &name)
+{
+    writer.writeStartElement(QStringLiteral("spacer"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+    writeProperty(writer, QStringLiteral("orientation"), QStringLiteral("enum"), QStringLiteral("Qt::Vertical"));
+    writer.writeEndElement();
+}
+
+static void writeCheckBox(QXmlStreamWriter &writer, const QString &name)
+{
+    writer.writeStartElement(QStringLiteral("widget"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QCheckBox"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+
+    writeProperty(writer, QStringLiteral("text"), QStringLiteral("string"), name);
+    writeProperty(writer, QStringLiteral("checked"), QStringLiteral("bool"), QStringLiteral("true"));
+
+    writer.writeEndElement();
+}
+
+// box layouts alternating in direction down to depth, with a check box in front of the next level
+static void writeNestedLayout(QXmlStreamWriter &writer, const QString &suffix, int level, int depth,
+                              QStringList *checkBoxes)
+{
+    const QString levelSuffix = suffix + QLatin1Char('_') + QString::number(level);
+    const QString checkBox = QStringLiteral("nestedCheckBox") + levelSuffix;
+    checkBoxes->append(checkBox);
+
+    writer.writeStartElement(QStringLiteral("layout"));
+    writer.writeAttribute(QStringLiteral("class"), level % 2 == 0 ? QStringLiteral("QHBoxLayout") : QStringLiteral("QVBoxLayout"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("nestedLayout") + levelSuffix);
+    writeProperty(writer, QStringLiteral("spacing"), QStringLiteral("number"), QString::number(level + 2));
+
+    writer.writeStartElement(QStringLiteral("item"));
+    writeCheckBox(writer, checkBox);
+    writer.writeEndElement();
+
+    if (level + 1 < depth) {
+        writer.writeStartElement(QStringLiteral("item"));
+        writeNestedLayout(writer, suffix, level + 1, depth, checkBoxes);
+        writer.writeEndElement();
+    }
+
+    writer.writeEndElement();
+}
+
+static void writeAction(QXmlStreamWriter &writer, const QString &name, int index)
+{
+    writer.writeStartElement(QStringLiteral("action"));
+    writer.writeAttribute(QStringLiteral("name"), name);
+
+    writeProperty(writer, QStringLiteral("checkable"), QStringLiteral("bool"), QStringLiteral("true"));
+    writeProperty(writer, QStringLiteral("text"), QStringLiteral("string"), QStringLiteral("Action %1").arg(index));
+    writeProperty(writer, QStringLiteral("shortcut"), QStringLiteral("string"), QStringLiteral("Ctrl+%1").arg(index % 10));
+
+    writer.writeEndElement();
+}
+
+static void writeConnection(QXmlStreamWriter &writer, const QString &sender, const QString &signal,
+                            const QString &receiver, const QString &slot)
+{
+    writer.writeStartElement(QStringLiteral("connection"));
+    writer.writeTextElement(QStringLiteral("sender"), sender);
+    writer.writeTextElement(QStringLiteral("signal"), signal);
+    writer.writeTextElement(QStringLiteral("receiver"), receiver);
+    writer.writeTextElement(QStringLiteral("slot"), slot);
+    writer.writeEndElement();
+}
+
+QByteArray generateUi(const UiGeneratorOptions &options)
+{
+    const int sectionCount = options.sectionCount;
+    const int rowsPerSection = options.rowsPerSection;
+
+    QByteArray result;
+    QXmlStreamWriter writer(&result);
+    writer.setAutoFormatting(true);
+
+    writer.writeStartDocument();
+    writer.writeStartElement(QStringLiteral("ui"));
+    writer.writeAttribute(QStringLiteral("version"), QStringLiteral("4.0"));
+    writer.writeTextElement(QStringLiteral("class"), QStringLiteral("Form"));
+
+    writer.writeStartElement(QStringLiteral("widget"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QWidget"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("Form"));
+    writeProperty(writer, QStringLiteral("windowTitle"), QStringLiteral("string"), QStringLiteral("Generated"));
+
+    writer.writeStartElement(QStringLiteral("layout"));
+    writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QVBoxLayout"));
+    writer.writeAttribute(QStringLiteral("name"), QStringLiteral("mainLayout"));
+    writeProperty(writer, QStringLiteral("margin"), QStringLiteral("number"), QStringLiteral("6"));
+
+    QStringList lineEdits;
+    QStringList buttons;
+    QStringList checkBoxes;
+    QStringList actionReceivers;
+
+    for (int section = 0; section < sectionCount; ++section) {
+        const QString suffix = QString::number(section);
+
+        writer.writeStartElement(QStringLiteral("item"));
+        writer.writeStartElement(QStringLiteral("widget"));
+        writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QGroupBox"));
+        writer.writeAttribute(QStringLiteral("name"), QStringLiteral("groupBox") + suffix);
+        writeProperty(writer, QStringLiteral("title"), QStringLiteral("string"), QStringLiteral("Section ") + suffix);
+
+        writer.writeStartElement(QStringLiteral("layout"));
+        writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QVBoxLayout"));
+        writer.writeAttribute(QStringLiteral("name"), QStringLiteral("sectionLayout") + suffix);
+
+        // grid part
+        writer.writeStartElement(QStringLiteral("item"));
+        writer.writeStartElement(QStringLiteral("layout"));
+        writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QGridLayout"));
+        writer.writeAttribute(QStringLiteral("name"), QStringLiteral("gridLayout") + suffix);
+        writeMargins(writer, 4);
+
+        for (int row = 0; row < rowsPerSection; ++row) {
+            const QString rowSuffix = suffix + QLatin1Char('_') + QString::number(row);
+            const QString lineEdit = QStringLiteral("gridLineEdit") + rowSuffix;
+            const QString button = QStringLiteral("gridButton") + rowSuffix;
+            lineEdits << lineEdit;
+            buttons << button;
+
+            writer.writeStartElement(QStringLiteral("item"));
+            writer.writeAttribute(QStringLiteral("row"), QString::number(row));
+            writer.writeAttribute(QStringLiteral("column"), QStringLiteral("0"));
+            writeLabel(writer, QStringLiteral("gridLabel") + rowSuffix, QStringLiteral("Grid ") + rowSuffix, lineEdit);
+            writer.writeEndElement();
+
+            writer.writeStartElement(QStringLiteral("item"));
+            writer.writeAttribute(QStringLiteral("row"), QString::number(row));
+            writer.writeAttribute(QStringLiteral("column"), QStringLiteral("1"));
+            writeLineEdit(writer, lineEdit);
+            writer.writeEndElement();
+
+            writer.writeStartElement(QStringLiteral("item"));
+            writer.writeAttribute(QStringLiteral("row"), QString::number(row));
+            writer.writeAttribute(QStringLiteral("column"), QStringLiteral("2"));
+            writer.writeAttribute(QStringLiteral("colspan"), QStringLiteral("2"));
+            writeButton(writer, button);
+            writer.writeEndElement();
+        }
+
+        writer.writeEndElement(); // layout
+        writer.writeEndElement(); // item
+
+        // form part
+        writer.writeStartElement(QStringLiteral("item"));
+        writer.writeStartElement(QStringLiteral("layout"));
+        writer.writeAttribute(QStringLiteral("class"), QStringLiteral("QFormLayout"));
+        writer.writeAttribute(QStringLiteral("name"), QStringLiteral("formLayout") + suffix);
+
+        for (int row = 0; row < rowsPerSection; ++row) {
+            const QString rowSuffix = suffix + QLatin1Char('_') + QString::number(row);
+            const QString lineEdit = QStringLiteral("formLineEdit") + rowSuffix;
+            lineEdits << lineEdit;
+
+            writer.writeStartElement(QStringLiteral("item"));
+            writer.writeAttribute(QStringLiteral("row"), QString::number(row));
+            writer.writeAttribute(QStringLiteral("column"), QStringLiteral("0"));
+            writeLabel(writer, QStringLiteral("formLabel") + rowSuffix, QStringLiteral("Form ") + rowSuffix, lineEdit);
+            writer.writeEndElement();
+
+            writer.writeStartElement(QStringLiteral("item"));
+            writer.writeAttribute(QStringLiteral("row"), QString::number(row));
+            writer.writeAttribute(QStringLiteral("column"), QStringLiteral("1"));
+            writeLineEdit(writer, lineEdit);
+            writer.writeEndElement();
+        }
+
+        writer.writeEndElement(); // layout
+        writer.writeEndElement(); // item
+
+        // nested part
+        if (options.nestingDepth > 0) {
+            writer.writeStartElement(QStringLiteral("item"));
+            writeNestedLayout(writer, suffix, 0, options.nestingDepth, &checkBoxes);
+            writer.writeEndElement();
+        }
+
+        writer.writeStartElement(QStringLiteral("item"));
+        writeSpacer(writer, QStringLiteral("verticalSpacer") + suffix);
+        writer.writeEndElement();
+
+        writer.writeEndElement(); // layout
+
+        if (options.actionCount > 0) {
+            const int action = section % options.actionCount;
+            if (action == actionReceivers.count()) {
+                actionReceivers << QStringLiteral("groupBox") + suffix;
+            }
+
+            writer.writeEmptyElement(QStringLiteral("addaction"));
+            writer.writeAttribute(QStringLiteral("name"), QStringLiteral("action") + QString::number(action));
+        }
+
+        writer.writeEndElement(); // widget
+        writer.writeEndElement(); // item
+    }
+
+    writer.writeEndElement(); // layout
+
+    for (int i = 0; i < options.actionCount; ++i) {
+        writeAction(writer, QStringLiteral("action") + QString::number(i), i);
+    }
+
+    writer.writeEndElement(); // widget
+
+    writer.writeStartElement(QStringLiteral("tabstops"));
+    Q_FOREACH (const QString &tabStop, lineEdits + checkBoxes) {
+        writer.writeTextElement(QStringLiteral("tabstop"), tabStop);
+    }
+    writer.writeEndElement();
+
+    writer.writeEmptyElement(QStringLiteral("resources"));
+
+    writer.writeStartElement(QStringLiteral("connections"));
+    for (int i = 0; i < buttons.count(); ++i) {
+        writeConnection(writer, buttons[i], QStringLiteral("clicked()"), lineEdits[i], QStringLiteral("clear()"));
+    }
+    for (int i = 0; i < actionReceivers.count(); ++i) {
+        writeConnection(writer, QStringLiteral("action") + QString::number(i), QStringLiteral("toggled(bool)"),
+                        actionReceivers[i], QStringLiteral("setEnabled(bool)"));
+    }
+    writer.writeEndElement();
+
+    writer.writeEndElement(); // ui
+    writer.writeEndDocument();
+
+    return result;
+}
+
+QByteArray generateUi(int sectionCount)
+{
+    UiGeneratorOptions options;
+    options.sectionCount = sectionCount;
+
+    return generateUi(options);
+}
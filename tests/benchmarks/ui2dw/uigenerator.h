@@ -0,0 +1,56 @@
+/*
+  uigenerator.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef UIGENERATOR_H
+#define UIGENERATOR_H
+
+#include <QByteArray>
+
+struct UiGeneratorOptions
+{
+    UiGeneratorOptions();
+
+    int sectionCount;
+    int rowsPerSection;
+
+    // levels of alternating box layouts with a check box each, per section
+    int nestingDepth;
+
+    // checkable actions, added to the group boxes in turn and each
+    // connected to the group box it is added to first
+    int actionCount;
+};
+
+// Creates Designer .ui documents with sectionCount group boxes, each
+// containing a grid layout and a form layout with labels, buddies, fonts,
+// enum and set properties, spacers, plus connections and tab stops
+// covering all generated input widgets
+QByteArray generateUi(const UiGeneratorOptions &options);
+
+// four rows per section, no nested layouts and no actions
+QByteArray generateUi(int sectionCount);
+
+#endif // UIGENERATOR_H
@@ -0,0 +1,329 @@
+/*
+  batchconverter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "batchconverter.h"
+
+#include "conversioncache.h"
+#include "converter.h"
+#include "widgetdefaults.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QThread>
+#include <QThreadPool>
+
+class BatchConverter::ConvertRunnable : public QRunnable
+{
+  public:
+    ConvertRunnable(Job *job, Converter::OutputFormat outputFormat, const ConversionCache *cache,
+                    bool optimize, bool collectTimings)
+      : m_job(job)
+      , m_outputFormat(outputFormat)
+      , m_cache(cache)
+      , m_optimize(optimize)
+      , m_collectTimings(collectTimings)
+    {
+    }
+
+    void run()
+    {
+      Converter converter;
+      converter.setOutputFormat(m_outputFormat);
+      converter.setConversionCache(m_cache);
+      converter.setOptimizationEnabled(m_optimize);
+      if (m_collectTimings) {
+        converter.setStageTimings(&m_job->timings);
+      }
+
+      if (!converter.convert(m_job->inputFileName, m_job->outputFileName)) {
+        m_job->errorString = converter.errorString();
+      }
+      m_job->optimizationStatistics = converter.optimizationStatistics();
+      m_job->cached = converter.isCacheHit();
+    }
+
+  private:
+    // each runnable owns exactly one slot of m_jobs, no locking necessary
+    Job *const m_job;
+    const Converter::OutputFormat m_outputFormat;
+    const ConversionCache *const m_cache;
+    const bool m_optimize;
+    const bool m_collectTimings;
+};
+
+BatchConverter::BatchConverter()
+  : m_maxThreadCount(0)
+  , m_outputFormat(Converter::QmlOutput)
+  , m_statisticsEnabled(false)
+  , m_optimizationEnabled(false)
+  , m_failedCount(0)
+  , m_cachedCount(0)
+  , m_inputBytes(0)
+  , m_elapsed(0)
+  , m_usedThreadCount(0)
+{
+}
+
+void BatchConverter::setOutputDirectory(const QString &outputDirectory)
+{
+  m_outputDirectory = outputDirectory;
+}
+
+QString BatchConverter::outputDirectory() const
+{
+  return m_outputDirectory;
+}
+
+void BatchConverter::setMaxThreadCount(int maxThreadCount)
+{
+  m_maxThreadCount = qMax(0, maxThreadCount);
+}
+
+int BatchConverter::maxThreadCount() const
+{
+  return m_maxThreadCount;
+}
+
+void BatchConverter::setOutputFormat(Converter::OutputFormat format)
+{
+  m_outputFormat = format;
+}
+
+Converter::OutputFormat BatchConverter::outputFormat() const
+{
+  return m_outputFormat;
+}
+
+void BatchConverter::setStatisticsEnabled(bool enabled)
+{
+  m_statisticsEnabled = enabled;
+}
+
+bool BatchConverter::statisticsEnabled() const
+{
+  return m_statisticsEnabled;
+}
+
+void BatchConverter::setCacheDirectory(const QString &cacheDirectory)
+{
+  m_cacheDirectory = cacheDirectory;
+}
+
+QString BatchConverter::cacheDirectory() const
+{
+  return m_cacheDirectory;
+}
+
+void BatchConverter::setOptimizationEnabled(bool enabled)
+{
+  m_optimizationEnabled = enabled;
+}
+
+bool BatchConverter::isOptimizationEnabled() const
+{
+  return m_optimizationEnabled;
+}
+
+bool BatchConverter::addInput(const QString &input)
+{
+  const QFileInfo inputInfo(input);
+  if (!inputInfo.exists()) {
+    m_errors << QString::fromLatin1("Input %1 does not exist").arg(input);
+    return false;
+  }
+
+  if (inputInfo.isFile()) {
+    addJob(inputInfo.filePath(), inputInfo.completeBaseName());
+    return true;
+  }
+
+  const QDir inputDir(inputInfo.filePath());
+
+  QStringList inputFileNames;
+  QDirIterator it(inputDir.path(), QStringList() << QLatin1String("*.ui"), QDir::Files, QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    inputFileNames << it.next();
+  }
+
+  // directory iteration order is file system dependent
+  inputFileNames.sort();
+
+  Q_FOREACH (const QString &inputFileName, inputFileNames) {
+    const QString relativePath = inputDir.relativeFilePath(inputFileName);
+    const QFileInfo relativeInfo(relativePath);
+    addJob(inputFileName, relativeInfo.path() + QLatin1Char('/') + relativeInfo.completeBaseName());
+  }
+
+  return true;
+}
+
+bool BatchConverter::run()
+{
+  m_failedCount = 0;
+  m_cachedCount = 0;
+  m_inputBytes = 0;
+  m_timings = StageTimings();
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // widgets can only be created on the main thread
+  if (m_optimizationEnabled) {
+    WidgetDefaults::initialize();
+  }
+
+  // hashes the executable once for all jobs
+  QScopedPointer<ConversionCache> cache;
+  if (!m_cacheDirectory.isEmpty()) {
+    cache.reset(new ConversionCache(m_cacheDirectory));
+  }
+
+  // prepare output paths up front, workers only touch their own files
+  const QString outputSuffix = m_outputFormat == Converter::CppOutput ? QLatin1String(".h") : QLatin1String(".qml");
+
+  QHash<QString, QString> inputsByOutput;
+  QVector<Job*> runnableJobs;
+  for (int i = 0; i < m_jobs.count(); ++i) {
+    Job &job = m_jobs[i];
+    job.errorString.clear();
+    job.timings = StageTimings();
+    job.optimizationStatistics = OptimizationStatistics();
+    job.cached = false;
+    job.outputFileName = QDir::cleanPath(m_outputDirectory + QLatin1Char('/') + job.relativeOutputPath + outputSuffix);
+
+    m_inputBytes += QFileInfo(job.inputFileName).size();
+
+    const QString previousInput = inputsByOutput.value(job.outputFileName);
+    if (!previousInput.isEmpty()) {
+      job.errorString = QString::fromLatin1("Output file %1 for %2 is already used for %3")
+                        .arg(job.outputFileName, job.inputFileName, previousInput);
+      continue;
+    }
+    inputsByOutput.insert(job.outputFileName, job.inputFileName);
+
+    const QString outputPath = QFileInfo(job.outputFileName).path();
+    if (!QDir().mkpath(outputPath)) {
+      job.errorString = QString::fromLatin1("Cannot create output directory %1").arg(outputPath);
+      continue;
+    }
+
+    runnableJobs << &job;
+  }
+
+  QThreadPool threadPool;
+  if (m_maxThreadCount > 0) {
+    threadPool.setMaxThreadCount(m_maxThreadCount);
+  }
+  m_usedThreadCount = qMin(threadPool.maxThreadCount(), qMax(1, runnableJobs.count()));
+
+  Q_FOREACH (Job *job, runnableJobs) {
+    threadPool.start(new ConvertRunnable(job, m_outputFormat, cache.data(), m_optimizationEnabled, m_statisticsEnabled));
+  }
+  threadPool.waitForDone();
+
+  // report in input order, independent of scheduling
+  Q_FOREACH (const Job &job, m_jobs) {
+    if (!job.errorString.isEmpty()) {
+      m_errors << job.errorString;
+      ++m_failedCount;
+    }
+
+    if (job.cached) {
+      ++m_cachedCount;
+    }
+
+    m_timings.merge(job.timings);
+  }
+
+  m_elapsed = timer.elapsed();
+
+  return m_errors.isEmpty();
+}
+
+QStringList BatchConverter::errors() const
+{
+  return m_errors;
+}
+
+int BatchConverter::fileCount() const
+{
+  return m_jobs.count();
+}
+
+int BatchConverter::failedCount() const
+{
+  return m_failedCount;
+}
+
+int BatchConverter::cachedCount() const
+{
+  return m_cachedCount;
+}
+
+qint64 BatchConverter::inputBytes() const
+{
+  return m_inputBytes;
+}
+
+qint64 BatchConverter::elapsed() const
+{
+  return m_elapsed;
+}
+
+int BatchConverter::usedThreadCount() const
+{
+  return m_usedThreadCount;
+}
+
+QString BatchConverter::inputFileName(int index) const
+{
+  return m_jobs.at(index).inputFileName;
+}
+
+OptimizationStatistics BatchConverter::optimizationStatistics(int index) const
+{
+  return m_jobs.at(index).optimizationStatistics;
+}
+
+StageTimings BatchConverter::stageTimings() const
+{
+  return m_timings;
+}
+
+void BatchConverter::addJob(const QString &inputFileName, const QString &relativeOutputPath)
+{
+  Job job;
+  job.inputFileName = inputFileName;
+  job.relativeOutputPath = relativeOutputPath;
+  job.cached = false;
+
+  m_jobs << job;
+}
@@ -0,0 +1,120 @@
+/*
+  batchconverter.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef BATCHCONVERTER_H
+#define BATCHCONVERTER_H
+
+#include "converter.h"
+#include "stagetimings.h"
+
+#include <QStringList>
+#include <QVector>
+
+// Converts many .ui files into an output directory on a thread pool
+class BatchConverter
+{
+  public:
+    BatchConverter();
+
+    void setOutputDirectory(const QString &outputDirectory);
+    QString outputDirectory() const;
+
+    // 0 uses QThread::idealThreadCount()
+    void setMaxThreadCount(int maxThreadCount);
+    int maxThreadCount() const;
+
+    void setOutputFormat(Converter::OutputFormat format);
+    Converter::OutputFormat outputFormat() const;
+
+    void setStatisticsEnabled(bool enabled);
+    bool statisticsEnabled() const;
+
+    // empty disables the cache, see ConversionCache
+    void setCacheDirectory(const QString &cacheDirectory);
+    QString cacheDirectory() const;
+
+    // see Converter::setOptimizationEnabled(), needs a QApplication
+    void setOptimizationEnabled(bool enabled);
+    bool isOptimizationEnabled() const;
+
+    // inputs can be .ui files or directories, which are searched recursively
+    bool addInput(const QString &input);
+
+    // returns true if all files were converted successfully
+    bool run();
+
+    QStringList errors() const;
+
+    int fileCount() const;
+    int failedCount() const;
+    int cachedCount() const;
+    qint64 inputBytes() const;
+    qint64 elapsed() const;
+    int usedThreadCount() const;
+
+    // per file, in the order the inputs were added
+    QString inputFileName(int index) const;
+    OptimizationStatistics optimizationStatistics(int index) const;
+
+    // summed over all files, only collected if statistics are enabled
+    StageTimings stageTimings() const;
+
+  private:
+    struct Job
+    {
+      QString inputFileName;
+      QString relativeOutputPath;
+      QString outputFileName;
+      QString errorString;
+      StageTimings timings;
+      OptimizationStatistics optimizationStatistics;
+      bool cached;
+    };
+
+    class ConvertRunnable;
+
+    QString m_outputDirectory;
+    QString m_cacheDirectory;
+    int m_maxThreadCount;
+    Converter::OutputFormat m_outputFormat;
+    bool m_statisticsEnabled;
+    bool m_optimizationEnabled;
+
+    QVector<Job> m_jobs;
+    QStringList m_errors;
+
+    int m_failedCount;
+    int m_cachedCount;
+    qint64 m_inputBytes;
+    qint64 m_elapsed;
+    int m_usedThreadCount;
+    StageTimings m_timings;
+
+  private:
+    void addJob(const QString &inputFileName, const QString &relativeOutputPath);
+};
+
+#endif // BATCHCONVERTER_H
@@ -0,0 +1,92 @@
+/*
+  compositevisitor.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "compositevisitor.h"
+
+#include "uinode.h"
+#include "uitopnode.h"
+
+#include <QElapsedTimer>
+
+CompositeVisitor::CompositeVisitor(const SharedVisitationContext &sharedContext)
+  : UiNodeVisitor(sharedContext)
+  , m_timingEnabled(false)
+{
+}
+
+void CompositeVisitor::addVisitor(UiNodeVisitor *visitor)
+{
+  visitor->setRecursive(false);
+
+  m_visitors << visitor;
+  m_elapsed << 0;
+}
+
+void CompositeVisitor::setTimingEnabled(bool enabled)
+{
+  m_timingEnabled = enabled;
+}
+
+qint64 CompositeVisitor::elapsed(int index) const
+{
+  return m_elapsed.value(index);
+}
+
+void CompositeVisitor::visit(UiNode *node)
+{
+  if (m_timingEnabled) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < m_visitors.count(); ++i) {
+      node->accept(m_visitors[i]);
+      m_elapsed[i] += timer.nsecsElapsed();
+      timer.restart();
+    }
+  } else {
+    Q_FOREACH (UiNodeVisitor *visitor, m_visitors) {
+      node->accept(visitor);
+    }
+  }
+
+  node->acceptChildren(this);
+}
+
+void CompositeVisitor::endVisit(UiTopNode *topNode)
+{
+  if (m_timingEnabled) {
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < m_visitors.count(); ++i) {
+      m_visitors[i]->endVisit(topNode);
+      m_elapsed[i] += timer.nsecsElapsed();
+      timer.restart();
+    }
+  } else {
+    Q_FOREACH (UiNodeVisitor *visitor, m_visitors) {
+      visitor->endVisit(topNode);
+    }
+  }
+}
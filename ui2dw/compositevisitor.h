@@ -0,0 +1,62 @@
+/*
+  compositevisitor.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef COMPOSITEVISITOR_H
+#define COMPOSITEVISITOR_H
+
+#include "uinodevisitor.h"
+
+#include <QVector>
+
+// Applies several visitors in a single traversal.
+// For every node all member visitors run in the order they were added,
+// before any of the node's children are visited. This keeps the result
+// identical to running them one after the other as long as a visitor only
+// depends on what previous visitors did to the current node and its
+// ancestors, and only modifies the current node's children.
+class CompositeVisitor : public UiNodeVisitor
+{
+  public:
+    explicit CompositeVisitor(const SharedVisitationContext &sharedContext);
+
+    // visitor is not owned and switched to non-recursive
+    void addVisitor(UiNodeVisitor *visitor);
+
+    // measures the time spent in each member visitor
+    void setTimingEnabled(bool enabled);
+    qint64 elapsed(int index) const;
+
+    void visit(UiNode *node);
+
+    void endVisit(UiTopNode *topNode);
+
+  private:
+    QVector<UiNodeVisitor*> m_visitors;
+    QVector<qint64> m_elapsed;
+    bool m_timingEnabled;
+};
+
+#endif // COMPOSITEVISITOR_H
@@ -65,10 +65,8 @@ void ConnectionNodeVisitor::visit(UiConnectionNode *connectionNode)
   m_connectionNodes << connectionNode;
 }
 
-void ConnectionNodeVisitor::visit(UiTopNode *topNode)
+void ConnectionNodeVisitor::endVisit(UiTopNode *topNode)
 {
-  UiNodeVisitor::visit(topNode);
-
   if (m_widgetNode != 0) {
     int i = 0;
     while (i < topNode->childCount()) {
@@ -36,9 +36,10 @@ class ConnectionNodeVisitor : public UiNodeVisitor
     explicit ConnectionNodeVisitor(const SharedVisitationContext &sharedContext);
 
     void visit(UiConnectionNode *connectionNode);
-    void visit(UiTopNode *topNode);
     void visit(UiWidgetNode *widgetNode);
 
+    void endVisit(UiTopNode *topNode);
+
   private:
     UiWidgetNode *m_widgetNode;
     QSet<UiNode*> m_connectionNodes;
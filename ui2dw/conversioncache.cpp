@@ -0,0 +1,103 @@
+/*
+  conversioncache.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "conversioncache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+ConversionCache::ConversionCache(const QString &directory)
+  : m_directory(directory)
+{
+  m_toolVersion = QByteArray("ui2dw " UI2DW_VERSION " Qt ") + qVersion();
+
+  if (QCoreApplication::instance() != 0) {
+    QFile executable(QCoreApplication::applicationFilePath());
+    if (executable.open(QIODevice::ReadOnly)) {
+      QCryptographicHash hash(QCryptographicHash::Sha1);
+      hash.addData(&executable);
+      m_toolVersion += ' ' + hash.result().toHex();
+    }
+  }
+}
+
+QString ConversionCache::directory() const
+{
+  return m_directory;
+}
+
+QByteArray ConversionCache::toolVersion() const
+{
+  return m_toolVersion;
+}
+
+QByteArray ConversionCache::key(const QByteArray &input, const QByteArray &options) const
+{
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  hash.addData(m_toolVersion);
+  hash.addData("\n", 1);
+  hash.addData(options);
+  hash.addData("\n", 1);
+  hash.addData(input);
+
+  return hash.result().toHex();
+}
+
+bool ConversionCache::lookup(const QByteArray &key, QByteArray *output) const
+{
+  QFile entryFile(entryFileName(key));
+  if (!entryFile.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  *output = entryFile.readAll();
+  return true;
+}
+
+bool ConversionCache::insert(const QByteArray &key, const QByteArray &output) const
+{
+  if (!QDir().mkpath(m_directory)) {
+    return false;
+  }
+
+  // concurrent writers of the same entry produce the same content,
+  // whichever rename happens last wins
+  QSaveFile entryFile(entryFileName(key));
+  if (!entryFile.open(QIODevice::WriteOnly)) {
+    return false;
+  }
+
+  entryFile.write(output);
+  return entryFile.commit();
+}
+
+QString ConversionCache::entryFileName(const QByteArray &key) const
+{
+  return m_directory + QLatin1Char('/') + QString::fromLatin1(key);
+}
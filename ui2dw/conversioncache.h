@@ -0,0 +1,60 @@
+/*
+  conversioncache.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CONVERSIONCACHE_H
+#define CONVERSIONCACHE_H
+
+#include <QByteArray>
+#include <QString>
+
+// Persistent store of conversion results, one file per entry.
+// Entries are keyed by a hash of the input, the conversion options and the
+// tool version, the latter includes a hash of the running executable so that
+// a rebuilt ui2dw never restores output of a previous build.
+// All methods are const and only work on files written atomically, a single
+// instance can be shared by several threads and processes.
+class ConversionCache
+{
+  public:
+    explicit ConversionCache(const QString &directory);
+
+    QString directory() const;
+    QByteArray toolVersion() const;
+
+    QByteArray key(const QByteArray &input, const QByteArray &options) const;
+
+    bool lookup(const QByteArray &key, QByteArray *output) const;
+    bool insert(const QByteArray &key, const QByteArray &output) const;
+
+  private:
+    QString entryFileName(const QByteArray &key) const;
+
+  private:
+    QString m_directory;
+    QByteArray m_toolVersion;
+};
+
+#endif // CONVERSIONCACHE_H
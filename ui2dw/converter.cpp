@@ -0,0 +1,311 @@
+/*
+  converter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "converter.h"
+
+#include "conversioncache.h"
+#include "cppwriter.h"
+#include "nodearena.h"
+#include "parser.h"
+#include "qmlwriter.h"
+#include "stagetimings.h"
+#include "uitopnode.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+
+#include <cstdio>
+
+Converter::Converter()
+  : m_error(NoError)
+  , m_outputFormat(QmlOutput)
+  , m_pipelineMode(VisitorPipeline::Fused)
+  , m_optimizationEnabled(false)
+  , m_timings(0)
+  , m_cache(0)
+  , m_cacheHit(false)
+  , m_treeMemoryUsage(0)
+{
+}
+
+void Converter::setOutputFormat(OutputFormat format)
+{
+  m_outputFormat = format;
+}
+
+Converter::OutputFormat Converter::outputFormat() const
+{
+  return m_outputFormat;
+}
+
+void Converter::setPipelineMode(VisitorPipeline::Mode mode)
+{
+  m_pipelineMode = mode;
+}
+
+VisitorPipeline::Mode Converter::pipelineMode() const
+{
+  return m_pipelineMode;
+}
+
+void Converter::setOptimizationEnabled(bool enabled)
+{
+  m_optimizationEnabled = enabled;
+}
+
+bool Converter::isOptimizationEnabled() const
+{
+  return m_optimizationEnabled;
+}
+
+void Converter::setStageTimings(StageTimings *timings)
+{
+  m_timings = timings;
+}
+
+void Converter::setConversionCache(const ConversionCache *cache)
+{
+  m_cache = cache;
+}
+
+bool Converter::convert(const QString &inputFileName, const QString &outputFileName)
+{
+  m_error = NoError;
+  m_errorString.clear();
+  m_optimizationStatistics = OptimizationStatistics();
+  m_cacheHit = false;
+
+  QFile inputFile(inputFileName);
+  if (!inputFile.open(QIODevice::ReadOnly)) {
+    m_error = InputError;
+    m_errorString = QString::fromLatin1("Cannot read input file %1").arg(inputFileName);
+    return false;
+  }
+
+  if (m_cache != 0) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const QByteArray input = inputFile.readAll();
+    const QByteArray key = m_cache->key(input, cacheOptions());
+
+    QByteArray output;
+    m_cacheHit = m_cache->lookup(key, &output);
+
+    qint64 cacheTime = timer.nsecsElapsed();
+
+    if (!m_cacheHit) {
+      QBuffer inputBuffer;
+      inputBuffer.setData(input);
+      inputBuffer.open(QIODevice::ReadOnly);
+
+      QBuffer outputBuffer(&output);
+      outputBuffer.open(QIODevice::WriteOnly);
+
+      if (!convert(&inputBuffer, &outputBuffer)) {
+        if (m_error == ParseError) {
+          m_errorString = QString::fromLatin1("Failed to parse input file %1: %2").arg(inputFileName, m_errorString);
+        }
+        return false;
+      }
+
+      // a cache that cannot be written only costs time
+      timer.start();
+      m_cache->insert(key, output);
+      cacheTime += timer.nsecsElapsed();
+    }
+
+    if (m_timings != 0) {
+      m_timings->addTime(QLatin1String("ConversionCache"), cacheTime);
+    }
+
+    return writeOutput(outputFileName, output);
+  }
+
+  if (outputFileName.isEmpty()) {
+    QFile outputFile;
+    outputFile.open(stdout, QIODevice::WriteOnly);
+    return convert(&inputFile, &outputFile);
+  }
+
+  // only replace an existing output file once the conversion succeeded
+  QSaveFile outputFile(outputFileName);
+  if (!outputFile.open(QIODevice::WriteOnly)) {
+    m_error = OutputError;
+    m_errorString = QString::fromLatin1("Cannot write to output file %1").arg(outputFileName);
+    return false;
+  }
+
+  if (!convert(&inputFile, &outputFile)) {
+    if (m_error == ParseError) {
+      m_errorString = QString::fromLatin1("Failed to parse input file %1: %2").arg(inputFileName, m_errorString);
+    }
+    outputFile.cancelWriting();
+    return false;
+  }
+
+  if (!outputFile.commit()) {
+    m_error = OutputError;
+    m_errorString = QString::fromLatin1("Cannot write to output file %1").arg(outputFileName);
+    return false;
+  }
+
+  return true;
+}
+
+bool Converter::convert(QIODevice *inputDevice, QIODevice *outputDevice)
+{
+  m_error = NoError;
+  m_errorString.clear();
+  m_optimizationStatistics = OptimizationStatistics();
+  m_treeMemoryUsage = 0;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  // the whole tree is released at once when the conversion is done
+  NodeArena arena;
+  NodeArena::Scope arenaScope(&arena);
+
+  Parser parser(inputDevice);
+
+  const QSharedPointer<UiTopNode> topNode = parser.parse();
+  if (!parser.errorString().isEmpty()) {
+    m_error = ParseError;
+    m_errorString = parser.errorString();
+    return false;
+  }
+
+  if (m_timings != 0) {
+    m_timings->addTime(QLatin1String("Parser"), timer.nsecsElapsed());
+  }
+
+  SharedVisitationContext sharedVisitationContext(new VisitationContext);
+
+  VisitorPipeline pipeline(sharedVisitationContext);
+  pipeline.setMode(m_pipelineMode);
+  pipeline.setOptimizationEnabled(m_optimizationEnabled);
+  pipeline.setStageTimings(m_timings);
+
+  if (m_outputFormat == CppOutput) {
+    // CppWriter works on the tree as parsed, it only needs the object ids
+    pipeline.prepare(topNode.data());
+    m_optimizationStatistics = pipeline.optimizationStatistics();
+
+    timer.start();
+
+    CppWriter writer(outputDevice, sharedVisitationContext);
+    writer.write(topNode);
+    m_treeMemoryUsage = arena.reservedBytes();
+
+    if (m_timings != 0) {
+      m_timings->addTime(QLatin1String("CppWriter"), timer.nsecsElapsed());
+      m_timings->addTraversals(1);
+    }
+
+    return true;
+  }
+
+  pipeline.run(topNode.data());
+  m_optimizationStatistics = pipeline.optimizationStatistics();
+
+  timer.start();
+
+  QmlWriter writer(outputDevice, sharedVisitationContext);
+  writer.write(topNode);
+  m_treeMemoryUsage = arena.reservedBytes();
+
+  if (m_timings != 0) {
+    m_timings->addTime(QLatin1String("QmlWriter"), timer.nsecsElapsed());
+    m_timings->addTraversals(1);
+  }
+
+  return true;
+}
+
+Converter::Error Converter::error() const
+{
+  return m_error;
+}
+
+QString Converter::errorString() const
+{
+  return m_errorString;
+}
+
+OptimizationStatistics Converter::optimizationStatistics() const
+{
+  return m_optimizationStatistics;
+}
+
+bool Converter::isCacheHit() const
+{
+  return m_cacheHit;
+}
+
+qint64 Converter::treeMemoryUsage() const
+{
+  return m_treeMemoryUsage;
+}
+
+QByteArray Converter::cacheOptions() const
+{
+  QByteArray options = m_outputFormat == CppOutput ? "cpp" : "qml";
+  if (m_optimizationEnabled) {
+    options += " optimize";
+  }
+
+  return options;
+}
+
+bool Converter::writeOutput(const QString &outputFileName, const QByteArray &output)
+{
+  if (outputFileName.isEmpty()) {
+    QFile outputFile;
+    outputFile.open(stdout, QIODevice::WriteOnly);
+    outputFile.write(output);
+    return true;
+  }
+
+  // keep the time stamp of an up to date output, nothing depending on it
+  // needs to be rebuilt
+  QFile existingFile(outputFileName);
+  if (existingFile.size() == output.size() && existingFile.open(QIODevice::ReadOnly) &&
+      existingFile.readAll() == output) {
+    return true;
+  }
+
+  QSaveFile outputFile(outputFileName);
+  if (!outputFile.open(QIODevice::WriteOnly) || outputFile.write(output) != output.size() || !outputFile.commit()) {
+    m_error = OutputError;
+    m_errorString = QString::fromLatin1("Cannot write to output file %1").arg(outputFileName);
+    return false;
+  }
+
+  return true;
+}
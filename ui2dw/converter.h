@@ -0,0 +1,113 @@
+/*
+  converter.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CONVERTER_H
+#define CONVERTER_H
+
+#include "visitorpipeline.h"
+
+#include <QString>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+QT_END_NAMESPACE
+
+class ConversionCache;
+class StageTimings;
+
+// Runs the complete .ui to QML or C++ pipeline for a single input file.
+// Every conversion uses its own Parser, NodeArena and VisitationContext so
+// instances can be used concurrently, apart from the optimization which
+// needs WidgetDefaults::initialize() to be called up front
+class Converter
+{
+  public:
+    enum OutputFormat {
+      QmlOutput,
+      CppOutput
+    };
+
+    enum Error {
+      NoError,
+      InputError,
+      OutputError,
+      ParseError
+    };
+
+    Converter();
+
+    void setOutputFormat(OutputFormat format);
+    OutputFormat outputFormat() const;
+
+    void setPipelineMode(VisitorPipeline::Mode mode);
+    VisitorPipeline::Mode pipelineMode() const;
+
+    // see VisitorPipeline::setOptimizationEnabled()
+    void setOptimizationEnabled(bool enabled);
+    bool isOptimizationEnabled() const;
+
+    // optional, receives the time spent in each stage
+    void setStageTimings(StageTimings *timings);
+
+    // optional, not owned. Used by the file based convert() only
+    void setConversionCache(const ConversionCache *cache);
+
+    // empty outputFileName writes to stdout
+    bool convert(const QString &inputFileName, const QString &outputFileName);
+
+    bool convert(QIODevice *inputDevice, QIODevice *outputDevice);
+
+    Error error() const;
+    QString errorString() const;
+
+    // of the last conversion, empty if it was restored from the cache
+    OptimizationStatistics optimizationStatistics() const;
+
+    // true if the output of the last conversion came from the cache
+    bool isCacheHit() const;
+
+    // bytes reserved for the parsed tree of the last conversion
+    qint64 treeMemoryUsage() const;
+
+  private:
+    QByteArray cacheOptions() const;
+    bool writeOutput(const QString &outputFileName, const QByteArray &output);
+
+  private:
+    Error m_error;
+    QString m_errorString;
+
+    OutputFormat m_outputFormat;
+    VisitorPipeline::Mode m_pipelineMode;
+    bool m_optimizationEnabled;
+    StageTimings *m_timings;
+    const ConversionCache *m_cache;
+    OptimizationStatistics m_optimizationStatistics;
+    bool m_cacheHit;
+    qint64 m_treeMemoryUsage;
+};
+
+#endif // CONVERTER_H
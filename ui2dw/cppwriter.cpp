@@ -0,0 +1,670 @@
+/*
+  cppwriter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cppwriter.h"
+
+#include "uiactionnode.h"
+#include "uiaddactionnode.h"
+#include "uiconnectionnode.h"
+#include "uilayoutitemnode.h"
+#include "uilayoutnode.h"
+#include "uipropertynode.h"
+#include "uispacernode.h"
+#include "uitabstopsnode.h"
+#include "uitopnode.h"
+#include "uiwidgetnode.h"
+
+#include <QDebug>
+#include <QIODevice>
+#include <QRect>
+#include <QSize>
+#include <QTextCodec>
+#include <QTextStream>
+
+static QStringList marginPropertyNames()
+{
+  return QStringList() << QLatin1String("margin")
+                       << QLatin1String("leftMargin")
+                       << QLatin1String("topMargin")
+                       << QLatin1String("rightMargin")
+                       << QLatin1String("bottomMargin");
+}
+
+CppWriter::CppWriter(QIODevice *outputDevice, const SharedVisitationContext &sharedContext)
+  : UiNodeVisitor(sharedContext)
+  , m_writer(new QTextStream(outputDevice))
+  , m_hasItem(false)
+  , m_anonymousCount(0)
+{
+  m_writer->setCodec(QTextCodec::codecForName("UTF-8"));
+}
+
+CppWriter::~CppWriter()
+{
+}
+
+void CppWriter::write(const QSharedPointer<UiTopNode> &topNode)
+{
+  topNode->accept(this);
+}
+
+void CppWriter::visit(UiActionNode *actionNode)
+{
+  const QString variable = declareObject(actionNode->id(), QStringList() << QLatin1String("QAction"));
+
+  m_body << QString::fromLatin1("%1 = new QAction(%2);").arg(variable, m_parentWidget);
+  writeObjectName(variable, actionNode->name());
+
+  Scope scope;
+  scope.kind = ActionObject;
+  scope.variable = variable;
+  scope.className = QLatin1String("QAction");
+
+  m_scopes << scope;
+  actionNode->acceptChildren(this);
+  m_scopes.removeLast();
+}
+
+void CppWriter::visit(UiAddActionNode *addActionNode)
+{
+  if (m_scopes.isEmpty()) {
+    return;
+  }
+
+  // actions are usually declared after the widgets using them
+  m_addedActions << qMakePair(m_scopes.last().variable, addActionNode->name());
+}
+
+void CppWriter::visit(UiConnectionNode *connectionNode)
+{
+  const QString sender = variableForObjectName(connectionNode->sender());
+  const QString receiver = variableForObjectName(connectionNode->receiver());
+
+  if (sender.isEmpty() || receiver.isEmpty()) {
+    qWarning() << Q_FUNC_INFO << "Skipping connection between unknown objects"
+               << connectionNode->sender() << connectionNode->receiver();
+    return;
+  }
+
+  m_connections << QString::fromLatin1("QObject::connect(%1, SIGNAL(%2), %3, SLOT(%4));")
+                   .arg(sender, connectionNode->signalSignature(), receiver, connectionNode->slotSignature());
+}
+
+void CppWriter::visit(UiLayoutItemNode *itemNode)
+{
+  if (m_scopes.isEmpty() || m_scopes.last().kind != LayoutObject) {
+    qWarning() << Q_FUNC_INFO << "Layout item outside of a layout";
+    return;
+  }
+
+  const LayoutItem previousItem = m_item;
+  const bool hadItem = m_hasItem;
+
+  m_item.layoutVariable = m_scopes.last().variable;
+  m_item.layoutClassName = m_scopes.last().className;
+  m_item.row = itemNode->row();
+  m_item.column = itemNode->column();
+  m_item.rowSpan = itemNode->rowSpan();
+  m_item.colSpan = itemNode->colSpan();
+  m_hasItem = true;
+
+  itemNode->acceptChildren(this);
+
+  m_item = previousItem;
+  m_hasItem = hadItem;
+}
+
+void CppWriter::visit(UiLayoutNode *layoutNode)
+{
+  const QString className = layoutNode->className().join(QLatin1String("::"));
+  const QString variable = declareObject(layoutNode->id(), layoutNode->className());
+
+  if (m_hasItem) {
+    m_body << QString::fromLatin1("%1 = new %2();").arg(variable, className);
+    addToLayout(LayoutObject, variable);
+  } else {
+    m_body << QString::fromLatin1("%1 = new %2(%3);").arg(variable, className, m_parentWidget);
+  }
+  writeObjectName(variable, layoutNode->name());
+  writeLayoutMargins(layoutNode, variable);
+
+  Scope scope;
+  scope.kind = LayoutObject;
+  scope.variable = variable;
+  scope.className = className;
+
+  m_scopes << scope;
+  layoutNode->acceptChildren(this);
+  m_scopes.removeLast();
+}
+
+void CppWriter::visit(UiPropertyNode *propertyNode)
+{
+  if (m_scopes.isEmpty()) {
+    return;
+  }
+
+  const Scope &scope = m_scopes.last();
+  const QString name = propertyNode->name();
+  const QVariant value = propertyNode->value();
+
+  if (scope.kind == LayoutObject && marginPropertyNames().contains(name)) {
+    return; // handled by writeLayoutMargins()
+  }
+
+  if (name == QLatin1String("buddy")) {
+    const QString buddy = variableForObjectName(value.toString());
+    if (buddy.isEmpty()) {
+      qWarning() << Q_FUNC_INFO << "Skipping unknown buddy" << value.toString() << "of" << scope.variable;
+      return;
+    }
+    m_deferred << QString::fromLatin1("%1->setBuddy(%2);").arg(scope.variable, buddy);
+    return;
+  }
+
+  if (value.userType() == qMetaTypeId<FontValue>()) {
+    writeFont(scope.variable, value);
+    return;
+  }
+
+  if (name == QLatin1String("geometry") && scope.variable == m_rootVariable && value.type() == QVariant::Rect) {
+    const QRect rect = value.toRect();
+    m_body << QString::fromLatin1("%1->resize(%2, %3);").arg(scope.variable).arg(rect.width()).arg(rect.height());
+    return;
+  }
+
+  const QString line = QString::fromLatin1("%1->%2(%3);").arg(scope.variable, setterName(name), valueToCpp(value));
+
+  // the current index refers to pages that are added later on
+  if (name == QLatin1String("currentIndex") || name == QLatin1String("currentRow")) {
+    m_deferred << line;
+  } else {
+    m_body << line;
+  }
+}
+
+void CppWriter::visit(UiSpacerNode *spacerNode)
+{
+  bool horizontal = false;
+  QSize size;
+  QString sizeType = QLatin1String("QSizePolicy::Expanding");
+
+  for (int i = 0; i < spacerNode->childCount(); ++i) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(spacerNode->childAt(i));
+    if (propertyNode == 0) {
+      continue;
+    }
+
+    if (propertyNode->name() == QLatin1String("orientation")) {
+      const QStringList nameParts = propertyNode->value().value<EnumValue>().nameParts;
+      horizontal = !nameParts.isEmpty() && nameParts.last() == QLatin1String("Horizontal");
+    } else if (propertyNode->name() == QLatin1String("sizeHint")) {
+      size = propertyNode->value().toSize();
+    } else if (propertyNode->name() == QLatin1String("sizeType")) {
+      sizeType = propertyNode->value().value<EnumValue>().nameParts.join(QLatin1String("::"));
+    }
+  }
+
+  if (!size.isValid()) {
+    size = horizontal ? QSize(40, 20) : QSize(20, 40);
+  }
+
+  const QString minimum = QLatin1String("QSizePolicy::Minimum");
+
+  const QString variable = declareObject(spacerNode->id(), QStringList() << QLatin1String("QSpacerItem"));
+  m_body << QString::fromLatin1("%1 = new QSpacerItem(%2, %3, %4, %5);")
+            .arg(variable).arg(size.width()).arg(size.height())
+            .arg(horizontal ? sizeType : minimum, horizontal ? minimum : sizeType);
+
+  if (m_hasItem) {
+    addToLayout(SpacerObject, variable);
+  } else {
+    qWarning() << Q_FUNC_INFO << "Spacer" << spacerNode->name() << "is not in a layout";
+  }
+}
+
+void CppWriter::visit(UiTabStopsNode *tabStopsNode)
+{
+  QString previous;
+  Q_FOREACH (const QString &tabStop, tabStopsNode->tabStops()) {
+    const QString current = variableForObjectName(tabStop);
+    if (current.isEmpty()) {
+      qWarning() << Q_FUNC_INFO << "Skipping unknown tab stop" << tabStop;
+      continue;
+    }
+
+    if (!previous.isEmpty()) {
+      m_tabOrder << QString::fromLatin1("QWidget::setTabOrder(%1, %2);").arg(previous, current);
+    }
+    previous = current;
+  }
+}
+
+void CppWriter::visit(UiTopNode *topNode)
+{
+  topNode->acceptChildren(this);
+
+  writeHeader(topNode);
+}
+
+void CppWriter::visit(UiWidgetNode *widgetNode)
+{
+  const QString className = widgetNode->className().join(QLatin1String("::"));
+  const QString variable = declareObject(widgetNode->id(), widgetNode->className());
+
+  if (m_rootVariable.isEmpty()) {
+    m_rootVariable = variable;
+    m_body << QString::fromLatin1("%1 = new %2(parent);").arg(variable, className);
+  } else {
+    m_body << QString::fromLatin1("%1 = new %2(%3);").arg(variable, className, m_parentWidget);
+
+    if (m_hasItem) {
+      addToLayout(WidgetObject, variable);
+    } else if (!m_scopes.isEmpty()) {
+      // widgets directly inside containers that manage their children
+      const QString container = m_scopes.last().variable;
+      const QString containerClass = m_scopes.last().className;
+      const QString childClass = widgetNode->className().last();
+
+      if (containerClass == QLatin1String("QMainWindow")) {
+        if (childClass == QLatin1String("QMenuBar")) {
+          m_body << QString::fromLatin1("%1->setMenuBar(%2);").arg(container, variable);
+        } else if (childClass == QLatin1String("QStatusBar")) {
+          m_body << QString::fromLatin1("%1->setStatusBar(%2);").arg(container, variable);
+        } else if (childClass == QLatin1String("QToolBar")) {
+          m_body << QString::fromLatin1("%1->addToolBar(%2);").arg(container, variable);
+        } else if (childClass == QLatin1String("QDockWidget")) {
+          m_body << QString::fromLatin1("%1->addDockWidget(Qt::LeftDockWidgetArea, %2);").arg(container, variable);
+        } else {
+          m_body << QString::fromLatin1("%1->setCentralWidget(%2);").arg(container, variable);
+        }
+      } else if (containerClass == QLatin1String("QTabWidget")) {
+        m_body << QString::fromLatin1("%1->addTab(%2, QString());").arg(container, variable);
+      } else if (containerClass == QLatin1String("QToolBox")) {
+        m_body << QString::fromLatin1("%1->addItem(%2, QString());").arg(container, variable);
+      } else if (containerClass == QLatin1String("QStackedWidget") || containerClass == QLatin1String("QSplitter")) {
+        m_body << QString::fromLatin1("%1->addWidget(%2);").arg(container, variable);
+      } else if (containerClass == QLatin1String("QScrollArea") || containerClass == QLatin1String("QDockWidget")) {
+        m_body << QString::fromLatin1("%1->setWidget(%2);").arg(container, variable);
+      }
+    }
+  }
+  writeObjectName(variable, widgetNode->name());
+
+  Scope scope;
+  scope.kind = WidgetObject;
+  scope.variable = variable;
+  scope.className = className;
+
+  const QString previousParentWidget = m_parentWidget;
+  m_parentWidget = variable;
+  m_hasItem = false;
+
+  m_scopes << scope;
+  widgetNode->acceptChildren(this);
+  m_scopes.removeLast();
+
+  m_parentWidget = previousParentWidget;
+}
+
+QString CppWriter::declareObject(const QString &id, const QStringList &className)
+{
+  QString variable = id;
+  if (variable.isEmpty()) {
+    QString base = className.last();
+    if (base.length() > 1 && base[0] == QLatin1Char('Q') && base[1].isUpper()) {
+      base = base.mid(1);
+    }
+    base[0] = base[0].toLower();
+
+    do {
+      variable = QString::fromLatin1("%1_%2").arg(base).arg(++m_anonymousCount);
+    } while (m_classNamesByVariable.contains(variable));
+  }
+
+  const QString fullClassName = className.join(QLatin1String("::"));
+
+  m_members << qMakePair(fullClassName, variable);
+  m_classNamesByVariable.insert(variable, fullClassName);
+
+  return variable;
+}
+
+void CppWriter::addToLayout(ObjectKind kind, const QString &variable)
+{
+  m_hasItem = false;
+
+  const int rowSpan = qMax(1, m_item.rowSpan);
+  const int colSpan = qMax(1, m_item.colSpan);
+
+  if (m_item.layoutClassName == QLatin1String("QFormLayout")) {
+    const char *role = colSpan > 1 ? "SpanningRole" : (m_item.column == 0 ? "LabelRole" : "FieldRole");
+    const char *method = kind == WidgetObject ? "setWidget" : (kind == LayoutObject ? "setLayout" : "setItem");
+
+    m_body << QString::fromLatin1("%1->%2(%3, QFormLayout::%4, %5);")
+              .arg(m_item.layoutVariable, QLatin1String(method)).arg(qMax(0, m_item.row))
+              .arg(QLatin1String(role), variable);
+    return;
+  }
+
+  const char *method = kind == WidgetObject ? "addWidget" : (kind == LayoutObject ? "addLayout" : "addItem");
+
+  if (m_item.layoutClassName == QLatin1String("QGridLayout")) {
+    m_body << QString::fromLatin1("%1->%2(%3, %4, %5, %6, %7);")
+              .arg(m_item.layoutVariable, QLatin1String(method), variable)
+              .arg(qMax(0, m_item.row)).arg(qMax(0, m_item.column)).arg(rowSpan).arg(colSpan);
+    return;
+  }
+
+  m_body << QString::fromLatin1("%1->%2(%3);").arg(m_item.layoutVariable, QLatin1String(method), variable);
+}
+
+void CppWriter::writeObjectName(const QString &variable, const QString &objectName)
+{
+  if (!objectName.isEmpty()) {
+    m_body << QString::fromLatin1("%1->setObjectName(%2);").arg(variable, stringLiteral(objectName));
+  }
+}
+
+void CppWriter::writeFont(const QString &variable, const QVariant &value)
+{
+  const QVariantHash fontProperties = value.value<FontValue>().fontProperties;
+
+  static const char *const orderedNames[] = {
+    "family", "pointsize", "weight", "bold", "italic", "underline", "strikeout", "kerning", "stylestrategy"
+  };
+
+  m_body << QLatin1String("{");
+  m_body << QLatin1String("  QFont font;");
+
+  for (unsigned int i = 0; i < sizeof(orderedNames) / sizeof(orderedNames[0]); ++i) {
+    const QString name = QLatin1String(orderedNames[i]);
+    const QVariantHash::const_iterator it = fontProperties.constFind(name);
+    if (it == fontProperties.constEnd()) {
+      continue;
+    }
+
+    QString setter;
+    QString cppValue = valueToCpp(it.value());
+    if (name == QLatin1String("pointsize")) {
+      setter = QLatin1String("setPointSize");
+    } else if (name == QLatin1String("strikeout")) {
+      setter = QLatin1String("setStrikeOut");
+    } else if (name == QLatin1String("stylestrategy")) {
+      setter = QLatin1String("setStyleStrategy");
+      if (!cppValue.contains(QLatin1String("::"))) {
+        cppValue.prepend(QLatin1String("QFont::"));
+      }
+    } else {
+      setter = setterName(name);
+    }
+
+    m_body << QString::fromLatin1("  font.%1(%2);").arg(setter, cppValue);
+  }
+
+  m_body << QString::fromLatin1("  %1->setFont(font);").arg(variable);
+  m_body << QLatin1String("}");
+}
+
+void CppWriter::writeLayoutMargins(UiLayoutNode *layoutNode, const QString &variable)
+{
+  int margins[4] = { -1, -1, -1, -1 };
+  bool hasMargins = false;
+
+  const QStringList names = marginPropertyNames();
+
+  for (int i = 0; i < layoutNode->childCount(); ++i) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(layoutNode->childAt(i));
+    if (propertyNode == 0) {
+      continue;
+    }
+
+    const int index = names.indexOf(propertyNode->name());
+    if (index < 0) {
+      continue;
+    }
+
+    const int margin = propertyNode->value().toInt();
+    if (index == 0) {
+      margins[0] = margins[1] = margins[2] = margins[3] = margin;
+    } else {
+      margins[index - 1] = margin;
+    }
+    hasMargins = true;
+  }
+
+  if (!hasMargins) {
+    return;
+  }
+
+  if (margins[0] >= 0 && margins[1] >= 0 && margins[2] >= 0 && margins[3] >= 0) {
+    m_body << QString::fromLatin1("%1->setContentsMargins(%2, %3, %4, %5);")
+              .arg(variable).arg(margins[0]).arg(margins[1]).arg(margins[2]).arg(margins[3]);
+    return;
+  }
+
+  // keep the style's default for margins not set in the form
+  const char *const defaults[] = { "left", "top", "right", "bottom" };
+  QStringList values;
+  for (int i = 0; i < 4; ++i) {
+    values << (margins[i] >= 0 ? QString::number(margins[i]) : QLatin1String(defaults[i]));
+  }
+
+  m_body << QLatin1String("{");
+  m_body << QLatin1String("  int left, top, right, bottom;");
+  m_body << QString::fromLatin1("  %1->getContentsMargins(&left, &top, &right, &bottom);").arg(variable);
+  m_body << QString::fromLatin1("  %1->setContentsMargins(%2);").arg(variable, values.join(QLatin1String(", ")));
+  m_body << QLatin1String("}");
+}
+
+void CppWriter::writeHeader(UiTopNode *topNode)
+{
+  QString className = topNode->className().isEmpty() ? QString() : topNode->className().last();
+  if (className.isEmpty()) {
+    className = QLatin1String("Form");
+  }
+
+  const QString guard = QString::fromLatin1("UI2DW_%1_H").arg(className.toUpper());
+  const QString rootClassName = m_classNamesByVariable.value(m_rootVariable, QLatin1String("QWidget"));
+
+  const QByteArray memberIndent(4, ' ');
+  const QByteArray bodyIndent(6, ' ');
+
+  *m_writer << "// Generated by ui2dw, changes will be lost when the form is converted again" << endl;
+  *m_writer << endl;
+  *m_writer << "#ifndef " << guard << endl;
+  *m_writer << "#define " << guard << endl;
+  *m_writer << endl;
+  *m_writer << "#include <QtWidgets>" << endl;
+  *m_writer << endl;
+  *m_writer << "namespace Ui2dw {" << endl;
+  *m_writer << endl;
+  *m_writer << "class " << className << endl;
+  *m_writer << "{" << endl;
+  *m_writer << "  public:" << endl;
+
+  for (int i = 0; i < m_members.count(); ++i) {
+    *m_writer << memberIndent << m_members[i].first << " *" << m_members[i].second << ";" << endl;
+  }
+  if (!m_members.isEmpty()) {
+    *m_writer << endl;
+  }
+
+  *m_writer << memberIndent << rootClassName << " *create(QWidget *parent = 0)" << endl;
+  *m_writer << memberIndent << "{" << endl;
+
+  Q_FOREACH (const QString &line, m_body) {
+    *m_writer << bodyIndent << line << endl;
+  }
+
+  QStringList finalLines;
+  for (int i = 0; i < m_addedActions.count(); ++i) {
+    const QString container = m_addedActions[i].first;
+    const QString name = m_addedActions[i].second;
+
+    if (name == QLatin1String("separator")) {
+      finalLines << QString::fromLatin1("%1->addSeparator();").arg(container);
+      continue;
+    }
+
+    const QString action = variableForObjectName(name);
+    if (action.isEmpty()) {
+      qWarning() << Q_FUNC_INFO << "Skipping unknown action" << name;
+      continue;
+    }
+
+    if (m_classNamesByVariable.value(action) == QLatin1String("QMenu")) {
+      finalLines << QString::fromLatin1("%1->addAction(%2->menuAction());").arg(container, action);
+    } else {
+      finalLines << QString::fromLatin1("%1->addAction(%2);").arg(container, action);
+    }
+  }
+  finalLines << m_deferred << m_tabOrder << m_connections;
+
+  if (!finalLines.isEmpty()) {
+    *m_writer << endl;
+    Q_FOREACH (const QString &line, finalLines) {
+      *m_writer << bodyIndent << line << endl;
+    }
+  }
+
+  *m_writer << endl;
+  *m_writer << bodyIndent << "return " << (m_rootVariable.isEmpty() ? QString::fromLatin1("0") : m_rootVariable) << ";" << endl;
+  *m_writer << memberIndent << "}" << endl;
+  *m_writer << "};" << endl;
+  *m_writer << endl;
+  *m_writer << "} // namespace Ui2dw" << endl;
+  *m_writer << endl;
+  *m_writer << "#endif // " << guard << endl;
+}
+
+QString CppWriter::variableForObjectName(const QString &objectName) const
+{
+  return m_sharedContext->idForObjectName(objectName);
+}
+
+QString CppWriter::valueToCpp(const QVariant &value)
+{
+  switch (value.type()) {
+  case QVariant::Bool:
+    return value.toBool() ? QLatin1String("true") : QLatin1String("false");
+
+  case QVariant::Double:
+    return QString::number(value.toDouble(), 'g', 15);
+
+  case QVariant::Int:
+    return QString::number(value.toInt());
+
+  case QVariant::Rect: {
+    const QRect r = value.toRect();
+    return QString::fromLatin1("QRect(%1, %2, %3, %4)").arg(r.x()).arg(r.y()).arg(r.width()).arg(r.height());
+  }
+
+  case QVariant::Size: {
+    const QSize s = value.toSize();
+    return QString::fromLatin1("QSize(%1, %2)").arg(s.width()).arg(s.height());
+  }
+
+  case QVariant::UInt:
+    return QString::number(value.toUInt()) + QLatin1Char('u');
+
+  case QVariant::UserType:
+    if (value.canConvert<EnumValue>()) {
+      return value.value<EnumValue>().nameParts.join(QLatin1String("::"));
+    }
+
+    if (value.canConvert<IdValue>()) {
+      return value.value<IdValue>().id;
+    }
+
+    if (value.canConvert<PixmapValue>()) {
+      return QString::fromLatin1("QPixmap(%1)").arg(stringLiteral(value.value<PixmapValue>().fileName));
+    }
+
+    if (value.canConvert<SetValue>()) {
+      QStringList flags;
+      Q_FOREACH (const EnumValue &enumValue, value.value<SetValue>().flags) {
+        flags << enumValue.nameParts.join(QLatin1String("::"));
+      }
+      return flags.isEmpty() ? QString::fromLatin1("0") : flags.join(QLatin1String(" | "));
+    }
+
+    // fall through
+
+  default:
+    return stringLiteral(value.toString());
+  }
+}
+
+QString CppWriter::stringLiteral(const QString &text)
+{
+  const QByteArray utf8 = text.toUtf8();
+
+  bool ascii = true;
+  QString escaped;
+  escaped.reserve(utf8.size() + 2);
+
+  for (int i = 0; i < utf8.size(); ++i) {
+    const unsigned char c = utf8[i];
+    switch (c) {
+    case '\\':
+      escaped += QLatin1String("\\\\");
+      break;
+    case '"':
+      escaped += QLatin1String("\\\"");
+      break;
+    case '\n':
+      escaped += QLatin1String("\\n");
+      break;
+    case '\t':
+      escaped += QLatin1String("\\t");
+      break;
+    default:
+      if (c < 0x20 || c >= 0x7f) {
+        // octal escapes end after three digits, unlike hex escapes
+        escaped += QString::fromLatin1("\\%1").arg(int(c), 3, 8, QLatin1Char('0'));
+        ascii = ascii && c < 0x7f;
+      } else {
+        escaped += QLatin1Char(c);
+      }
+      break;
+    }
+  }
+
+  if (ascii) {
+    return QString::fromLatin1("QStringLiteral(\"%1\")").arg(escaped);
+  }
+
+  return QString::fromLatin1("QString::fromUtf8(\"%1\")").arg(escaped);
+}
+
+QString CppWriter::setterName(const QString &propertyName)
+{
+  QString setter = QLatin1String("set") + propertyName;
+  setter[3] = setter[3].toUpper();
+
+  return setter;
+}
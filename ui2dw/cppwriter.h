@@ -0,0 +1,126 @@
+/*
+  cppwriter.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef CPPWRITER_H
+#define CPPWRITER_H
+
+#include "uinodevisitor.h"
+
+#include <QHash>
+#include <QPair>
+#include <QSharedPointer>
+#include <QScopedPointer>
+#include <QStringList>
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+class QTextStream;
+QT_END_NAMESPACE
+
+// Writes a header with a class that builds the form's widgets directly,
+// similar to uic but for forms that do not need the QML runtime.
+// Expects a tree that has only been processed by IdVisitor, all other
+// visitors prepare the tree for QML.
+class CppWriter : public UiNodeVisitor
+{
+  public:
+    CppWriter(QIODevice *outputDevice, const SharedVisitationContext &sharedContext);
+    ~CppWriter();
+
+    void write(const QSharedPointer<UiTopNode> &topNode);
+
+    void visit(UiActionNode *actionNode);
+    void visit(UiAddActionNode *addActionNode);
+    void visit(UiConnectionNode *connectionNode);
+    void visit(UiLayoutItemNode *itemNode);
+    void visit(UiLayoutNode *layoutNode);
+    void visit(UiPropertyNode *propertyNode);
+    void visit(UiSpacerNode *spacerNode);
+    void visit(UiTabStopsNode *tabStopsNode);
+    void visit(UiTopNode *topNode);
+    void visit(UiWidgetNode *widgetNode);
+
+  private:
+    enum ObjectKind {
+      WidgetObject,
+      LayoutObject,
+      ActionObject,
+      SpacerObject
+    };
+
+    struct Scope
+    {
+      ObjectKind kind;
+      QString variable;
+      QString className;
+    };
+
+    struct LayoutItem
+    {
+      QString layoutVariable;
+      QString layoutClassName;
+      int row;
+      int column;
+      int rowSpan;
+      int colSpan;
+    };
+
+    QScopedPointer<QTextStream> m_writer;
+
+    QString m_rootVariable;
+    QList<Scope> m_scopes;
+    QString m_parentWidget;
+
+    LayoutItem m_item;
+    bool m_hasItem;
+
+    int m_anonymousCount;
+
+    QList<QPair<QString, QString> > m_members;
+    QHash<QString, QString> m_classNamesByVariable;
+
+    QStringList m_body;
+    QStringList m_deferred;
+    QList<QPair<QString, QString> > m_addedActions;
+    QStringList m_connections;
+    QStringList m_tabOrder;
+
+  private:
+    QString declareObject(const QString &id, const QStringList &className);
+    void addToLayout(ObjectKind kind, const QString &variable);
+    void writeObjectName(const QString &variable, const QString &objectName);
+    void writeFont(const QString &variable, const QVariant &value);
+    void writeLayoutMargins(UiLayoutNode *layoutNode, const QString &variable);
+    void writeHeader(UiTopNode *topNode);
+
+    QString variableForObjectName(const QString &objectName) const;
+
+    static QString valueToCpp(const QVariant &value);
+    static QString stringLiteral(const QString &text);
+    static QString setterName(const QString &propertyName);
+};
+
+#endif // CPPWRITER_H
@@ -0,0 +1,83 @@
+/*
+  lookuptable.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOOKUPTABLE_H
+#define LOOKUPTABLE_H
+
+#include <QLatin1String>
+#include <QStringRef>
+
+#include <algorithm>
+#include <cstddef>
+
+// Binary search in a static array of entries with a "const char *name"
+// member, sorted by name. Looks up names read by QXmlStreamReader without
+// creating a QString for every element.
+template <typename Entry>
+class LookupTable
+{
+  public:
+    template <std::size_t N>
+    LookupTable(const Entry (&entries)[N], Qt::CaseSensitivity caseSensitivity)
+      : m_begin(entries)
+      , m_end(entries + N)
+      , m_caseSensitivity(caseSensitivity)
+    {
+    }
+
+    // returns 0 if there is no entry for name
+    const Entry *find(const QStringRef &name) const
+    {
+      const Entry *entry = std::lower_bound(m_begin, m_end, name, LessThan(m_caseSensitivity));
+      if (entry == m_end || name.compare(QLatin1String(entry->name), m_caseSensitivity) != 0) {
+        return 0;
+      }
+
+      return entry;
+    }
+
+  private:
+    struct LessThan
+    {
+        explicit LessThan(Qt::CaseSensitivity caseSensitivity)
+          : caseSensitivity(caseSensitivity)
+        {
+        }
+
+        bool operator()(const Entry &entry, const QStringRef &name) const
+        {
+          return name.compare(QLatin1String(entry.name), caseSensitivity) > 0;
+        }
+
+        Qt::CaseSensitivity caseSensitivity;
+    };
+
+    const Entry *m_begin;
+    const Entry *m_end;
+    Qt::CaseSensitivity m_caseSensitivity;
+};
+
+#endif // LOOKUPTABLE_H
@@ -25,30 +25,162 @@
   along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
-#include "parser.h"
 
-#include <QFile>
+#include "batchconverter.h"
+#include "conversioncache.h"
+#include "converter.h"
+#include "memoryusage.h"
+#include "stagetimings.h"
+#include "watchconverter.h"
+#include "widgetdefaults.h"
+
+#include <QApplication>
+#include <QScopedPointer>
 #include <QString>
+#include <QStringList>
 
-#include <cstdio>
+#include <iomanip>
 #include <iostream>
 
-#include "buddyvisitor.h"
-#include "connectionnodevisitor.h"
-#include "elementnamevisitor.h"
-#include "fontproperyvisitor.h"
-#include "idvisitor.h"
-#include "itemvisitor.h"
-#include "layoutvisitor.h"
-#include "qmlwriter.h"
-#include "tabstopsnodevisitor.h"
-#include "uitopnode.h"
-
 using namespace std;
 
 void printUsage()
 {
-  cout << "Usage: ui2dw [ -o <outputfile> ] inputfile" << endl;
+  cout << "Usage: ui2dw [ <options> ] [ -o <outputfile> ] inputfile" << endl;
+  cout << "       ui2dw [ <options> ] -d <outputdirectory> [ -j <jobs> ] inputfile|inputdirectory..." << endl;
+  cout << "       ui2dw [ <options> ] --watch -d <outputdirectory> inputfile|inputdirectory..." << endl;
+  cout << "       ui2dw --version" << endl;
+  cout << endl;
+  cout << "  --cache <directory>  reuse the output of earlier conversions of the same input" << endl;
+  cout << "  --cpp                write a C++ header building the widgets instead of QML" << endl;
+  cout << "  --optimize           leave out default valued properties and redundant layouts and containers" << endl;
+  cout << "  --stats              print the time spent in each conversion stage" << endl;
+  cout << "  --watch              keep converting the inputs whenever they change, until interrupted" << endl;
+}
+
+class WatchReporter : public QObject
+{
+  Q_OBJECT
+
+  public Q_SLOTS:
+    void onFileConverted(const QString &inputFileName, const QString &outputFileName, qint64 elapsed)
+    {
+      cout << "Converted " << inputFileName.toLocal8Bit().constData()
+           << " to " << outputFileName.toLocal8Bit().constData()
+           << " in " << elapsed << " ms" << endl;
+    }
+
+    void onConversionFailed(const QString &inputFileName, const QString &errorString)
+    {
+      Q_UNUSED(inputFileName);
+      cerr << "Error: " << errorString.toLocal8Bit().constData() << endl;
+    }
+};
+
+void printOptimizationStatistics(const QString &inputFileName, const OptimizationStatistics &statistics)
+{
+  cerr << inputFileName.toLocal8Bit().constData() << ": eliminated "
+       << statistics.eliminatedObjects << " objects and "
+       << statistics.eliminatedBindings << " property bindings" << endl;
+}
+
+void printStageTimings(const StageTimings &timings)
+{
+  const qint64 total = qMax<qint64>(1, timings.totalTime());
+
+  cerr << "Stage timings (" << timings.traversals() << " tree traversals):" << endl;
+  Q_FOREACH (const QString &stage, timings.stages()) {
+    const qint64 nsecs = timings.time(stage);
+    cerr << "  " << left << setw(24) << stage.toLocal8Bit().constData() << right
+         << fixed << setprecision(3) << setw(12) << (nsecs / 1000000.0) << " ms"
+         << setprecision(1) << setw(8) << (nsecs * 100.0 / total) << " %" << endl;
+  }
+  cerr << "  " << left << setw(24) << "total" << right
+       << fixed << setprecision(3) << setw(12) << (total / 1000000.0) << " ms" << endl;
+
+  const qint64 peakMemory = peakMemoryUsage();
+  if (peakMemory >= 0) {
+    cerr << "Peak memory usage: " << (peakMemory / 1024) << " KiB" << endl;
+  }
+}
+
+int convertBatch(const QString &outputDirectory, const QString &cacheDirectory, int jobs,
+                 Converter::OutputFormat format, bool optimize, bool stats, const QStringList &inputs)
+{
+  BatchConverter batchConverter;
+  batchConverter.setOutputDirectory(outputDirectory);
+  batchConverter.setCacheDirectory(cacheDirectory);
+  batchConverter.setOutputFormat(format);
+  batchConverter.setMaxThreadCount(jobs);
+  batchConverter.setOptimizationEnabled(optimize);
+  batchConverter.setStatisticsEnabled(stats);
+
+  Q_FOREACH (const QString &input, inputs) {
+    batchConverter.addInput(input);
+  }
+
+  const bool success = batchConverter.run();
+
+  Q_FOREACH (const QString &error, batchConverter.errors()) {
+    cerr << "Error: " << error.toLocal8Bit().constData() << endl;
+  }
+
+  if (optimize) {
+    for (int i = 0; i < batchConverter.fileCount(); ++i) {
+      printOptimizationStatistics(batchConverter.inputFileName(i), batchConverter.optimizationStatistics(i));
+    }
+  }
+
+  const int convertedCount = batchConverter.fileCount() - batchConverter.failedCount();
+  const qint64 elapsed = qMax<qint64>(1, batchConverter.elapsed());
+
+  cout << "Converted " << convertedCount << " of " << batchConverter.fileCount() << " files"
+       << " in " << batchConverter.elapsed() << " ms"
+       << " using " << batchConverter.usedThreadCount() << " threads"
+       << " (" << (batchConverter.fileCount() * 1000.0 / elapsed) << " files/s, "
+       << (batchConverter.inputBytes() / 1024.0 * 1000.0 / elapsed) << " KiB/s)" << endl;
+
+  if (!cacheDirectory.isEmpty()) {
+    cout << "Restored " << batchConverter.cachedCount() << " files from the cache" << endl;
+  }
+
+  if (stats) {
+    printStageTimings(batchConverter.stageTimings());
+  }
+
+  return success ? 0 : 6;
+}
+
+int convertWatch(const QString &outputDirectory, Converter::OutputFormat format, bool optimize,
+                 const QStringList &inputs)
+{
+  WatchConverter watchConverter;
+  watchConverter.setOutputDirectory(outputDirectory);
+  watchConverter.setOutputFormat(format);
+  watchConverter.setOptimizationEnabled(optimize);
+
+  Q_FOREACH (const QString &input, inputs) {
+    watchConverter.addInput(input);
+  }
+
+  if (!watchConverter.errors().isEmpty()) {
+    Q_FOREACH (const QString &error, watchConverter.errors()) {
+      cerr << "Error: " << error.toLocal8Bit().constData() << endl;
+    }
+    return 6;
+  }
+
+  WatchReporter reporter;
+  QObject::connect(&watchConverter, SIGNAL(fileConverted(QString,QString,qint64)),
+                   &reporter, SLOT(onFileConverted(QString,QString,qint64)));
+  QObject::connect(&watchConverter, SIGNAL(conversionFailed(QString,QString)),
+                   &reporter, SLOT(onConversionFailed(QString,QString)));
+
+  watchConverter.start();
+
+  cout << "Watching " << watchConverter.fileCount() << " files for changes" << endl;
+
+  return QCoreApplication::exec();
 }
 
 int main(int argc, char *argv[])
@@ -59,92 +191,142 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  if (argc > 4) {
-    cerr << "Too many arguments" << endl;
-    printUsage();
-    return 1;
-  }
-
-  QString inputFileName;
   QString outputFileName;
-  if (argc == 2) {
-    inputFileName = QString::fromLocal8Bit(argv[1]);
-  } else {
-    if (qstrncmp(argv[1], "-o", 2) == 0) {
-      inputFileName = QString::fromLocal8Bit(argv[3]);
-      outputFileName = QString::fromLocal8Bit(argv[2]);
-    } else if (qstrncmp(argv[2], "-o", 2) == 0) {
-      inputFileName = QString::fromLocal8Bit(argv[1]);
-      outputFileName = QString::fromLocal8Bit(argv[3]);
-    } else {
+  QString outputDirectory;
+  QString cacheDirectory;
+  int jobs = 0;
+  Converter::OutputFormat format = Converter::QmlOutput;
+  bool optimize = false;
+  bool stats = false;
+  bool watch = false;
+  QStringList inputs;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (qstrcmp(argv[i], "-o") == 0 && hasValue) {
+      outputFileName = QString::fromLocal8Bit(argv[++i]);
+    } else if (qstrcmp(argv[i], "-d") == 0 && hasValue) {
+      outputDirectory = QString::fromLocal8Bit(argv[++i]);
+    } else if (qstrcmp(argv[i], "--cache") == 0 && hasValue) {
+      cacheDirectory = QString::fromLocal8Bit(argv[++i]);
+    } else if (qstrcmp(argv[i], "--version") == 0) {
+      cout << "ui2dw " UI2DW_VERSION << endl;
+      return 0;
+    } else if (qstrcmp(argv[i], "-j") == 0 && hasValue) {
+      bool ok = false;
+      jobs = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+      if (!ok || jobs < 1) {
+        cerr << "Invalid number of jobs " << argv[i] << endl;
+        printUsage();
+        return 2;
+      }
+    } else if (qstrcmp(argv[i], "--cpp") == 0) {
+      format = Converter::CppOutput;
+    } else if (qstrcmp(argv[i], "--optimize") == 0) {
+      optimize = true;
+    } else if (qstrcmp(argv[i], "--stats") == 0) {
+      stats = true;
+    } else if (qstrcmp(argv[i], "--watch") == 0) {
+      watch = true;
+    } else if (argv[i][0] == '-') {
       cerr << "Invalid usage" << endl;
       printUsage();
       return 2;
+    } else {
+      inputs << QString::fromLocal8Bit(argv[i]);
     }
   }
 
-  QFile inputFile(inputFileName);
-  if (!inputFile.open(QIODevice::ReadOnly)) {
-    cerr << "Cannot read input file " << inputFileName.toLocal8Bit().constData() << endl;
-    return 3;
+  if (inputs.isEmpty()) {
+    cerr << "Too few arguments" << endl;
+    printUsage();
+    return 1;
+  }
+
+  // conversions in watch mode run on the event loop, caching, statistics
+  // and parallel jobs only make sense for one-off conversions
+  if (watch && (outputDirectory.isEmpty() || !cacheDirectory.isEmpty() || stats || jobs > 0)) {
+    cerr << "Invalid usage" << endl;
+    printUsage();
+    return 2;
   }
 
-  QFile outputFile;
-  if (!outputFileName.isEmpty()) {
-    outputFile.setFileName(outputFileName);
-    if (!outputFile.open(QIODevice::WriteOnly)) {
-      cerr << "Cannot write to output file" << outputFileName.toLocal8Bit().constData() << endl;
-      return 4;
+  // class defaults are read from actual widget instances, the cache
+  // needs the application file path for hashing the executable
+  QScopedPointer<QCoreApplication> application;
+  if (optimize) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+      qputenv("QT_QPA_PLATFORM", "offscreen");
     }
-  } else {
-    outputFile.open(stdout, QIODevice::WriteOnly);
+    application.reset(new QApplication(argc, argv));
+    WidgetDefaults::initialize();
+  } else if (!cacheDirectory.isEmpty() || watch) {
+    application.reset(new QCoreApplication(argc, argv));
   }
 
-  Parser parser(&inputFile);
+  if (!outputDirectory.isEmpty()) {
+    if (!outputFileName.isEmpty()) {
+      cerr << "Invalid usage" << endl;
+      printUsage();
+      return 2;
+    }
 
-  const QSharedPointer<UiTopNode> topNode = parser.parse();
-  if (!parser.errorString().isEmpty()) {
-    cerr << "Failed to parse input file" << inputFileName.toLocal8Bit().constData() << endl;
-    cerr << "Error: " << parser.errorString().toLocal8Bit().constData() << endl;
-    return 5;
-  }
+    if (watch) {
+      return convertWatch(outputDirectory, format, optimize, inputs);
+    }
 
-  SharedVisitationContext sharedVisitationContext(new VisitationContext);
+    return convertBatch(outputDirectory, cacheDirectory, jobs, format, optimize, stats, inputs);
+  }
 
-  // set element "id" from objectName
-  IdVisitor idVisitor(sharedVisitationContext);
-  topNode->accept(&idVisitor);
+  if (jobs > 0) {
+    cerr << "Invalid usage" << endl;
+    printUsage();
+    return 2;
+  }
 
-  // handle layout items
-  ItemVisitor itemVisitor(sharedVisitationContext);
-  topNode->accept(&itemVisitor);
+  if (inputs.count() > 1) {
+    cerr << "Too many arguments" << endl;
+    printUsage();
+    return 1;
+  }
 
-  // handle layout adjustments
-  LayoutVisitor layoutVisitor(sharedVisitationContext);
-  topNode->accept(&layoutVisitor);
+  StageTimings timings;
 
-  // adjust class names
-  ElementNameVisitor classVisitor(sharedVisitationContext);
-  topNode->accept(&classVisitor);
+  QScopedPointer<ConversionCache> cache;
+  if (!cacheDirectory.isEmpty()) {
+    cache.reset(new ConversionCache(cacheDirectory));
+  }
 
-  // adjust font properties
-  FontProperyVisitor fontPropertiesVisitor(sharedVisitationContext);
-  topNode->accept(&fontPropertiesVisitor);
+  Converter converter;
+  converter.setConversionCache(cache.data());
+  converter.setOutputFormat(format);
+  converter.setOptimizationEnabled(optimize);
+  if (stats) {
+    converter.setStageTimings(&timings);
+  }
 
-  // handle label buddies
-  BuddyVisitor buddyVisitor(sharedVisitationContext);
-  topNode->accept(&buddyVisitor);
+  if (!converter.convert(inputs.first(), outputFileName)) {
+    cerr << "Error: " << converter.errorString().toLocal8Bit().constData() << endl;
 
-  // handle connections
-  ConnectionNodeVisitor connectionVisitor(sharedVisitationContext);
-  topNode->accept(&connectionVisitor);
+    switch (converter.error()) {
+    case Converter::InputError:
+      return 3;
+    case Converter::OutputError:
+      return 4;
+    default:
+      return 5;
+    }
+  }
 
-  // handle tab stops
-  TabStopsNodeVisitor tabStopsVisitor(sharedVisitationContext);
-  topNode->accept(&tabStopsVisitor);
+  if (optimize) {
+    printOptimizationStatistics(inputs.first(), converter.optimizationStatistics());
+  }
 
-  QmlWriter writer(&outputFile, sharedVisitationContext);
-  writer.write(topNode);
+  if (stats) {
+    printStageTimings(timings);
+  }
 
   return 0;
 }
+
+#include "main.moc"
@@ -0,0 +1,98 @@
+/*
+  memoryusage.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memoryusage.h"
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(Q_OS_DARWIN)
+#include <mach/mach.h>
+#elif defined(Q_OS_LINUX)
+#include <QFile>
+#endif
+#endif
+
+qint64 peakMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.PeakWorkingSetSize;
+  }
+  return -1;
+#elif defined(Q_OS_UNIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#if defined(Q_OS_DARWIN)
+  return usage.ru_maxrss;
+#else
+  // kilobytes everywhere else
+  return qint64(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return -1;
+#endif
+}
+
+qint64 currentMemoryUsage()
+{
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+    return counters.WorkingSetSize;
+  }
+  return -1;
+#elif defined(Q_OS_DARWIN)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return -1;
+  }
+  return info.resident_size;
+#elif defined(Q_OS_LINUX)
+  // the second field is the resident set size in pages
+  QFile statm(QLatin1String("/proc/self/statm"));
+  if (!statm.open(QIODevice::ReadOnly)) {
+    return -1;
+  }
+
+  const QList<QByteArray> fields = statm.readAll().split(' ');
+  bool ok = false;
+  const qint64 pages = fields.count() > 1 ? fields.at(1).toLongLong(&ok) : 0;
+  if (!ok) {
+    return -1;
+  }
+  return pages * sysconf(_SC_PAGESIZE);
+#else
+  return -1;
+#endif
+}
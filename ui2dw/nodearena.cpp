@@ -0,0 +1,113 @@
+/*
+  nodearena.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "nodearena.h"
+
+#include <QThreadStorage>
+
+#include <new>
+
+static const std::size_t s_blockSize = 64 * 1024;
+static const std::size_t s_alignment = 16;
+
+// QThreadStorage would delete a stored pointer, keep it in a struct instead
+struct CurrentArena
+{
+    CurrentArena()
+      : arena(0)
+    {
+    }
+
+    NodeArena *arena;
+};
+
+static QThreadStorage<CurrentArena> s_currentArena;
+
+NodeArena::Scope::Scope(NodeArena *arena)
+  : m_previous(s_currentArena.localData().arena)
+{
+  s_currentArena.localData().arena = arena;
+}
+
+NodeArena::Scope::~Scope()
+{
+  s_currentArena.localData().arena = m_previous;
+}
+
+NodeArena::NodeArena()
+  : m_position(0)
+  , m_end(0)
+  , m_allocatedBytes(0)
+  , m_reservedBytes(0)
+{
+}
+
+NodeArena::~NodeArena()
+{
+  Q_FOREACH (char *block, m_blocks) {
+    ::operator delete(block);
+  }
+}
+
+NodeArena *NodeArena::current()
+{
+  if (!s_currentArena.hasLocalData()) {
+    return 0;
+  }
+
+  return s_currentArena.localData().arena;
+}
+
+void *NodeArena::allocate(std::size_t size)
+{
+  size = (size + s_alignment - 1) & ~(s_alignment - 1);
+
+  if (m_position == 0 || std::size_t(m_end - m_position) < size) {
+    // oversized requests get a block of their own
+    const std::size_t blockSize = qMax(size, s_blockSize);
+    char *block = static_cast<char*>(::operator new(blockSize));
+    m_blocks << block;
+    m_position = block;
+    m_end = block + blockSize;
+    m_reservedBytes += blockSize;
+  }
+
+  void *result = m_position;
+  m_position += size;
+  m_allocatedBytes += size;
+
+  return result;
+}
+
+qint64 NodeArena::allocatedBytes() const
+{
+  return m_allocatedBytes;
+}
+
+qint64 NodeArena::reservedBytes() const
+{
+  return m_reservedBytes;
+}
@@ -0,0 +1,75 @@
+/*
+  nodearena.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NODEARENA_H
+#define NODEARENA_H
+
+#include <QVector>
+
+#include <cstddef>
+
+// Memory for the UiNode tree of one conversion.
+// Nodes created while a Scope is active on the current thread are placed
+// into large blocks instead of being allocated one by one. Deleting such a
+// node only runs its destructor, the memory is released with the arena, so
+// the arena has to outlive the tree. Without an active arena nodes are
+// allocated on the heap as usual.
+class NodeArena
+{
+  public:
+    class Scope
+    {
+      public:
+        explicit Scope(NodeArena *arena);
+        ~Scope();
+
+      private:
+        NodeArena *m_previous;
+    };
+
+    NodeArena();
+    ~NodeArena();
+
+    // the arena of the innermost Scope on this thread, or 0
+    static NodeArena *current();
+
+    // aligned for any node type
+    void *allocate(std::size_t size);
+
+    qint64 allocatedBytes() const;
+    qint64 reservedBytes() const;
+
+  private:
+    Q_DISABLE_COPY(NodeArena)
+
+    QVector<char*> m_blocks;
+    char *m_position;
+    char *m_end;
+    qint64 m_allocatedBytes;
+    qint64 m_reservedBytes;
+};
+
+#endif // NODEARENA_H
@@ -0,0 +1,328 @@
+/*
+  optimizingvisitor.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "optimizingvisitor.h"
+
+#include "uiactionnode.h"
+#include "uiconnectionnode.h"
+#include "uilayoutitemnode.h"
+#include "uilayoutnode.h"
+#include "uipropertynode.h"
+#include "uitabstopsnode.h"
+#include "uitopnode.h"
+#include "uiwidgetnode.h"
+#include "widgetdefaults.h"
+
+static bool isMarginProperty(const QString &name)
+{
+  return name == QLatin1String("margin") ||
+         name == QLatin1String("leftMargin") ||
+         name == QLatin1String("topMargin") ||
+         name == QLatin1String("rightMargin") ||
+         name == QLatin1String("bottomMargin");
+}
+
+static bool isSpacingProperty(const QString &name)
+{
+  return name == QLatin1String("spacing") ||
+         name == QLatin1String("horizontalSpacing") ||
+         name == QLatin1String("verticalSpacing");
+}
+
+static bool isBoxLayout(const QStringList &className)
+{
+  return className == QStringList(QLatin1String("QHBoxLayout")) ||
+         className == QStringList(QLatin1String("QVBoxLayout"));
+}
+
+// nested layouts have no margins by default, so a layout only setting them to 0
+// behaves like one without any properties. Its spacing only matters with more than one item
+static bool hasOnlyNeutralProperties(UiNode *layoutNode)
+{
+  for (int i = 0; i < layoutNode->childCount(); ++i) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(layoutNode->childAt(i));
+    if (propertyNode == 0) {
+      continue;
+    }
+
+    if (isMarginProperty(propertyNode->name())) {
+      if (propertyNode->value().toInt() != 0) {
+        return false;
+      }
+    } else if (!isSpacingProperty(propertyNode->name())) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool hasExplicitMargins(UiNode *layoutNode)
+{
+  int sides = 0;
+  for (int i = 0; i < layoutNode->childCount(); ++i) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(layoutNode->childAt(i));
+    if (propertyNode == 0) {
+      continue;
+    }
+
+    if (propertyNode->name() == QLatin1String("margin")) {
+      sides = 0xf;
+    } else if (propertyNode->name() == QLatin1String("leftMargin")) {
+      sides |= 0x1;
+    } else if (propertyNode->name() == QLatin1String("topMargin")) {
+      sides |= 0x2;
+    } else if (propertyNode->name() == QLatin1String("rightMargin")) {
+      sides |= 0x4;
+    } else if (propertyNode->name() == QLatin1String("bottomMargin")) {
+      sides |= 0x8;
+    }
+  }
+
+  return sides == 0xf;
+}
+
+static bool hasSpacing(UiNode *layoutNode)
+{
+  for (int i = 0; i < layoutNode->childCount(); ++i) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(layoutNode->childAt(i));
+    if (propertyNode != 0 && isSpacingProperty(propertyNode->name())) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static int propertyCount(UiNode *node)
+{
+  int count = 0;
+  for (int i = 0; i < node->childCount(); ++i) {
+    if (dynamic_cast<UiPropertyNode*>(node->childAt(i)) != 0) {
+      ++count;
+    }
+  }
+
+  return count;
+}
+
+OptimizingVisitor::OptimizingVisitor(const SharedVisitationContext &sharedContext)
+  : UiNodeVisitor(sharedContext)
+{
+}
+
+void OptimizingVisitor::visit(UiLayoutNode *layoutNode)
+{
+  int i = 0;
+  while (i < layoutNode->childCount()) {
+    // check the same item again, its new content might be collapsible as well
+    UiLayoutItemNode *itemNode = dynamic_cast<UiLayoutItemNode*>(layoutNode->childAt(i));
+    if (itemNode != 0 &&
+        (collapseSingleItemLayout(itemNode) || unwrapLayoutContainer(layoutNode, itemNode))) {
+      continue;
+    }
+
+    ++i;
+  }
+
+  visit(static_cast<UiObjectNode*>(layoutNode));
+}
+
+void OptimizingVisitor::visit(UiObjectNode *objectNode)
+{
+  removeDefaultProperties(objectNode);
+
+  objectNode->acceptChildren(this);
+}
+
+void OptimizingVisitor::visit(UiTopNode *topNode)
+{
+  // connections and tab stops are direct children of the top node,
+  // objects referenced by them have to be kept
+  for (int i = 0; i < topNode->childCount(); ++i) {
+    UiConnectionNode *connectionNode = dynamic_cast<UiConnectionNode*>(topNode->childAt(i));
+    if (connectionNode != 0) {
+      m_referencedObjectNames.insert(connectionNode->sender());
+      m_referencedObjectNames.insert(connectionNode->receiver());
+      continue;
+    }
+
+    UiTabStopsNode *tabStopsNode = dynamic_cast<UiTabStopsNode*>(topNode->childAt(i));
+    if (tabStopsNode != 0) {
+      Q_FOREACH (const QString &tabStop, tabStopsNode->tabStops()) {
+        m_referencedObjectNames.insert(tabStop);
+      }
+    }
+  }
+
+  topNode->acceptChildren(this);
+}
+
+OptimizationStatistics OptimizingVisitor::statistics() const
+{
+  return m_statistics;
+}
+
+void OptimizingVisitor::removeDefaultProperties(UiObjectNode *objectNode)
+{
+  const WidgetDefaults *defaults = WidgetDefaults::instance();
+  if (defaults == 0) {
+    return;
+  }
+
+  QString className = objectNode->className().join(QLatin1String("::"));
+  if (dynamic_cast<UiActionNode*>(objectNode) != 0) {
+    className = QLatin1String("QAction");
+  }
+
+  if (!defaults->hasClass(className)) {
+    return;
+  }
+
+  int i = 0;
+  while (i < objectNode->childCount()) {
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(objectNode->childAt(i));
+    if (propertyNode != 0 && defaults->isDefault(className, propertyNode->name(), propertyNode->value())) {
+      delete objectNode->takeChildAt(i);
+      ++m_statistics.eliminatedBindings;
+    } else {
+      ++i;
+    }
+  }
+}
+
+bool OptimizingVisitor::collapseSingleItemLayout(UiLayoutItemNode *itemNode)
+{
+  if (itemNode->childCount() != 1) {
+    return false;
+  }
+
+  UiLayoutNode *nestedLayoutNode = dynamic_cast<UiLayoutNode*>(itemNode->childAt(0));
+  if (nestedLayoutNode == 0 || m_referencedObjectNames.contains(nestedLayoutNode->name())) {
+    return false;
+  }
+
+  // form layouts treat their items differently depending on the column
+  if (!isBoxLayout(nestedLayoutNode->className()) &&
+      nestedLayoutNode->className() != QStringList(QLatin1String("QGridLayout"))) {
+    return false;
+  }
+
+  if (!hasOnlyNeutralProperties(nestedLayoutNode)) {
+    return false;
+  }
+
+  UiLayoutItemNode *nestedItemNode = 0;
+  for (int i = 0; i < nestedLayoutNode->childCount(); ++i) {
+    UiNode *childNode = nestedLayoutNode->childAt(i);
+    if (dynamic_cast<UiPropertyNode*>(childNode) != 0) {
+      continue;
+    }
+
+    UiLayoutItemNode *childItemNode = dynamic_cast<UiLayoutItemNode*>(childNode);
+    if (childItemNode == 0 || nestedItemNode != 0) {
+      return false;
+    }
+    nestedItemNode = childItemNode;
+  }
+
+  if (nestedItemNode == 0 || nestedItemNode->childCount() != 1) {
+    return false;
+  }
+
+  itemNode->takeChildAt(0);
+  itemNode->appendChild(nestedItemNode->takeChildAt(0));
+
+  eliminateObject(nestedLayoutNode);
+
+  return true;
+}
+
+bool OptimizingVisitor::unwrapLayoutContainer(UiLayoutNode *layoutNode, UiLayoutItemNode *itemNode)
+{
+  if (itemNode->childCount() != 1) {
+    return false;
+  }
+
+  UiWidgetNode *widgetNode = dynamic_cast<UiWidgetNode*>(itemNode->childAt(0));
+  if (widgetNode == 0 || m_referencedObjectNames.contains(widgetNode->name())) {
+    return false;
+  }
+
+  if (widgetNode->className() != QStringList(QLatin1String("QWidget"))) {
+    return false;
+  }
+
+  // the geometry of a managed widget is determined by the layout anyway
+  int nestedLayoutIndex = -1;
+  for (int i = 0; i < widgetNode->childCount(); ++i) {
+    UiNode *childNode = widgetNode->childAt(i);
+
+    UiPropertyNode *propertyNode = dynamic_cast<UiPropertyNode*>(childNode);
+    if (propertyNode != 0) {
+      if (propertyNode->name() != QLatin1String("geometry")) {
+        return false;
+      }
+      continue;
+    }
+
+    if (dynamic_cast<UiLayoutNode*>(childNode) == 0 || nestedLayoutIndex != -1) {
+      return false;
+    }
+    nestedLayoutIndex = i;
+  }
+
+  if (nestedLayoutIndex == -1) {
+    return false;
+  }
+
+  // the layout of a widget gets margins from the style, a nested one does not.
+  // Its spacing would be inherited from the outer layout instead of the style
+  UiNode *nestedLayoutNode = widgetNode->childAt(nestedLayoutIndex);
+  if (!hasExplicitMargins(nestedLayoutNode)) {
+    return false;
+  }
+
+  if (!hasSpacing(nestedLayoutNode) && hasSpacing(layoutNode)) {
+    return false;
+  }
+
+  widgetNode->takeChildAt(nestedLayoutIndex);
+  itemNode->takeChildAt(0);
+  itemNode->appendChild(nestedLayoutNode);
+
+  eliminateObject(widgetNode);
+
+  return true;
+}
+
+void OptimizingVisitor::eliminateObject(UiNode *node)
+{
+  ++m_statistics.eliminatedObjects;
+  m_statistics.eliminatedBindings += propertyCount(node);
+
+  delete node;
+}
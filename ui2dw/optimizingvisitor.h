@@ -0,0 +1,77 @@
+/*
+  optimizingvisitor.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPTIMIZINGVISITOR_H
+#define OPTIMIZINGVISITOR_H
+
+#include "uinodevisitor.h"
+
+#include <QSet>
+
+struct OptimizationStatistics
+{
+    OptimizationStatistics()
+      : eliminatedObjects(0)
+      , eliminatedBindings(0)
+    {
+    }
+
+    int eliminatedObjects;
+    int eliminatedBindings;
+};
+
+// Reduces the number of objects and property bindings in the generated code
+// without changing the resulting UI:
+// - drops properties set to the class default, see WidgetDefaults
+// - replaces nested layouts holding only a single item by that item
+// - replaces plain QWidget containers of a nested layout by the layout itself
+// Works on the tree as parsed, i.e. has to run before any other visitor
+// apart from IdVisitor, and only modifies nodes below the current one.
+class OptimizingVisitor : public UiNodeVisitor
+{
+  public:
+    explicit OptimizingVisitor(const SharedVisitationContext &sharedContext);
+
+    void visit(UiLayoutNode *layoutNode);
+    void visit(UiObjectNode *objectNode);
+    void visit(UiTopNode *topNode);
+
+    OptimizationStatistics statistics() const;
+
+  private:
+    void removeDefaultProperties(UiObjectNode *objectNode);
+
+    bool collapseSingleItemLayout(UiLayoutItemNode *itemNode);
+    bool unwrapLayoutContainer(UiLayoutNode *layoutNode, UiLayoutItemNode *itemNode);
+
+    void eliminateObject(UiNode *node);
+
+  private:
+    QSet<QString> m_referencedObjectNames;
+    OptimizationStatistics m_statistics;
+};
+
+#endif // OPTIMIZINGVISITOR_H
@@ -27,6 +27,7 @@
 
 #include "parser.h"
 
+#include "lookuptable.h"
 #include "uiconnectionnode.h"
 #include "uitabstopsnode.h"
 #include "uitopnode.h"
@@ -36,34 +37,39 @@
 #include <QIODevice>
 #include <QXmlStreamReader>
 
-static QSet<QString> ignoredElementNames()
+struct ElementTypeEntry
 {
-  QSet<QString> result;
-
-  result << QLatin1String("connections");
-  result << QLatin1String("ui");
-
-  return result;
-}
-
-static QSet<QString> skippedElementNames()
-{
-  QSet<QString> result;
-
-  result << QLatin1String("resources");
-
-  return result;
-}
+    const char *name;
+    Parser::ElementType type;
+};
+
+// sorted by name
+static const ElementTypeEntry elementTypeEntries[] = {
+  { "action", Parser::ActionElement },
+  { "addaction", Parser::AddActionElement },
+  { "class", Parser::ClassElement },
+  { "connection", Parser::ConnectionElement },
+  { "connections", Parser::ConnectionsElement },
+  { "item", Parser::ItemElement },
+  { "layout", Parser::LayoutElement },
+  { "property", Parser::PropertyElement },
+  { "resources", Parser::ResourcesElement },
+  { "spacer", Parser::SpacerElement },
+  { "tabstops", Parser::TabStopsElement },
+  { "ui", Parser::UiElement },
+  { "widget", Parser::WidgetElement }
+};
+
+static const LookupTable<ElementTypeEntry> elementTypes(elementTypeEntries, Qt::CaseInsensitive);
 
 Parser::Parser(QIODevice *inputDevice)
   : m_reader(new QXmlStreamReader(inputDevice))
-  , m_ignoredElementNames(ignoredElementNames())
-  , m_skippedElementNames(skippedElementNames())
 {
 }
 
 Parser::~Parser()
 {
+  qDeleteAll(m_nameStorage);
 }
 
 QSharedPointer<UiTopNode> Parser::parse()
@@ -76,29 +82,47 @@ QSharedPointer<UiTopNode> Parser::parse()
       continue;
     }
 
-    if (m_reader->name().compare(QLatin1String("widget"), Qt::CaseInsensitive) == 0) {
+    switch (elementType()) {
+    case WidgetElement: {
       UiNode *widgetNode = UiWidgetNode::parse(this);
       if (widgetNode != 0) {
         topNode->appendChild(widgetNode);
       }
-    } else if (m_reader->name().compare(QLatin1String("class"), Qt::CaseInsensitive) == 0) {
+      break;
+    }
+
+    case ClassElement:
       topNode->setClassName(m_reader->readElementText().split(QLatin1String("::")));
-    } else if (m_reader->name().compare(QLatin1String("connection"), Qt::CaseInsensitive) == 0) {
+      break;
+
+    case ConnectionElement: {
       UiNode *connectionNode = UiConnectionNode::parse(this);
       if (connectionNode != 0) {
         topNode->appendChild(connectionNode);
       }
-    } else if (m_reader->name().compare(QLatin1String("tabstops"), Qt::CaseInsensitive) == 0) {
+      break;
+    }
+
+    case TabStopsElement: {
       UiNode *tabStopsNode = UiTabStopsNode::parse(this);
       if (tabStopsNode != 0) {
         topNode->appendChild(tabStopsNode);
       }
-    } else if (m_ignoredElementNames.contains(m_reader->name().toString())) {
-      continue;
-    } else if (m_skippedElementNames.contains(m_reader->name().toString())) {
+      break;
+    }
+
+    // containers of elements handled above
+    case ConnectionsElement:
+    case UiElement:
+      break;
+
+    case ResourcesElement:
       m_reader->skipCurrentElement();
-    } else {
+      break;
+
+    default:
       qWarning() << "Skipping unsupported element" << m_reader->name();
+      break;
     }
   }
 
@@ -115,6 +139,13 @@ QXmlStreamReader *Parser::reader() const
   return m_reader.data();
 }
 
+Parser::ElementType Parser::elementType() const
+{
+  const ElementTypeEntry *entry = elementTypes.find(m_reader->name());
+
+  return entry != 0 ? entry->type : UnknownElement;
+}
+
 bool Parser::readUntilElement(const QString &parent, const QString &element)
 {
   while (!m_reader->atEnd()) {
@@ -130,3 +161,30 @@ bool Parser::readUntilElement(const QString &parent, const QString &element)
 
   return false;
 }
+
+QString Parser::internedName(const QStringRef &name)
+{
+  QHash<QStringRef, QString>::const_iterator it = m_names.constFind(name);
+  if (it != m_names.constEnd()) {
+    return *it;
+  }
+
+  QString *storedName = new QString(name.toString());
+  m_nameStorage << storedName;
+  m_names.insert(QStringRef(storedName), *storedName);
+
+  return *storedName;
+}
+
+QStringList Parser::internedClassName(const QString &className)
+{
+  QHash<QString, QStringList>::const_iterator it = m_classNames.constFind(className);
+  if (it != m_classNames.constEnd()) {
+    return *it;
+  }
+
+  const QStringList result = className.split(QLatin1String("::"));
+  m_classNames.insert(className, result);
+
+  return result;
+}
@@ -28,9 +28,11 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-#include <QSet>
+#include <QHash>
 #include <QSharedPointer>
 #include <QScopedPointer>
+#include <QStringList>
+#include <QVector>
 
 QT_BEGIN_NAMESPACE
 class QIODevice;
@@ -43,6 +45,23 @@ class UiTopNode;
 class Parser
 {
   public:
+    enum ElementType {
+      UnknownElement,
+      ActionElement,
+      AddActionElement,
+      ClassElement,
+      ConnectionElement,
+      ConnectionsElement,
+      ItemElement,
+      LayoutElement,
+      PropertyElement,
+      ResourcesElement,
+      SpacerElement,
+      TabStopsElement,
+      UiElement,
+      WidgetElement
+    };
+
     explicit Parser(QIODevice *inputDevice);
     ~Parser();
 
@@ -52,12 +71,25 @@ class Parser
 
     QXmlStreamReader *reader() const;
 
+    // of the reader's current element
+    ElementType elementType() const;
+
     bool readUntilElement(const QString &parent, const QString &element);
 
+    // names repeated throughout a document, e.g. property names, share
+    // a single copy
+    QString internedName(const QStringRef &name);
+
+    // className split into its scopes, shared by all objects of the class
+    QStringList internedClassName(const QString &className);
+
   protected:
     QScopedPointer<QXmlStreamReader> m_reader;
-    const QSet<QString> m_ignoredElementNames;
-    const QSet<QString> m_skippedElementNames;
+
+    // keys refer to the strings in m_nameStorage
+    QHash<QStringRef, QString> m_names;
+    QVector<QString*> m_nameStorage;
+    QHash<QString, QStringList> m_classNames;
 };
 
 #endif // PARSER_H
@@ -0,0 +1,82 @@
+/*
+  stagetimings.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "stagetimings.h"
+
+StageTimings::StageTimings()
+  : m_traversals(0)
+{
+}
+
+void StageTimings::addTime(const QString &stage, qint64 nsecs)
+{
+  QHash<QString, qint64>::iterator it = m_times.find(stage);
+  if (it == m_times.end()) {
+    m_stages << stage;
+    m_times.insert(stage, nsecs);
+  } else {
+    *it += nsecs;
+  }
+}
+
+void StageTimings::addTraversals(int count)
+{
+  m_traversals += count;
+}
+
+void StageTimings::merge(const StageTimings &other)
+{
+  Q_FOREACH (const QString &stage, other.m_stages) {
+    addTime(stage, other.m_times.value(stage));
+  }
+
+  m_traversals += other.m_traversals;
+}
+
+QStringList StageTimings::stages() const
+{
+  return m_stages;
+}
+
+qint64 StageTimings::time(const QString &stage) const
+{
+  return m_times.value(stage);
+}
+
+qint64 StageTimings::totalTime() const
+{
+  qint64 total = 0;
+  Q_FOREACH (qint64 nsecs, m_times) {
+    total += nsecs;
+  }
+
+  return total;
+}
+
+int StageTimings::traversals() const
+{
+  return m_traversals;
+}
@@ -0,0 +1,57 @@
+/*
+  stagetimings.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef STAGETIMINGS_H
+#define STAGETIMINGS_H
+
+#include <QHash>
+#include <QStringList>
+
+// Accumulated time per conversion stage, in nanoseconds
+class StageTimings
+{
+  public:
+    StageTimings();
+
+    void addTime(const QString &stage, qint64 nsecs);
+    void addTraversals(int count);
+
+    void merge(const StageTimings &other);
+
+    // in order of first appearance
+    QStringList stages() const;
+    qint64 time(const QString &stage) const;
+    qint64 totalTime() const;
+
+    int traversals() const;
+
+  private:
+    QStringList m_stages;
+    QHash<QString, qint64> m_times;
+    int m_traversals;
+};
+
+#endif // STAGETIMINGS_H
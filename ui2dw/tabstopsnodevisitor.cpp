@@ -48,10 +48,8 @@ void TabStopsNodeVisitor::visit(UiTabStopsNode *tabStopsNode)
   m_tabStopsNodes << tabStopsNode;
 }
 
-void TabStopsNodeVisitor::visit(UiTopNode *topNode)
+void TabStopsNodeVisitor::endVisit(UiTopNode *topNode)
 {
-  UiNodeVisitor::visit(topNode);
-
   if (m_widgetNode != 0) {
     int i = 0;
     while (i < topNode->childCount()) {
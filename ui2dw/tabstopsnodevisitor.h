@@ -36,9 +36,10 @@ class TabStopsNodeVisitor : public UiNodeVisitor
     explicit TabStopsNodeVisitor(const SharedVisitationContext &sharedContext);
 
     void visit(UiTabStopsNode *tabStopsNode);
-    void visit(UiTopNode *topNode);
     void visit(UiWidgetNode *widgetNode);
 
+    void endVisit(UiTopNode *topNode);
+
   private:
     UiWidgetNode *m_widgetNode;
     QSet<UiNode*> m_tabStopsNodes;
@@ -0,0 +1,85 @@
+QT += widgets
+
+# reported by --version and part of the conversion cache key
+UI2DW_VERSION = 1.1
+DEFINES += UI2DW_VERSION=\\\"$$UI2DW_VERSION\\\"
+
+win32: LIBS += -lpsapi
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+SOURCES += \
+    $$PWD/uinode.cpp \
+    $$PWD/uinodevisitor.cpp \
+    $$PWD/uiwidgetnode.cpp \
+    $$PWD/parser.cpp \
+    $$PWD/uitopnode.cpp \
+    $$PWD/qmlwriter.cpp \
+    $$PWD/idvisitor.cpp \
+    $$PWD/uilayoutnode.cpp \
+    $$PWD/uiobjectnode.cpp \
+    $$PWD/uipropertynode.cpp \
+    $$PWD/elementnamevisitor.cpp \
+    $$PWD/uiactionnode.cpp \
+    $$PWD/uiaddactionnode.cpp \
+    $$PWD/uilayoutitemnode.cpp \
+    $$PWD/itemvisitor.cpp \
+    $$PWD/uispacernode.cpp \
+    $$PWD/fontproperyvisitor.cpp \
+    $$PWD/uiconnectionnode.cpp \
+    $$PWD/connectionnodevisitor.cpp \
+    $$PWD/layoutvisitor.cpp \
+    $$PWD/buddyvisitor.cpp \
+    $$PWD/uitabstopsnode.cpp \
+    $$PWD/tabstopsnodevisitor.cpp \
+    $$PWD/converter.cpp \
+    $$PWD/batchconverter.cpp \
+    $$PWD/stagetimings.cpp \
+    $$PWD/compositevisitor.cpp \
+    $$PWD/visitorpipeline.cpp \
+    $$PWD/cppwriter.cpp \
+    $$PWD/widgetdefaults.cpp \
+    $$PWD/optimizingvisitor.cpp \
+    $$PWD/conversioncache.cpp \
+    $$PWD/nodearena.cpp \
+    $$PWD/memoryusage.cpp \
+    $$PWD/watchconverter.cpp
+
+HEADERS += \
+    $$PWD/uinode.h \
+    $$PWD/uinodevisitor.h \
+    $$PWD/uiwidgetnode.h \
+    $$PWD/parser.h \
+    $$PWD/uitopnode.h \
+    $$PWD/qmlwriter.h \
+    $$PWD/idvisitor.h \
+    $$PWD/uilayoutnode.h \
+    $$PWD/uiobjectnode.h \
+    $$PWD/uipropertynode.h \
+    $$PWD/elementnamevisitor.h \
+    $$PWD/uiactionnode.h \
+    $$PWD/uiaddactionnode.h \
+    $$PWD/uilayoutitemnode.h \
+    $$PWD/itemvisitor.h \
+    $$PWD/uispacernode.h \
+    $$PWD/fontproperyvisitor.h \
+    $$PWD/uiconnectionnode.h \
+    $$PWD/connectionnodevisitor.h \
+    $$PWD/layoutvisitor.h \
+    $$PWD/buddyvisitor.h \
+    $$PWD/uitabstopsnode.h \
+    $$PWD/tabstopsnodevisitor.h \
+    $$PWD/converter.h \
+    $$PWD/batchconverter.h \
+    $$PWD/stagetimings.h \
+    $$PWD/compositevisitor.h \
+    $$PWD/visitorpipeline.h \
+    $$PWD/cppwriter.h \
+    $$PWD/widgetdefaults.h \
+    $$PWD/optimizingvisitor.h \
+    $$PWD/conversioncache.h \
+    $$PWD/nodearena.h \
+    $$PWD/lookuptable.h \
+    $$PWD/memoryusage.h \
+    $$PWD/watchconverter.h
@@ -91,26 +91,31 @@ UiNode *UiLayoutItemNode::parse(Parser *parser)
       }
     }
 
-    if (parser->reader()->name().compare(QLatin1String("widget"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiWidgetNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("layout"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiLayoutNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("spacer"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiSpacerNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else {
+    UiNode *childNode = 0;
+
+    switch (parser->elementType()) {
+    case Parser::WidgetElement:
+      childNode = UiWidgetNode::parse(parser);
+      break;
+
+    case Parser::LayoutElement:
+      childNode = UiLayoutNode::parse(parser);
+      break;
+
+    case Parser::SpacerElement:
+      childNode = UiSpacerNode::parse(parser);
+      break;
+
+    default:
       qDebug() << "Skipping unsupported" << parser->reader()->name().toString()
                << "sub element of item element, line"
                << parser->reader()->lineNumber();
       parser->reader()->skipCurrentElement();
+      break;
+    }
+
+    if (childNode != 0) {
+      target->appendChild(childNode);
     }
   }
   return target;
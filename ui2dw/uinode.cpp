@@ -27,8 +27,12 @@
 
 #include "uinode.h"
 
+#include "nodearena.h"
 #include "uinodevisitor.h"
 
+// keeps the owning arena in front of each node, padded to keep the alignment
+static const std::size_t s_headerSize = 16;
+
 UiNode::UiNode()
 {
 }
@@ -38,8 +42,35 @@ UiNode::~UiNode()
   qDeleteAll(m_children);
 }
 
+void *UiNode::operator new(std::size_t size)
+{
+  NodeArena *arena = NodeArena::current();
+
+  void *memory = arena != 0 ? arena->allocate(s_headerSize + size) : ::operator new(s_headerSize + size);
+  *static_cast<NodeArena**>(memory) = arena;
+
+  return static_cast<char*>(memory) + s_headerSize;
+}
+
+void UiNode::operator delete(void *pointer)
+{
+  if (pointer == 0) {
+    return;
+  }
+
+  // arena memory is released together with the arena
+  char *memory = static_cast<char*>(pointer) - s_headerSize;
+  if (*reinterpret_cast<NodeArena**>(memory) == 0) {
+    ::operator delete(memory);
+  }
+}
+
 void UiNode::acceptChildren(UiNodeVisitor *visitor)
 {
+  if (!visitor->isRecursive()) {
+    return;
+  }
+
   Q_FOREACH (UiNode *child, m_children) {
     child->accept(visitor);
   }
@@ -55,6 +86,11 @@ void UiNode::prependChild(UiNode *node)
   m_children.prepend(node);
 }
 
+void UiNode::insertChild(int index, UiNode *node)
+{
+  m_children.insert(index, node);
+}
+
 UiNode *UiNode::childAt(int index)
 {
   return m_children.at(index);
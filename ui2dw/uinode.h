@@ -33,17 +33,24 @@ class UiNodeVisitor;
 #include <QList>
 #include <QString>
 
+#include <cstddef>
+
 class UiNode
 {
   public:
     UiNode();
     virtual ~UiNode();
 
+    // allocate from the current NodeArena if there is one
+    static void *operator new(std::size_t size);
+    static void operator delete(void *pointer);
+
     virtual void accept(UiNodeVisitor *visitor) = 0;
     void acceptChildren(UiNodeVisitor *visitor);
 
     virtual void appendChild(UiNode *node);
     virtual void prependChild(UiNode *node);
+    void insertChild(int index, UiNode *node);
     UiNode *childAt(int index);
     UiNode *takeChildAt(int index);
     int childCount() const;
@@ -114,6 +114,7 @@ QString VisitationContext::idForObjectName(const QString &objectName) const
 
 UiNodeVisitor::UiNodeVisitor(const SharedVisitationContext &sharedContext)
   : m_sharedContext(sharedContext)
+  , m_recursive(true)
 {
 }
 
@@ -180,3 +181,18 @@ void UiNodeVisitor::visit(UiWidgetNode *widgetNode)
 {
   visit(static_cast<UiObjectNode*>(widgetNode));
 }
+
+void UiNodeVisitor::endVisit(UiTopNode *topNode)
+{
+  Q_UNUSED(topNode);
+}
+
+bool UiNodeVisitor::isRecursive() const
+{
+  return m_recursive;
+}
+
+void UiNodeVisitor::setRecursive(bool recursive)
+{
+  m_recursive = recursive;
+}
@@ -89,8 +89,19 @@ class UiNodeVisitor
     virtual void visit(UiTopNode*topNode);
     virtual void visit(UiWidgetNode *widgetNode);
 
+    // called after all nodes below topNode have been visited
+    virtual void endVisit(UiTopNode *topNode);
+
+    // a non-recursive visitor only handles the node it is applied to,
+    // e.g. when a CompositeVisitor drives the traversal
+    bool isRecursive() const;
+    void setRecursive(bool recursive);
+
   protected:
     SharedVisitationContext m_sharedContext;
+
+  private:
+    bool m_recursive;
 };
 
 #endif // UINODEVISITOR_H
@@ -72,7 +72,9 @@ void UiObjectNode::setId(const QString &id)
 
 UiObjectNode *UiObjectNode::parse(UiObjectNode *target, Parser *parser)
 {
-  const QString className = parser->reader()->attributes().value(QLatin1String("class")).toString();
+  const QXmlStreamAttributes attributes = parser->reader()->attributes();
+
+  const QString className = parser->internedName(attributes.value(QLatin1String("class")));
   if (className.isEmpty()) {
     parser->reader()->raiseError(target->m_elementName + QLatin1String(" element is missing the class attribute"));
     delete target;
@@ -80,8 +82,8 @@ UiObjectNode *UiObjectNode::parse(UiObjectNode *target, Parser *parser)
   }
 
   QString objectName;
-  if (parser->reader()->attributes().hasAttribute(QLatin1String("name"))) {
-    objectName = parser->reader()->attributes().value(QLatin1String("name")).toString();
+  if (attributes.hasAttribute(QLatin1String("name"))) {
+    objectName = attributes.value(QLatin1String("name")).toString();
     if (objectName.isEmpty()) {
       qWarning() << target->m_elementName << "element has an empty name attribute";
     } else {
@@ -89,7 +91,7 @@ UiObjectNode *UiObjectNode::parse(UiObjectNode *target, Parser *parser)
     }
   }
 
-  target->setClassName(className.split(QLatin1String("::")));
+  target->setClassName(parser->internedClassName(className));
 
   while (!parser->reader()->atEnd()) {
     if (!parser->reader()->readNextStartElement()) {
@@ -100,27 +102,26 @@ UiObjectNode *UiObjectNode::parse(UiObjectNode *target, Parser *parser)
       }
     }
 
-    if (parser->reader()->name().compare(QLatin1String("widget"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiWidgetNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("layout"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiLayoutNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("property"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiPropertyNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("action"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiActionNode::parse(parser);
-      if (childNode != 0) {
-        target->appendChild(childNode);
-      }
-    } else if (parser->reader()->name().compare(QLatin1String("addaction"), Qt::CaseInsensitive) == 0) {
+    UiNode *childNode = 0;
+
+    switch (parser->elementType()) {
+    case Parser::WidgetElement:
+      childNode = UiWidgetNode::parse(parser);
+      break;
+
+    case Parser::LayoutElement:
+      childNode = UiLayoutNode::parse(parser);
+      break;
+
+    case Parser::PropertyElement:
+      childNode = UiPropertyNode::parse(parser);
+      break;
+
+    case Parser::ActionElement:
+      childNode = UiActionNode::parse(parser);
+      break;
+
+    case Parser::AddActionElement: {
       const QString actionName = parser->reader()->attributes().value(QLatin1String("name")).toString();
       if (actionName.isEmpty()) {
         parser->reader()->raiseError(QLatin1String("addaction element is missing the name attribute"));
@@ -128,20 +129,28 @@ UiObjectNode *UiObjectNode::parse(UiObjectNode *target, Parser *parser)
         continue;
       }
 
-      UiNode *childNode = new UiAddActionNode;
+      childNode = new UiAddActionNode;
       childNode->setName(actionName);
-      target->appendChild(childNode);
-    } else if (parser->reader()->name().compare(QLatin1String("item"), Qt::CaseInsensitive) == 0) {
-      UiNode *childNode = UiLayoutItemNode::parse(parser);
+      break;
+    }
+
+    case Parser::ItemElement:
+      childNode = UiLayoutItemNode::parse(parser);
       if (childNode != 0) {
         childNode->setName(className);
-        target->appendChild(childNode);
       }
-    } else {
+      break;
+
+    default:
       qDebug() << "Skipping unsupported" << parser->reader()->name().toString()
                << "sub element of" << target->m_elementName << "element" << objectName << ", line"
                << parser->reader()->lineNumber();
       parser->reader()->skipCurrentElement();
+      break;
+    }
+
+    if (childNode != 0) {
+      target->appendChild(childNode);
     }
   }
 
@@ -27,6 +27,7 @@
 
 #include "uipropertynode.h"
 
+#include "lookuptable.h"
 #include "parser.h"
 #include "uinodevisitor.h"
 
@@ -34,242 +35,206 @@
 #include <QRect>
 #include <QXmlStreamReader>
 
-class PropertyValueParser
+typedef QVariant (*ValueParser)(Parser *parser);
+
+struct ValueParserEntry
 {
-  public:
-    virtual ~PropertyValueParser() {}
-    virtual QVariant parse(Parser *parser) = 0;
+    const char *name;
+    ValueParser parse;
 };
 
-class BoolValueParser : public PropertyValueParser
+static QVariant parseBool(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      const QString text = parser->reader()->readElementText().toLower();
-      if (text == QLatin1String("true")) {
-        return QVariant(true);
-      } else if (text == QLatin1String("false")) {
-        return QVariant(false);
-      }
-      return QVariant();
-    }
-};
+  const QString text = parser->reader()->readElementText().toLower();
+  if (text == QLatin1String("true")) {
+    return QVariant(true);
+  } else if (text == QLatin1String("false")) {
+    return QVariant(false);
+  }
+  return QVariant();
+}
 
-class DoubleValueParser : public PropertyValueParser
+static QVariant parseDouble(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      bool ok = false;
-      const double value = parser->reader()->readElementText().toDouble(&ok);
-      if (ok) {
-        return QVariant(value);
-      }
-      return QVariant();
-    }
-};
+  bool ok = false;
+  const double value = parser->reader()->readElementText().toDouble(&ok);
+  if (ok) {
+    return QVariant(value);
+  }
+  return QVariant();
+}
 
-class EnumValueParser : public PropertyValueParser
+static EnumValue parseEnumString(const QString &enumString)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      return QVariant::fromValue(parseEnumString(parser->reader()->readElementText()));
-    }
+  EnumValue value;
+  value.nameParts = enumString.split(QLatin1String("::"));
+  return value;
+}
 
-    static EnumValue parseEnumString(const QString &enumString)
-    {
-      EnumValue value;
-      value.nameParts = enumString.split(QLatin1String("::"));
-      return value;
-    }
-};
+static QVariant parseEnum(Parser *parser)
+{
+  return QVariant::fromValue(parseEnumString(parser->reader()->readElementText()));
+}
 
-class NumberValueParser : public PropertyValueParser
+static QVariant parseNumber(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      bool ok = false;
-      const int value = parser->reader()->readElementText().toInt(&ok);
-      if (ok) {
-        return QVariant(value);
-      }
-      return QVariant();
-    }
-};
+  bool ok = false;
+  const int value = parser->reader()->readElementText().toInt(&ok);
+  if (ok) {
+    return QVariant(value);
+  }
+  return QVariant();
+}
 
-class PixmapValueParser : public PropertyValueParser
+static QVariant parsePixmap(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      PixmapValue value;
+  PixmapValue value;
 
-      value.resource = parser->reader()->attributes().value(QLatin1String("resource")).toString();
-      value.fileName = parser->reader()->readElementText();
+  value.resource = parser->reader()->attributes().value(QLatin1String("resource")).toString();
+  value.fileName = parser->reader()->readElementText();
 
-      return QVariant::fromValue(value);
-    }
-};
+  return QVariant::fromValue(value);
+}
 
-class RectValueParser : public PropertyValueParser
+static QVariant parseRect(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      QRect r;
-
-      if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("x"))) {
-        parser->reader()->raiseError(QLatin1String("rect property element does not have an x element"));
-        return QVariant();
-      }
-      r.setX(parser->reader()->readElementText().toInt());
+  QRect r;
 
-      if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("y"))) {
-        parser->reader()->raiseError(QLatin1String("rect property element does not have a y element"));
-        return QVariant();
-      }
-      r.setY(parser->reader()->readElementText().toInt());
+  if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("x"))) {
+    parser->reader()->raiseError(QLatin1String("rect property element does not have an x element"));
+    return QVariant();
+  }
+  r.setX(parser->reader()->readElementText().toInt());
 
-      if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("width"))) {
-        parser->reader()->raiseError(QLatin1String("rect property element does not have a width element"));
-        return QVariant();
-      }
-      r.setWidth(parser->reader()->readElementText().toInt());
+  if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("y"))) {
+    parser->reader()->raiseError(QLatin1String("rect property element does not have a y element"));
+    return QVariant();
+  }
+  r.setY(parser->reader()->readElementText().toInt());
 
-      if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("height"))) {
-        parser->reader()->raiseError(QLatin1String("rect property element does not have a height element"));
-        return QVariant();
-      }
-      r.setHeight(parser->reader()->readElementText().toInt());
+  if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("width"))) {
+    parser->reader()->raiseError(QLatin1String("rect property element does not have a width element"));
+    return QVariant();
+  }
+  r.setWidth(parser->reader()->readElementText().toInt());
 
-      return QVariant(r);
-    }
-};
+  if (!parser->readUntilElement(QLatin1String("rect"), QLatin1String("height"))) {
+    parser->reader()->raiseError(QLatin1String("rect property element does not have a height element"));
+    return QVariant();
+  }
+  r.setHeight(parser->reader()->readElementText().toInt());
+
+  return QVariant(r);
+}
 
-class SetValueParser : public PropertyValueParser
+static QVariant parseSet(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      const QStringList flagList = parser->reader()->readElementText().split(QLatin1String("|"));
+  const QStringList flagList = parser->reader()->readElementText().split(QLatin1String("|"));
 
-      SetValue value;
+  SetValue value;
 
-      Q_FOREACH (const QString &flagString, flagList) {
-        value.flags << EnumValueParser::parseEnumString(flagString);
-      }
+  Q_FOREACH (const QString &flagString, flagList) {
+    value.flags << parseEnumString(flagString);
+  }
 
-      return QVariant::fromValue(value);
-    }
-};
+  return QVariant::fromValue(value);
+}
 
-class SizeValueParser : public PropertyValueParser
+static QVariant parseSize(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      QSize s;
-
-      if (!parser->readUntilElement(QLatin1String("size"), QLatin1String("width"))) {
-        parser->reader()->raiseError(QLatin1String("size property element does not have a width element"));
-        return QVariant();
-      }
-      s.setWidth(parser->reader()->readElementText().toInt());
+  QSize s;
 
-      if (!parser->readUntilElement(QLatin1String("size"), QLatin1String("height"))) {
-        parser->reader()->raiseError(QLatin1String("size property element does not have a height element"));
-        return QVariant();
-      }
-      s.setHeight(parser->reader()->readElementText().toInt());
+  if (!parser->readUntilElement(QLatin1String("size"), QLatin1String("width"))) {
+    parser->reader()->raiseError(QLatin1String("size property element does not have a width element"));
+    return QVariant();
+  }
+  s.setWidth(parser->reader()->readElementText().toInt());
 
-      return QVariant(s);
-    }
-};
+  if (!parser->readUntilElement(QLatin1String("size"), QLatin1String("height"))) {
+    parser->reader()->raiseError(QLatin1String("size property element does not have a height element"));
+    return QVariant();
+  }
+  s.setHeight(parser->reader()->readElementText().toInt());
+
+  return QVariant(s);
+}
 
-class StringValueParser : public PropertyValueParser
+static QVariant parseString(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      return QVariant(parser->reader()->readElementText());
-    }
+  return QVariant(parser->reader()->readElementText());
+}
+
+// sorted by name
+static const ValueParserEntry fontValueParserEntries[] = {
+  { "bold", &parseBool },
+  { "family", &parseString },
+  { "italic", &parseBool },
+  { "kerning", &parseBool },
+  { "pointsize", &parseNumber },
+  { "strikeout", &parseBool },
+  { "stylestrategy", &parseEnum },
+  { "underline", &parseBool },
+  { "weight", &parseNumber }
 };
 
+static const LookupTable<ValueParserEntry> fontValueParsers(fontValueParserEntries, Qt::CaseSensitive);
 
-class FontValueParser : public PropertyValueParser
+static QVariant parseFont(Parser *parser)
 {
-  public:
-    QVariant parse(Parser *parser)
-    {
-      initializeValueParsers();
-
-      FontValue fontValue;
-
-      while (!parser->reader()->atEnd()) {
-        parser->reader()->readNext();
-        if (parser->reader()->isEndElement() && parser->reader()->name().compare(QLatin1String("font")) == 0) {
-          break;
-        }
-
-        if (parser->reader()->isStartElement()) {
-          const QString valueName = parser->reader()->name().toString();
-          PropertyValueParser *const valueParser = s_valueParsers.value(valueName);
-          if (valueParser == 0) {
-            qWarning() << "skipping unsupported font property type" << valueName
-                       << "in line" << parser->reader()->lineNumber();
-            parser->reader()->skipCurrentElement();
-            continue;
-          }
-
-          const QVariant value = valueParser->parse(parser);
-          if (!value.isValid()) {
-            qWarning() << "skipping unsupported font property type" << valueName
-                       << "in line" << parser->reader()->lineNumber();
-            parser->reader()->skipCurrentElement();
-            continue;
-          }
-
-          fontValue.fontProperties.insert(valueName, value);
-        }
+  FontValue fontValue;
+
+  while (!parser->reader()->atEnd()) {
+    parser->reader()->readNext();
+    if (parser->reader()->isEndElement() && parser->reader()->name().compare(QLatin1String("font")) == 0) {
+      break;
+    }
+
+    if (parser->reader()->isStartElement()) {
+      const ValueParserEntry *entry = fontValueParsers.find(parser->reader()->name());
+      if (entry == 0) {
+        qWarning() << "skipping unsupported font property type" << parser->reader()->name().toString()
+                   << "in line" << parser->reader()->lineNumber();
+        parser->reader()->skipCurrentElement();
+        continue;
       }
 
-      if (!fontValue.fontProperties.isEmpty()) {
-        return QVariant::fromValue(fontValue);
+      const QString valueName = parser->internedName(parser->reader()->name());
+      const QVariant value = entry->parse(parser);
+      if (!value.isValid()) {
+        qWarning() << "skipping unsupported font property type" << valueName
+                   << "in line" << parser->reader()->lineNumber();
+        parser->reader()->skipCurrentElement();
+        continue;
       }
 
-      qWarning() << "font property without any supported sub properties";
-      return QVariant();
+      fontValue.fontProperties.insert(valueName, value);
     }
+  }
 
-  private:
-    typedef QHash<QString, PropertyValueParser*> ValueParserHash;
-    static ValueParserHash s_valueParsers;
+  if (!fontValue.fontProperties.isEmpty()) {
+    return QVariant::fromValue(fontValue);
+  }
 
-  private:
-    static void initializeValueParsers()
-    {
-      if (!s_valueParsers.isEmpty()) {
-        return;
-      }
+  qWarning() << "font property without any supported sub properties";
+  return QVariant();
+}
 
-      s_valueParsers.insert(QLatin1String("bold"), new BoolValueParser);
-      s_valueParsers.insert(QLatin1String("family"), new StringValueParser);
-      s_valueParsers.insert(QLatin1String("italic"), new BoolValueParser);
-      s_valueParsers.insert(QLatin1String("kerning"), new BoolValueParser);
-      s_valueParsers.insert(QLatin1String("pointsize"), new NumberValueParser);
-      s_valueParsers.insert(QLatin1String("strikeout"), new BoolValueParser);
-      s_valueParsers.insert(QLatin1String("underline"), new BoolValueParser);
-      s_valueParsers.insert(QLatin1String("weight"), new NumberValueParser);
-      s_valueParsers.insert(QLatin1String("stylestrategy"), new EnumValueParser);
-    }
+// sorted by name
+static const ValueParserEntry valueParserEntries[] = {
+  { "bool", &parseBool },
+  { "cstring", &parseString },
+  { "double", &parseDouble },
+  { "enum", &parseEnum },
+  { "font", &parseFont },
+  { "number", &parseNumber },
+  { "pixmap", &parsePixmap },
+  { "rect", &parseRect },
+  { "set", &parseSet },
+  { "size", &parseSize },
+  { "string", &parseString }
 };
 
-FontValueParser::ValueParserHash FontValueParser::s_valueParsers;
-
-UiPropertyNode::ValueParserHash UiPropertyNode::s_valueParsers;
+static const LookupTable<ValueParserEntry> valueParsers(valueParserEntries, Qt::CaseSensitive);
 
 UiPropertyNode::UiPropertyNode()
 {
@@ -277,7 +242,7 @@ UiPropertyNode::UiPropertyNode()
 
 UiNode *UiPropertyNode::parse(Parser *parser)
 {
-  const QString objectName = parser->reader()->attributes().value(QLatin1String("name")).toString();
+  const QString objectName = parser->internedName(parser->reader()->attributes().value(QLatin1String("name")));
   if (objectName.isEmpty()) {
     parser->reader()->raiseError(QLatin1String("property element is missing the name attribute"));
     return 0;
@@ -288,17 +253,15 @@ UiNode *UiPropertyNode::parse(Parser *parser)
     return 0;
   }
 
-  initializeValueParsers();
-
-  PropertyValueParser *const valueParser = s_valueParsers.value(parser->reader()->name().toString());
-  if (valueParser == 0) {
+  const ValueParserEntry *entry = valueParsers.find(parser->reader()->name());
+  if (entry == 0) {
     qWarning() << "skipping unsupported property type" << parser->reader()->name().toString()
                << "in line" << parser->reader()->lineNumber();
     parser->reader()->skipCurrentElement();
     return 0;
   }
 
-  const QVariant value = valueParser->parse(parser);
+  const QVariant value = entry->parse(parser);
   if (!value.isValid()) {
     qWarning() << "skipping unsupported property type" << parser->reader()->name().toString()
                << "in line" << parser->reader()->lineNumber();
@@ -327,22 +290,3 @@ void UiPropertyNode::setValue(const QVariant &value)
 {
   m_value = value;
 }
-
-void UiPropertyNode::initializeValueParsers()
-{
-  if (!s_valueParsers.isEmpty()) {
-    return;
-  }
-
-  s_valueParsers.insert(QLatin1String("bool"), new BoolValueParser);
-  s_valueParsers.insert(QLatin1String("cstring"), new StringValueParser);
-  s_valueParsers.insert(QLatin1String("double"), new DoubleValueParser);
-  s_valueParsers.insert(QLatin1String("enum"), new EnumValueParser);
-  s_valueParsers.insert(QLatin1String("font"), new FontValueParser);
-  s_valueParsers.insert(QLatin1String("number"), new NumberValueParser);
-  s_valueParsers.insert(QLatin1String("pixmap"), new PixmapValueParser);
-  s_valueParsers.insert(QLatin1String("rect"), new RectValueParser);
-  s_valueParsers.insert(QLatin1String("set"), new SetValueParser);
-  s_valueParsers.insert(QLatin1String("size"), new SizeValueParser);
-  s_valueParsers.insert(QLatin1String("string"), new StringValueParser);
-}
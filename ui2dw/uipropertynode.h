@@ -36,7 +36,6 @@
 #include <QVariant>
 
 class Parser;
-class PropertyValueParser;
 
 Q_DECLARE_METATYPE(QMargins)
 
@@ -90,12 +89,6 @@ class UiPropertyNode : public UiNode
 
   protected:
     QVariant m_value;
-
-    typedef QHash<QString, PropertyValueParser*> ValueParserHash;
-    static ValueParserHash s_valueParsers;
-
-  protected:
-    static void initializeValueParsers();
 };
 
 #endif // UIPROPERTYNODE_H
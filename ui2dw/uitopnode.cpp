@@ -36,6 +36,10 @@ UiTopNode::UiTopNode()
 void UiTopNode::accept(UiNodeVisitor *visitor)
 {
   visitor->visit(this);
+
+  if (visitor->isRecursive()) {
+    visitor->endVisit(this);
+  }
 }
 
 QStringList UiTopNode::className() const
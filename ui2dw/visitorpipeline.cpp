@@ -0,0 +1,174 @@
+/*
+  visitorpipeline.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "visitorpipeline.h"
+
+#include "buddyvisitor.h"
+#include "compositevisitor.h"
+#include "connectionnodevisitor.h"
+#include "elementnamevisitor.h"
+#include "fontproperyvisitor.h"
+#include "idvisitor.h"
+#include "itemvisitor.h"
+#include "layoutvisitor.h"
+#include "stagetimings.h"
+#include "tabstopsnodevisitor.h"
+#include "uitopnode.h"
+
+#include <QElapsedTimer>
+
+VisitorPipeline::VisitorPipeline(const SharedVisitationContext &sharedContext)
+  : m_sharedContext(sharedContext)
+  , m_mode(Fused)
+  , m_optimizationEnabled(false)
+  , m_timings(0)
+{
+}
+
+void VisitorPipeline::setMode(Mode mode)
+{
+  m_mode = mode;
+}
+
+VisitorPipeline::Mode VisitorPipeline::mode() const
+{
+  return m_mode;
+}
+
+void VisitorPipeline::setOptimizationEnabled(bool enabled)
+{
+  m_optimizationEnabled = enabled;
+}
+
+bool VisitorPipeline::isOptimizationEnabled() const
+{
+  return m_optimizationEnabled;
+}
+
+void VisitorPipeline::setStageTimings(StageTimings *timings)
+{
+  m_timings = timings;
+}
+
+void VisitorPipeline::prepare(UiTopNode *topNode)
+{
+  // remove redundant objects and properties
+  OptimizingVisitor optimizingVisitor(m_sharedContext);
+
+  // set element "id" from objectName
+  IdVisitor idVisitor(m_sharedContext);
+
+  const Stage stages[] = {
+    { "OptimizingVisitor", &optimizingVisitor },
+    { "IdVisitor", &idVisitor }
+  };
+
+  if (m_optimizationEnabled) {
+    runStages(topNode, stages, 2);
+    m_optimizationStatistics = optimizingVisitor.statistics();
+  } else {
+    runStages(topNode, stages + 1, 1);
+  }
+}
+
+void VisitorPipeline::run(UiTopNode *topNode)
+{
+  prepare(topNode);
+
+  // handle layout items
+  ItemVisitor itemVisitor(m_sharedContext);
+
+  // handle layout adjustments
+  LayoutVisitor layoutVisitor(m_sharedContext);
+
+  // adjust class names
+  ElementNameVisitor classVisitor(m_sharedContext);
+
+  // adjust font properties
+  FontProperyVisitor fontPropertiesVisitor(m_sharedContext);
+
+  // handle label buddies
+  BuddyVisitor buddyVisitor(m_sharedContext);
+
+  // handle connections
+  ConnectionNodeVisitor connectionVisitor(m_sharedContext);
+
+  // handle tab stops
+  TabStopsNodeVisitor tabStopsVisitor(m_sharedContext);
+
+  const Stage stages[] = {
+    { "ItemVisitor", &itemVisitor },
+    { "LayoutVisitor", &layoutVisitor },
+    { "ElementNameVisitor", &classVisitor },
+    { "FontProperyVisitor", &fontPropertiesVisitor },
+    { "BuddyVisitor", &buddyVisitor },
+    { "ConnectionNodeVisitor", &connectionVisitor },
+    { "TabStopsNodeVisitor", &tabStopsVisitor }
+  };
+
+  runStages(topNode, stages, sizeof(stages) / sizeof(stages[0]));
+}
+
+OptimizationStatistics VisitorPipeline::optimizationStatistics() const
+{
+  return m_optimizationStatistics;
+}
+
+void VisitorPipeline::runStages(UiTopNode *topNode, const Stage *stages, int stageCount)
+{
+  QElapsedTimer timer;
+
+  if (m_mode == Sequential || stageCount == 1) {
+    for (int i = 0; i < stageCount; ++i) {
+      timer.start();
+      topNode->accept(stages[i].visitor);
+
+      if (m_timings != 0) {
+        m_timings->addTime(QLatin1String(stages[i].name), timer.nsecsElapsed());
+      }
+    }
+
+    if (m_timings != 0) {
+      m_timings->addTraversals(stageCount);
+    }
+    return;
+  }
+
+  CompositeVisitor compositeVisitor(m_sharedContext);
+  compositeVisitor.setTimingEnabled(m_timings != 0);
+  for (int i = 0; i < stageCount; ++i) {
+    compositeVisitor.addVisitor(stages[i].visitor);
+  }
+
+  topNode->accept(&compositeVisitor);
+
+  if (m_timings != 0) {
+    for (int i = 0; i < stageCount; ++i) {
+      m_timings->addTime(QLatin1String(stages[i].name), compositeVisitor.elapsed(i));
+    }
+    m_timings->addTraversals(1);
+  }
+}
@@ -0,0 +1,84 @@
+/*
+  visitorpipeline.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef VISITORPIPELINE_H
+#define VISITORPIPELINE_H
+
+#include "optimizingvisitor.h"
+
+class StageTimings;
+
+// Runs the transformation visitors between parsing and writing.
+// Fused mode needs two traversals: IdVisitor has to see every object
+// before anything resolves ids or removes nodes, all other visitors only
+// look at the current node and its children and share the second one.
+// The optimization runs ahead of IdVisitor in the first traversal.
+class VisitorPipeline
+{
+  public:
+    enum Mode {
+      Sequential,
+      Fused
+    };
+
+    explicit VisitorPipeline(const SharedVisitationContext &sharedContext);
+
+    void setMode(Mode mode);
+    Mode mode() const;
+
+    // removes redundant objects and properties first, see OptimizingVisitor
+    void setOptimizationEnabled(bool enabled);
+    bool isOptimizationEnabled() const;
+
+    // optional, receives the time spent in each visitor
+    void setStageTimings(StageTimings *timings);
+
+    // optimization and ids only, for writers working on the tree as parsed
+    void prepare(UiTopNode *topNode);
+
+    // prepare() followed by the transformations needed for QmlWriter
+    void run(UiTopNode *topNode);
+
+    OptimizationStatistics optimizationStatistics() const;
+
+  private:
+    struct Stage
+    {
+        const char *name;
+        UiNodeVisitor *visitor;
+    };
+
+    void runStages(UiTopNode *topNode, const Stage *stages, int stageCount);
+
+  private:
+    SharedVisitationContext m_sharedContext;
+    Mode m_mode;
+    bool m_optimizationEnabled;
+    StageTimings *m_timings;
+    OptimizationStatistics m_optimizationStatistics;
+};
+
+#endif // VISITORPIPELINE_H
@@ -0,0 +1,362 @@
+/*
+  watchconverter.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "watchconverter.h"
+
+#include "widgetdefaults.h"
+
+#include <QBuffer>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+WatchConverter::WatchConverter(QObject *parent)
+  : QObject(parent)
+  , m_outputFormat(Converter::QmlOutput)
+  , m_optimizationEnabled(false)
+{
+  m_coalescingTimer.setSingleShot(true);
+  m_coalescingTimer.setInterval(100);
+
+  connect(&m_coalescingTimer, SIGNAL(timeout()), this, SLOT(processPendingChanges()));
+  connect(&m_watcher, SIGNAL(directoryChanged(QString)), this, SLOT(onDirectoryChanged(QString)));
+  connect(&m_watcher, SIGNAL(fileChanged(QString)), this, SLOT(onFileChanged(QString)));
+}
+
+void WatchConverter::setOutputDirectory(const QString &outputDirectory)
+{
+  m_outputDirectory = outputDirectory;
+}
+
+QString WatchConverter::outputDirectory() const
+{
+  return m_outputDirectory;
+}
+
+void WatchConverter::setOutputFormat(Converter::OutputFormat format)
+{
+  m_outputFormat = format;
+}
+
+Converter::OutputFormat WatchConverter::outputFormat() const
+{
+  return m_outputFormat;
+}
+
+void WatchConverter::setOptimizationEnabled(bool enabled)
+{
+  m_optimizationEnabled = enabled;
+}
+
+bool WatchConverter::isOptimizationEnabled() const
+{
+  return m_optimizationEnabled;
+}
+
+void WatchConverter::setCoalescingInterval(int msecs)
+{
+  m_coalescingTimer.setInterval(qMax(0, msecs));
+}
+
+int WatchConverter::coalescingInterval() const
+{
+  return m_coalescingTimer.interval();
+}
+
+bool WatchConverter::addInput(const QString &input)
+{
+  const QFileInfo inputInfo(input);
+  if (!inputInfo.exists()) {
+    m_errors << QString::fromLatin1("Input %1 does not exist").arg(input);
+    return false;
+  }
+
+  // the file system watcher reports the paths it has been given
+  Root root;
+  root.path = QDir::cleanPath(inputInfo.absoluteFilePath());
+  root.isDirectory = inputInfo.isDir();
+
+  m_roots << root;
+
+  return true;
+}
+
+void WatchConverter::start()
+{
+  if (m_optimizationEnabled) {
+    WidgetDefaults::initialize();
+  }
+
+  // single files are replaced rather than modified by many editors, so
+  // their directory is watched as well
+  Q_FOREACH (const Root &root, m_roots) {
+    if (root.isDirectory) {
+      scanDirectory(root.path, true);
+    } else {
+      scanDirectory(QFileInfo(root.path).path(), false);
+    }
+  }
+
+  processPendingChanges();
+}
+
+QStringList WatchConverter::errors() const
+{
+  return m_errors;
+}
+
+int WatchConverter::fileCount() const
+{
+  return m_files.count();
+}
+
+void WatchConverter::onDirectoryChanged(const QString &path)
+{
+  m_pendingDirectories.insert(path);
+  m_coalescingTimer.start();
+}
+
+void WatchConverter::onFileChanged(const QString &path)
+{
+  m_pendingFiles.insert(path);
+  m_coalescingTimer.start();
+}
+
+void WatchConverter::processPendingChanges()
+{
+  const QSet<QString> pendingDirectories = m_pendingDirectories;
+  m_pendingDirectories.clear();
+
+  Q_FOREACH (const QString &path, pendingDirectories) {
+    scanDirectory(path, false);
+  }
+
+  QStringList pendingFiles = m_pendingFiles.toList();
+  m_pendingFiles.clear();
+
+  // report in a stable order
+  pendingFiles.sort();
+
+  Q_FOREACH (const QString &inputFileName, pendingFiles) {
+    convertFile(inputFileName);
+  }
+}
+
+void WatchConverter::scanDirectory(const QString &path, bool recursive)
+{
+  const QDir dir(path);
+  if (!dir.exists()) {
+    const QString prefix = path + QLatin1Char('/');
+    Q_FOREACH (const QString &inputFileName, m_files.keys()) {
+      if (inputFileName.startsWith(prefix)) {
+        removeFile(inputFileName);
+      }
+    }
+    return;
+  }
+
+  const QStringList watchedDirectories = m_watcher.directories();
+  if (!watchedDirectories.contains(path)) {
+    m_watcher.addPath(path);
+  }
+
+  const QStringList watchedFiles = m_watcher.files();
+
+  Q_FOREACH (const QFileInfo &fileInfo, dir.entryInfoList(QStringList() << QLatin1String("*.ui"), QDir::Files)) {
+    const QString inputFileName = fileInfo.absoluteFilePath();
+    if (m_files.contains(inputFileName)) {
+      // a file that has been replaced is no longer watched
+      if (!watchedFiles.contains(inputFileName)) {
+        m_pendingFiles.insert(inputFileName);
+      }
+      continue;
+    }
+
+    const QString outputPath = relativeOutputPath(inputFileName);
+    if (!outputPath.isEmpty()) {
+      addFile(inputFileName, outputPath);
+    }
+  }
+
+  Q_FOREACH (const QString &inputFileName, m_files.keys()) {
+    if (QFileInfo(inputFileName).path() == path && !QFile::exists(inputFileName)) {
+      removeFile(inputFileName);
+    }
+  }
+
+  Q_FOREACH (const QFileInfo &subDirInfo, dir.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    const QString subDirPath = subDirInfo.absoluteFilePath();
+
+    // only directories below a directory input, new ones need a full scan
+    const int index = rootIndex(subDirPath);
+    if (index < 0 || !m_roots.at(index).isDirectory) {
+      continue;
+    }
+
+    if (recursive || !watchedDirectories.contains(subDirPath)) {
+      scanDirectory(subDirPath, true);
+    }
+  }
+}
+
+void WatchConverter::addFile(const QString &inputFileName, const QString &relativeOutputPath)
+{
+  const QString outputSuffix = m_outputFormat == Converter::CppOutput ? QLatin1String(".h") : QLatin1String(".qml");
+
+  WatchedFile file;
+  file.outputFileName = QDir::cleanPath(m_outputDirectory + QLatin1Char('/') + relativeOutputPath + outputSuffix);
+
+  const QString previousInput = m_inputsByOutput.value(file.outputFileName);
+  if (!previousInput.isEmpty()) {
+    emit conversionFailed(inputFileName, QString::fromLatin1("Output file %1 for %2 is already used for %3")
+                                         .arg(file.outputFileName, inputFileName, previousInput));
+    return;
+  }
+
+  // an up to date output from an earlier run is not rewritten
+  QFile outputFile(file.outputFileName);
+  if (outputFile.open(QIODevice::ReadOnly)) {
+    file.output = outputFile.readAll();
+  }
+
+  m_files.insert(inputFileName, file);
+  m_inputsByOutput.insert(file.outputFileName, inputFileName);
+  m_pendingFiles.insert(inputFileName);
+
+  m_watcher.addPath(inputFileName);
+}
+
+void WatchConverter::removeFile(const QString &inputFileName)
+{
+  // the output stays, an application might still be using it
+  const WatchedFile file = m_files.take(inputFileName);
+  m_inputsByOutput.remove(file.outputFileName);
+  m_pendingFiles.remove(inputFileName);
+
+  if (m_watcher.files().contains(inputFileName)) {
+    m_watcher.removePath(inputFileName);
+  }
+}
+
+void WatchConverter::convertFile(const QString &inputFileName)
+{
+  QHash<QString, WatchedFile>::iterator it = m_files.find(inputFileName);
+  if (it == m_files.end()) {
+    return;
+  }
+
+  QFile inputFile(inputFileName);
+  if (!inputFile.exists()) {
+    removeFile(inputFileName);
+    return;
+  }
+
+  // saving through a temporary file replaces the watched file
+  if (!m_watcher.files().contains(inputFileName)) {
+    m_watcher.addPath(inputFileName);
+  }
+
+  if (!inputFile.open(QIODevice::ReadOnly)) {
+    emit conversionFailed(inputFileName, QString::fromLatin1("Cannot read input file %1").arg(inputFileName));
+    return;
+  }
+
+  const QByteArray input = inputFile.readAll();
+  if (input == it->input) {
+    return;
+  }
+  it->input = input;
+
+  QElapsedTimer timer;
+  timer.start();
+
+  QBuffer inputBuffer;
+  inputBuffer.setData(input);
+  inputBuffer.open(QIODevice::ReadOnly);
+
+  QByteArray output;
+  QBuffer outputBuffer(&output);
+  outputBuffer.open(QIODevice::WriteOnly);
+
+  Converter converter;
+  converter.setOutputFormat(m_outputFormat);
+  converter.setOptimizationEnabled(m_optimizationEnabled);
+
+  // the previous output stays in place until the input is valid again
+  if (!converter.convert(&inputBuffer, &outputBuffer)) {
+    emit conversionFailed(inputFileName, QString::fromLatin1("Failed to parse input file %1: %2")
+                                         .arg(inputFileName, converter.errorString()));
+    return;
+  }
+
+  if (output != it->output) {
+    QDir().mkpath(QFileInfo(it->outputFileName).path());
+
+    // applications loading the output never see a partially written file
+    QSaveFile outputFile(it->outputFileName);
+    if (!outputFile.open(QIODevice::WriteOnly) || outputFile.write(output) != output.size() || !outputFile.commit()) {
+      // retry with the next change even if the input stays the same
+      it->input.clear();
+      emit conversionFailed(inputFileName, QString::fromLatin1("Cannot write to output file %1").arg(it->outputFileName));
+      return;
+    }
+
+    it->output = output;
+  }
+
+  emit fileConverted(inputFileName, it->outputFileName, timer.elapsed());
+}
+
+int WatchConverter::rootIndex(const QString &path) const
+{
+  for (int i = 0; i < m_roots.count(); ++i) {
+    const Root &root = m_roots.at(i);
+    if (path == root.path || (root.isDirectory && path.startsWith(root.path + QLatin1Char('/')))) {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+QString WatchConverter::relativeOutputPath(const QString &inputFileName) const
+{
+  const int index = rootIndex(inputFileName);
+  if (index < 0) {
+    return QString();
+  }
+
+  const Root &root = m_roots.at(index);
+  if (!root.isDirectory) {
+    return QFileInfo(inputFileName).completeBaseName();
+  }
+
+  const QFileInfo relativeInfo(QDir(root.path).relativeFilePath(inputFileName));
+  return relativeInfo.path() + QLatin1Char('/') + relativeInfo.completeBaseName();
+}
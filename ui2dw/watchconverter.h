@@ -0,0 +1,125 @@
+/*
+  watchconverter.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef WATCHCONVERTER_H
+#define WATCHCONVERTER_H
+
+#include "converter.h"
+
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+// Keeps converting .ui files into an output directory whenever they change.
+// The last input and output of every file are kept in memory, so saves
+// without changes neither trigger a conversion nor touch the output, and
+// outputs are replaced atomically for applications loading them meanwhile
+class WatchConverter : public QObject
+{
+  Q_OBJECT
+
+  public:
+    explicit WatchConverter(QObject *parent = 0);
+
+    void setOutputDirectory(const QString &outputDirectory);
+    QString outputDirectory() const;
+
+    void setOutputFormat(Converter::OutputFormat format);
+    Converter::OutputFormat outputFormat() const;
+
+    // see Converter::setOptimizationEnabled(), needs a QApplication
+    void setOptimizationEnabled(bool enabled);
+    bool isOptimizationEnabled() const;
+
+    // time to wait for further changes before converting, editors
+    // often write a file several times when saving it
+    void setCoalescingInterval(int msecs);
+    int coalescingInterval() const;
+
+    // inputs can be .ui files or directories, which are watched recursively
+    bool addInput(const QString &input);
+
+    // converts all inputs once, then converts changed files while the
+    // event loop is running
+    void start();
+
+    QStringList errors() const;
+
+    int fileCount() const;
+
+  Q_SIGNALS:
+    void fileConverted(const QString &inputFileName, const QString &outputFileName, qint64 elapsed);
+    void conversionFailed(const QString &inputFileName, const QString &errorString);
+
+  private Q_SLOTS:
+    void onDirectoryChanged(const QString &path);
+    void onFileChanged(const QString &path);
+    void processPendingChanges();
+
+  private:
+    struct Root
+    {
+      QString path;
+      bool isDirectory;
+    };
+
+    struct WatchedFile
+    {
+      QString outputFileName;
+      QByteArray input;
+      QByteArray output;
+    };
+
+    QString m_outputDirectory;
+    Converter::OutputFormat m_outputFormat;
+    bool m_optimizationEnabled;
+
+    QVector<Root> m_roots;
+    QStringList m_errors;
+
+    QHash<QString, WatchedFile> m_files;
+    QHash<QString, QString> m_inputsByOutput;
+
+    QFileSystemWatcher m_watcher;
+    QTimer m_coalescingTimer;
+    QSet<QString> m_pendingDirectories;
+    QSet<QString> m_pendingFiles;
+
+  private:
+    void scanDirectory(const QString &path, bool recursive);
+    void addFile(const QString &inputFileName, const QString &relativeOutputPath);
+    void removeFile(const QString &inputFileName);
+    void convertFile(const QString &inputFileName);
+    int rootIndex(const QString &path) const;
+    QString relativeOutputPath(const QString &inputFileName) const;
+};
+
+#endif // WATCHCONVERTER_H
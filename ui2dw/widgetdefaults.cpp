@@ -0,0 +1,357 @@
+/*
+  widgetdefaults.cpp
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "widgetdefaults.h"
+
+#include "uipropertynode.h"
+
+#include <QAction>
+#include <QApplication>
+#include <QCalendarWidget>
+#include <QCheckBox>
+#include <QColumnView>
+#include <QComboBox>
+#include <QCommandLinkButton>
+#include <QDateEdit>
+#include <QDateTimeEdit>
+#include <QDebug>
+#include <QDial>
+#include <QDialog>
+#include <QDialogButtonBox>
+#include <QDockWidget>
+#include <QDoubleSpinBox>
+#include <QFontComboBox>
+#include <QFormLayout>
+#include <QFrame>
+#include <QGraphicsView>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QHBoxLayout>
+#include <QLCDNumber>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QListWidget>
+#include <QMainWindow>
+#include <QMdiArea>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMetaProperty>
+#include <QPlainTextEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QScrollArea>
+#include <QScrollBar>
+#include <QSlider>
+#include <QSpinBox>
+#include <QSplitter>
+#include <QStackedWidget>
+#include <QStatusBar>
+#include <QTabWidget>
+#include <QTableView>
+#include <QTableWidget>
+#include <QTextBrowser>
+#include <QTextEdit>
+#include <QTimeEdit>
+#include <QToolBar>
+#include <QToolBox>
+#include <QToolButton>
+#include <QTreeView>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+#include <QWidget>
+
+WidgetDefaults *WidgetDefaults::s_instance = 0;
+
+template <typename T>
+static QObject *createObject()
+{
+  return new T;
+}
+
+static QObject *createAction()
+{
+  return new QAction(static_cast<QObject*>(0));
+}
+
+struct ClassFactory
+{
+    const char *className;
+    QObject *(*create)();
+};
+
+static const ClassFactory classFactories[] = {
+  { "QAction", &createAction },
+  { "QCalendarWidget", &createObject<QCalendarWidget> },
+  { "QCheckBox", &createObject<QCheckBox> },
+  { "QColumnView", &createObject<QColumnView> },
+  { "QComboBox", &createObject<QComboBox> },
+  { "QCommandLinkButton", &createObject<QCommandLinkButton> },
+  { "QDateEdit", &createObject<QDateEdit> },
+  { "QDateTimeEdit", &createObject<QDateTimeEdit> },
+  { "QDial", &createObject<QDial> },
+  { "QDialog", &createObject<QDialog> },
+  { "QDialogButtonBox", &createObject<QDialogButtonBox> },
+  { "QDockWidget", &createObject<QDockWidget> },
+  { "QDoubleSpinBox", &createObject<QDoubleSpinBox> },
+  { "QFontComboBox", &createObject<QFontComboBox> },
+  { "QFormLayout", &createObject<QFormLayout> },
+  { "QFrame", &createObject<QFrame> },
+  { "QGraphicsView", &createObject<QGraphicsView> },
+  { "QGridLayout", &createObject<QGridLayout> },
+  { "QGroupBox", &createObject<QGroupBox> },
+  { "QHBoxLayout", &createObject<QHBoxLayout> },
+  { "QLCDNumber", &createObject<QLCDNumber> },
+  { "QLabel", &createObject<QLabel> },
+  { "QLineEdit", &createObject<QLineEdit> },
+  { "QListView", &createObject<QListView> },
+  { "QListWidget", &createObject<QListWidget> },
+  { "QMainWindow", &createObject<QMainWindow> },
+  { "QMdiArea", &createObject<QMdiArea> },
+  { "QMenu", &createObject<QMenu> },
+  { "QMenuBar", &createObject<QMenuBar> },
+  { "QPlainTextEdit", &createObject<QPlainTextEdit> },
+  { "QProgressBar", &createObject<QProgressBar> },
+  { "QPushButton", &createObject<QPushButton> },
+  { "QRadioButton", &createObject<QRadioButton> },
+  { "QScrollArea", &createObject<QScrollArea> },
+  { "QScrollBar", &createObject<QScrollBar> },
+  { "QSlider", &createObject<QSlider> },
+  { "QSpinBox", &createObject<QSpinBox> },
+  { "QSplitter", &createObject<QSplitter> },
+  { "QStackedWidget", &createObject<QStackedWidget> },
+  { "QStatusBar", &createObject<QStatusBar> },
+  { "QTabWidget", &createObject<QTabWidget> },
+  { "QTableView", &createObject<QTableView> },
+  { "QTableWidget", &createObject<QTableWidget> },
+  { "QTextBrowser", &createObject<QTextBrowser> },
+  { "QTextEdit", &createObject<QTextEdit> },
+  { "QTimeEdit", &createObject<QTimeEdit> },
+  { "QToolBar", &createObject<QToolBar> },
+  { "QToolBox", &createObject<QToolBox> },
+  { "QToolButton", &createObject<QToolButton> },
+  { "QTreeView", &createObject<QTreeView> },
+  { "QTreeWidget", &createObject<QTreeWidget> },
+  { "QVBoxLayout", &createObject<QVBoxLayout> },
+  { "QWidget", &createObject<QWidget> }
+};
+
+struct ContextDependentProperty
+{
+    const char *className;
+    const char *propertyName;
+};
+
+// properties whose default depends on the parent or its style, so the value of a
+// parentless instance is not the value of the same widget inside a form. E.g. push
+// buttons are autoDefault inside a QDialog, tool buttons inside a QToolBar follow its
+// style and icon size, and nested layouts have no margins while top level ones do
+static const ContextDependentProperty contextDependentProperties[] = {
+  { "QWidget", "layoutDirection" },
+  { "QPushButton", "autoDefault" },
+  { "QPushButton", "default" },
+  { "QToolButton", "autoRaise" },
+  { "QToolButton", "iconSize" },
+  { "QToolButton", "toolButtonStyle" },
+  { "QToolBar", "iconSize" },
+  { "QToolBar", "toolButtonStyle" },
+  { "QLayout", "margin" },
+  { "QLayout", "spacing" },
+  { "QGridLayout", "horizontalSpacing" },
+  { "QGridLayout", "verticalSpacing" },
+  { "QFormLayout", "horizontalSpacing" },
+  { "QFormLayout", "verticalSpacing" },
+  { "QFormLayout", "fieldGrowthPolicy" },
+  { "QFormLayout", "rowWrapPolicy" },
+  { "QFormLayout", "labelAlignment" },
+  { "QFormLayout", "formAlignment" }
+};
+
+static bool isContextDependent(const QObject *object, const char *propertyName)
+{
+  const int count = sizeof(contextDependentProperties) / sizeof(contextDependentProperties[0]);
+  for (int i = 0; i < count; ++i) {
+    if (qstrcmp(contextDependentProperties[i].propertyName, propertyName) == 0 &&
+        object->inherits(contextDependentProperties[i].className)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static int enumValue(const QVariant &value)
+{
+  bool ok = false;
+  const int result = value.toInt(&ok);
+  if (ok) {
+    return result;
+  }
+
+  // QFlags and enums without registered conversion hold a plain int
+  return *static_cast<const int*>(value.constData());
+}
+
+static QString enumKeys(const SetValue &setValue)
+{
+  QStringList keys;
+  Q_FOREACH (const EnumValue &flag, setValue.flags) {
+    keys << flag.nameParts.last();
+  }
+
+  return keys.join(QLatin1Char('|'));
+}
+
+const WidgetDefaults *WidgetDefaults::instance()
+{
+  return s_instance;
+}
+
+void WidgetDefaults::initialize()
+{
+  if (s_instance != 0) {
+    return;
+  }
+
+  s_instance = new WidgetDefaults;
+}
+
+WidgetDefaults::WidgetDefaults()
+{
+  if (qobject_cast<QApplication*>(QCoreApplication::instance()) == 0) {
+    qWarning() << Q_FUNC_INFO << "Widget defaults need a QApplication, no defaults available";
+    return;
+  }
+
+  const int classCount = sizeof(classFactories) / sizeof(classFactories[0]);
+  for (int i = 0; i < classCount; ++i) {
+    QObject *object = classFactories[i].create();
+    addClass(QLatin1String(classFactories[i].className), object);
+    delete object;
+  }
+}
+
+void WidgetDefaults::addClass(const QString &className, QObject *object)
+{
+  PropertyDefaultHash &properties = m_classes[className];
+
+  const QMetaObject *metaObject = object->metaObject();
+  for (int i = 0; i < metaObject->propertyCount(); ++i) {
+    const QMetaProperty property = metaObject->property(i);
+    if (!property.isReadable() || !property.isWritable() || !property.isDesignable()) {
+      continue;
+    }
+
+    // a parentless widget is a window and has a different geometry than
+    // the same widget inside a form
+    const QLatin1String name(property.name());
+    if (name == QLatin1String("objectName") || name == QLatin1String("geometry")) {
+      continue;
+    }
+
+    if (isContextDependent(object, property.name())) {
+      continue;
+    }
+
+    PropertyDefault propertyDefault;
+    propertyDefault.value = property.read(object);
+    if (!propertyDefault.value.isValid()) {
+      continue;
+    }
+
+    if (property.isEnumType()) {
+      propertyDefault.enumerator = property.enumerator();
+      propertyDefault.value = enumValue(propertyDefault.value);
+    }
+
+    properties.insert(name, propertyDefault);
+  }
+}
+
+bool WidgetDefaults::hasClass(const QString &className) const
+{
+  return m_classes.contains(className);
+}
+
+bool WidgetDefaults::isDefault(const QString &className, const QString &propertyName, const QVariant &value) const
+{
+  QHash<QString, PropertyDefaultHash>::const_iterator classIt = m_classes.constFind(className);
+  if (classIt == m_classes.constEnd()) {
+    return false;
+  }
+
+  PropertyDefaultHash::const_iterator propertyIt = classIt->constFind(propertyName);
+  if (propertyIt == classIt->constEnd()) {
+    return false;
+  }
+
+  const PropertyDefault &propertyDefault = *propertyIt;
+
+  if (propertyDefault.enumerator.isValid()) {
+    const QMetaEnum &enumerator = propertyDefault.enumerator;
+
+    bool ok = false;
+    int intValue = 0;
+    if (value.canConvert<EnumValue>()) {
+      const QString key = value.value<EnumValue>().nameParts.last();
+      if (enumerator.isFlag()) {
+        intValue = enumerator.keysToValue(key.toLatin1().constData(), &ok);
+      } else {
+        intValue = enumerator.keyToValue(key.toLatin1().constData(), &ok);
+      }
+    } else if (value.canConvert<SetValue>() && enumerator.isFlag()) {
+      const QString keys = enumKeys(value.value<SetValue>());
+      intValue = enumerator.keysToValue(keys.toLatin1().constData(), &ok);
+    }
+
+    return ok && intValue == propertyDefault.value.toInt();
+  }
+
+  const QVariant &defaultValue = propertyDefault.value;
+
+  switch (value.type()) {
+  case QVariant::Bool:
+    return defaultValue.type() == QVariant::Bool && defaultValue.toBool() == value.toBool();
+
+  case QVariant::Int:
+    return (defaultValue.type() == QVariant::Int || defaultValue.type() == QVariant::UInt) &&
+           defaultValue.toInt() == value.toInt();
+
+  case QVariant::Double:
+    return defaultValue.type() == QVariant::Double && defaultValue.toDouble() == value.toDouble();
+
+  case QVariant::String:
+  case QVariant::Rect:
+  case QVariant::Size:
+    return defaultValue.type() == value.type() && defaultValue == value;
+
+  default:
+    break;
+  }
+
+  return false;
+}
@@ -0,0 +1,71 @@
+/*
+  widgetdefaults.h
+
+  This file is part of DeclarativeWidgets, library and tools for creating QtWidget UIs with QML.
+
+  Copyright (C) 2017 Klarälvdalens Datakonsult AB, a KDAB Group company, info@kdab.com
+
+  Licensees holding valid commercial KDAB DeclarativeWidgets licenses may use this file in
+  accordance with DeclarativeWidgets Commercial License Agreement provided with the Software.
+
+  Contact info@kdab.com if any conditions of this licensing are not clear to you.
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef WIDGETDEFAULTS_H
+#define WIDGETDEFAULTS_H
+
+#include <QHash>
+#include <QMetaEnum>
+#include <QVariant>
+
+// Default property values of the standard widget, layout and action classes,
+// read from freshly created instances through their meta objects.
+// Properties whose default depends on the parent, like QPushButton::autoDefault
+// inside a QDialog, are left out and therefore never considered default.
+// Creating widgets needs a QApplication, so the table is built once on the
+// main thread; afterwards it is only read and can be shared between threads.
+class WidgetDefaults
+{
+  public:
+    // returns 0 until initialize() has been called
+    static const WidgetDefaults *instance();
+
+    static void initialize();
+
+    bool hasClass(const QString &className) const;
+
+    // value as stored in a UiPropertyNode, enums and sets are compared by value
+    bool isDefault(const QString &className, const QString &propertyName, const QVariant &value) const;
+
+  private:
+    WidgetDefaults();
+
+    void addClass(const QString &className, QObject *object);
+
+  private:
+    struct PropertyDefault
+    {
+        QVariant value;
+        QMetaEnum enumerator;
+    };
+
+    typedef QHash<QString, PropertyDefault> PropertyDefaultHash;
+    QHash<QString, PropertyDefaultHash> m_classes;
+
+    static WidgetDefaults *s_instance;
+};
+
+#endif // WIDGETDEFAULTS_H